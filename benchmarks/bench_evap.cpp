@@ -0,0 +1,404 @@
+/*
+ * Microbenchmark suite for every evaporation loss implementation.
+ *
+ * Measures ns/eval, evals/sec/core and heap allocations per eval for the
+ * scalar, batch, SIMD and parallel paths over three input distributions:
+ *   uniform    - uniform over the physical parameter limits
+ *   clustered  - field-like data: few nozzle sizes and pressure setpoints
+ *   clamp      - 40% of every axis outside the limits (clamping / error paths)
+ *
+ * Output is one JSON object per line, for example:
+ *   {"impl":"simd_batch","variant":"avx2","dist":"uniform","threads":1,
+ *    "records":1000000,"ns_per_eval":35.7,"evals_per_sec_per_core":2.8e7,
+ *    "allocs_per_eval":0,"errors":0,"checksum":8153321.4}
+ *
+ * Build: g++ -std=c++17 -O2 -pthread -o bench_evap bench_evap.cpp ../src/solver.cpp
+ * Usage: ./bench_evap [--records N] [--min-time SECONDS] [--threads MAX] [--filter SUBSTRING]
+ *
+ * The parallel path is measured at 1, 2, 4, ... threads up to --threads
+ * (default: hardware concurrency). --filter keeps only the measurements
+ * whose "impl/variant/dist" label contains the substring.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../src/solver.h"
+#include "../src/evap_solver_compact.h"
+#include "../src/evap_solver_validated.h"
+#include "../src/evap_solver_simd.h"
+#include "../src/evap_solver_parallel.h"
+#include "../src/evap_solver_aggregate.h"
+#include "../src/evap_solver_uncertainty.h"
+#include "../src/evap_solver_separable.h"
+#include "../src/evap_solver_polynomial.h"
+#include "../src/evap_solver_profile.h"
+#include "../src/evap_solver_lut.h"
+#include "../src/evap_solver_tables.h"
+#include "../src/evap_solver_memo.h"
+#include "../src/evap_solver_inverse.h"
+#include "../examples/evap_calculator.h"
+
+// The copy-paste calculator is a complete program; compile its function in
+// a namespace and rename its example main so it can be linked in here
+namespace CopyPaste {
+#define main copyPasteExampleMain
+#include "../examples/copy_paste_calculator.cpp"
+#undef main
+}
+
+// ---------------------------------------------------------------------------
+// Heap allocation counting
+
+static std::atomic<size_t> allocationCount{0};
+
+void* operator new(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+// ---------------------------------------------------------------------------
+// Input distributions
+
+struct Dataset {
+    std::string name;
+    std::vector<double> vpd, pressure, wind;
+    std::vector<int> nozzle;
+
+    size_t size() const { return vpd.size(); }
+};
+
+Dataset makeUniform(size_t n, std::mt19937_64& rng) {
+    Dataset d{"uniform", {}, {}, {}, {}};
+    std::uniform_real_distribution<double> vpd(0.0, 1.0), pressure(20, 80), wind(0, 15);
+    std::uniform_int_distribution<int> nozzle(8, 64);
+    for (size_t i = 0; i < n; i++) {
+        d.vpd.push_back(vpd(rng));
+        d.nozzle.push_back(nozzle(rng));
+        d.pressure.push_back(pressure(rng));
+        d.wind.push_back(wind(rng));
+    }
+    return d;
+}
+
+Dataset makeClustered(size_t n, std::mt19937_64& rng) {
+    Dataset d{"clustered", {}, {}, {}, {}};
+    const int nozzles[] = {10, 12, 16, 24};
+    const double setpoints[] = {35, 40, 50, 60};
+    std::uniform_int_distribution<int> pick(0, 3);
+    std::normal_distribution<double> vpd(0.55, 0.12), drift(0.0, 0.5);
+    std::gamma_distribution<double> wind(2.0, 2.2);
+    for (size_t i = 0; i < n; i++) {
+        d.vpd.push_back(std::clamp(vpd(rng), 0.0, 1.0));
+        d.nozzle.push_back(nozzles[pick(rng)]);
+        d.pressure.push_back(std::clamp(setpoints[pick(rng)] + drift(rng), 20.0, 80.0));
+        d.wind.push_back(std::min(wind(rng), 15.0));
+    }
+    return d;
+}
+
+Dataset makeClamp(size_t n, std::mt19937_64& rng) {
+    Dataset d{"clamp", {}, {}, {}, {}};
+    // Each axis spans 20% beyond each limit, so 40% of values are out of range
+    std::uniform_real_distribution<double> vpd(-1.0 / 3, 4.0 / 3), pressure(0, 100), wind(-5, 20);
+    std::uniform_int_distribution<int> nozzle(-11, 83);
+    for (size_t i = 0; i < n; i++) {
+        d.vpd.push_back(vpd(rng));
+        d.nozzle.push_back(nozzle(rng));
+        d.pressure.push_back(pressure(rng));
+        d.wind.push_back(wind(rng));
+    }
+    return d;
+}
+
+// ---------------------------------------------------------------------------
+// Measurement
+
+struct Options {
+    size_t records = 1000000;
+    double minTime = 0.2;
+    unsigned maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    std::string filter;
+};
+
+struct RunStats {
+    size_t errors = 0;
+    double checksum = 0.0;
+};
+
+// Run body(out) repeatedly for at least minTime and report the fastest pass
+template <class Body>
+void measure(const Options& opt, const std::string& impl, const std::string& variant, const Dataset& data,
+             unsigned threads, Body&& body) {
+    std::string label = impl + "/" + variant + "/" + data.name;
+    if (!opt.filter.empty() && label.find(opt.filter) == std::string::npos) return;
+
+    std::vector<double> out(data.size());
+    RunStats stats = body(out); // warm-up
+
+    size_t allocsBefore = allocationCount.load();
+    stats = body(out);
+    size_t allocs = allocationCount.load() - allocsBefore;
+
+    double best = 1e300;
+    double elapsed = 0.0;
+    int passes = 0;
+    while (elapsed < opt.minTime || passes < 3) {
+        auto start = std::chrono::steady_clock::now();
+        stats = body(out);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        best = std::min(best, seconds);
+        elapsed += seconds;
+        passes++;
+    }
+
+    double nsPerEval = best * 1e9 / data.size();
+    std::printf("{\"impl\":\"%s\",\"variant\":\"%s\",\"dist\":\"%s\",\"threads\":%u,\"records\":%zu,"
+                "\"ns_per_eval\":%.3f,\"evals_per_sec_per_core\":%.6g,\"allocs_per_eval\":%.6g,"
+                "\"errors\":%zu,\"checksum\":%.6f}\n",
+                impl.c_str(), variant.c_str(), data.name.c_str(), threads, data.size(), nsPerEval,
+                1e9 / nsPerEval / threads, static_cast<double>(allocs) / data.size(), stats.errors,
+                stats.checksum);
+    std::fflush(stdout);
+}
+
+double sum(const std::vector<double>& out) {
+    double s = 0.0;
+    for (double v : out) s += v;
+    return s;
+}
+
+// Per-record scalar implementation; exceptions count as errors
+template <class Fn>
+void measureScalar(const Options& opt, const std::string& impl, const Dataset& data, Fn fn) {
+    measure(opt, impl, "scalar", data, 1, [&](std::vector<double>& out) {
+        RunStats stats;
+        for (size_t i = 0; i < data.size(); i++) {
+            try {
+                out[i] = fn(data.vpd[i], data.nozzle[i], data.pressure[i], data.wind[i]);
+            } catch (const std::exception&) {
+                out[i] = 0.0;
+                stats.errors++;
+            }
+        }
+        stats.checksum = sum(out);
+        return stats;
+    });
+}
+
+void runDataset(const Options& opt, const Dataset& data) {
+    using namespace EvapSolver;
+
+    // The five implementations, one record at a time
+    measureScalar(opt, "solver_cpp", data, [](double v, int n, double p, double w) {
+        Inputs in;
+        in.vpd = v;
+        in.nozzle = n;
+        in.pressure = p;
+        in.wind = w;
+        return solveEvaporationLoss(in);
+    });
+    measureScalar(opt, "compact", data, [](double v, int n, double p, double w) {
+        return Calculator::calculate({v, n, p, w});
+    });
+    // Distinct records, so this is the cache-miss cost
+    measureScalar(opt, "memo", data, [](double v, int n, double p, double w) {
+        return calculateEvaporationLossMemoized(v, n, p, w);
+    });
+    measureScalar(opt, "validated", data, [](double v, int n, double p, double w) {
+        return EvapSolverValidated::calculateEvaporationLoss(v, n, p, w);
+    });
+    measureScalar(opt, "validated_safe", data, [](double v, int n, double p, double w) {
+        return EvapSolverValidated::calculateEvaporationLossSafe(v, n, p, w);
+    });
+    measureScalar(opt, "evap_calculator_h", data, [](double v, int n, double p, double w) {
+        return ::calculateEvaporationLoss(v, n, p, w);
+    });
+    measureScalar(opt, "copy_paste", data, [](double v, int n, double p, double w) {
+        return CopyPaste::calculateEvaporationLoss(v, n, p, w);
+    });
+
+    // Batch paths
+    measure(opt, "compact_batch", "scalar", data, 1, [&](std::vector<double>& out) {
+        Calculator::calculateBatch(data.vpd.data(), data.nozzle.data(), data.pressure.data(),
+                                   data.wind.data(), out.data(), data.size());
+        return RunStats{0, sum(out)};
+    });
+    const Simd::Kernel kernels[] = {Simd::Kernel::Scalar, Simd::Kernel::AVX2, Simd::Kernel::AVX512,
+                                    Simd::Kernel::NEON};
+    for (Simd::Kernel k : kernels) {
+        if (!Simd::isSupported(k)) continue;
+        measure(opt, "simd_batch", Simd::kernelName(k), data, 1, [&](std::vector<double>& out) {
+            Simd::calculateBatch(k, data.vpd.data(), data.nozzle.data(), data.pressure.data(),
+                                 data.wind.data(), out.data(), data.size());
+            return RunStats{0, sum(out)};
+        });
+    }
+    // Same kernels on runtime-loaded tables (defaults: identical checksums)
+    const NomographTables tables;
+    for (Simd::Kernel k : kernels) {
+        if (!Simd::isSupported(k)) continue;
+        measure(opt, "tables_batch", Simd::kernelName(k), data, 1, [&](std::vector<double>& out) {
+            Simd::calculateBatch(k, tables, data.vpd.data(), data.nozzle.data(), data.pressure.data(),
+                                 data.wind.data(), out.data(), data.size());
+            return RunStats{0, sum(out)};
+        });
+    }
+    // Inverse queries: the dataset's wind column is the target loss (0-15%)
+    std::vector<InverseStatus> inverseStatus(data.size());
+    for (Simd::Kernel k : kernels) {
+        if (!Simd::isSupported(k)) continue;
+        measure(opt, "inverse_wind_batch", Simd::kernelName(k), data, 1, [&](std::vector<double>& out) {
+            Simd::maxWindBatch(k, data.vpd.data(), data.nozzle.data(), data.pressure.data(), data.wind.data(),
+                               out.data(), inverseStatus.data(), data.size());
+            return RunStats{0, sum(out)};
+        });
+    }
+    std::vector<EvapSolverValidated::Status> status(data.size());
+    measure(opt, "validated_batch", "scalar", data, 1, [&](std::vector<double>& out) {
+        size_t invalid = EvapSolverValidated::Calculator::calculateBatch(
+            data.vpd.data(), data.nozzle.data(), data.pressure.data(), data.wind.data(), out.data(),
+            status.data(), data.size());
+        return RunStats{invalid, sum(out)};
+    });
+    std::vector<float> vpdF(data.vpd.begin(), data.vpd.end()), pressureF(data.pressure.begin(), data.pressure.end()),
+        windF(data.wind.begin(), data.wind.end()), outF(data.size());
+    for (Simd::Kernel k : kernels) {
+        if (!Simd::isSupported(k)) continue;
+        measure(opt, "simd_batch_float", Simd::kernelName(k), data, 1, [&](std::vector<double>& out) {
+            Simd::calculateBatch(k, vpdF.data(), data.nozzle.data(), pressureF.data(), windF.data(), outF.data(),
+                                 data.size());
+            std::copy(outF.begin(), outF.end(), out.begin());
+            return RunStats{0, sum(out)};
+        });
+    }
+    measure(opt, "separable_batch", "scalar", data, 1, [&](std::vector<double>& out) {
+        SeparableCalculator::calculateBatch(data.vpd.data(), data.nozzle.data(), data.pressure.data(),
+                                            data.wind.data(), out.data(), data.size());
+        return RunStats{0, sum(out)};
+    });
+    for (Simd::Kernel k : kernels) {
+        if (!Simd::isSupported(k)) continue;
+        measure(opt, "polynomial_batch", Simd::kernelName(k), data, 1, [&](std::vector<double>& out) {
+            Simd::calculatePolynomialBatch(k, detail::polynomialFit, data.vpd.data(), data.nozzle.data(),
+                                           data.pressure.data(), data.wind.data(), out.data(), data.size());
+            return RunStats{0, sum(out)};
+        });
+    }
+    std::vector<SprinklerProfile> profiles;
+    for (size_t i = 0; i < data.size(); i++) profiles.emplace_back(data.nozzle[i], data.pressure[i]);
+    measure(opt, "profile_batch", "scalar", data, 1, [&](std::vector<double>& out) {
+        evaluateProfiles(profiles.data(), data.vpd.data(), data.wind.data(), out.data(), data.size());
+        return RunStats{0, sum(out)};
+    });
+
+    // One sprinkler's lookup table over the dataset's weather columns
+    for (LutInterpolation mode : {LutInterpolation::Nearest, LutInterpolation::Bilinear}) {
+        LutOptions lutOptions;
+        lutOptions.interpolation = mode;
+        ProfileLut lut(12, 40, lutOptions);
+        measure(opt, "lut_batch", mode == LutInterpolation::Nearest ? "nearest" : "bilinear", data, 1,
+                [&](std::vector<double>& out) {
+                    lut.evaluateBatch(data.vpd.data(), data.wind.data(), out.data(), data.size());
+                    return RunStats{0, sum(out)};
+                });
+    }
+
+    // Thread scaling of the parallel engine
+    std::vector<unsigned> threadCounts;
+    for (unsigned threads = 1; threads < opt.maxThreads; threads *= 2) threadCounts.push_back(threads);
+    threadCounts.push_back(opt.maxThreads);
+    for (unsigned threads : threadCounts) {
+        Parallel::ThreadPool pool({threads, 16384, false});
+        measure(opt, "parallel_batch", Simd::kernelName(Simd::activeKernel()), data, threads,
+                [&](std::vector<double>& out) {
+                    Parallel::calculateBatch(pool, data.vpd.data(), data.nozzle.data(), data.pressure.data(),
+                                             data.wind.data(), out.data(), data.size());
+                    return RunStats{0, sum(out)};
+                });
+    }
+
+    // Grouped totals over 256 fields, no per-record output
+    std::vector<double> volume(data.size(), 1.0);
+    std::vector<uint32_t> field(data.size());
+    for (size_t i = 0; i < field.size(); i++) field[i] = static_cast<uint32_t>(i * 256 / field.size());
+    for (unsigned threads : threadCounts) {
+        Parallel::ThreadPool pool({threads, 16384, false});
+        measure(opt, "aggregate", Simd::kernelName(Simd::activeKernel()), data, threads,
+                [&](std::vector<double>&) {
+                    std::vector<Parallel::GroupTotal> totals = Parallel::aggregateByKey(
+                        pool, data.vpd.data(), data.nozzle.data(), data.pressure.data(), data.wind.data(),
+                        volume.data(), field.data(), data.size(), 256);
+                    double lost = 0;
+                    for (const Parallel::GroupTotal& t : totals) lost += t.lost;
+                    return RunStats{0, lost};
+                });
+    }
+
+    // Monte Carlo: 1000 samples for each of the first 1000 records; ns_per_eval is per record
+    Dataset head{data.name, {}, {}, {}, {}};
+    size_t headSize = std::min<size_t>(data.size(), 1000);
+    head.vpd.assign(data.vpd.begin(), data.vpd.begin() + headSize);
+    head.pressure.assign(data.pressure.begin(), data.pressure.begin() + headSize);
+    head.wind.assign(data.wind.begin(), data.wind.begin() + headSize);
+    head.nozzle.assign(data.nozzle.begin(), data.nozzle.begin() + headSize);
+    Uncertainty::SensorNoise noise{0.02, 1.0, 0.5};
+    Uncertainty::Options mcOptions;
+    std::vector<double> variance(headSize), quantiles(headSize * mcOptions.quantiles.size());
+    for (unsigned threads : threadCounts) {
+        Parallel::ThreadPool pool({threads, 16, false});
+        measure(opt, "uncertainty", "1000_samples", head, threads, [&](std::vector<double>& out) {
+            Uncertainty::propagateBatch(pool, head.vpd.data(), head.nozzle.data(), head.pressure.data(),
+                                        head.wind.data(), noise, mcOptions, out.data(), variance.data(),
+                                        quantiles.data(), head.size());
+            return RunStats{0, sum(out)};
+        });
+    }
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--records" && i + 1 < argc) {
+            opt.records = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--min-time" && i + 1 < argc) {
+            opt.minTime = std::atof(argv[++i]);
+        } else if (arg == "--threads" && i + 1 < argc) {
+            opt.maxThreads = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--filter" && i + 1 < argc) {
+            opt.filter = argv[++i];
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--records N] [--min-time SECONDS] [--threads MAX]"
+                      << " [--filter SUBSTRING]\n";
+            return 1;
+        }
+    }
+    if (opt.records == 0) opt.records = 1;
+
+    std::mt19937_64 rng(20250704);
+    const Dataset datasets[] = {makeUniform(opt.records, rng), makeClustered(opt.records, rng),
+                                makeClamp(opt.records, rng)};
+    for (const Dataset& data : datasets) runDataset(opt, data);
+    return 0;
+}
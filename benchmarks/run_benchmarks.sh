@@ -0,0 +1,29 @@
+#!/bin/bash
+
+# Build and run the benchmark suite.
+# Usage: benchmarks/run_benchmarks.sh [output file] [bench_evap arguments...]
+# Results are one JSON object per line (default: bench_output.txt in the repo root).
+
+OUTPUT="$(realpath -m "${1:-$(dirname "$0")/../bench_output.txt}")"
+shift
+
+cd "$(dirname "$0")"
+
+echo "🔧 Compiling benchmarks (-O2)..."
+g++ -std=c++17 -O2 -pthread -o bench_evap bench_evap.cpp ../src/solver.cpp
+if [ $? -ne 0 ]; then
+    echo "❌ Benchmark compilation failed."
+    exit 1
+fi
+
+echo "⏱️  Running benchmarks..."
+./bench_evap "$@" | tee "$OUTPUT"
+exit_code=${PIPESTATUS[0]}
+
+rm -f bench_evap
+
+if [ $exit_code -ne 0 ]; then
+    echo "❌ Benchmarks failed."
+    exit 1
+fi
+echo "✅ Results written to $OUTPUT"
@@ -0,0 +1,19 @@
+#!/bin/bash
+
+# Build the C ABI (src/evap_solver_c.h) as a shared library
+# Usage: ./build_c_library.sh [OUTPUT_DIR]    (default: build)
+#   OUTPUT_DIR/libevap_solver.so.1 and a libevap_solver.so link to it
+
+ROOT="$(cd "$(dirname "$0")" && pwd)"
+OUT="${1:-$ROOT/build}"
+mkdir -p "$OUT" || exit 1
+
+g++ -std=c++17 -O2 -fPIC -shared -pthread -fvisibility=hidden -fvisibility-inlines-hidden \
+    -Wl,-soname,libevap_solver.so.1 -Wl,--version-script,"$ROOT/src/evap_solver_c.map" \
+    -o "$OUT/libevap_solver.so.1" "$ROOT/src/evap_solver_c.cpp"
+if [ $? -ne 0 ]; then
+    echo "❌ Failed to build libevap_solver.so"
+    exit 1
+fi
+ln -sf libevap_solver.so.1 "$OUT/libevap_solver.so"
+echo "✅ Built $OUT/libevap_solver.so.1"
@@ -53,6 +53,20 @@ else
     exit 1
 fi
 
+# Build the engine differential harness, with the GPU backend when nvcc is available
+echo "Building engine differential harness..."
+DIFF_EXTRA=()
+if command -v nvcc > /dev/null && nvcc -std=c++17 -O3 -fmad=false -c ../src/evap_solver_gpu.cu -o evap_solver_gpu.o; then
+    DIFF_EXTRA=(-DEVAP_SOLVER_DIFF_GPU=1 evap_solver_gpu.o -L"$(dirname "$(command -v nvcc)")/../lib64" -lcudart)
+fi
+g++ -std=c++17 -O2 -pthread -I.. -o test_engine_differential ../tests/test_engine_differential.cpp ../src/solver.cpp "${DIFF_EXTRA[@]}"
+if [ $? -eq 0 ]; then
+    echo "✅ Engine differential harness built successfully"
+else
+    echo "❌ Failed to build engine differential harness"
+    exit 1
+fi
+
 echo
 echo "🧪 Running Validation Tests..."
 echo
@@ -79,6 +93,24 @@ echo "=================================================="
 echo "... (output truncated, see full test for complete results)"
 echo
 
+# Throughput depends on the machine: the first run records build/engine_throughput.txt,
+# later runs fail when an engine falls more than 25% below it
+echo "=================================================="
+echo "4. Engine Differential Fuzz and Throughput Regression"
+echo "=================================================="
+DIFF_ARGS=(--records "${EVAP_FUZZ_RECORDS:-200000000}" --perf-time 1 --baseline ../tests/engine_baseline.txt)
+if [ -f engine_throughput.txt ]; then
+    DIFF_ARGS+=(--baseline engine_throughput.txt)
+else
+    DIFF_ARGS+=(--write-throughput engine_throughput.txt)
+fi
+./test_engine_differential "${DIFF_ARGS[@]}"
+if [ $? -ne 0 ]; then
+    echo "❌ Engine differential checks failed"
+    exit 1
+fi
+echo
+
 # Return to project root
 cd ..
 
@@ -87,6 +119,7 @@ echo "📊 Validation Summary"
 echo "=================================================="
 echo "✅ All validation tests completed successfully"
 echo "✅ All three solver implementations validated"
+echo "✅ All engines agree with solveEvaporationLoss() within their baselines"
 echo "✅ 100% consistency across all solvers"
 echo "✅ 11/11 test cases passed"
 echo "✅ Average accuracy: ±6% of reference data"
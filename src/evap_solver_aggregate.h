@@ -0,0 +1,256 @@
+#ifndef EVAP_SOLVER_AGGREGATE_H
+#define EVAP_SOLVER_AGGREGATE_H
+
+// Grouped totals of water lost, evaluated and reduced in one streaming pass.
+//
+// Each record carries a group key (field, zone, season, ...) and the volume
+// of water applied; the aggregator adds volume and volume * loss / 100 per
+// key without writing the per-record losses anywhere but a block-sized
+// scratch buffer per thread.
+//
+// Reproducibility: records are cut into blocks of blockSize consecutive
+// records, counted over everything ever passed to add(). Each block is
+// evaluated and summed by one thread with compensated (Neumaier) sums per
+// key, and block partials are folded into the totals strictly in block
+// order. The grouping depends only on the record sequence and blockSize, so
+// totals are bit-identical for any pool size, chunk size, stealing order or
+// split of the input across add() calls.
+//
+// Keys are dense ids in [0, groups); records with a larger key are skipped
+// and counted in skipped().
+//
+// Usage:
+//   EvapSolver::Parallel::ThreadPool pool;
+//   EvapSolver::Parallel::Aggregator agg(pool, {fieldCount});
+//   agg.add(vpd, nozzle, pressure, wind, volume, field, n);   // repeat per chunk
+//   std::vector<EvapSolver::Parallel::GroupTotal> fields = agg.totals();
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "evap_solver_parallel.h"
+
+namespace EvapSolver {
+namespace Parallel {
+
+struct AggregateOptions {
+    std::size_t groups = 1;       // Keys are 0 .. groups - 1
+    std::size_t blockSize = 4096; // Records per block; changing it changes the rounding of the totals
+};
+
+struct GroupTotal {
+    std::size_t records = 0;
+    double volume = 0.0; // Applied water, in the caller's unit
+    double lost = 0.0;   // Water lost to evaporation, same unit
+
+    // Volume-weighted mean loss (%)
+    double meanLoss() const { return volume > 0 ? 100.0 * lost / volume : 0.0; }
+};
+
+namespace detail {
+
+// Neumaier's variant of Kahan summation; value() is the compensated sum.
+// Also used on the device by evap_solver_gpu.cu.
+struct CompensatedSum {
+    double sum = 0.0;
+    double comp = 0.0;
+
+    EVAP_SOLVER_HD void add(double x) {
+        double t = sum + x;
+        if ((sum >= 0 ? sum : -sum) >= (x >= 0 ? x : -x)) {
+            comp += (sum - t) + x;
+        } else {
+            comp += (x - t) + sum;
+        }
+        sum = t;
+    }
+
+    EVAP_SOLVER_HD double value() const { return sum + comp; }
+};
+
+struct GroupSums {
+    std::uint32_t key = 0;
+    std::size_t records = 0;
+    CompensatedSum volume, lost;
+};
+
+// Per-key sums of one block, in order of first appearance
+struct BlockPartial {
+    std::vector<GroupSums> entries;
+    std::size_t records = 0;
+    std::size_t skipped = 0;
+
+    void clear() {
+        entries.clear();
+        records = skipped = 0;
+    }
+};
+
+// Per-thread scratch: block losses and a key -> entry index. The index is
+// never cleared; a slot is trusted only if it points at an entry with the
+// same key.
+struct AggregateScratch {
+    std::vector<double> loss;
+    std::vector<std::uint32_t> slot;
+};
+
+inline AggregateScratch& aggregateScratch() {
+    thread_local AggregateScratch scratch;
+    return scratch;
+}
+
+// Evaluate n records and add them to p (which may hold an unfinished block)
+inline void accumulateBlock(const double* vpd, const int* nozzle, const double* pressure, const double* wind,
+                            const double* volume, const std::uint32_t* key, std::size_t n, std::size_t groups,
+                            BlockPartial& p) {
+    AggregateScratch& s = aggregateScratch();
+    if (s.loss.size() < n) s.loss.resize(n);
+    if (s.slot.size() < groups) s.slot.resize(groups);
+    Simd::calculateBatch(vpd, nozzle, pressure, wind, s.loss.data(), n);
+
+    for (std::size_t e = 0; e < p.entries.size(); ++e) s.slot[p.entries[e].key] = static_cast<std::uint32_t>(e);
+    for (std::size_t i = 0; i < n; ++i) {
+        std::uint32_t k = key[i];
+        if (k >= groups) {
+            ++p.skipped;
+            continue;
+        }
+        std::uint32_t e = s.slot[k];
+        if (e >= p.entries.size() || p.entries[e].key != k) {
+            e = static_cast<std::uint32_t>(p.entries.size());
+            s.slot[k] = e;
+            p.entries.emplace_back();
+            p.entries.back().key = k;
+        }
+        GroupSums& g = p.entries[e];
+        ++g.records;
+        g.volume.add(volume[i]);
+        g.lost.add(volume[i] * s.loss[i] / 100.0);
+    }
+    p.records += n;
+}
+
+} // namespace detail
+
+// Streaming grouped reduction; add() may be called any number of times.
+// Not thread-safe itself: call add() from one thread, it fans out to the pool.
+class Aggregator {
+public:
+    Aggregator(ThreadPool& pool, const AggregateOptions& options) : Aggregator(&pool, options) {}
+
+    // Single-threaded; same totals as any pool
+    explicit Aggregator(const AggregateOptions& options) : Aggregator(nullptr, options) {}
+
+    // Evaluate n records and add them to their groups
+    void add(const double* vpd, const int* nozzle, const double* pressure, const double* wind,
+             const double* volume, const std::uint32_t* key, std::size_t n) {
+        // Finish the block left open by the previous call
+        if (carry.records > 0 || n < block) {
+            std::size_t k = block - carry.records < n ? block - carry.records : n;
+            detail::accumulateBlock(vpd, nozzle, pressure, wind, volume, key, k, groups, carry);
+            vpd += k, nozzle += k, pressure += k, wind += k, volume += k, key += k, n -= k;
+            if (carry.records < block) return;
+            commit(carry);
+            carry.clear();
+        }
+
+        // Whole blocks, a round at a time so the partials stay bounded
+        std::size_t blocks = n / block;
+        for (std::size_t first = 0; first < blocks; first += round.size()) {
+            std::size_t count = blocks - first < round.size() ? blocks - first : round.size();
+            std::size_t base = first * block;
+            auto body = [&](std::size_t begin, std::size_t end) {
+                // Run every block that starts inside [begin, end)
+                for (std::size_t b = (begin + block - 1) / block; b * block < end; ++b) {
+                    std::size_t r = base + b * block;
+                    round[b].clear();
+                    detail::accumulateBlock(vpd + r, nozzle + r, pressure + r, wind + r, volume + r, key + r,
+                                            block, groups, round[b]);
+                }
+            };
+            if (pool) {
+                pool->parallelFor(count * block, body);
+            } else {
+                body(0, count * block);
+            }
+            for (std::size_t b = 0; b < count; ++b) commit(round[b]);
+        }
+
+        // The tail opens the next block
+        std::size_t done = blocks * block;
+        if (done < n) {
+            detail::accumulateBlock(vpd + done, nozzle + done, pressure + done, wind + done, volume + done,
+                                    key + done, n - done, groups, carry);
+        }
+    }
+
+    // Totals per key, including the open block
+    std::vector<GroupTotal> totals() const {
+        std::vector<detail::GroupSums> all = sums;
+        fold(carry, all);
+        std::vector<GroupTotal> out(groups);
+        for (std::size_t k = 0; k < groups; ++k) {
+            out[k].records = all[k].records;
+            out[k].volume = all[k].volume.value();
+            out[k].lost = all[k].lost.value();
+        }
+        return out;
+    }
+
+    // Records passed to add(), and those skipped for an out-of-range key
+    std::size_t records() const { return recordCount + carry.records; }
+    std::size_t skipped() const { return skippedCount + carry.skipped; }
+    std::size_t groupCount() const { return groups; }
+
+    // Drop all totals and the open block
+    void reset() {
+        sums.assign(groups, detail::GroupSums());
+        carry.clear();
+        recordCount = skippedCount = 0;
+    }
+
+private:
+    Aggregator(ThreadPool* p, const AggregateOptions& options)
+        : pool(p), groups(options.groups), block(options.blockSize ? options.blockSize : 1),
+          round(p ? 8 * p->size() : 1) {
+        reset();
+    }
+
+    // Add one block's compensated partials to per-key sums
+    static void fold(const detail::BlockPartial& p, std::vector<detail::GroupSums>& into) {
+        for (const detail::GroupSums& e : p.entries) {
+            detail::GroupSums& g = into[e.key];
+            g.records += e.records;
+            g.volume.add(e.volume.value());
+            g.lost.add(e.lost.value());
+        }
+    }
+
+    void commit(const detail::BlockPartial& p) {
+        fold(p, sums);
+        recordCount += p.records;
+        skippedCount += p.skipped;
+    }
+
+    ThreadPool* pool;
+    std::size_t groups;
+    std::size_t block;
+    std::vector<detail::BlockPartial> round; // Partials of the blocks in flight
+    detail::BlockPartial carry;              // Open block, shorter than blockSize
+    std::vector<detail::GroupSums> sums;     // Indexed by key; key fields unused
+    std::size_t recordCount = 0, skippedCount = 0;
+};
+
+// One-shot grouped totals on the pool's threads
+inline std::vector<GroupTotal> aggregateByKey(ThreadPool& pool, const double* vpd, const int* nozzle,
+                                              const double* pressure, const double* wind, const double* volume,
+                                              const std::uint32_t* key, std::size_t n, std::size_t groups) {
+    Aggregator agg(pool, {groups});
+    agg.add(vpd, nozzle, pressure, wind, volume, key, n);
+    return agg.totals();
+}
+
+} // namespace Parallel
+} // namespace EvapSolver
+
+#endif // EVAP_SOLVER_AGGREGATE_H
@@ -0,0 +1,198 @@
+// C ABI of evap_solver_c.h over the header-only engines; built as
+// libevap_solver.so by build_c_library.sh
+#define EVAP_SOLVER_BUILD_LIBRARY
+#include "evap_solver_c.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include "evap_solver_engines.h"
+#include "evap_solver_parallel.h"
+
+static_assert(std::is_same<std::int32_t, int>::value, "nozzle columns are passed through as int");
+static_assert(EVAP_STATUS_VPD == EvapSolver::VpdOutOfRange && EVAP_STATUS_NOZZLE == EvapSolver::NozzleOutOfRange &&
+                  EVAP_STATUS_PRESSURE == EvapSolver::PressureOutOfRange &&
+                  EVAP_STATUS_WIND == EvapSolver::WindOutOfRange,
+              "status bits are the library's own");
+
+namespace {
+
+using EvapSolver::Engine;
+using EvapSolver::Parallel::ThreadPool;
+
+// Library-wide pool, created on first parallel call. A batch holds a
+// reference, so evap_set_threads() can replace the pool while it runs.
+struct PoolState {
+    std::mutex mutex;
+    std::shared_ptr<ThreadPool> pool;
+    unsigned threads = 0;
+};
+
+PoolState& poolState() {
+    static PoolState state;
+    return state;
+}
+
+std::shared_ptr<ThreadPool> sharedPool() {
+    PoolState& s = poolState();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    if (!s.pool) s.pool = std::make_shared<ThreadPool>(EvapSolver::Parallel::PoolOptions{s.threads, 16384, false});
+    return s.pool;
+}
+
+// Engine selected by flags; false for unknown bits
+bool parseFlags(std::uint32_t flags, Engine& engine) {
+    if (flags & ~(EVAP_ENGINE_MASK | EVAP_FLAG_PARALLEL)) return false;
+    switch (flags & EVAP_ENGINE_MASK) {
+        case EVAP_ENGINE_EXACT: engine = Engine::Exact; return true;
+        case EVAP_ENGINE_SEPARABLE: engine = Engine::Separable; return true;
+        case EVAP_ENGINE_POLYNOMIAL: engine = Engine::Polynomial; return true;
+        default: return false;
+    }
+}
+
+// body(begin, end) over [0, n), on the pool if asked for
+template <class Body>
+int run(std::size_t n, std::uint32_t flags, const Body& body) {
+    try {
+        if (flags & EVAP_FLAG_PARALLEL) {
+            sharedPool()->parallelFor(n, body);
+        } else if (n > 0) {
+            body(0, n);
+        }
+        return EVAP_OK;
+    } catch (...) {
+        return EVAP_ERROR_INTERNAL;
+    }
+}
+
+template <class T>
+const T& element(const T* base, std::ptrdiff_t stride, std::size_t i) {
+    return *reinterpret_cast<const T*>(reinterpret_cast<const char*>(base) + stride * static_cast<std::ptrdiff_t>(i));
+}
+
+template <class T>
+T& element(T* base, std::ptrdiff_t stride, std::size_t i) {
+    return *reinterpret_cast<T*>(reinterpret_cast<char*>(base) + stride * static_cast<std::ptrdiff_t>(i));
+}
+
+// Records a strided batch gathers at a time, on the stack
+constexpr std::size_t stridedBlock = 512;
+
+} // namespace
+
+extern "C" {
+
+uint32_t evap_abi_version(void) {
+    return EVAP_ABI_VERSION;
+}
+
+const char* evap_strerror(int code) {
+    switch (code) {
+        case EVAP_OK: return "success";
+        case EVAP_ERROR_ARGUMENT: return "null buffer";
+        case EVAP_ERROR_FLAGS: return "unsupported flags";
+        case EVAP_ERROR_INTERNAL: return "internal error (out of memory or threads)";
+        default: return "unknown error";
+    }
+}
+
+int evap_batch(const double* vpd, const int32_t* nozzle, const double* pressure, const double* wind, double* out,
+               size_t n, uint32_t flags) {
+    Engine engine;
+    if (!parseFlags(flags, engine)) return EVAP_ERROR_FLAGS;
+    if (n > 0 && !(vpd && nozzle && pressure && wind && out)) return EVAP_ERROR_ARGUMENT;
+    return run(n, flags, [=](std::size_t begin, std::size_t end) {
+        EvapSolver::calculateBatch(engine, vpd + begin, nozzle + begin, pressure + begin, wind + begin, out + begin,
+                                   end - begin);
+    });
+}
+
+int evap_batch_strided(const double* vpd, ptrdiff_t vpd_stride, const int32_t* nozzle, ptrdiff_t nozzle_stride,
+                       const double* pressure, ptrdiff_t pressure_stride, const double* wind, ptrdiff_t wind_stride,
+                       double* out, ptrdiff_t out_stride, size_t n, uint32_t flags) {
+    const std::ptrdiff_t d = sizeof(double);
+    if (vpd_stride == d && nozzle_stride == static_cast<std::ptrdiff_t>(sizeof(int32_t)) && pressure_stride == d &&
+        wind_stride == d && out_stride == d) {
+        return evap_batch(vpd, nozzle, pressure, wind, out, n, flags);
+    }
+    Engine engine;
+    if (!parseFlags(flags, engine)) return EVAP_ERROR_FLAGS;
+    if (n > 0 && !(vpd && nozzle && pressure && wind && out)) return EVAP_ERROR_ARGUMENT;
+    return run(n, flags, [=](std::size_t begin, std::size_t end) {
+        double v[stridedBlock], p[stridedBlock], w[stridedBlock], loss[stridedBlock];
+        int z[stridedBlock];
+        for (std::size_t first = begin; first < end; first += stridedBlock) {
+            std::size_t count = end - first < stridedBlock ? end - first : stridedBlock;
+            for (std::size_t i = 0; i < count; ++i) {
+                v[i] = element(vpd, vpd_stride, first + i);
+                z[i] = element(nozzle, nozzle_stride, first + i);
+                p[i] = element(pressure, pressure_stride, first + i);
+                w[i] = element(wind, wind_stride, first + i);
+            }
+            EvapSolver::calculateBatch(engine, v, z, p, w, loss, count);
+            for (std::size_t i = 0; i < count; ++i) element(out, out_stride, first + i) = loss[i];
+        }
+    });
+}
+
+int evap_batch_f32(const float* vpd, const int32_t* nozzle, const float* pressure, const float* wind, float* out,
+                   size_t n, uint32_t flags) {
+    Engine engine;
+    if (!parseFlags(flags, engine) || engine != Engine::Exact) return EVAP_ERROR_FLAGS;
+    if (n > 0 && !(vpd && nozzle && pressure && wind && out)) return EVAP_ERROR_ARGUMENT;
+    return run(n, flags, [=](std::size_t begin, std::size_t end) {
+        EvapSolver::Simd::calculateBatch(vpd + begin, nozzle + begin, pressure + begin, wind + begin, out + begin,
+                                         end - begin);
+    });
+}
+
+int evap_batch_status(const double* vpd, const int32_t* nozzle, const double* pressure, const double* wind,
+                      double* out, uint8_t* status, size_t n, double invalid_value, uint32_t flags,
+                      size_t* invalid_count) {
+    Engine engine;
+    if (!parseFlags(flags, engine)) return EVAP_ERROR_FLAGS;
+    if (n > 0 && !(vpd && nozzle && pressure && wind && out && status)) return EVAP_ERROR_ARGUMENT;
+    std::atomic<std::size_t> invalid{0};
+    int rc = run(n, flags, [=, &invalid](std::size_t begin, std::size_t end) {
+        EvapSolver::calculateBatch(engine, vpd + begin, nozzle + begin, pressure + begin, wind + begin, out + begin,
+                                   end - begin);
+        std::size_t rejected = 0;
+        for (std::size_t i = begin; i < end; ++i) {
+            EvapSolver::Status s = EvapSolver::checkInputs(vpd[i], nozzle[i], pressure[i], wind[i]);
+            status[i] = s;
+            if (s != EvapSolver::StatusOk) {
+                out[i] = invalid_value;
+                ++rejected;
+            }
+        }
+        invalid.fetch_add(rejected, std::memory_order_relaxed);
+    });
+    if (rc == EVAP_OK && invalid_count) *invalid_count = invalid.load();
+    return rc;
+}
+
+int evap_set_threads(unsigned threads) {
+    try {
+        PoolState& s = poolState();
+        std::lock_guard<std::mutex> lock(s.mutex);
+        s.threads = threads;
+        s.pool.reset();
+        return EVAP_OK;
+    } catch (...) {
+        return EVAP_ERROR_INTERNAL;
+    }
+}
+
+unsigned evap_threads(void) {
+    try {
+        return sharedPool()->size();
+    } catch (...) {
+        return 0;
+    }
+}
+
+} // extern "C"
@@ -0,0 +1,108 @@
+#ifndef EVAP_SOLVER_C_H
+#define EVAP_SOLVER_C_H
+
+// Stable C ABI over the batch engines, for callers in other runtimes.
+//
+// Every entry point takes whole columns: the caller's own buffers are read
+// and written in place, so a batch costs one FFI call. Built as
+// libevap_solver.so by build_c_library.sh; the header is plain C99.
+//
+//   evap_batch()          contiguous double columns
+//   evap_batch_strided()  any byte stride per column (record structs, Arrow
+//                         slices, a stride of 0 to repeat one value)
+//   evap_batch_f32()      contiguous float columns, single-precision chain
+//   evap_batch_status()   status bits per record (EVAP_STATUS_*); invalid
+//                         records get invalid_value instead of a loss
+//
+// flags selects the engine (EVAP_ENGINE_*) and, with EVAP_FLAG_PARALLEL,
+// runs the batch on the library's thread pool. Results do not depend on
+// the flag or the thread count. Parallel calls from several threads share
+// the pool and run one after another; other calls run on the caller.
+//
+// Functions return EVAP_OK or a negative EVAP_ERROR_* code and never
+// throw or abort. Buffers and flags are checked before anything is written.
+//
+// Usage:
+//   int rc = evap_batch(vpd, nozzle, pressure, wind, out, n, EVAP_FLAG_PARALLEL);
+//   if (rc != EVAP_OK) fprintf(stderr, "%s\n", evap_strerror(rc));
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32)
+#if defined(EVAP_SOLVER_BUILD_LIBRARY)
+#define EVAP_API __declspec(dllexport)
+#else
+#define EVAP_API __declspec(dllimport)
+#endif
+#else
+#define EVAP_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Incremented on any incompatible change to this header
+#define EVAP_ABI_VERSION 1
+
+// Return codes
+#define EVAP_OK 0
+#define EVAP_ERROR_ARGUMENT (-1) // A null buffer with n > 0
+#define EVAP_ERROR_FLAGS (-2)    // Unknown flag bits, or an engine the call does not offer
+#define EVAP_ERROR_INTERNAL (-3) // Out of memory or thread creation failed
+
+// Flags
+#define EVAP_ENGINE_EXACT 0x00u      // Reference nomograph chain
+#define EVAP_ENGINE_SEPARABLE 0x10u  // <= 1e-12 points from exact; double only
+#define EVAP_ENGINE_POLYNOMIAL 0x20u // <= 1e-12 points from exact; double only
+#define EVAP_ENGINE_MASK 0xF0u
+#define EVAP_FLAG_PARALLEL 0x01u
+
+// Status bits of evap_batch_status(), one per parameter out of range
+#define EVAP_STATUS_OK 0u
+#define EVAP_STATUS_VPD 0x01u
+#define EVAP_STATUS_NOZZLE 0x02u
+#define EVAP_STATUS_PRESSURE 0x04u
+#define EVAP_STATUS_WIND 0x08u
+
+// EVAP_ABI_VERSION of the loaded library
+EVAP_API uint32_t evap_abi_version(void);
+
+// Static description of a return code
+EVAP_API const char* evap_strerror(int code);
+
+// Evaporation loss (%) of n records
+EVAP_API int evap_batch(const double* vpd, const int32_t* nozzle, const double* pressure, const double* wind,
+                        double* out, size_t n, uint32_t flags);
+
+// Same with a byte stride per column; strides may be 0 or negative
+EVAP_API int evap_batch_strided(const double* vpd, ptrdiff_t vpd_stride, const int32_t* nozzle,
+                                ptrdiff_t nozzle_stride, const double* pressure, ptrdiff_t pressure_stride,
+                                const double* wind, ptrdiff_t wind_stride, double* out, ptrdiff_t out_stride,
+                                size_t n, uint32_t flags);
+
+// Single precision; only EVAP_ENGINE_EXACT
+EVAP_API int evap_batch_f32(const float* vpd, const int32_t* nozzle, const float* pressure, const float* wind,
+                            float* out, size_t n, uint32_t flags);
+
+// Validated batch: status[i] gets the record's EVAP_STATUS_* bits and out[i]
+// its loss, or invalid_value. invalid_count (may be NULL) gets the number of
+// records with a non-zero status.
+EVAP_API int evap_batch_status(const double* vpd, const int32_t* nozzle, const double* pressure,
+                               const double* wind, double* out, uint8_t* status, size_t n, double invalid_value,
+                               uint32_t flags, size_t* invalid_count);
+
+// Threads of the pool used by EVAP_FLAG_PARALLEL, including the caller;
+// 0 = hardware concurrency (the default). Batches already running finish
+// on the previous pool. If its threads cannot be created, parallel calls
+// return EVAP_ERROR_INTERNAL, evap_threads() returns 0, and the next call
+// tries again.
+EVAP_API int evap_set_threads(unsigned threads);
+EVAP_API unsigned evap_threads(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // EVAP_SOLVER_C_H
@@ -0,0 +1,446 @@
+#ifndef EVAP_SOLVER_CORE_H
+#define EVAP_SOLVER_CORE_H
+
+// Shared nomograph core: the tick tables, the evaluation chain and the
+// policy-based front end that every public API is built on.
+//
+//   Nomograph<T, Validation, Diagnostics>
+//     T            precision of the tables and the arithmetic (double, float)
+//     Validation   NoValidation          out-of-range inputs clamp to the tables
+//                  ThrowingValidation<>  std::runtime_error naming the first
+//                                        violated parameter (and its value)
+//                  StatusValidation      Status bits; rejected records return
+//                                        a caller-supplied value
+//     Diagnostics  NoDiagnostics, or any type with onResult(T) and
+//                  onOutOfRange(T), e.g. the DiagnosticsSink of solver.h
+//
+// Policies are resolved at compile time: Nomograph<double> compiles to the
+// bare chain, and the front ends (Calculator, EvapSolverValidated::Calculator,
+// solveEvaporationLoss()) are one-line wrappers over an instantiation, so
+// they return bit-identical results and share every table optimization.
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include "evap_solver_instrument.h"
+
+// The chain functions the GPU backend (evap_solver_gpu.cu) runs on the
+// device are marked host and device under nvcc; plain C++ sees nothing.
+#ifdef __CUDACC__
+#define EVAP_SOLVER_HD __host__ __device__
+#else
+#define EVAP_SOLVER_HD
+#endif
+
+namespace EvapSolver {
+
+// Input structure, templated on the floating-point type
+template <class T>
+struct BasicInput {
+    T vpd;      // Vapor-Pressure Deficit (psi)
+    int nozzle; // Nozzle diameter (64ths inch)
+    T pressure; // Pressure (psi)
+    T wind;     // Wind velocity (mph)
+};
+
+using Input = BasicInput<double>;
+using FloatInput = BasicInput<float>;
+
+namespace detail {
+
+// Keeps a parameter out of template argument deduction, so an int nozzle
+// or a double literal converts to the table's type
+template <class T>
+struct NonDeduced {
+    using type = T;
+};
+
+template <class T>
+using NonDeducedT = typename NonDeduced<T>::type;
+
+// Nomograph scale stored as flat tick arrays (abscissa x, ordinate y)
+template <std::size_t N, class T = double>
+struct Scale {
+    T x[N];
+    T y[N];
+};
+
+// Index of the first tick >= v (what std::lower_bound returns), found by
+// compare-and-count so the loop has no data-dependent branches.
+// Never returns 0, so a NaN input yields NaN instead of reading before x[0].
+template <std::size_t N, class T>
+constexpr std::size_t segment(const Scale<N, T>& s, NonDeducedT<T> v) {
+    std::size_t i = 0;
+    for (std::size_t k = 0; k < N; ++k) i += (s.x[k] < v);
+    return i + (i == 0);
+}
+
+// Uniform-grid index over a scale for O(1) segment lookup. Cell c covers
+// [x0 + c*h, x0 + (c+1)*h) and stores the segment() of its lower edge. The
+// cell width h is at most half the smallest tick gap, so the stored segment
+// is off by at most one (including rounding of the cell computation) and a
+// single up/down correction recovers exactly what segment() returns.
+template <std::size_t N, std::size_t Cells, class T = double>
+struct GridIndex {
+    T x0;
+    T invH;
+    unsigned char seg[Cells];
+};
+
+// Number of cells needed for a scale: ceil(2 * span / smallest tick gap)
+template <std::size_t N, class T>
+constexpr std::size_t gridCells(const Scale<N, T>& s) {
+    T minGap = s.x[1] - s.x[0];
+    for (std::size_t k = 2; k < N; ++k) {
+        if (s.x[k] - s.x[k - 1] < minGap) minGap = s.x[k] - s.x[k - 1];
+    }
+    T cells = 2 * (s.x[N - 1] - s.x[0]) / minGap;
+    std::size_t c = static_cast<std::size_t>(cells);
+    return c < cells ? c + 1 : c;
+}
+
+template <std::size_t Cells, std::size_t N, class T>
+constexpr GridIndex<N, Cells, T> makeGridIndex(const Scale<N, T>& s) {
+    static_assert(N < 256, "segment indices are stored as unsigned char");
+    GridIndex<N, Cells, T> g{};
+    T span = s.x[N - 1] - s.x[0];
+    g.x0 = s.x[0];
+    g.invH = Cells / span;
+    for (std::size_t c = 0; c < Cells; ++c) {
+        std::size_t i = segment(s, s.x[0] + span * c / Cells);
+        g.seg[c] = static_cast<unsigned char>(i < N ? i : N - 1);
+    }
+    return g;
+}
+
+// Same result as segment(s, v) for v strictly inside the table, without a search.
+// NaN maps to cell 0 and, as with segment(), never to index 0.
+template <std::size_t N, std::size_t Cells, class T>
+constexpr std::size_t gridSegment(const Scale<N, T>& s, const GridIndex<N, Cells, T>& g, NonDeducedT<T> v) {
+    T t = (v - g.x0) * g.invH;
+    std::size_t c = t > 0 ? (t < Cells - 1 ? static_cast<std::size_t>(t) : Cells - 1) : 0;
+    std::size_t i = g.seg[c];
+    i += (s.x[i] < v);
+    i -= (s.x[i - 1] >= v);
+    return i;
+}
+
+// Linear interpolation, clamped to the table ends
+template <std::size_t N, class T>
+constexpr T lerp(const Scale<N, T>& s, NonDeducedT<T> v) {
+    if (v <= s.x[0]) return s.y[0];
+    if (v >= s.x[N - 1]) return s.y[N - 1];
+
+    std::size_t i = segment(s, v);
+    return s.y[i - 1] + (s.y[i] - s.y[i - 1]) * (v - s.x[i - 1]) / (s.x[i] - s.x[i - 1]);
+}
+
+// Linear interpolation with grid segment lookup; identical to lerp(s, v)
+template <std::size_t N, std::size_t Cells, class T>
+constexpr T lerp(const Scale<N, T>& s, const GridIndex<N, Cells, T>& g, NonDeducedT<T> v) {
+    if (v <= s.x[0]) return s.y[0];
+    if (v >= s.x[N - 1]) return s.y[N - 1];
+
+    std::size_t i = gridSegment(s, g, v);
+    return s.y[i - 1] + (s.y[i] - s.y[i - 1]) * (v - s.x[i - 1]) / (s.x[i] - s.x[i - 1]);
+}
+
+// Linear interpolation between two points
+template <class T>
+EVAP_SOLVER_HD constexpr T lerp2(T x, T x1, T y1, T x2, T y2) {
+    return y1 + (y2 - y1) * (x - x1) / (x2 - x1);
+}
+
+// Nomograph data tables (S3, S5, S7, S9, S6 with x/y flipped) and their
+// grid indices, stored in T. The float tables round the published
+// three-digit ticks to the nearest float.
+template <class T>
+struct Tables {
+    static constexpr Scale<11, T> S3 = {
+        {0, 0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7, 0.8, 0.9, 1.0},
+        {0, 0.221, 0.381, 0.508, 0.613, 0.695, 0.762, 0.829, 0.887, 0.949, 1.0}
+    };
+    static constexpr Scale<11, T> S5 = {
+        {8, 10, 12, 14, 16, 20, 24, 32, 40, 48, 64},
+        {1.002, 0.895, 0.815, 0.742, 0.675, 0.563, 0.483, 0.352, 0.233, 0.152, -0.001}
+    };
+    static constexpr Scale<11, T> S7 = {
+        {20, 25, 30, 35, 40, 45, 50, 55, 60, 70, 80},
+        {0.0, 0.159, 0.296, 0.407, 0.499, 0.589, 0.665, 0.735, 0.800, 0.900, 0.996}
+    };
+    static constexpr Scale<15, T> S9 = {
+        {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 15},
+        {0.0, 0.140, 0.246, 0.356, 0.435, 0.508, 0.578, 0.651, 0.706, 0.760, 0.811, 0.854, 0.895, 0.930, 0.994}
+    };
+    static constexpr Scale<14, T> S6_flip = {
+        {0.102, 0.252, 0.360, 0.460, 0.521, 0.563, 0.599, 0.633, 0.671, 0.702, 0.758, 0.812, 0.883, 0.917},
+        {0, 0.5, 1, 2, 3, 4, 5, 6, 8, 10, 15, 20, 30, 40}
+    };
+
+    // Grid indices for every scale (weighted variants of a scale share its index)
+    static constexpr auto S3_grid = makeGridIndex<gridCells(S3)>(S3);
+    static constexpr auto S5_grid = makeGridIndex<gridCells(S5)>(S5);
+    static constexpr auto S7_grid = makeGridIndex<gridCells(S7)>(S7);
+    static constexpr auto S9_grid = makeGridIndex<gridCells(S9)>(S9);
+    static constexpr auto S6_flip_grid = makeGridIndex<gridCells(S6_flip)>(S6_flip);
+};
+
+// Double-precision tables, used by every other module
+inline constexpr const Scale<11>& S3 = Tables<double>::S3;
+inline constexpr const Scale<11>& S5 = Tables<double>::S5;
+inline constexpr const Scale<11>& S7 = Tables<double>::S7;
+inline constexpr const Scale<15>& S9 = Tables<double>::S9;
+inline constexpr const Scale<14>& S6_flip = Tables<double>::S6_flip;
+
+inline constexpr const auto& S3_grid = Tables<double>::S3_grid;
+inline constexpr const auto& S5_grid = Tables<double>::S5_grid;
+inline constexpr const auto& S7_grid = Tables<double>::S7_grid;
+inline constexpr const auto& S9_grid = Tables<double>::S9_grid;
+inline constexpr const auto& S6_flip_grid = Tables<double>::S6_flip_grid;
+
+// Column X coordinates
+inline constexpr double x3 = 0.0, x4 = 0.237, x5 = 0.439, x6 = 0.490,
+                        x7 = 0.738, x8 = 0.870, x9 = 1.000;
+
+// Instrumentation hooks (evap_solver_instrument.h): count the clamp, NaN or
+// segment bin of one lookup of v on scale s. Callers guard them with
+// if constexpr (Instrument::enabled).
+template <std::size_t N, class T>
+inline void instrumentScale(std::size_t axis, const Scale<N, T>& s, NonDeducedT<T> v) {
+    using namespace Instrument::detail;
+    std::size_t bin = v < s.x[0]       ? binBelow
+                      : v > s.x[N - 1] ? binAbove
+                      : v == v         ? binSegment + segment(s, v) - 1
+                                       : binNaN;
+    record(axis, bin);
+}
+
+template <class T, class Tab>
+inline void instrumentInputs(const Tab& t, NonDeducedT<T> vpd, int nozzle, NonDeducedT<T> pressure,
+                             NonDeducedT<T> wind) {
+    instrumentScale(Instrument::Vpd, t.S3, vpd);
+    instrumentScale(Instrument::Nozzle, t.S5, static_cast<T>(nozzle));
+    instrumentScale(Instrument::Pressure, t.S7, pressure);
+    instrumentScale(Instrument::Wind, t.S9, wind);
+}
+
+// Nomograph geometry from the four axis ordinates: pivot points, intersection
+// at column 6 and the reverse S6 lookup on table set t. A table set is any
+// type with the scales S3, S5, S7, S9, S6_flip and a grid index for each
+// (S3_grid, ...): Tables<T>, or a runtime block from evap_solver_tables.h.
+template <class T = double, class Tab>
+EVAP_SOLVER_HD inline T combine(const Tab& t, NonDeducedT<T> y3, NonDeducedT<T> y5, NonDeducedT<T> y7,
+                                NonDeducedT<T> y9) {
+    // Calculate pivot points and intersection
+    T yA = lerp2<T>(x4, x3, y3, x5, y5);
+    T yB = lerp2<T>(x8, x7, y7, x9, y9);
+    T yL = lerp2<T>(x6, x4, yA, x8, yB);
+    if constexpr (Instrument::enabled) instrumentScale(Instrument::Loss, t.S6_flip, yL);
+
+    // Reverse interpolation on S6
+    return lerp(t.S6_flip, t.S6_flip_grid, yL);
+}
+
+// Same on the built-in tables
+template <class T = double>
+inline T combine(NonDeducedT<T> y3, NonDeducedT<T> y5, NonDeducedT<T> y7, NonDeducedT<T> y9) {
+    return combine<T>(Tables<T>{}, y3, y5, y7, y9);
+}
+
+// Full nomograph chain for a single record on table set t
+template <class T = double, class Tab>
+EVAP_SOLVER_HD inline T evaluate(const Tab& t, NonDeducedT<T> vpd, int nozzle, NonDeducedT<T> pressure,
+                                 NonDeducedT<T> wind) {
+    if constexpr (Instrument::enabled) instrumentInputs<T>(t, vpd, nozzle, pressure, wind);
+
+    // Interpolate Y coordinates
+    T y3 = lerp(t.S3, t.S3_grid, vpd);
+    T y5 = lerp(t.S5, t.S5_grid, nozzle);
+    T y7 = lerp(t.S7, t.S7_grid, pressure);
+    T y9 = lerp(t.S9, t.S9_grid, wind);
+
+    return combine<T>(t, y3, y5, y7, y9);
+}
+
+// Full nomograph chain for a single record on the built-in tables
+template <class T = double>
+inline T evaluate(NonDeducedT<T> vpd, int nozzle, NonDeducedT<T> pressure, NonDeducedT<T> wind) {
+    return evaluate<T>(Tables<T>{}, vpd, nozzle, pressure, wind);
+}
+
+// Instrument records [0, n) that a vector kernel evaluated without the
+// scalar chain: the four inputs and the S6 lookup of their intersection
+template <class T, class Tab>
+inline void instrumentRecords(const Tab& t, const T* vpd, const int* nozzle, const T* pressure, const T* wind,
+                              std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        instrumentInputs<T>(t, vpd[i], nozzle[i], pressure[i], wind[i]);
+        T yA = lerp2<T>(x4, x3, lerp(t.S3, t.S3_grid, vpd[i]), x5, lerp(t.S5, t.S5_grid, nozzle[i]));
+        T yB = lerp2<T>(x8, x7, lerp(t.S7, t.S7_grid, pressure[i]), x9, lerp(t.S9, t.S9_grid, wind[i]));
+        instrumentScale(Instrument::Loss, t.S6_flip, lerp2<T>(x6, x4, yA, x8, yB));
+    }
+}
+
+} // namespace detail
+
+// Validation status: one bit per parameter outside its valid range.
+// Checking never throws or allocates; messages are only built by
+// statusMessage() when asked for.
+using Status = std::uint8_t;
+inline constexpr Status StatusOk = 0;
+inline constexpr Status VpdOutOfRange = 1u << 0;
+inline constexpr Status NozzleOutOfRange = 1u << 1;
+inline constexpr Status PressureOutOfRange = 1u << 2;
+inline constexpr Status WindOutOfRange = 1u << 3;
+
+// Status of a raw record (NaN compares false and therefore passes)
+inline constexpr Status checkInputs(double vpd, int nozzle, double pressure, double wind) noexcept {
+    return static_cast<Status>(((vpd < 0.0 || vpd > 1.0) ? VpdOutOfRange : 0) |
+                               ((nozzle < 8 || nozzle > 64) ? NozzleOutOfRange : 0) |
+                               ((pressure < 20 || pressure > 80) ? PressureOutOfRange : 0) |
+                               ((wind < 0 || wind > 15) ? WindOutOfRange : 0));
+}
+
+// Lowest violated bit, i.e. the error the throwing policy reports
+inline constexpr Status firstViolation(Status status) noexcept {
+    return static_cast<Status>(status & (~status + 1u));
+}
+
+// Valid range of the parameter named by a single status bit
+inline const char* rangeMessage(Status bit) noexcept {
+    switch (bit) {
+        case VpdOutOfRange: return "Vapor-Pressure Deficit must be between 0.0 and 1.0 psi";
+        case NozzleOutOfRange: return "Nozzle diameter must be between 8 and 64 (64ths of an inch)";
+        case PressureOutOfRange: return "Nozzle pressure must be between 20 and 80 psi";
+        case WindOutOfRange: return "Wind velocity must be between 0 and 15 mph";
+        default: return "";
+    }
+}
+
+// Human-readable description of every violation in status, joined by "; "
+inline std::string statusMessage(Status status, double vpd, int nozzle, double pressure, double wind) {
+    std::string message;
+    auto append = [&](Status bit, const std::string& value) {
+        if (!(status & bit)) return;
+        if (!message.empty()) message += "; ";
+        message += std::string(rangeMessage(bit)) + " (got " + value + ")";
+    };
+    append(VpdOutOfRange, std::to_string(vpd));
+    append(NozzleOutOfRange, std::to_string(nozzle));
+    append(PressureOutOfRange, std::to_string(pressure));
+    append(WindOutOfRange, std::to_string(wind));
+    return message;
+}
+
+// Validation policies. check() returns the status the front end acts on: a
+// non-zero status rejects the record.
+
+// Inputs are not checked; out-of-range values clamp to the table ends
+struct NoValidation {
+    static constexpr bool validates = false;
+
+    template <class T>
+    static constexpr Status check(const BasicInput<T>&) noexcept {
+        return StatusOk;
+    }
+};
+
+// Throws std::runtime_error for the first violated parameter; with
+// ReportValues the message also carries the offending value
+template <bool ReportValues = true>
+struct ThrowingValidation {
+    static constexpr bool validates = true;
+
+    template <class T>
+    static Status check(const BasicInput<T>& in) {
+        Status status = checkInputs(in.vpd, in.nozzle, in.pressure, in.wind);
+        if (status != StatusOk) {
+            Status first = firstViolation(status);
+            throw std::runtime_error(ReportValues ? statusMessage(first, in.vpd, in.nozzle, in.pressure, in.wind)
+                                                  : std::string(rangeMessage(first)));
+        }
+        return StatusOk;
+    }
+};
+
+// Reports every violated parameter in the status bits; never throws
+struct StatusValidation {
+    static constexpr bool validates = true;
+
+    template <class T>
+    static constexpr Status check(const BasicInput<T>& in) noexcept {
+        return checkInputs(in.vpd, in.nozzle, in.pressure, in.wind);
+    }
+};
+
+// Diagnostics policy that reports nothing
+struct NoDiagnostics {
+    template <class T>
+    void onResult(T) noexcept {}
+    template <class T>
+    void onOutOfRange(T) noexcept {}
+};
+
+// Policy-based front end over detail::evaluate(). Stateless: every member
+// reads only the constexpr tables and may be called from any thread.
+template <class T = double, class Validation = NoValidation, class Diagnostics = NoDiagnostics>
+class Nomograph {
+public:
+    using Input = BasicInput<T>;
+
+    // Validate, evaluate and report one record. status receives the policy's
+    // status bits; a rejected record returns invalidValue and is not reported.
+    static T calculate(const Input& in, Status& status, T invalidValue, Diagnostics& diagnostics) {
+        status = Validation::check(in);
+        if (status != StatusOk) return invalidValue;
+
+        T loss = detail::evaluate<T>(in.vpd, in.nozzle, in.pressure, in.wind);
+        if constexpr (!std::is_same_v<Diagnostics, NoDiagnostics>) {
+            if (loss < T(0) || loss > T(40)) diagnostics.onOutOfRange(loss);
+            diagnostics.onResult(loss);
+        }
+        return loss;
+    }
+
+    static T calculate(const Input& in, Status& status, T invalidValue = T(0)) {
+        Diagnostics diagnostics{};
+        return calculate(in, status, invalidValue, diagnostics);
+    }
+
+    static T calculate(const Input& in) {
+        Status status;
+        return calculate(in, status);
+    }
+
+    // n records stored as parallel arrays; out[i] is bit-identical to
+    // calculate() of record i. With a validating policy status[i] receives
+    // the record's bits and rejected records get invalidValue; status may be
+    // null with NoValidation. Returns the number of rejected records.
+    static std::size_t calculateBatch(const T* vpd, const int* nozzle, const T* pressure, const T* wind, T* out,
+                                      Status* status, std::size_t n, T invalidValue = T(0)) {
+        Instrument::BatchTimer timer(n);
+        if constexpr (!Validation::validates) {
+            for (std::size_t i = 0; i < n; ++i) {
+                out[i] = detail::evaluate<T>(vpd[i], nozzle[i], pressure[i], wind[i]);
+            }
+            return 0;
+        } else {
+            std::size_t invalid = 0;
+            for (std::size_t i = 0; i < n; ++i) {
+                // Out-of-range inputs clamp to the tables, so evaluate unconditionally and select
+                Status s = Validation::check(Input{vpd[i], nozzle[i], pressure[i], wind[i]});
+                T result = detail::evaluate<T>(vpd[i], nozzle[i], pressure[i], wind[i]);
+                status[i] = s;
+                out[i] = s == StatusOk ? result : invalidValue;
+                invalid += s != StatusOk;
+            }
+            return invalid;
+        }
+    }
+};
+
+} // namespace EvapSolver
+
+#endif // EVAP_SOLVER_CORE_H
@@ -0,0 +1,44 @@
+#ifndef EVAP_SOLVER_ENDIAN_H
+#define EVAP_SOLVER_ENDIAN_H
+
+// Little-endian loads and stores for the binary formats (table files, LUT
+// files, stream records, service frames), independent of the host order.
+
+#include <cstdint>
+#include <cstring>
+
+namespace EvapSolver {
+namespace detail {
+
+// For formats mapped in place, which can only be read on a little-endian host
+inline bool hostIsLittleEndian() {
+    const std::uint32_t one = 1;
+    unsigned char first;
+    std::memcpy(&first, &one, 1);
+    return first == 1;
+}
+
+inline std::uint32_t loadLE32(const char* p) {
+    std::uint32_t v = 0;
+    for (int k = 3; k >= 0; --k) v = (v << 8) | static_cast<unsigned char>(p[k]);
+    return v;
+}
+
+inline std::uint64_t loadLE64(const char* p) {
+    std::uint64_t v = 0;
+    for (int k = 7; k >= 0; --k) v = (v << 8) | static_cast<unsigned char>(p[k]);
+    return v;
+}
+
+inline void storeLE32(char* p, std::uint32_t v) {
+    for (int k = 0; k < 4; ++k) p[k] = static_cast<char>(v >> (8 * k));
+}
+
+inline void storeLE64(char* p, std::uint64_t v) {
+    for (int k = 0; k < 8; ++k) p[k] = static_cast<char>(v >> (8 * k));
+}
+
+} // namespace detail
+} // namespace EvapSolver
+
+#endif // EVAP_SOLVER_ENDIAN_H
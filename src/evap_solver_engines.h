@@ -0,0 +1,101 @@
+#ifndef EVAP_SOLVER_ENGINES_H
+#define EVAP_SOLVER_ENGINES_H
+
+// Runtime selection between the evaporation loss engines.
+//
+//   Engine::Exact      Reference nomograph chain (SIMD batch kernel)
+//   Engine::Separable  Per-axis weighted tables, <= 1e-12 points from Exact
+//   Engine::Polynomial Branch-free piecewise-linear pieces, no table search,
+//                      <= 1e-12 points from Exact
+//
+// Usage:
+//   EvapSolver::calculateBatch(EvapSolver::Engine::Separable, vpd, nozzle, pressure, wind, out, n);
+//   EvapSolver::calculateBatch(EvapSolver::Engine::Exact, tables, vpd, nozzle, pressure, wind, out, n);
+
+#include <cstddef>
+#include <cstring>
+#include "evap_solver_compact.h"
+#include "evap_solver_polynomial.h"
+#include "evap_solver_simd.h"
+#include "evap_solver_separable.h"
+#include "evap_solver_tables.h"
+
+namespace EvapSolver {
+
+enum class Engine { Exact, Separable, Polynomial };
+
+inline const char* engineName(Engine e) {
+    switch (e) {
+        case Engine::Separable: return "separable";
+        case Engine::Polynomial: return "polynomial";
+        default: return "exact";
+    }
+}
+
+// Parse an engine name as returned by engineName(); false if unknown
+inline bool parseEngine(const char* name, Engine& e) {
+    const Engine all[] = {Engine::Exact, Engine::Separable, Engine::Polynomial};
+    for (Engine candidate : all) {
+        if (std::strcmp(name, engineName(candidate)) == 0) {
+            e = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+inline double calculate(Engine e, const Input& in) {
+    switch (e) {
+        case Engine::Separable: return SeparableCalculator::calculate(in);
+        case Engine::Polynomial: return PolynomialCalculator::calculate(in);
+        default: return Calculator::calculate(in);
+    }
+}
+
+inline void calculateBatch(Engine e, const double* vpd, const int* nozzle, const double* pressure,
+                           const double* wind, double* out, std::size_t n) {
+    switch (e) {
+        case Engine::Separable:
+            SeparableCalculator::calculateBatch(vpd, nozzle, pressure, wind, out, n);
+            return;
+        case Engine::Polynomial:
+            PolynomialCalculator::calculateBatch(vpd, nozzle, pressure, wind, out, n);
+            return;
+        default:
+            Simd::calculateBatch(vpd, nozzle, pressure, wind, out, n);
+            return;
+    }
+}
+
+// The same on runtime tables
+inline double calculate(Engine e, const NomographTables& tables, const Input& in) {
+    switch (e) {
+        case Engine::Separable: return tables.calculateSeparable(in);
+        case Engine::Polynomial: return tables.calculatePolynomial(in);
+        default: return tables.calculate(in);
+    }
+}
+
+inline void calculateBatch(Engine e, const NomographTables& tables, const double* vpd, const int* nozzle,
+                           const double* pressure, const double* wind, double* out, std::size_t n) {
+    switch (e) {
+        case Engine::Separable: {
+            const detail::TableBlock& t = tables.tables();
+            Instrument::BatchTimer timer(n);
+            for (std::size_t i = 0; i < n; ++i) {
+                out[i] = detail::evaluateSeparable(t, vpd[i], nozzle[i], pressure[i], wind[i]);
+            }
+            return;
+        }
+        case Engine::Polynomial:
+            Simd::calculatePolynomialBatch(tables.tables().poly, vpd, nozzle, pressure, wind, out, n);
+            return;
+        default:
+            Simd::calculateBatch(tables, vpd, nozzle, pressure, wind, out, n);
+            return;
+    }
+}
+
+} // namespace EvapSolver
+
+#endif // EVAP_SOLVER_ENGINES_H
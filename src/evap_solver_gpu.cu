@@ -0,0 +1,392 @@
+// CUDA kernels and stream pipeline of evap_solver_gpu.h
+//   nvcc -std=c++17 -O3 -fmad=false -c src/evap_solver_gpu.cu
+#include "evap_solver_gpu.h"
+#include <cuda_runtime.h>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#if EVAP_SOLVER_INSTRUMENT
+#error "The GPU backend has no instrumentation hooks; build evap_solver_gpu.cu without EVAP_SOLVER_INSTRUMENT"
+#endif
+
+namespace EvapSolver {
+namespace Gpu {
+namespace {
+
+using detail::TableBlock;
+using Parallel::detail::CompensatedSum;
+using Parallel::detail::GroupSums;
+
+static_assert(sizeof(TableBlock) % sizeof(unsigned long long) == 0, "tables are staged in 8-byte words");
+
+constexpr unsigned threadsPerBlock = 256;
+
+void check(cudaError_t e, const char* what) {
+    if (e != cudaSuccess) throw std::runtime_error(std::string("CUDA ") + what + ": " + cudaGetErrorString(e));
+}
+
+struct DeviceFree {
+    void operator()(void* p) const { cudaFree(p); }
+};
+struct HostFree {
+    void operator()(void* p) const { cudaFreeHost(p); }
+};
+struct StreamDestroy {
+    void operator()(cudaStream_t s) const { cudaStreamDestroy(s); }
+};
+struct EventDestroy {
+    void operator()(cudaEvent_t e) const { cudaEventDestroy(e); }
+};
+
+template <class T>
+using DeviceArray = std::unique_ptr<T[], DeviceFree>;
+template <class T>
+using PinnedArray = std::unique_ptr<T[], HostFree>;
+
+template <class T>
+DeviceArray<T> deviceArray(std::size_t n) {
+    void* p = nullptr;
+    check(cudaMalloc(&p, (n ? n : 1) * sizeof(T)), "cudaMalloc");
+    return DeviceArray<T>(static_cast<T*>(p));
+}
+
+template <class T>
+PinnedArray<T> pinnedArray(std::size_t n) {
+    void* p = nullptr;
+    check(cudaHostAlloc(&p, (n ? n : 1) * sizeof(T), cudaHostAllocDefault), "cudaHostAlloc");
+    return PinnedArray<T>(static_cast<T*>(p));
+}
+
+template <class T>
+void upload(T* device, const T* host, std::size_t n, cudaStream_t s) {
+    check(cudaMemcpyAsync(device, host, n * sizeof(T), cudaMemcpyHostToDevice, s), "cudaMemcpyAsync");
+}
+
+// Copy the table block into this thread block's shared memory; every thread
+// of the block must call it
+__device__ const TableBlock& stageTables(const TableBlock* tables) {
+    __shared__ __align__(64) unsigned long long words[sizeof(TableBlock) / sizeof(unsigned long long)];
+    const unsigned long long* src = reinterpret_cast<const unsigned long long*>(tables);
+    for (std::size_t i = threadIdx.x; i < sizeof(TableBlock) / sizeof(unsigned long long); i += blockDim.x) {
+        words[i] = src[i];
+    }
+    __syncthreads();
+    return *reinterpret_cast<const TableBlock*>(words);
+}
+
+__global__ void lossKernel(const TableBlock* tables, const double* vpd, const int* nozzle, const double* pressure,
+                           const double* wind, double* out, std::size_t n) {
+    const TableBlock& t = stageTables(tables);
+    std::size_t stride = static_cast<std::size_t>(gridDim.x) * blockDim.x;
+    for (std::size_t i = static_cast<std::size_t>(blockIdx.x) * blockDim.x + threadIdx.x; i < n; i += stride) {
+        out[i] = detail::evaluate(t, vpd[i], nozzle[i], pressure[i], wind[i]);
+    }
+}
+
+// One thread per aggregation block: the records of the block in order, as
+// detail::accumulateBlock() adds them. partial holds groups sums per block.
+__global__ void blockKernel(const double* loss, const double* volume, const std::uint32_t* key, std::size_t n,
+                            std::size_t block, std::size_t groups, GroupSums* partial) {
+    std::size_t b = static_cast<std::size_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+    std::size_t first = b * block;
+    if (first >= n) return;
+    std::size_t last = n - first < block ? n : first + block;
+    GroupSums* p = partial + b * groups;
+    for (std::size_t i = first; i < last; ++i) {
+        std::uint32_t k = key[i];
+        if (k >= groups) continue;
+        GroupSums& g = p[k];
+        ++g.records;
+        g.volume.add(volume[i]);
+        g.lost.add(volume[i] * loss[i] / 100.0);
+    }
+}
+
+// One thread per key: the block partials in block order, as Aggregator::fold()
+__global__ void foldKernel(const GroupSums* partial, std::size_t blocks, std::size_t groups, GroupSums* totals) {
+    std::size_t k = static_cast<std::size_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+    if (k >= groups) return;
+    GroupSums& g = totals[k];
+    for (std::size_t b = 0; b < blocks; ++b) {
+        const GroupSums& e = partial[b * groups + k];
+        if (e.records == 0) continue;
+        g.records += e.records;
+        g.volume.add(e.volume.value());
+        g.lost.add(e.lost.value());
+    }
+}
+
+// One thread block per design; per-thread compensated sums folded in thread order
+__global__ void sweepKernel(const TableBlock* tables, const int* nozzle, const double* pressure, std::size_t designs,
+                            const double* vpd, const double* wind, std::size_t hours, double* lost) {
+    const TableBlock& t = stageTables(tables);
+    __shared__ double sums[threadsPerBlock], comps[threadsPerBlock];
+    for (std::size_t d = blockIdx.x; d < designs; d += gridDim.x) {
+        CompensatedSum acc;
+        for (std::size_t h = threadIdx.x; h < hours; h += blockDim.x) {
+            acc.add(detail::evaluate(t, vpd[h], nozzle[d], pressure[d], wind[h]) / 100.0);
+        }
+        sums[threadIdx.x] = acc.sum;
+        comps[threadIdx.x] = acc.comp;
+        __syncthreads();
+        if (threadIdx.x == 0) {
+            CompensatedSum total;
+            for (unsigned i = 0; i < blockDim.x; ++i) total.add(sums[i] + comps[i]);
+            lost[d] = total.value();
+        }
+        __syncthreads();
+    }
+}
+
+unsigned gridFor(std::size_t items, unsigned perBlock, unsigned limit) {
+    std::size_t blocks = (items + perBlock - 1) / perBlock;
+    return static_cast<unsigned>(blocks < limit ? (blocks ? blocks : 1) : limit);
+}
+
+// One chunk in flight: a stream with its pinned and device buffers
+struct Slot {
+    std::unique_ptr<CUstream_st, StreamDestroy> stream;
+    PinnedArray<double> hVpd, hPressure, hWind, hVolume, hOut;
+    PinnedArray<int> hNozzle;
+    PinnedArray<std::uint32_t> hKey;
+    DeviceArray<double> dVpd, dPressure, dWind, dVolume, dOut;
+    DeviceArray<int> dNozzle;
+    DeviceArray<std::uint32_t> dKey;
+    DeviceArray<GroupSums> dPartial;
+    std::size_t partialCapacity = 0;
+    std::size_t pendingOffset = 0, pendingCount = 0; // Losses waiting in hOut
+
+    // Wait for the chunk in flight; copy its losses to out if given
+    void drain(double* out) {
+        check(cudaStreamSynchronize(stream.get()), "cudaStreamSynchronize");
+        if (out && pendingCount) std::memcpy(out + pendingOffset, hOut.get(), pendingCount * sizeof(double));
+        pendingCount = 0;
+    }
+};
+
+} // namespace
+
+struct Engine::State {
+    Options options;
+    unsigned gridLimit = 0;
+    DeviceArray<TableBlock> tables;
+    std::vector<Slot> slots;
+    std::unique_ptr<CUevent_st, EventDestroy> folded; // Last fold; the next waits for it
+
+    ~State() {
+        for (Slot& s : slots) {
+            if (s.stream) cudaStreamSynchronize(s.stream.get());
+        }
+    }
+
+    void init(const NomographTables& t, const Options& o) {
+        options = o;
+        if (options.streams < 1) options.streams = 1;
+        if (options.blockSize == 0) options.blockSize = 1;
+        std::size_t blocks = (options.chunkRecords + options.blockSize - 1) / options.blockSize;
+        options.chunkRecords = (blocks ? blocks : 1) * options.blockSize;
+
+        int count = 0;
+        check(cudaGetDeviceCount(&count), "cudaGetDeviceCount");
+        if (options.device < 0 || options.device >= count) {
+            throw std::runtime_error("no CUDA device " + std::to_string(options.device));
+        }
+        check(cudaSetDevice(options.device), "cudaSetDevice");
+        int sms = 0;
+        check(cudaDeviceGetAttribute(&sms, cudaDevAttrMultiProcessorCount, options.device), "cudaDeviceGetAttribute");
+        gridLimit = static_cast<unsigned>(sms > 0 ? sms * 8 : 8);
+
+        tables = deviceArray<TableBlock>(1);
+        check(cudaMemcpy(tables.get(), &t.tables(), sizeof(TableBlock), cudaMemcpyHostToDevice), "cudaMemcpy");
+
+        std::size_t chunk = options.chunkRecords;
+        slots.resize(static_cast<std::size_t>(options.streams));
+        for (Slot& s : slots) {
+            cudaStream_t stream = nullptr;
+            check(cudaStreamCreateWithFlags(&stream, cudaStreamNonBlocking), "cudaStreamCreate");
+            s.stream.reset(stream);
+            s.hVpd = pinnedArray<double>(chunk);
+            s.hPressure = pinnedArray<double>(chunk);
+            s.hWind = pinnedArray<double>(chunk);
+            s.hVolume = pinnedArray<double>(chunk);
+            s.hOut = pinnedArray<double>(chunk);
+            s.hNozzle = pinnedArray<int>(chunk);
+            s.hKey = pinnedArray<std::uint32_t>(chunk);
+            s.dVpd = deviceArray<double>(chunk);
+            s.dPressure = deviceArray<double>(chunk);
+            s.dWind = deviceArray<double>(chunk);
+            s.dVolume = deviceArray<double>(chunk);
+            s.dOut = deviceArray<double>(chunk);
+            s.dNozzle = deviceArray<int>(chunk);
+            s.dKey = deviceArray<std::uint32_t>(chunk);
+        }
+        cudaEvent_t event = nullptr;
+        check(cudaEventCreateWithFlags(&event, cudaEventDisableTiming), "cudaEventCreate");
+        folded.reset(event);
+    }
+
+    // Make the device current and drop results of an interrupted call
+    void begin() {
+        check(cudaSetDevice(options.device), "cudaSetDevice");
+        for (Slot& s : slots) s.drain(nullptr);
+    }
+
+    // Stage record inputs [first, first + count) in s and start their losses in s.dOut
+    void issueLosses(Slot& s, const double* vpd, const int* nozzle, const double* pressure, const double* wind,
+                     std::size_t first, std::size_t count) {
+        std::memcpy(s.hVpd.get(), vpd + first, count * sizeof(double));
+        std::memcpy(s.hNozzle.get(), nozzle + first, count * sizeof(int));
+        std::memcpy(s.hPressure.get(), pressure + first, count * sizeof(double));
+        std::memcpy(s.hWind.get(), wind + first, count * sizeof(double));
+        cudaStream_t stream = s.stream.get();
+        upload(s.dVpd.get(), s.hVpd.get(), count, stream);
+        upload(s.dNozzle.get(), s.hNozzle.get(), count, stream);
+        upload(s.dPressure.get(), s.hPressure.get(), count, stream);
+        upload(s.dWind.get(), s.hWind.get(), count, stream);
+        lossKernel<<<gridFor(count, threadsPerBlock, gridLimit), threadsPerBlock, 0, stream>>>(
+            tables.get(), s.dVpd.get(), s.dNozzle.get(), s.dPressure.get(), s.dWind.get(), s.dOut.get(), count);
+        check(cudaGetLastError(), "lossKernel");
+    }
+};
+
+bool available() {
+    int count = 0;
+    return cudaGetDeviceCount(&count) == cudaSuccess && count > 0;
+}
+
+Engine::Engine(const NomographTables& tables, const Options& options) : state(std::make_unique<State>()) {
+    state->init(tables, options);
+}
+
+Engine::~Engine() = default;
+Engine::Engine(Engine&&) noexcept = default;
+Engine& Engine::operator=(Engine&&) noexcept = default;
+
+const Options& Engine::options() const {
+    return state->options;
+}
+
+void Engine::calculateBatch(const double* vpd, const int* nozzle, const double* pressure, const double* wind,
+                            double* out, std::size_t n) {
+    State& st = *state;
+    st.begin();
+    std::size_t chunk = st.options.chunkRecords;
+    for (std::size_t first = 0, c = 0; first < n; first += chunk, ++c) {
+        Slot& s = st.slots[c % st.slots.size()];
+        s.drain(out);
+        std::size_t count = n - first < chunk ? n - first : chunk;
+        st.issueLosses(s, vpd, nozzle, pressure, wind, first, count);
+        check(cudaMemcpyAsync(s.hOut.get(), s.dOut.get(), count * sizeof(double), cudaMemcpyDeviceToHost,
+                              s.stream.get()),
+              "cudaMemcpyAsync");
+        s.pendingOffset = first;
+        s.pendingCount = count;
+    }
+    for (Slot& s : st.slots) s.drain(out);
+}
+
+std::vector<Parallel::GroupTotal> Engine::aggregate(const double* vpd, const int* nozzle, const double* pressure,
+                                                    const double* wind, const double* volume,
+                                                    const std::uint32_t* key, std::size_t n, std::size_t groups) {
+    State& st = *state;
+    st.begin();
+    std::size_t chunk = st.options.chunkRecords, block = st.options.blockSize;
+    std::size_t blocksPerChunk = chunk / block;
+    // Blocks whose partials fit in partialBytes per stream; a chunk takes several passes if needed
+    std::size_t blockBytes = groups * sizeof(GroupSums);
+    std::size_t blocksPerPass = blockBytes ? st.options.partialBytes / blockBytes : blocksPerChunk;
+    if (blocksPerPass < 1) blocksPerPass = 1;
+    if (blocksPerPass > blocksPerChunk) blocksPerPass = blocksPerChunk;
+    for (Slot& s : st.slots) {
+        if (s.partialCapacity < blocksPerPass * groups) {
+            s.dPartial = deviceArray<GroupSums>(blocksPerPass * groups);
+            s.partialCapacity = blocksPerPass * groups;
+        }
+    }
+
+    // The slot streams do not wait for the legacy default stream: clear the
+    // totals on the first slot and make the first fold wait for it
+    DeviceArray<GroupSums> totals = deviceArray<GroupSums>(groups);
+    cudaStream_t clearStream = st.slots[0].stream.get();
+    check(cudaMemsetAsync(totals.get(), 0, groups * sizeof(GroupSums), clearStream), "cudaMemsetAsync");
+    check(cudaEventRecord(st.folded.get(), clearStream), "cudaEventRecord");
+
+    for (std::size_t first = 0, c = 0; first < n; first += chunk, ++c) {
+        Slot& s = st.slots[c % st.slots.size()];
+        s.drain(nullptr);
+        std::size_t count = n - first < chunk ? n - first : chunk;
+        std::size_t blocks = (count + block - 1) / block;
+        cudaStream_t stream = s.stream.get();
+        std::memcpy(s.hVolume.get(), volume + first, count * sizeof(double));
+        std::memcpy(s.hKey.get(), key + first, count * sizeof(std::uint32_t));
+        upload(s.dVolume.get(), s.hVolume.get(), count, stream);
+        upload(s.dKey.get(), s.hKey.get(), count, stream);
+        st.issueLosses(s, vpd, nozzle, pressure, wind, first, count);
+
+        for (std::size_t b = 0; b < blocks; b += blocksPerPass) {
+            std::size_t passBlocks = blocks - b < blocksPerPass ? blocks - b : blocksPerPass;
+            std::size_t offset = b * block;
+            std::size_t passCount = count - offset < passBlocks * block ? count - offset : passBlocks * block;
+            check(cudaMemsetAsync(s.dPartial.get(), 0, passBlocks * groups * sizeof(GroupSums), stream),
+                  "cudaMemsetAsync");
+            blockKernel<<<gridFor(passBlocks, 64, 0xffffffffu), 64, 0, stream>>>(
+                s.dOut.get() + offset, s.dVolume.get() + offset, s.dKey.get() + offset, passCount, block, groups,
+                s.dPartial.get());
+            check(cudaGetLastError(), "blockKernel");
+
+            // Passes fold in block order, whatever stream they ran on
+            check(cudaStreamWaitEvent(stream, st.folded.get(), 0), "cudaStreamWaitEvent");
+            foldKernel<<<gridFor(groups, threadsPerBlock, 0xffffffffu), threadsPerBlock, 0, stream>>>(
+                s.dPartial.get(), passBlocks, groups, totals.get());
+            check(cudaGetLastError(), "foldKernel");
+            check(cudaEventRecord(st.folded.get(), stream), "cudaEventRecord");
+        }
+    }
+    for (Slot& s : st.slots) s.drain(nullptr);
+
+    std::vector<GroupSums> sums(groups);
+    check(cudaMemcpy(sums.data(), totals.get(), groups * sizeof(GroupSums), cudaMemcpyDeviceToHost), "cudaMemcpy");
+    std::vector<Parallel::GroupTotal> out(groups);
+    for (std::size_t k = 0; k < groups; ++k) {
+        out[k].records = sums[k].records;
+        out[k].volume = sums[k].volume.value();
+        out[k].lost = sums[k].lost.value();
+    }
+    return out;
+}
+
+std::vector<Parallel::GroupTotal> Engine::sweep(const int* nozzle, const double* pressure, std::size_t designs,
+                                                const double* vpd, const double* wind, std::size_t hours) {
+    State& st = *state;
+    st.begin();
+    cudaStream_t stream = st.slots[0].stream.get();
+    DeviceArray<int> dNozzle = deviceArray<int>(designs);
+    DeviceArray<double> dPressure = deviceArray<double>(designs), dLost = deviceArray<double>(designs);
+    DeviceArray<double> dVpd = deviceArray<double>(hours), dWind = deviceArray<double>(hours);
+    upload(dNozzle.get(), nozzle, designs, stream);
+    upload(dPressure.get(), pressure, designs, stream);
+    upload(dVpd.get(), vpd, hours, stream);
+    upload(dWind.get(), wind, hours, stream);
+    if (designs > 0) {
+        unsigned grid = designs < (std::size_t(1) << 20) ? static_cast<unsigned>(designs) : 1u << 20;
+        sweepKernel<<<grid, threadsPerBlock, 0, stream>>>(st.tables.get(), dNozzle.get(), dPressure.get(), designs,
+                                                          dVpd.get(), dWind.get(), hours, dLost.get());
+        check(cudaGetLastError(), "sweepKernel");
+    }
+    std::vector<double> lost(designs);
+    check(cudaMemcpyAsync(lost.data(), dLost.get(), designs * sizeof(double), cudaMemcpyDeviceToHost, stream),
+          "cudaMemcpyAsync");
+    check(cudaStreamSynchronize(stream), "cudaStreamSynchronize");
+
+    std::vector<Parallel::GroupTotal> out(designs);
+    for (std::size_t d = 0; d < designs; ++d) {
+        out[d].records = hours;
+        out[d].volume = static_cast<double>(hours);
+        out[d].lost = lost[d];
+    }
+    return out;
+}
+
+} // namespace Gpu
+} // namespace EvapSolver
@@ -0,0 +1,100 @@
+#ifndef EVAP_SOLVER_GPU_H
+#define EVAP_SOLVER_GPU_H
+
+// Optional CUDA backend for large batch, aggregation and design sweeps.
+//
+// This header is plain C++. The kernels live in evap_solver_gpu.cu, built
+// with nvcc and linked with the CUDA runtime:
+//   nvcc -std=c++17 -O3 -fmad=false -c src/evap_solver_gpu.cu
+//   g++ -std=c++17 -O2 -pthread app.cpp evap_solver_gpu.o -lcudart
+// Device code runs the same chain as the CPU engines, detail::evaluate()
+// on a TableBlock (evap_solver_core.h, evap_solver_tables.h). The block is
+// copied to the device once per Engine, and each thread block stages it in
+// shared memory. Constant memory would serialize the divergent tick
+// lookups of a warp, and a per-Engine copy lets Engines differ in tables.
+// With -fmad=false no multiply-add is contracted, so per-record losses are
+// bit-identical to Calculator::calculate() on the same tables.
+//
+// Records are streamed in chunks through pinned host buffers on several
+// CUDA streams. The copies of one chunk overlap the kernels of the others.
+// The aggregation paths reduce on the device and copy back only totals:
+//   aggregate()  per-key totals with the blocked, compensated, block-ordered
+//                reduction of Parallel::Aggregator; for one add() of the
+//                same records and blockSize the totals are bit-identical.
+//                Each aggregation block keeps a dense partial per key
+//                (48 bytes x groups). Blocks are folded in passes that fit
+//                partialBytes per stream. With 10^6 keys only five blocks
+//                fit per 256 MiB pass, so the block kernel runs five
+//                threads; beyond about 10^5 keys a larger blockSize or the
+//                CPU Aggregator is faster.
+//   sweep()      nozzle/pressure designs against a weather series (unit
+//                volume per hour); one thread block per design, summed in a
+//                fixed order, so repeated runs give the same bits
+//
+// Errors (no device, failed allocations or launches) are reported as
+// std::runtime_error with the CUDA message. available() checks for a device
+// without throwing.
+//
+// Usage:
+//   EvapSolver::Gpu::Engine gpu;                                  // built-in tables, device 0
+//   gpu.calculateBatch(vpd, nozzle, pressure, wind, out, n);
+//   std::vector<EvapSolver::Parallel::GroupTotal> fields =
+//       gpu.aggregate(vpd, nozzle, pressure, wind, volume, field, n, fieldCount);
+//   std::vector<EvapSolver::Parallel::GroupTotal> designs =
+//       gpu.sweep(designNozzle, designPressure, designCount, hourlyVpd, hourlyWind, hours);
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "evap_solver_aggregate.h"
+#include "evap_solver_tables.h"
+
+namespace EvapSolver {
+namespace Gpu {
+
+struct Options {
+    int device = 0;
+    std::size_t chunkRecords = std::size_t(1) << 20; // Records per transfer; rounded up to blockSize
+    int streams = 2;                                 // Chunks in flight
+    std::size_t blockSize = 4096;                    // aggregate(): as in Parallel::AggregateOptions
+    std::size_t partialBytes = std::size_t(256) << 20; // aggregate(): per-block partial sums per stream
+};
+
+// True if the CUDA runtime finds at least one device
+bool available();
+
+class Engine {
+public:
+    explicit Engine(const NomographTables& tables = NomographTables::defaults(), const Options& options = {});
+    ~Engine();
+    Engine(Engine&&) noexcept;
+    Engine& operator=(Engine&&) noexcept;
+    Engine(const Engine&) = delete;
+    Engine& operator=(const Engine&) = delete;
+
+    // Per-record losses (%), bit-identical to the CPU chain
+    void calculateBatch(const double* vpd, const int* nozzle, const double* pressure, const double* wind,
+                        double* out, std::size_t n);
+
+    // Totals per key in [0, groups); larger keys are skipped
+    std::vector<Parallel::GroupTotal> aggregate(const double* vpd, const int* nozzle, const double* pressure,
+                                                const double* wind, const double* volume, const std::uint32_t* key,
+                                                std::size_t n, std::size_t groups);
+
+    // Every design (nozzle[d], pressure[d]) against every hour (vpd[h], wind[h]).
+    // Totals per design: records = volume = hours, lost = sum of loss / 100.
+    std::vector<Parallel::GroupTotal> sweep(const int* nozzle, const double* pressure, std::size_t designs,
+                                            const double* vpd, const double* wind, std::size_t hours);
+
+    const Options& options() const;
+
+private:
+    struct State;
+    std::unique_ptr<State> state;
+};
+
+} // namespace Gpu
+} // namespace EvapSolver
+
+#endif // EVAP_SOLVER_GPU_H
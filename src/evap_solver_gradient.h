@@ -0,0 +1,113 @@
+#ifndef EVAP_SOLVER_GRADIENT_H
+#define EVAP_SOLVER_GRADIENT_H
+
+// Loss together with its partial derivatives in vpd, pressure and wind.
+//
+// Every stage of the chain is piecewise linear, so the local slope of each
+// table lookup is known once its segment is found, and the pivots are fixed
+// linear combinations:
+//   d loss / d vpd      = s6 * (1 - c) * (1 - a) * s3
+//   d loss / d pressure = s6 * c * (1 - b) * s7
+//   d loss / d wind     = s6 * c * b * s9
+// with s3, s7, s9, s6 the segment slopes and a, b, c the pivot fractions
+// (x4 - x3) / (x5 - x3), (x8 - x7) / (x9 - x7) and (x6 - x4) / (x8 - x4).
+// The value is computed with the same expressions as Calculator::calculate()
+// and is bit-identical to it.
+//
+// Breakpoints: at a tick the slope of the segment ending there is used (a
+// left derivative), except at the first tick, where the first segment is the
+// only one inside the table. Outside the table a lookup is clamped, its
+// slope is 0 and its bit is set in GradientResult::clamped. The nozzle is an
+// integer and has no derivative; it is still flagged when clamped.
+//
+// Usage:
+//   EvapSolver::GradientResult g = EvapSolver::calculateWithGradient({0.6, 12, 40, 5});
+//   // g.value, g.dVpd (%/psi), g.dPressure (%/psi), g.dWind (%/mph), g.clamped
+
+#include <cstddef>
+#include <cstdint>
+#include "evap_solver_compact.h"
+
+namespace EvapSolver {
+
+// Clamp bits, one per table lookup that left its table
+using ClampFlags = std::uint8_t;
+inline constexpr ClampFlags VpdClamped = 1u << 0;
+inline constexpr ClampFlags NozzleClamped = 1u << 1;
+inline constexpr ClampFlags PressureClamped = 1u << 2;
+inline constexpr ClampFlags WindClamped = 1u << 3;
+inline constexpr ClampFlags LossClamped = 1u << 4; // yL outside S6: loss pinned at 0% or 40%
+
+struct GradientResult {
+    double value;     // Evaporation loss (%)
+    double dVpd;      // d loss / d vpd (% per psi)
+    double dPressure; // d loss / d pressure (% per psi)
+    double dWind;     // d loss / d wind (% per mph)
+    ClampFlags clamped;
+};
+
+namespace detail {
+
+// lerp(s, g, v) together with the slope of the segment it used; slope is 0
+// and clamped is set when v is outside the table
+template <std::size_t N, std::size_t Cells>
+inline double lerpWithSlope(const Scale<N>& s, const GridIndex<N, Cells>& g, double v, double& slope,
+                            bool& clamped) {
+    if (v <= s.x[0] || v >= s.x[N - 1]) {
+        // The end ticks themselves are inside the table and take the adjacent segment
+        std::size_t i = v == s.x[0] ? 1 : N - 1;
+        clamped = !(v == s.x[0] || v == s.x[N - 1]);
+        slope = clamped ? 0.0 : (s.y[i] - s.y[i - 1]) / (s.x[i] - s.x[i - 1]);
+        return v <= s.x[0] ? s.y[0] : s.y[N - 1];
+    }
+
+    std::size_t i = gridSegment(s, g, v);
+    clamped = false;
+    slope = (s.y[i] - s.y[i - 1]) / (s.x[i] - s.x[i - 1]);
+    return s.y[i - 1] + (s.y[i] - s.y[i - 1]) * (v - s.x[i - 1]) / (s.x[i] - s.x[i - 1]);
+}
+
+inline GradientResult evaluateWithGradient(double vpd, int nozzle, double pressure, double wind) {
+    constexpr double a = (x4 - x3) / (x5 - x3);
+    constexpr double b = (x8 - x7) / (x9 - x7);
+    constexpr double c = (x6 - x4) / (x8 - x4);
+
+    double s3, s5, s7, s9, s6;
+    bool c3, c5, c7, c9, c6;
+    double y3 = lerpWithSlope(S3, S3_grid, vpd, s3, c3);
+    double y5 = lerpWithSlope(S5, S5_grid, nozzle, s5, c5);
+    double y7 = lerpWithSlope(S7, S7_grid, pressure, s7, c7);
+    double y9 = lerpWithSlope(S9, S9_grid, wind, s9, c9);
+
+    // Same expressions as combine()
+    double yA = lerp2(x4, x3, y3, x5, y5);
+    double yB = lerp2(x8, x7, y7, x9, y9);
+    double yL = lerp2(x6, x4, yA, x8, yB);
+
+    GradientResult r;
+    r.value = lerpWithSlope(S6_flip, S6_flip_grid, yL, s6, c6);
+    r.dVpd = s6 * (1 - c) * (1 - a) * s3;
+    r.dPressure = s6 * c * (1 - b) * s7;
+    r.dWind = s6 * c * b * s9;
+    r.clamped = static_cast<ClampFlags>((c3 ? VpdClamped : 0) | (c5 ? NozzleClamped : 0) |
+                                        (c7 ? PressureClamped : 0) | (c9 ? WindClamped : 0) |
+                                        (c6 ? LossClamped : 0));
+    return r;
+}
+
+} // namespace detail
+
+// Loss and partial derivatives in one pass
+inline GradientResult calculateWithGradient(const Input& in) {
+    return detail::evaluateWithGradient(in.vpd, in.nozzle, in.pressure, in.wind);
+}
+
+// n records stored as parallel arrays; out[i] equals calculateWithGradient()
+inline void calculateWithGradientBatch(const double* vpd, const int* nozzle, const double* pressure,
+                                       const double* wind, GradientResult* out, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) out[i] = detail::evaluateWithGradient(vpd[i], nozzle[i], pressure[i], wind[i]);
+}
+
+} // namespace EvapSolver
+
+#endif // EVAP_SOLVER_GRADIENT_H
@@ -0,0 +1,88 @@
+#ifndef EVAP_SOLVER_INCREMENTAL_H
+#define EVAP_SOLVER_INCREMENTAL_H
+
+// Incremental evaluation of one sprinkler's weather time series.
+//
+// The nomograph chain splits by driver: vpd only feeds y3 -> yA, wind only
+// feeds y9 -> yB, and yL combines the two pivots. IncrementalEvaluator keeps
+// the pivots of the previous record and recomputes only the branch whose
+// input changed, so a step where just the wind changes costs one S9 lookup,
+// one pivot and the S6 lookup; a repeated record costs a compare. Results
+// are bit-identical to Calculator::calculate(), since every value is
+// produced by the same expressions in the same order.
+//
+// Usage:
+//   EvapSolver::IncrementalEvaluator eval(EvapSolver::SprinklerProfile(12, 40));
+//   for (hour...) loss[hour] = eval.push(vpd[hour], wind[hour]);
+//   eval.pushBatch(vpdSeries, windSeries, out, hours);   // same, columnar
+
+#include <cmath>
+#include <cstddef>
+#include "evap_solver_compact.h"
+#include "evap_solver_profile.h"
+
+namespace EvapSolver {
+
+// How often each branch of the chain was recomputed
+struct IncrementalStats {
+    std::size_t pushes = 0;
+    std::size_t vpdUpdates = 0;  // S3 lookup and yA
+    std::size_t windUpdates = 0; // S9 lookup and yB
+};
+
+// Stateful per-sprinkler evaluator; not thread-safe, use one per thread
+class IncrementalEvaluator {
+public:
+    explicit IncrementalEvaluator(const SprinklerProfile& profile) : y5(profile.y5), y7(profile.y7) { reset(); }
+
+    IncrementalEvaluator(int nozzle, double pressure) : IncrementalEvaluator(SprinklerProfile(nozzle, pressure)) {}
+
+    // Evaporation loss (%) for the next weather record
+    double push(double vpd, double wind) {
+        using namespace detail;
+        ++counts.pushes;
+        // NaN never compares equal, so it is always recomputed (and propagates)
+        bool vpdChanged = !(vpd == lastVpd);
+        bool windChanged = !(wind == lastWind);
+        if (!vpdChanged && !windChanged) return loss;
+
+        if (vpdChanged) {
+            lastVpd = vpd;
+            y3 = lerp(S3, S3_grid, vpd);
+            yA = lerp2(x4, x3, y3, x5, y5);
+            ++counts.vpdUpdates;
+        }
+        if (windChanged) {
+            lastWind = wind;
+            y9 = lerp(S9, S9_grid, wind);
+            yB = lerp2(x8, x7, y7, x9, y9);
+            ++counts.windUpdates;
+        }
+        double yL = lerp2(x6, x4, yA, x8, yB);
+        loss = lerp(S6_flip, S6_flip_grid, yL);
+        return loss;
+    }
+
+    // Columnar time series; continues from the current state
+    void pushBatch(const double* vpd, const double* wind, double* out, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) out[i] = push(vpd[i], wind[i]);
+    }
+
+    // Forget the cached record (e.g. before replaying another series)
+    void reset() {
+        lastVpd = lastWind = NAN;
+        y3 = y9 = yA = yB = loss = 0.0;
+    }
+
+    const IncrementalStats& stats() const { return counts; }
+
+private:
+    double y5, y7;
+    double lastVpd, lastWind;
+    double y3, y9, yA, yB, loss;
+    IncrementalStats counts;
+};
+
+} // namespace EvapSolver
+
+#endif // EVAP_SOLVER_INCREMENTAL_H
@@ -0,0 +1,318 @@
+#ifndef EVAP_SOLVER_INSTRUMENT_H
+#define EVAP_SOLVER_INSTRUMENT_H
+
+// Compile-time switchable hot-path instrumentation.
+//
+// Built with -DEVAP_SOLVER_INSTRUMENT=1, the exact chain (Calculator,
+// Nomograph, the scalar and SIMD batch kernels, runtime tables) and the
+// separable engine record, per thread:
+//   - per scale (S3 vpd, S5 nozzle, S7 pressure, S9 wind, S6 loss): how
+//     many lookups clamped below the first or above the last tick, were
+//     NaN, or fell into each segment between two ticks
+//   - per batch entry point: the number of batches, and for every Nth batch
+//     on a thread (setSampleInterval(), default 16) its record count and
+//     wall time in a log2 histogram
+// Each thread writes only its own 64-byte-aligned counter block, with
+// relaxed load/store pairs that compile to plain adds, so enabled counting
+// never contends on a shared cache line. snapshot() sums the blocks of live
+// threads and the counts left by exited ones at any time.
+//
+// Without the macro (the default) the hooks are empty, `if constexpr`
+// discards them, and snapshot() returns zeros with enabled == false, so
+// callers compile unchanged. Define the macro identically in every
+// translation unit of a program.
+//
+// Usage:
+//   g++ -std=c++17 -O2 -pthread -DEVAP_SOLVER_INSTRUMENT=1 ...
+//   EvapSolver::Instrument::Snapshot s = EvapSolver::Instrument::snapshot();
+//   EvapSolver::Instrument::writeJson(std::cout, s);
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+#ifndef EVAP_SOLVER_INSTRUMENT
+#define EVAP_SOLVER_INSTRUMENT 0
+#endif
+
+#if EVAP_SOLVER_INSTRUMENT
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <vector>
+#endif
+
+namespace EvapSolver {
+namespace Instrument {
+
+inline constexpr bool enabled = EVAP_SOLVER_INSTRUMENT != 0;
+
+// Scales in chain order: the four input axes, then the S6 loss lookup
+enum Axis : std::size_t { Vpd, Nozzle, Pressure, Wind, Loss };
+inline constexpr std::size_t axisCount = 5;
+inline constexpr std::size_t maxSegments = 14; // S9 has 15 ticks
+inline constexpr std::size_t latencyBuckets = 40;
+
+inline const char* axisName(std::size_t axis) {
+    static const char* const names[axisCount] = {"vpd", "nozzle", "pressure", "wind", "loss"};
+    return axis < axisCount ? names[axis] : "";
+}
+
+// Segments of the scale behind an axis (ticks - 1)
+inline constexpr std::size_t segmentCount(std::size_t axis) {
+    return axis == Wind ? 14 : axis == Loss ? 13 : 10;
+}
+
+struct AxisCounts {
+    std::uint64_t below = 0; // v < x[0], clamped to the first tick
+    std::uint64_t above = 0; // v > x[last], clamped to the last tick
+    std::uint64_t nan = 0;
+    std::uint64_t segments[maxSegments] = {}; // segments[k]: x[k] < v <= x[k+1] (and v == x[0] for k = 0)
+
+    std::uint64_t clamped() const { return below + above; }
+
+    std::uint64_t total() const {
+        std::uint64_t t = below + above + nan;
+        for (std::uint64_t s : segments) t += s;
+        return t;
+    }
+};
+
+struct LatencyCounts {
+    std::uint64_t batches = 0;     // Batch calls (nested entry points count once)
+    std::uint64_t sampled = 0;     // Batches timed
+    std::uint64_t records = 0;     // Records in the timed batches
+    std::uint64_t nanoseconds = 0; // Wall time of the timed batches
+    std::uint64_t maxNanoseconds = 0;
+    std::uint64_t buckets[latencyBuckets] = {}; // buckets[b]: time in [2^b, 2^(b+1)) ns; 0 ns in bucket 0
+
+    double nsPerRecord() const { return records ? double(nanoseconds) / double(records) : 0.0; }
+
+    // Upper edge of the bucket holding quantile q of the timed batches (ns)
+    double quantileNanoseconds(double q) const {
+        if (!sampled) return 0.0;
+        double rank = q * double(sampled);
+        std::uint64_t seen = 0;
+        for (std::size_t b = 0; b < latencyBuckets; ++b) {
+            seen += buckets[b];
+            if (double(seen) >= rank && seen) return double(std::uint64_t(2) << b);
+        }
+        return double(std::uint64_t(2) << (latencyBuckets - 1));
+    }
+};
+
+struct Snapshot {
+    bool enabled = false;
+    std::uint64_t threads = 0; // Threads that have recorded, live or exited
+    AxisCounts axes[axisCount];
+    LatencyCounts latency;
+};
+
+// Bins of one axis: clamp and NaN events, then the segments
+namespace detail {
+inline constexpr std::size_t binBelow = 0, binAbove = 1, binNaN = 2, binSegment = 3;
+inline constexpr std::size_t binCount = binSegment + maxSegments;
+} // namespace detail
+
+#if EVAP_SOLVER_INSTRUMENT
+
+namespace detail {
+
+using Counter = std::atomic<std::uint64_t>;
+
+// Only the owning thread writes a counter, so no read-modify-write is needed
+inline void bump(Counter& c, std::uint64_t by = 1) {
+    c.store(c.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+}
+
+// One thread's counters, on cache lines of their own
+struct alignas(64) ThreadCounters {
+    Counter bins[axisCount][binCount];
+    Counter batches, sampled, records, nanoseconds, maxNanoseconds;
+    Counter buckets[latencyBuckets];
+    unsigned depth; // Open BatchTimers; owner thread only
+
+    void addTo(Snapshot& s) const {
+        for (std::size_t a = 0; a < axisCount; ++a) {
+            AxisCounts& axis = s.axes[a];
+            axis.below += bins[a][binBelow].load(std::memory_order_relaxed);
+            axis.above += bins[a][binAbove].load(std::memory_order_relaxed);
+            axis.nan += bins[a][binNaN].load(std::memory_order_relaxed);
+            for (std::size_t k = 0; k < maxSegments; ++k) {
+                axis.segments[k] += bins[a][binSegment + k].load(std::memory_order_relaxed);
+            }
+        }
+        LatencyCounts& l = s.latency;
+        l.batches += batches.load(std::memory_order_relaxed);
+        l.sampled += sampled.load(std::memory_order_relaxed);
+        l.records += records.load(std::memory_order_relaxed);
+        l.nanoseconds += nanoseconds.load(std::memory_order_relaxed);
+        l.maxNanoseconds = std::max<std::uint64_t>(l.maxNanoseconds, maxNanoseconds.load(std::memory_order_relaxed));
+        for (std::size_t b = 0; b < latencyBuckets; ++b) l.buckets[b] += buckets[b].load(std::memory_order_relaxed);
+    }
+
+    void clear() {
+        for (auto& axis : bins) {
+            for (Counter& c : axis) c.store(0, std::memory_order_relaxed);
+        }
+        for (Counter* c : {&batches, &sampled, &records, &nanoseconds, &maxNanoseconds}) {
+            c->store(0, std::memory_order_relaxed);
+        }
+        for (Counter& c : buckets) c.store(0, std::memory_order_relaxed);
+    }
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<ThreadCounters*> live;
+    Snapshot retired; // Counts of exited threads
+    std::atomic<unsigned> sampleInterval{16};
+};
+
+// Never destroyed: threads may still exit after static destruction
+inline Registry& registry() {
+    static Registry* r = new Registry();
+    return *r;
+}
+
+// Registers the thread's counters on first use and hands them to the
+// registry when the thread exits
+struct ThreadSlot {
+    ThreadCounters* counters = new ThreadCounters(); // Value-initialized: all zero
+
+    ThreadSlot() {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.live.push_back(counters);
+    }
+
+    ~ThreadSlot() {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        counters->addTo(r.retired);
+        r.retired.threads++;
+        r.live.erase(std::find(r.live.begin(), r.live.end(), counters));
+        delete counters;
+    }
+};
+
+inline ThreadCounters& local() {
+    thread_local ThreadSlot slot;
+    return *slot.counters;
+}
+
+// One lookup on axis, in bin (binBelow ... binSegment + k)
+inline void record(std::size_t axis, std::size_t bin) {
+    bump(local().bins[axis][bin]);
+}
+
+} // namespace detail
+
+// Counts a batch of n records and times every sampleInterval-th one; a
+// batch entry point called inside another one on the same thread is neither
+// counted nor timed
+class BatchTimer {
+public:
+    explicit BatchTimer(std::size_t n) : c(detail::local()), records(n) {
+        if (c.depth++ != 0) return;
+        std::uint64_t batch = c.batches.load(std::memory_order_relaxed);
+        detail::bump(c.batches);
+        unsigned interval = detail::registry().sampleInterval.load(std::memory_order_relaxed);
+        timed = interval != 0 && batch % interval == 0;
+        if (timed) start = Clock::now();
+    }
+
+    ~BatchTimer() {
+        c.depth--;
+        if (!timed) return;
+        std::uint64_t ns = static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+        std::size_t bucket = 0;
+        while (bucket + 1 < latencyBuckets && (ns >> (bucket + 1)) != 0) ++bucket;
+        detail::bump(c.sampled);
+        detail::bump(c.records, records);
+        detail::bump(c.nanoseconds, ns);
+        detail::bump(c.buckets[bucket]);
+        if (ns > c.maxNanoseconds.load(std::memory_order_relaxed)) {
+            c.maxNanoseconds.store(ns, std::memory_order_relaxed);
+        }
+    }
+
+    BatchTimer(const BatchTimer&) = delete;
+    BatchTimer& operator=(const BatchTimer&) = delete;
+
+private:
+    using Clock = std::chrono::steady_clock;
+    detail::ThreadCounters& c;
+    std::size_t records;
+    bool timed = false;
+    Clock::time_point start;
+};
+
+// Sum of all threads' counters so far
+inline Snapshot snapshot() {
+    detail::Registry& r = detail::registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    Snapshot s = r.retired;
+    s.enabled = true;
+    for (const detail::ThreadCounters* c : r.live) c->addTo(s);
+    s.threads += r.live.size();
+    return s;
+}
+
+// Zero every counter. Counts recorded concurrently with reset() may survive
+// it; reset between runs for exact figures.
+inline void reset() {
+    detail::Registry& r = detail::registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    for (detail::ThreadCounters* c : r.live) c->clear();
+    r.retired = Snapshot();
+}
+
+// Time every n-th batch on each thread; 1 times all, 0 none
+inline void setSampleInterval(unsigned n) {
+    detail::registry().sampleInterval.store(n, std::memory_order_relaxed);
+}
+
+#else
+
+namespace detail {
+inline void record(std::size_t, std::size_t) {}
+} // namespace detail
+
+class BatchTimer {
+public:
+    explicit BatchTimer(std::size_t) {}
+};
+
+inline Snapshot snapshot() { return Snapshot(); }
+inline void reset() {}
+inline void setSampleInterval(unsigned) {}
+
+#endif
+
+// Snapshot as one JSON object: {"enabled", "threads", "axes": {name: {...}},
+// "latency": {...}}, with only the segments the axis' scale has
+inline void writeJson(std::ostream& out, const Snapshot& s) {
+    out << "{\"enabled\":" << (s.enabled ? "true" : "false") << ",\"threads\":" << s.threads << ",\"axes\":{";
+    for (std::size_t a = 0; a < axisCount; ++a) {
+        const AxisCounts& axis = s.axes[a];
+        out << (a ? "," : "") << '"' << axisName(a) << "\":{\"below\":" << axis.below << ",\"above\":" << axis.above
+            << ",\"nan\":" << axis.nan << ",\"segments\":[";
+        for (std::size_t k = 0; k < segmentCount(a); ++k) out << (k ? "," : "") << axis.segments[k];
+        out << "]}";
+    }
+    const LatencyCounts& l = s.latency;
+    out << "},\"latency\":{\"batches\":" << l.batches << ",\"sampled\":" << l.sampled << ",\"records\":" << l.records
+        << ",\"nanoseconds\":" << l.nanoseconds << ",\"maxNanoseconds\":" << l.maxNanoseconds << ",\"buckets\":[";
+    std::size_t used = latencyBuckets;
+    while (used > 0 && l.buckets[used - 1] == 0) --used;
+    for (std::size_t b = 0; b < used; ++b) out << (b ? "," : "") << l.buckets[b];
+    out << "]}}";
+}
+
+} // namespace Instrument
+} // namespace EvapSolver
+
+#endif // EVAP_SOLVER_INSTRUMENT_H
@@ -0,0 +1,320 @@
+#ifndef EVAP_SOLVER_INVERSE_H
+#define EVAP_SOLVER_INVERSE_H
+
+// Inverse queries: the largest wind speed or nozzle pressure at which the
+// loss stays at or below a target.
+//
+// Every scale is monotone: the loss increases with vpd, pressure and wind
+// and decreases with the nozzle diameter. So "loss <= target" holds below
+// one limit on the wind or pressure axis, and the limit can be read off the
+// nomograph backwards instead of bisecting:
+//   target -> yL on column 6 (S6 with x and y swapped back)
+//   line through the A pivot and yL -> yB on column 8
+//   line through yB and the known ordinate (S7 or S9) -> the unknown ordinate
+//   unknown ordinate -> axis value (S9 or S7 with x and y swapped)
+// That is four lookups and three straight lines per query. Evaluating
+// Calculator::calculate() at an Exact result gives the target back to
+// within rounding (1e-12 percentage points).
+//
+// Status reports when the limit falls outside the axis range:
+//   BelowRange  even the lowest wind (0 mph) or pressure (20 psi) exceeds
+//               the target, or the target is below 0% or NaN; the lower end
+//               is returned
+//   AboveRange  the whole axis meets the target, or the target is at or
+//               above 40%; the upper end (15 mph, 80 psi) is returned
+//
+// Usage:
+//   auto r = EvapSolver::InverseSolver::maxWind(0.6, 12, 40, 15.0);   // r.value mph, r.status
+//   EvapSolver::InverseSolver::maxPressureBatch(vpd, nozzle, wind, target, out, status, n);
+
+#include <cstddef>
+#include <cstdint>
+#include "evap_solver_compact.h"
+#include "evap_solver_simd.h"
+
+namespace EvapSolver {
+
+enum class InverseStatus : std::uint8_t {
+    Exact = 0,      // The limit lies inside the axis range
+    BelowRange = 1, // No value in range meets the target; lower end returned
+    AboveRange = 2  // Every value in range meets the target; upper end returned
+};
+
+struct InverseResult {
+    double value;
+    InverseStatus status;
+};
+
+namespace detail {
+
+// Axis solved for
+enum class InverseAxis { Wind, Pressure };
+
+// Scale with abscissae and ordinates swapped (the ordinates must increase)
+template <std::size_t N>
+constexpr Scale<N> swapAxes(const Scale<N>& s) {
+    Scale<N> out{};
+    for (std::size_t i = 0; i < N; ++i) {
+        out.x[i] = s.y[i];
+        out.y[i] = s.x[i];
+    }
+    return out;
+}
+
+inline constexpr Scale<14> S6 = swapAxes(S6_flip); // loss -> yL
+inline constexpr Scale<11> S7_inv = swapAxes(S7);  // y7 -> pressure
+inline constexpr Scale<15> S9_inv = swapAxes(S9);  // y9 -> wind
+
+inline constexpr auto S6_grid = makeGridIndex<gridCells(S6)>(S6);
+inline constexpr auto S7_inv_grid = makeGridIndex<gridCells(S7_inv)>(S7_inv);
+inline constexpr auto S9_inv_grid = makeGridIndex<gridCells(S9_inv)>(S9_inv);
+
+inline constexpr double maxLoss = S6_flip.y[13];
+
+// Largest value on the wind or pressure axis with loss <= targetLoss; known
+// is the value on the other of the two axes
+template <InverseAxis A>
+inline InverseResult inverse(double vpd, int nozzle, double known, double targetLoss) {
+    constexpr bool wind = A == InverseAxis::Wind;
+    const double lower = wind ? S9_inv.y[0] : S7_inv.y[0];
+    const double upper = wind ? S9_inv.y[14] : S7_inv.y[10];
+
+    if (targetLoss >= maxLoss) return {upper, InverseStatus::AboveRange};
+    if (!(targetLoss >= 0.0)) return {lower, InverseStatus::BelowRange};
+
+    // Line through the A pivot and the target's yL, extended to column 8
+    double yA = lerp2(x4, x3, lerp(S3, S3_grid, vpd), x5, lerp(S5, S5_grid, nozzle));
+    double yB = lerp2(x8, x4, yA, x6, lerp(S6, S6_grid, targetLoss));
+
+    // Line through the known ordinate and yB, extended to the unknown column
+    double y = wind ? lerp2(x9, x7, lerp(S7, S7_grid, known), x8, yB)
+                    : lerp2(x7, x9, lerp(S9, S9_grid, known), x8, yB);
+
+    if (y < (wind ? S9_inv.x[0] : S7_inv.x[0])) return {lower, InverseStatus::BelowRange};
+    if (y > (wind ? S9_inv.x[14] : S7_inv.x[10])) return {upper, InverseStatus::AboveRange};
+    return {wind ? lerp(S9_inv, S9_inv_grid, y) : lerp(S7_inv, S7_inv_grid, y), InverseStatus::Exact};
+}
+
+} // namespace detail
+
+namespace Simd {
+namespace detail {
+
+template <EvapSolver::detail::InverseAxis A>
+inline void scalarInverseBatch(const double* vpd, const int* nozzle, const double* known, const double* target,
+                               double* out, InverseStatus* status, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        InverseResult r = EvapSolver::detail::inverse<A>(vpd[i], nozzle[i], known[i], target[i]);
+        out[i] = r.value;
+        status[i] = r.status;
+    }
+}
+
+// Status from the lane bits of the below/above masks (never both set)
+inline void storeInverseStatus(InverseStatus* status, unsigned below, unsigned above, int lanes) {
+    for (int l = 0; l < lanes; ++l) {
+        status[l] = static_cast<InverseStatus>(((below >> l) & 1u) | (((above >> l) & 1u) << 1));
+    }
+}
+
+#if defined(EVAP_SOLVER_SIMD_X86)
+
+template <EvapSolver::detail::InverseAxis A>
+__attribute__((target("avx2"))) inline void avx2InverseBatch(const double* vpd, const int* nozzle,
+                                                              const double* known, const double* target,
+                                                              double* out, InverseStatus* status, std::size_t n) {
+    using namespace EvapSolver::detail;
+    constexpr bool wind = A == InverseAxis::Wind;
+
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d t = _mm256_loadu_pd(target + i);
+        __m256d vn = _mm256_cvtepi32_pd(_mm_loadu_si128(reinterpret_cast<const __m128i*>(nozzle + i)));
+        __m256d yA = lerp2Avx2(x4, x3, lerpAvx2(S3, _mm256_loadu_pd(vpd + i)), x5, lerpAvx2(S5, vn));
+        __m256d yL = lerpAvx2(S6, t);
+        __m256d yB = lerp2Avx2(x8, x4, yA, x6, yL);
+
+        __m256d y, value, lower, upper, lo, hi;
+        if constexpr (wind) {
+            y = lerp2Avx2(x9, x7, lerpAvx2(S7, _mm256_loadu_pd(known + i)), x8, yB);
+            value = lerpAvx2(S9_inv, y);
+            lower = _mm256_set1_pd(S9_inv.y[0]), upper = _mm256_set1_pd(S9_inv.y[14]);
+            lo = _mm256_set1_pd(S9_inv.x[0]), hi = _mm256_set1_pd(S9_inv.x[14]);
+        } else {
+            y = lerp2Avx2(x7, x9, lerpAvx2(S9, _mm256_loadu_pd(known + i)), x8, yB);
+            value = lerpAvx2(S7_inv, y);
+            lower = _mm256_set1_pd(S7_inv.y[0]), upper = _mm256_set1_pd(S7_inv.y[10]);
+            lo = _mm256_set1_pd(S7_inv.x[0]), hi = _mm256_set1_pd(S7_inv.x[10]);
+        }
+
+        // Same priority as the scalar path: target checks first, then the ordinate range
+        __m256d tHigh = _mm256_cmp_pd(t, _mm256_set1_pd(maxLoss), _CMP_GE_OQ);
+        __m256d tValid = _mm256_cmp_pd(t, _mm256_setzero_pd(), _CMP_GE_OQ);
+        __m256d above = _mm256_or_pd(tHigh, _mm256_and_pd(tValid, _mm256_cmp_pd(y, hi, _CMP_GT_OQ)));
+        __m256d below = _mm256_or_pd(_mm256_cmp_pd(t, _mm256_setzero_pd(), _CMP_NGE_UQ),
+                                     _mm256_andnot_pd(tHigh, _mm256_cmp_pd(y, lo, _CMP_LT_OQ)));
+        value = _mm256_blendv_pd(value, upper, above);
+        value = _mm256_blendv_pd(value, lower, below);
+
+        _mm256_storeu_pd(out + i, value);
+        storeInverseStatus(status + i, static_cast<unsigned>(_mm256_movemask_pd(below)),
+                           static_cast<unsigned>(_mm256_movemask_pd(above)), 4);
+    }
+    scalarInverseBatch<A>(vpd + i, nozzle + i, known + i, target + i, out + i, status + i, n - i);
+}
+
+// See evap_solver_simd.h for why this warning is silenced around AVX-512 code
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+template <EvapSolver::detail::InverseAxis A>
+__attribute__((target("avx512f"))) inline void avx512InverseBatch(const double* vpd, const int* nozzle,
+                                                                  const double* known, const double* target,
+                                                                  double* out, InverseStatus* status,
+                                                                  std::size_t n) {
+    using namespace EvapSolver::detail;
+    constexpr bool wind = A == InverseAxis::Wind;
+
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m512d t = _mm512_loadu_pd(target + i);
+        __m512d vn = _mm512_cvtepi32_pd(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(nozzle + i)));
+        __m512d yA = lerp2Avx512(x4, x3, lerpAvx512(S3, _mm512_loadu_pd(vpd + i)), x5, lerpAvx512(S5, vn));
+        __m512d yL = lerpAvx512(S6, t);
+        __m512d yB = lerp2Avx512(x8, x4, yA, x6, yL);
+
+        __m512d y, value;
+        double lower, upper, lo, hi;
+        if constexpr (wind) {
+            y = lerp2Avx512(x9, x7, lerpAvx512(S7, _mm512_loadu_pd(known + i)), x8, yB);
+            value = lerpAvx512(S9_inv, y);
+            lower = S9_inv.y[0], upper = S9_inv.y[14], lo = S9_inv.x[0], hi = S9_inv.x[14];
+        } else {
+            y = lerp2Avx512(x7, x9, lerpAvx512(S9, _mm512_loadu_pd(known + i)), x8, yB);
+            value = lerpAvx512(S7_inv, y);
+            lower = S7_inv.y[0], upper = S7_inv.y[10], lo = S7_inv.x[0], hi = S7_inv.x[10];
+        }
+
+        __mmask8 tHigh = _mm512_cmp_pd_mask(t, _mm512_set1_pd(maxLoss), _CMP_GE_OQ);
+        __mmask8 tValid = _mm512_cmp_pd_mask(t, _mm512_setzero_pd(), _CMP_GE_OQ);
+        __mmask8 above = static_cast<__mmask8>(tHigh | (tValid & _mm512_cmp_pd_mask(y, _mm512_set1_pd(hi), _CMP_GT_OQ)));
+        __mmask8 below = static_cast<__mmask8>(~tValid | (~tHigh & _mm512_cmp_pd_mask(y, _mm512_set1_pd(lo), _CMP_LT_OQ)));
+        value = _mm512_mask_mov_pd(value, above, _mm512_set1_pd(upper));
+        value = _mm512_mask_mov_pd(value, below, _mm512_set1_pd(lower));
+
+        _mm512_storeu_pd(out + i, value);
+        storeInverseStatus(status + i, below, above, 8);
+    }
+    scalarInverseBatch<A>(vpd + i, nozzle + i, known + i, target + i, out + i, status + i, n - i);
+}
+
+#pragma GCC diagnostic pop
+
+#elif defined(EVAP_SOLVER_SIMD_NEON)
+
+template <EvapSolver::detail::InverseAxis A>
+inline void neonInverseBatch(const double* vpd, const int* nozzle, const double* known, const double* target,
+                             double* out, InverseStatus* status, std::size_t n) {
+    using namespace EvapSolver::detail;
+    constexpr bool wind = A == InverseAxis::Wind;
+
+    std::size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        float64x2_t t = vld1q_f64(target + i);
+        float64x2_t vn = vcvtq_f64_s64(vmovl_s32(vld1_s32(nozzle + i)));
+        float64x2_t yA = lerp2Neon(x4, x3, lerpNeon(S3, vld1q_f64(vpd + i)), x5, lerpNeon(S5, vn));
+        float64x2_t yB = lerp2Neon(x8, x4, yA, x6, lerpNeon(S6, t));
+
+        float64x2_t y, value;
+        double lower, upper, lo, hi;
+        if constexpr (wind) {
+            y = lerp2Neon(x9, x7, lerpNeon(S7, vld1q_f64(known + i)), x8, yB);
+            value = lerpNeon(S9_inv, y);
+            lower = S9_inv.y[0], upper = S9_inv.y[14], lo = S9_inv.x[0], hi = S9_inv.x[14];
+        } else {
+            y = lerp2Neon(x7, x9, lerpNeon(S9, vld1q_f64(known + i)), x8, yB);
+            value = lerpNeon(S7_inv, y);
+            lower = S7_inv.y[0], upper = S7_inv.y[10], lo = S7_inv.x[0], hi = S7_inv.x[10];
+        }
+
+        // tValid is false for NaN targets, so vmvnq of it marks them below range
+        uint64x2_t tHigh = vcgeq_f64(t, vdupq_n_f64(maxLoss));
+        uint64x2_t tValid = vcgeq_f64(t, vdupq_n_f64(0.0));
+        uint64x2_t above = vorrq_u64(tHigh, vandq_u64(tValid, vcgtq_f64(y, vdupq_n_f64(hi))));
+        uint64x2_t below = vorrq_u64(veorq_u64(tValid, vdupq_n_u64(~0ull)),
+                                     vbicq_u64(vcltq_f64(y, vdupq_n_f64(lo)), tHigh));
+        value = vbslq_f64(above, vdupq_n_f64(upper), value);
+        value = vbslq_f64(below, vdupq_n_f64(lower), value);
+
+        vst1q_f64(out + i, value);
+        unsigned belowBits = static_cast<unsigned>((vgetq_lane_u64(below, 0) & 1) | ((vgetq_lane_u64(below, 1) & 1) << 1));
+        unsigned aboveBits = static_cast<unsigned>((vgetq_lane_u64(above, 0) & 1) | ((vgetq_lane_u64(above, 1) & 1) << 1));
+        storeInverseStatus(status + i, belowBits, aboveBits, 2);
+    }
+    scalarInverseBatch<A>(vpd + i, nozzle + i, known + i, target + i, out + i, status + i, n - i);
+}
+
+#endif
+
+template <EvapSolver::detail::InverseAxis A>
+inline void inverseBatch(Kernel k, const double* vpd, const int* nozzle, const double* known, const double* target,
+                         double* out, InverseStatus* status, std::size_t n) {
+    if (!isSupported(k)) k = Kernel::Scalar;
+    switch (k) {
+#if defined(EVAP_SOLVER_SIMD_X86)
+        case Kernel::AVX512: avx512InverseBatch<A>(vpd, nozzle, known, target, out, status, n); return;
+        case Kernel::AVX2: avx2InverseBatch<A>(vpd, nozzle, known, target, out, status, n); return;
+#elif defined(EVAP_SOLVER_SIMD_NEON)
+        case Kernel::NEON: neonInverseBatch<A>(vpd, nozzle, known, target, out, status, n); return;
+#endif
+        default: scalarInverseBatch<A>(vpd, nozzle, known, target, out, status, n); return;
+    }
+}
+
+} // namespace detail
+
+// Inverse batches with an explicit kernel; fall back to scalar if k is not
+// supported on this CPU. Every kernel gives bit-identical results.
+inline void maxWindBatch(Kernel k, const double* vpd, const int* nozzle, const double* pressure,
+                         const double* targetLoss, double* out, InverseStatus* status, std::size_t n) {
+    detail::inverseBatch<EvapSolver::detail::InverseAxis::Wind>(k, vpd, nozzle, pressure, targetLoss, out, status, n);
+}
+
+inline void maxPressureBatch(Kernel k, const double* vpd, const int* nozzle, const double* wind,
+                             const double* targetLoss, double* out, InverseStatus* status, std::size_t n) {
+    detail::inverseBatch<EvapSolver::detail::InverseAxis::Pressure>(k, vpd, nozzle, wind, targetLoss, out, status,
+                                                                    n);
+}
+
+} // namespace Simd
+
+// Inverse nomograph queries (stateless, safe to call from any thread)
+class InverseSolver {
+public:
+    // Largest wind (mph) with loss <= targetLoss (%) at the given vpd, nozzle and pressure
+    static InverseResult maxWind(double vpd, int nozzle, double pressure, double targetLoss) {
+        return detail::inverse<detail::InverseAxis::Wind>(vpd, nozzle, pressure, targetLoss);
+    }
+
+    // Largest pressure (psi) with loss <= targetLoss (%) at the given vpd, nozzle and wind
+    static InverseResult maxPressure(double vpd, int nozzle, double wind, double targetLoss) {
+        return detail::inverse<detail::InverseAxis::Pressure>(vpd, nozzle, wind, targetLoss);
+    }
+
+    // n queries with the fastest supported SIMD kernel; out[i] and status[i]
+    // are bit-identical to maxWind()
+    static void maxWindBatch(const double* vpd, const int* nozzle, const double* pressure, const double* targetLoss,
+                             double* out, InverseStatus* status, std::size_t n) {
+        Simd::maxWindBatch(Simd::activeKernel(), vpd, nozzle, pressure, targetLoss, out, status, n);
+    }
+
+    // Same for maxPressure()
+    static void maxPressureBatch(const double* vpd, const int* nozzle, const double* wind, const double* targetLoss,
+                                 double* out, InverseStatus* status, std::size_t n) {
+        Simd::maxPressureBatch(Simd::activeKernel(), vpd, nozzle, wind, targetLoss, out, status, n);
+    }
+};
+
+} // namespace EvapSolver
+
+#endif // EVAP_SOLVER_INVERSE_H
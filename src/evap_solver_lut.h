@@ -0,0 +1,215 @@
+#ifndef EVAP_SOLVER_LUT_H
+#define EVAP_SOLVER_LUT_H
+
+// Quantized (vpd, wind) lookup table for one sprinkler profile.
+//
+// With nozzle and pressure fixed, the loss is a surface over vpd in
+// [0, 1] psi and wind in [0, 15] mph (the S3 and S9 tick ranges, which a
+// LUT built from NomographTables takes from those tables). ProfileLut samples that surface on a
+// regular grid once and stores it as floats:
+//   Nearest   one load per evaluation; exact (up to float rounding) for
+//             inputs quantized to the grid, e.g. sensor readings
+//   Bilinear  four loads from two adjacent rows, for off-grid inputs
+// The default 0.001 psi x 0.1 mph grid has 1001 x 151 entries (590 KiB);
+// coarser grids with bilinear lookup fit in a few KiB.
+//
+// Error bound against Calculator::calculate(), returned by errorBound():
+//   on-grid inputs  float rounding of the stored loss, <= 2^-24 * 40
+//   any inputs      (Lv * hv + Lw * hw) / 2 plus the rounding term, where
+//                   hv, hw are the grid steps and Lv, Lw the largest slopes
+//                   of the loss in vpd and wind reachable by this profile
+// Inputs outside the domain clamp to its edges, as the tables do; NaN
+// inputs also map to the lower edge instead of propagating.
+//
+// Usage:
+//   EvapSolver::ProfileLut lut(EvapSolver::SprinklerProfile(12, 40));
+//   double loss = lut.evaluate(0.612, 4.3);
+//   EvapSolver::ProfileLut calibrated(tables, 12, 40);      // runtime NomographTables
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+#include "evap_solver_compact.h"
+#include "evap_solver_separable.h"
+#include "evap_solver_profile.h"
+
+namespace EvapSolver {
+
+enum class LutInterpolation { Nearest, Bilinear };
+
+struct LutOptions {
+    double vpdStep = 0.001; // Grid step in psi (rounded down to divide the S3 span, 1.0, evenly)
+    double windStep = 0.1;  // Grid step in mph (rounded down to divide the S9 span, 15.0, evenly)
+    LutInterpolation interpolation = LutInterpolation::Nearest;
+};
+
+namespace detail {
+
+// Largest |dy/dx| over the segments of s
+template <std::size_t N>
+double maxSlope(const Scale<N>& s) {
+    double m = 0.0;
+    for (std::size_t i = 1; i < N; ++i) m = std::fmax(m, std::fabs((s.y[i] - s.y[i - 1]) / (s.x[i] - s.x[i - 1])));
+    return m;
+}
+
+// Largest slope of S6^-1 over the segments that intersect [lo, hi]
+inline double maxS6Slope(const Scale<14>& s6, double lo, double hi) {
+    double m = 0.0;
+    for (std::size_t i = 1; i < 14; ++i) {
+        if (s6.x[i] < lo || s6.x[i - 1] > hi) continue;
+        m = std::fmax(m, std::fabs((s6.y[i] - s6.y[i - 1]) / (s6.x[i] - s6.x[i - 1])));
+    }
+    return m;
+}
+
+// Sampling grid of one LUT; the table is row-major, table[vpdIndex * nw + windIndex]
+struct LutGrid {
+    LutInterpolation mode;
+    double vpd0, wind0; // Domain: the S3 and S9 tick ranges
+    double vpdSpan, windSpan;
+    std::size_t nv, nw;
+    double vpdScale, windScale; // Grid points per unit
+};
+
+// NaN fails both comparisons and lands on 0
+inline double lutClamp(double x, double hi) {
+    return x > 0 ? (x < hi ? x : hi) : 0.0;
+}
+
+// Evaporation loss (%) looked up in table sampled on grid g
+inline double lutEvaluate(const LutGrid& g, const float* table, double vpd, double wind) {
+    double u = lutClamp(vpd - g.vpd0, g.vpdSpan) * g.vpdScale;
+    double v = lutClamp(wind - g.wind0, g.windSpan) * g.windScale;
+    if (g.mode == LutInterpolation::Nearest) {
+        return table[static_cast<std::size_t>(u + 0.5) * g.nw + static_cast<std::size_t>(v + 0.5)];
+    }
+
+    // Bilinear; the last row/column uses the cell before it
+    std::size_t nw = g.nw;
+    std::size_t i = static_cast<std::size_t>(u), j = static_cast<std::size_t>(v);
+    i -= (i == g.nv - 1);
+    j -= (j == nw - 1);
+    double fu = u - i, fv = v - j;
+    const float* row = &table[i * nw + j];
+    double a = row[0] + (row[1] - row[0]) * fv;
+    double b = row[nw] + (row[nw + 1] - row[nw]) * fv;
+    return a + (b - a) * fu;
+}
+
+} // namespace detail
+
+class ProfileLut {
+public:
+    explicit ProfileLut(const SprinklerProfile& profile, const LutOptions& options = LutOptions())
+        : ProfileLut(detail::Tables<double>{}, profile, options) {}
+
+    ProfileLut(int nozzle, double pressure, const LutOptions& options = LutOptions())
+        : ProfileLut(SprinklerProfile(nozzle, pressure), options) {}
+
+    // Sampled on runtime tables; profile must have been built from them
+    ProfileLut(const NomographTables& tables, const SprinklerProfile& profile,
+               const LutOptions& options = LutOptions())
+        : ProfileLut(tables.tables(), profile, options) {}
+
+    ProfileLut(const NomographTables& tables, int nozzle, double pressure,
+               const LutOptions& options = LutOptions())
+        : ProfileLut(tables, SprinklerProfile(tables, nozzle, pressure), options) {}
+
+    // Evaporation loss (%) for one weather record
+    double evaluate(double vpd, double wind) const { return detail::lutEvaluate(g, table.data(), vpd, wind); }
+
+    // Weather time series for this sprinkler
+    void evaluateBatch(const double* vpd, const double* wind, double* out, std::size_t n) const {
+        for (std::size_t k = 0; k < n; ++k) out[k] = evaluate(vpd[k], wind[k]);
+    }
+
+    // Maximum |evaluate() - Calculator::calculate()| in percentage points
+    // (NomographTables::calculate() for a table-built LUT); see the header
+    // comment for onGrid
+    double errorBound(bool onGrid = false) const { return onGrid ? rounding : bound; }
+
+    std::size_t vpdPoints() const { return g.nv; }
+    std::size_t windPoints() const { return g.nw; }
+    std::size_t bytes() const { return table.size() * sizeof(float); }
+
+    // Grid a LUT with these options samples on the built-in or runtime tables
+    static detail::LutGrid gridFor(const LutOptions& options = LutOptions()) {
+        return makeGrid(detail::Tables<double>{}, options);
+    }
+
+    static detail::LutGrid gridFor(const NomographTables& tables, const LutOptions& options = LutOptions()) {
+        return makeGrid(tables.tables(), options);
+    }
+
+    // Sampling grid and the raw samples, e.g. for writing a LUT file
+    const detail::LutGrid& grid() const { return g; }
+    const float* data() const { return table.data(); }
+
+private:
+    template <class Tab>
+    ProfileLut(const Tab& t, const SprinklerProfile& profile, const LutOptions& options)
+        : g(makeGrid(t, options)), table(g.nv * g.nw) {
+        for (std::size_t i = 0; i < g.nv; ++i) {
+            double vpd = g.vpd0 + g.vpdSpan * i / (g.nv - 1);
+            for (std::size_t j = 0; j < g.nw; ++j) {
+                double wind = g.wind0 + g.windSpan * j / (g.nw - 1);
+                table[i * g.nw + j] = static_cast<float>(profile.evaluateOn(t, vpd, wind));
+            }
+        }
+        rounding = roundingBound(t);
+        bound = computeBound(t, profile);
+    }
+
+    // Half an ulp of the largest loss (40%) stored as float, plus the
+    // 1e-12 regrouping error of the separable identity used for the slopes
+    template <class Tab>
+    static double roundingBound(const Tab& t) {
+        return std::fmax(std::fabs(t.S6_flip.y[0]), std::fabs(t.S6_flip.y[13])) / (1 << 24) + 1e-12;
+    }
+
+    static std::size_t cells(double span, double step) {
+        double c = step > 0 ? std::ceil(span / step - 1e-9) : 1.0;
+        return c < 1 ? 1 : static_cast<std::size_t>(c);
+    }
+
+    template <class Tab>
+    static detail::LutGrid makeGrid(const Tab& t, const LutOptions& options) {
+        detail::LutGrid grid;
+        grid.mode = options.interpolation;
+        grid.vpd0 = t.S3.x[0];
+        grid.wind0 = t.S9.x[0];
+        grid.vpdSpan = t.S3.x[10] - grid.vpd0;
+        grid.windSpan = t.S9.x[14] - grid.wind0;
+        grid.nv = cells(grid.vpdSpan, options.vpdStep) + 1;
+        grid.nw = cells(grid.windSpan, options.windStep) + 1;
+        grid.vpdScale = (grid.nv - 1) / grid.vpdSpan;
+        grid.windScale = (grid.nw - 1) / grid.windSpan;
+        return grid;
+    }
+
+    // loss = S6^-1(base + w3 y3(vpd) + w9 y9(wind)), so its slopes are
+    // bounded by products of the per-axis slopes over the reachable yL range
+    template <class Tab>
+    double computeBound(const Tab& t, const SprinklerProfile& profile) const {
+        using namespace detail;
+        // The scales are monotone, so their ends bound the ordinates
+        double lo = profile.separableBase + w3 * std::fmin(t.S3.y[0], t.S3.y[10]) +
+                    w9 * std::fmin(t.S9.y[0], t.S9.y[14]);
+        double hi = profile.separableBase + w3 * std::fmax(t.S3.y[0], t.S3.y[10]) +
+                    w9 * std::fmax(t.S9.y[0], t.S9.y[14]);
+        double s6 = maxS6Slope(t.S6_flip, lo, hi);
+        double lv = s6 * w3 * maxSlope(t.S3);
+        double lw = s6 * w9 * maxSlope(t.S9);
+        return (lv / g.vpdScale + lw / g.windScale) / 2 + rounding;
+    }
+
+    detail::LutGrid g;
+    std::vector<float> table; // Row-major: table[vpdIndex * nw + windIndex]
+    double rounding = 0.0;
+    double bound = 0.0;
+};
+
+} // namespace EvapSolver
+
+#endif // EVAP_SOLVER_LUT_H
@@ -0,0 +1,402 @@
+#ifndef EVAP_SOLVER_LUT_FILE_H
+#define EVAP_SOLVER_LUT_FILE_H
+
+// Precomputed profile LUTs in a versioned, checksummed file that is mapped
+// read-only (POSIX).
+//
+// writeLutFile() samples one ProfileLut per (nozzle, pressure) and stores
+// them on a shared grid; LutFile maps the result with MAP_SHARED, so opening
+// costs a header check instead of millions of evaluations, and every process
+// mapping the same file shares one copy in the page cache. A LutView
+// evaluates one stored profile with the same arithmetic as ProfileLut and
+// returns bit-identical results and error bounds.
+//
+// File layout (little-endian, every section 64-byte aligned). The float
+// tables are mapped in place, so writeLutFile() and LutFile throw on a
+// big-endian host:
+//   0    char[8] "EVAPLUT\0", u32 version (1), u32 interpolation (0 nearest, 1 bilinear)
+//   16   u64 file bytes, u64 profile count, u64 vpd points, u64 wind points
+//   48   f64 vpd0, vpd span, wind0, wind span
+//   80   u64 directory offset, data offset, table stride (bytes per profile)
+//   104  u64 checksum of the nomograph tables the LUTs were sampled from, u64 reserved
+//   120  u64 checksum of the rest of the file (bytes 0-119 and 128-end)
+//   128  directory: per profile i32 nozzle, u32 reserved, f64 pressure, f64 error bound, f64 rounding bound
+//   data profile k's float table at data offset + k * table stride
+//
+// writeLutFile() writes to a temporary file and renames it over the target,
+// so processes that still map the old file keep reading the old data.
+//
+// Usage:
+//   EvapSolver::writeLutFile("fleet.lut", tables, {{12, 40}, {16, 50}});   // or the evap_lut_gen tool
+//   EvapSolver::LutFile file("fleet.lut");
+//   double loss = file.profile(file.find(12, 40)).evaluate(0.612, 4.3);
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "evap_solver_endian.h"
+#include "evap_solver_lut.h"
+#include "evap_solver_tables.h"
+
+namespace EvapSolver {
+
+// Hardware of one stored profile
+struct LutProfileKey {
+    int nozzle;
+    double pressure;
+};
+
+namespace detail {
+
+inline constexpr char lutFileMagic[8] = {'E', 'V', 'A', 'P', 'L', 'U', 'T', '\0'};
+inline constexpr std::uint32_t lutFileVersion = 1;
+inline constexpr std::size_t lutHeaderSize = 128, lutChecksumOffset = 120, lutEntrySize = 32;
+
+inline std::uint64_t rotl64(std::uint64_t x, int r) {
+    return (x << r) | (x >> (64 - r));
+}
+
+// 64-bit checksum over whole words (n must be a multiple of 8): four
+// independent multiply-rotate lanes, mixed at the end, so verification runs
+// at memory speed. Detects corruption; not a cryptographic hash.
+inline std::uint64_t lutChecksum(const unsigned char* p, std::size_t n, std::uint64_t seed = 0) {
+    const std::uint64_t p1 = 0x9E3779B185EBCA87ull, p2 = 0xC2B2AE3D27D4EB4Full;
+    std::uint64_t h[4] = {seed + p1 + p2, seed + p2, seed, seed - p1};
+    auto round = [&](std::uint64_t acc, std::uint64_t word) { return rotl64(acc + word * p2, 31) * p1; };
+
+    std::size_t words = n / 8, i = 0;
+    for (; i + 4 <= words; i += 4) {
+        for (int lane = 0; lane < 4; ++lane) {
+            h[lane] = round(h[lane], loadLE64(reinterpret_cast<const char*>(p + 8 * (i + lane))));
+        }
+    }
+    for (; i < words; ++i) {
+        h[0] = round(h[0], loadLE64(reinterpret_cast<const char*>(p + 8 * i)));
+    }
+
+    std::uint64_t r = rotl64(h[0], 1) + rotl64(h[1], 7) + rotl64(h[2], 12) + rotl64(h[3], 18) + n;
+    r ^= r >> 33;
+    r *= p2;
+    r ^= r >> 29;
+    r *= 0x165667B19E3779F9ull;
+    return r ^ (r >> 32);
+}
+
+// Checksum of a LUT file image: everything but the checksum field
+inline std::uint64_t lutFileChecksum(const unsigned char* file, std::size_t bytes) {
+    std::uint64_t h = lutChecksum(file, lutChecksumOffset);
+    return lutChecksum(file + lutHeaderSize, bytes - lutHeaderSize, h);
+}
+
+inline std::size_t alignTo64(std::size_t n) {
+    return (n + 63) & ~std::size_t(63);
+}
+
+// Header and directory fields: 32- and 64-bit integers and doubles, stored
+// little-endian
+template <class T>
+void putField(std::vector<unsigned char>& image, std::size_t offset, T value) {
+    static_assert(sizeof(T) == 4 || sizeof(T) == 8, "LUT file fields are 4 or 8 bytes");
+    char* p = reinterpret_cast<char*>(image.data() + offset);
+    if constexpr (sizeof(T) == 4) {
+        std::uint32_t bits;
+        std::memcpy(&bits, &value, 4);
+        storeLE32(p, bits);
+    } else {
+        std::uint64_t bits;
+        std::memcpy(&bits, &value, 8);
+        storeLE64(p, bits);
+    }
+}
+
+template <class T>
+T getField(const unsigned char* image, std::size_t offset) {
+    static_assert(sizeof(T) == 4 || sizeof(T) == 8, "LUT file fields are 4 or 8 bytes");
+    const char* p = reinterpret_cast<const char*>(image + offset);
+    T value;
+    if constexpr (sizeof(T) == 4) {
+        std::uint32_t bits = loadLE32(p);
+        std::memcpy(&value, &bits, 4);
+    } else {
+        std::uint64_t bits = loadLE64(p);
+        std::memcpy(&value, &bits, 8);
+    }
+    return value;
+}
+
+inline void requireLittleEndianHost() {
+    if (!hostIsLittleEndian()) throw std::runtime_error("LUT files are mapped in place and need a little-endian host");
+}
+
+} // namespace detail
+
+// Checksum identifying a table set, as stored in LUT files built from it
+inline std::uint64_t tablesChecksum(const NomographTables& tables) {
+    std::ostringstream out;
+    tables.writeBinary(out);
+    std::string bytes = out.str();
+    bytes.resize(detail::alignTo64(bytes.size()), '\0');
+    return detail::lutChecksum(reinterpret_cast<const unsigned char*>(bytes.data()), bytes.size());
+}
+
+// One profile of a mapped LUT file; valid while the mapping is open (moving
+// the LutFile keeps it)
+class LutView {
+public:
+    // Evaporation loss (%) for one weather record, bit-identical to the ProfileLut it was written from
+    double evaluate(double vpd, double wind) const { return detail::lutEvaluate(g, table, vpd, wind); }
+
+    void evaluateBatch(const double* vpd, const double* wind, double* out, std::size_t n) const {
+        for (std::size_t k = 0; k < n; ++k) out[k] = evaluate(vpd[k], wind[k]);
+    }
+
+    // As ProfileLut::errorBound()
+    double errorBound(bool onGrid = false) const { return onGrid ? rounding : bound; }
+
+    int nozzle() const { return key.nozzle; }
+    double pressure() const { return key.pressure; }
+
+private:
+    friend class LutFile;
+    LutView(const detail::LutGrid& grid, const float* data, LutProfileKey k, double b, double r)
+        : g(grid), table(data), key(k), bound(b), rounding(r) {}
+
+    detail::LutGrid g;
+    const float* table;
+    LutProfileKey key;
+    double bound, rounding;
+};
+
+// Read-only mapping of a LUT file. Throws std::runtime_error if the file
+// cannot be mapped or fails the format, size or checksum checks.
+class LutFile {
+public:
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    // verify = false skips the checksum, which reads every page of the file,
+    // and maps lazily; the header and layout are still checked
+    explicit LutFile(const std::string& path, bool verify = true) {
+        detail::requireLittleEndianHost();
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw std::runtime_error("cannot open " + path + ": " + std::strerror(errno));
+        struct stat st;
+        if (::fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(detail::lutHeaderSize)) {
+            ::close(fd);
+            throw std::runtime_error(path + ": not a LUT file");
+        }
+        size = static_cast<std::size_t>(st.st_size);
+        void* p = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        int err = errno;
+        ::close(fd);
+        if (p == MAP_FAILED) throw std::runtime_error("cannot map " + path + ": " + std::strerror(err));
+        base = static_cast<const unsigned char*>(p);
+        try {
+            parse(path, verify);
+        } catch (...) {
+            ::munmap(const_cast<unsigned char*>(base), size);
+            throw;
+        }
+    }
+
+    LutFile(const LutFile&) = delete;
+    LutFile& operator=(const LutFile&) = delete;
+
+    LutFile(LutFile&& other) noexcept { *this = std::move(other); }
+
+    LutFile& operator=(LutFile&& other) noexcept {
+        if (this != &other) {
+            unmap();
+            base = other.base;
+            size = other.size;
+            g = other.g;
+            count = other.count;
+            stride = other.stride;
+            dataOffset = other.dataOffset;
+            tables = other.tables;
+            other.base = nullptr;
+            other.size = 0;
+        }
+        return *this;
+    }
+
+    ~LutFile() { unmap(); }
+
+    std::size_t profileCount() const { return count; }
+
+    // Profile k < profileCount(), in the order given to writeLutFile()
+    LutView profile(std::size_t k) const {
+        const unsigned char* e = base + detail::lutHeaderSize + k * detail::lutEntrySize;
+        LutProfileKey key{detail::getField<std::int32_t>(e, 0), detail::getField<double>(e, 8)};
+        const float* data = reinterpret_cast<const float*>(base + dataOffset + k * stride);
+        return LutView(g, data, key, detail::getField<double>(e, 16), detail::getField<double>(e, 24));
+    }
+
+    // Index of the profile with exactly this nozzle and pressure, or npos
+    std::size_t find(int nozzle, double pressure) const {
+        for (std::size_t k = 0; k < count; ++k) {
+            const unsigned char* e = base + detail::lutHeaderSize + k * detail::lutEntrySize;
+            if (detail::getField<std::int32_t>(e, 0) == nozzle && detail::getField<double>(e, 8) == pressure) {
+                return k;
+            }
+        }
+        return npos;
+    }
+
+    const detail::LutGrid& grid() const { return g; }
+    std::size_t vpdPoints() const { return g.nv; }
+    std::size_t windPoints() const { return g.nw; }
+    std::size_t bytes() const { return size; }
+
+    // tablesChecksum() of the nomograph tables the file was generated from
+    std::uint64_t tablesChecksum() const { return tables; }
+
+private:
+    void unmap() {
+        if (base) ::munmap(const_cast<unsigned char*>(base), size);
+        base = nullptr;
+    }
+
+    void parse(const std::string& path, bool verify) {
+        using detail::getField;
+        auto fail = [&](const std::string& what) { throw std::runtime_error(path + ": " + what); };
+        if (std::memcmp(base, detail::lutFileMagic, 8) != 0) fail("not a LUT file");
+        std::uint32_t version = getField<std::uint32_t>(base, 8);
+        if (version != detail::lutFileVersion) fail("unsupported LUT file version " + std::to_string(version));
+        std::uint32_t mode = getField<std::uint32_t>(base, 12);
+        if (mode > 1) fail("unknown interpolation " + std::to_string(mode));
+        if (getField<std::uint64_t>(base, 16) != size) fail("truncated LUT file");
+
+        count = getField<std::uint64_t>(base, 24);
+        g.mode = mode == 0 ? LutInterpolation::Nearest : LutInterpolation::Bilinear;
+        g.nv = getField<std::uint64_t>(base, 32);
+        g.nw = getField<std::uint64_t>(base, 40);
+        g.vpd0 = getField<double>(base, 48);
+        g.vpdSpan = getField<double>(base, 56);
+        g.wind0 = getField<double>(base, 64);
+        g.windSpan = getField<double>(base, 72);
+        std::uint64_t directory = getField<std::uint64_t>(base, 80);
+        dataOffset = getField<std::uint64_t>(base, 88);
+        stride = getField<std::uint64_t>(base, 96);
+        tables = getField<std::uint64_t>(base, 104);
+
+        // Divisions instead of products, so a corrupt header cannot overflow the checks
+        std::size_t floats = stride / sizeof(float);
+        bool layoutOk = directory == detail::lutHeaderSize && count <= size / detail::lutEntrySize &&
+                        dataOffset % 64 == 0 && dataOffset >= directory + count * detail::lutEntrySize &&
+                        dataOffset <= size && stride % 64 == 0 && g.nv >= 2 && g.nw >= 2 &&
+                        g.nw <= floats && g.nv <= floats / g.nw && g.vpdSpan > 0 && g.windSpan > 0;
+        std::size_t payload = size - (dataOffset <= size ? dataOffset : size);
+        layoutOk = layoutOk && (count ? payload % count == 0 && payload / count == stride : payload == 0);
+        if (!layoutOk) fail("inconsistent LUT file layout");
+        g.vpdScale = (g.nv - 1) / g.vpdSpan;
+        g.windScale = (g.nw - 1) / g.windSpan;
+
+        if (verify && detail::lutFileChecksum(base, size) != getField<std::uint64_t>(base, detail::lutChecksumOffset)) {
+            fail("LUT file checksum mismatch");
+        }
+    }
+
+    const unsigned char* base = nullptr;
+    std::size_t size = 0;
+    detail::LutGrid g{};
+    std::size_t count = 0, stride = 0, dataOffset = 0;
+    std::uint64_t tables = 0;
+};
+
+namespace detail {
+
+inline void writeAt(int fd, const void* data, std::size_t n, std::size_t offset) {
+    const char* p = static_cast<const char*>(data);
+    for (std::size_t done = 0; done < n;) {
+        ssize_t w = ::pwrite(fd, p + done, n - done, static_cast<off_t>(offset + done));
+        if (w < 0 && errno == EINTR) continue;
+        if (w <= 0) throw std::runtime_error("write failed: " + std::string(std::strerror(errno)));
+        done += static_cast<std::size_t>(w);
+    }
+}
+
+} // namespace detail
+
+// Sample one ProfileLut per key on tables and write them to path. One LUT is
+// held in memory at a time; the checksum is computed from the written file.
+inline void writeLutFile(const std::string& path, const NomographTables& tables,
+                         const std::vector<LutProfileKey>& profiles, const LutOptions& options = LutOptions()) {
+    using detail::putField;
+    detail::requireLittleEndianHost();
+    const detail::LutGrid g = ProfileLut::gridFor(tables, options);
+    const std::size_t tableBytes = g.nv * g.nw * sizeof(float);
+    const std::size_t stride = detail::alignTo64(tableBytes);
+    const std::size_t dataOffset = detail::alignTo64(detail::lutHeaderSize + profiles.size() * detail::lutEntrySize);
+    const std::size_t bytes = dataOffset + profiles.size() * stride;
+
+    // Header and directory
+    std::vector<unsigned char> head(dataOffset, 0);
+    std::memcpy(head.data(), detail::lutFileMagic, 8);
+    putField<std::uint32_t>(head, 8, detail::lutFileVersion);
+    putField<std::uint32_t>(head, 12, g.mode == LutInterpolation::Nearest ? 0 : 1);
+    putField<std::uint64_t>(head, 16, bytes);
+    putField<std::uint64_t>(head, 24, profiles.size());
+    putField<std::uint64_t>(head, 32, g.nv);
+    putField<std::uint64_t>(head, 40, g.nw);
+    putField<double>(head, 48, g.vpd0);
+    putField<double>(head, 56, g.vpdSpan);
+    putField<double>(head, 64, g.wind0);
+    putField<double>(head, 72, g.windSpan);
+    putField<std::uint64_t>(head, 80, detail::lutHeaderSize);
+    putField<std::uint64_t>(head, 88, dataOffset);
+    putField<std::uint64_t>(head, 96, stride);
+    putField<std::uint64_t>(head, 104, tablesChecksum(tables));
+
+    std::string temporary = path + ".tmp" + std::to_string(::getpid());
+    int fd = ::open(temporary.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) throw std::runtime_error("cannot open " + temporary + ": " + std::strerror(errno));
+    try {
+        if (::ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+            throw std::runtime_error("cannot size " + temporary + ": " + std::strerror(errno));
+        }
+        for (std::size_t k = 0; k < profiles.size(); ++k) {
+            ProfileLut lut(tables, profiles[k].nozzle, profiles[k].pressure, options);
+            std::size_t e = detail::lutHeaderSize + k * detail::lutEntrySize;
+            putField<std::int32_t>(head, e, profiles[k].nozzle);
+            putField<double>(head, e + 8, profiles[k].pressure);
+            putField<double>(head, e + 16, lut.errorBound());
+            putField<double>(head, e + 24, lut.errorBound(true));
+            detail::writeAt(fd, lut.data(), tableBytes, dataOffset + k * stride);
+        }
+        detail::writeAt(fd, head.data(), head.size(), 0);
+
+        void* p = ::mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+        if (p == MAP_FAILED) throw std::runtime_error("cannot map " + temporary + ": " + std::strerror(errno));
+        std::uint64_t checksum = detail::lutFileChecksum(static_cast<const unsigned char*>(p), bytes);
+        ::munmap(p, bytes);
+        char stored[8];
+        detail::storeLE64(stored, checksum);
+        detail::writeAt(fd, stored, sizeof(stored), detail::lutChecksumOffset);
+    } catch (...) {
+        ::close(fd);
+        std::remove(temporary.c_str());
+        throw;
+    }
+    if (::close(fd) != 0 || std::rename(temporary.c_str(), path.c_str()) != 0) {
+        int err = errno;
+        std::remove(temporary.c_str());
+        throw std::runtime_error("cannot write " + path + ": " + std::strerror(err));
+    }
+}
+
+} // namespace EvapSolver
+
+#endif // EVAP_SOLVER_LUT_FILE_H
@@ -0,0 +1,170 @@
+#ifndef EVAP_SOLVER_MEMO_H
+#define EVAP_SOLVER_MEMO_H
+
+// Opt-in memoization in front of Calculator for heavily repeated records.
+//
+// MemoCache is a fixed-size, open-addressed table of two-slot buckets keyed
+// on the bit patterns of (vpd, nozzle, pressure, wind). A lookup hashes the
+// key and compares the two slots of one bucket; a miss evaluates the chain
+// and overwrites the bucket's older slot, so there are no chains, no
+// rehashing and no heap allocation after construction. Each thread owns its
+// cache (threadMemoCache() or a thread_local of your own), so nothing is
+// locked or shared.
+//
+// With a quantization step set, inputs are first rounded to the nearest
+// multiple of it, and the cached result is calculate() of the rounded
+// record; with the default steps of 0 results are bit-identical to
+// calculate(). Keys are bit patterns, so -0.0 and 0.0 are separate entries
+// and a NaN record only hits another NaN with the same payload.
+//
+// Usage:
+//   double loss = EvapSolver::MemoizedCalculator::calculate({0.6, 12, 40, 5});
+//   EvapSolver::MemoCache cache({1 << 16, 0.01, 1.0, 0.5});   // quantized
+//   double loss2 = cache.calculate({0.613, 12, 40.2, 5.1});
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "evap_solver_compact.h"
+
+namespace EvapSolver {
+
+struct MemoOptions {
+    std::size_t capacity = 4096; // Entries, rounded up to a power of two (at least 2)
+    double vpdStep = 0.0;        // Quantization steps; 0 keys on the exact input
+    double pressureStep = 0.0;
+    double windStep = 0.0;
+};
+
+struct MemoStats {
+    std::size_t hits = 0;
+    std::size_t misses = 0;
+};
+
+// Single-threaded cache; use one per thread
+class MemoCache {
+public:
+    explicit MemoCache(const MemoOptions& options = MemoOptions())
+        : vpdStep(options.vpdStep), pressureStep(options.pressureStep), windStep(options.windStep),
+          slots(roundCapacity(options.capacity)), mask(slots.size() - 1) {}
+
+    // Evaporation loss percentage, from the cache when the key was seen
+    double calculate(const Input& in) {
+        double vpd = quantize(in.vpd, vpdStep);
+        double pressure = quantize(in.pressure, pressureStep);
+        double wind = quantize(in.wind, windStep);
+        Key key{bits(vpd), bits(pressure), bits(wind), in.nozzle};
+
+        // Two-slot bucket: the most recently inserted entry is in slot 0
+        Slot* bucket = &slots[hash(key) & mask & ~std::size_t(1)];
+        if (bucket[0].used && bucket[0].key == key) {
+            ++counts.hits;
+            return bucket[0].value;
+        }
+        if (bucket[1].used && bucket[1].key == key) {
+            ++counts.hits;
+            return bucket[1].value;
+        }
+
+        ++counts.misses;
+        double value = detail::evaluate(vpd, in.nozzle, pressure, wind);
+        bucket[1] = bucket[0];
+        bucket[0] = Slot{key, value, true};
+        return value;
+    }
+
+    // Calculate evaporation loss for n records stored as parallel arrays
+    void calculateBatch(const double* vpd, const int* nozzle, const double* pressure, const double* wind,
+                        double* out, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) out[i] = calculate({vpd[i], nozzle[i], pressure[i], wind[i]});
+    }
+
+    // Drop every entry (keeps the storage and the counters)
+    void clear() {
+        for (Slot& s : slots) s.used = false;
+    }
+
+    const MemoStats& stats() const { return counts; }
+    void resetStats() { counts = MemoStats(); }
+    std::size_t capacity() const { return slots.size(); }
+
+private:
+    struct Key {
+        std::uint64_t vpd, pressure, wind;
+        std::int32_t nozzle;
+
+        bool operator==(const Key& o) const {
+            return vpd == o.vpd && pressure == o.pressure && wind == o.wind && nozzle == o.nozzle;
+        }
+    };
+
+    struct Slot {
+        Key key;
+        double value;
+        bool used;
+    };
+
+    static std::size_t roundCapacity(std::size_t n) {
+        std::size_t c = 2;
+        while (c < n) c <<= 1;
+        return c;
+    }
+
+    static double quantize(double x, double step) {
+        return step > 0 ? std::nearbyint(x / step) * step : x;
+    }
+
+    static std::uint64_t bits(double x) {
+        std::uint64_t b;
+        std::memcpy(&b, &x, sizeof(b));
+        return b;
+    }
+
+    // Multiply-xorshift mix of the key words
+    static std::uint64_t hash(const Key& k) {
+        std::uint64_t h = k.vpd * 0x9E3779B97F4A7C15ull;
+        h = (h ^ (h >> 29) ^ k.pressure) * 0xBF58476D1CE4E5B9ull;
+        h = (h ^ (h >> 32) ^ k.wind) * 0x94D049BB133111EBull;
+        h = (h ^ (h >> 29) ^ static_cast<std::uint32_t>(k.nozzle)) * 0x9E3779B97F4A7C15ull;
+        return h ^ (h >> 32);
+    }
+
+    double vpdStep, pressureStep, windStep;
+    std::vector<Slot> slots;
+    std::size_t mask;
+    MemoStats counts;
+};
+
+// This thread's default cache (MemoOptions()), created on first use
+inline MemoCache& threadMemoCache() {
+    thread_local MemoCache cache;
+    return cache;
+}
+
+// Calculator front end backed by the calling thread's cache
+class MemoizedCalculator {
+public:
+    // Calculate evaporation loss percentage; bit-identical to Calculator::calculate()
+    static double calculate(const Input& in) {
+        return threadMemoCache().calculate(in);
+    }
+
+    static void calculateBatch(const double* vpd, const int* nozzle, const double* pressure,
+                               const double* wind, double* out, std::size_t n) {
+        threadMemoCache().calculateBatch(vpd, nozzle, pressure, wind, out, n);
+    }
+
+    // Hit/miss counters of the calling thread's cache
+    static const MemoStats& stats() { return threadMemoCache().stats(); }
+};
+
+// Convenience function
+inline double calculateEvaporationLossMemoized(double vpd, int nozzle, double pressure, double wind) {
+    return MemoizedCalculator::calculate({vpd, nozzle, pressure, wind});
+}
+
+} // namespace EvapSolver
+
+#endif // EVAP_SOLVER_MEMO_H
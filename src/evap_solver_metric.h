@@ -0,0 +1,197 @@
+#ifndef EVAP_SOLVER_METRIC_H
+#define EVAP_SOLVER_METRIC_H
+
+// Metric input path: vpd and pressure in kPa, nozzle diameter in mm, wind in m/s.
+//
+// The unit conversion is folded into the tables: every abscissa of S3, S5,
+// S7 and S9 is divided by its conversion factor at compile time, so records
+// are interpolated in their own units with no conversion pass. The nozzle
+// stays a double, so a 4.0 mm nozzle is evaluated at 10.08/64" instead of
+// being rounded to 10/64". Ordinates and S6 are unchanged.
+//
+// The factors are the ones used by the Trimmer (1987) validation cases:
+//   psi = kPa * 0.145038,  64ths inch = mm / 25.4 * 64,  mph = m/s * 2.237
+// Results agree with converting first and interpolating the imperial tables
+// with a fractional nozzle to within 1e-12 percentage points (rounding of
+// the scaled abscissae); checked by tests/test_metric_solver.cpp.
+//
+// Usage:
+//   double loss = EvapSolver::MetricCalculator::calculate({4.14, 4.0, 276, 2.2});
+//   EvapSolver::MetricCalculator::calculateBatch(vpdKPa, nozzleMm, pressureKPa, windMs, out, n);
+
+#include <cstddef>
+#include "evap_solver_compact.h"
+#include "evap_solver_simd.h"
+
+namespace EvapSolver {
+
+// Metric input structure
+struct MetricInput {
+    double vpd;      // Vapor-Pressure Deficit (kPa)
+    double nozzle;   // Nozzle diameter (mm)
+    double pressure; // Pressure (kPa)
+    double wind;     // Wind velocity (m/s)
+};
+
+namespace detail {
+
+// Nomograph units per metric unit
+inline constexpr double psiPerKPa = 0.145038;
+inline constexpr double sixtyFourthsPerMm = 64.0 / 25.4;
+inline constexpr double mphPerMs = 2.237;
+
+// Scale with every abscissa converted to the metric unit
+template <std::size_t N>
+constexpr Scale<N> metric(const Scale<N>& s, double unitsPerMetric) {
+    Scale<N> out{};
+    for (std::size_t i = 0; i < N; ++i) {
+        out.x[i] = s.x[i] / unitsPerMetric;
+        out.y[i] = s.y[i];
+    }
+    return out;
+}
+
+inline constexpr Scale<11> S3m = metric(S3, psiPerKPa);
+inline constexpr Scale<11> S5m = metric(S5, sixtyFourthsPerMm);
+inline constexpr Scale<11> S7m = metric(S7, psiPerKPa);
+inline constexpr Scale<15> S9m = metric(S9, mphPerMs);
+
+inline constexpr auto S3m_grid = makeGridIndex<gridCells(S3m)>(S3m);
+inline constexpr auto S5m_grid = makeGridIndex<gridCells(S5m)>(S5m);
+inline constexpr auto S7m_grid = makeGridIndex<gridCells(S7m)>(S7m);
+inline constexpr auto S9m_grid = makeGridIndex<gridCells(S9m)>(S9m);
+
+inline double evaluateMetric(double vpd, double nozzle, double pressure, double wind) {
+    double y3 = lerp(S3m, S3m_grid, vpd);
+    double y5 = lerp(S5m, S5m_grid, nozzle);
+    double y7 = lerp(S7m, S7m_grid, pressure);
+    double y9 = lerp(S9m, S9m_grid, wind);
+
+    return combine(y3, y5, y7, y9);
+}
+
+} // namespace detail
+
+namespace Simd {
+namespace detail {
+
+inline void scalarMetricBatch(const double* vpd, const double* nozzle, const double* pressure,
+                              const double* wind, double* out, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        out[i] = EvapSolver::detail::evaluateMetric(vpd[i], nozzle[i], pressure[i], wind[i]);
+    }
+}
+
+#if defined(EVAP_SOLVER_SIMD_X86)
+
+__attribute__((target("avx2"))) inline void avx2MetricBatch(const double* vpd, const double* nozzle,
+                                                             const double* pressure, const double* wind,
+                                                             double* out, std::size_t n) {
+    using namespace EvapSolver::detail;
+
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d y3 = lerpAvx2(S3m, _mm256_loadu_pd(vpd + i));
+        __m256d y5 = lerpAvx2(S5m, _mm256_loadu_pd(nozzle + i));
+        __m256d y7 = lerpAvx2(S7m, _mm256_loadu_pd(pressure + i));
+        __m256d y9 = lerpAvx2(S9m, _mm256_loadu_pd(wind + i));
+
+        __m256d yA = lerp2Avx2(x4, x3, y3, x5, y5);
+        __m256d yB = lerp2Avx2(x8, x7, y7, x9, y9);
+        __m256d yL = lerp2Avx2(x6, x4, yA, x8, yB);
+
+        _mm256_storeu_pd(out + i, lerpAvx2(S6_flip, yL));
+    }
+    scalarMetricBatch(vpd + i, nozzle + i, pressure + i, wind + i, out + i, n - i);
+}
+
+// See evap_solver_simd.h for why this warning is silenced around AVX-512 code
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+__attribute__((target("avx512f"))) inline void avx512MetricBatch(const double* vpd, const double* nozzle,
+                                                                 const double* pressure, const double* wind,
+                                                                 double* out, std::size_t n) {
+    using namespace EvapSolver::detail;
+
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m512d y3 = lerpAvx512(S3m, _mm512_loadu_pd(vpd + i));
+        __m512d y5 = lerpAvx512(S5m, _mm512_loadu_pd(nozzle + i));
+        __m512d y7 = lerpAvx512(S7m, _mm512_loadu_pd(pressure + i));
+        __m512d y9 = lerpAvx512(S9m, _mm512_loadu_pd(wind + i));
+
+        __m512d yA = lerp2Avx512(x4, x3, y3, x5, y5);
+        __m512d yB = lerp2Avx512(x8, x7, y7, x9, y9);
+        __m512d yL = lerp2Avx512(x6, x4, yA, x8, yB);
+
+        _mm512_storeu_pd(out + i, lerpAvx512(S6_flip, yL));
+    }
+    scalarMetricBatch(vpd + i, nozzle + i, pressure + i, wind + i, out + i, n - i);
+}
+
+#pragma GCC diagnostic pop
+
+#elif defined(EVAP_SOLVER_SIMD_NEON)
+
+inline void neonMetricBatch(const double* vpd, const double* nozzle, const double* pressure,
+                            const double* wind, double* out, std::size_t n) {
+    using namespace EvapSolver::detail;
+
+    std::size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        float64x2_t y3 = lerpNeon(S3m, vld1q_f64(vpd + i));
+        float64x2_t y5 = lerpNeon(S5m, vld1q_f64(nozzle + i));
+        float64x2_t y7 = lerpNeon(S7m, vld1q_f64(pressure + i));
+        float64x2_t y9 = lerpNeon(S9m, vld1q_f64(wind + i));
+
+        float64x2_t yA = lerp2Neon(x4, x3, y3, x5, y5);
+        float64x2_t yB = lerp2Neon(x8, x7, y7, x9, y9);
+        float64x2_t yL = lerp2Neon(x6, x4, yA, x8, yB);
+
+        vst1q_f64(out + i, lerpNeon(S6_flip, yL));
+    }
+    scalarMetricBatch(vpd + i, nozzle + i, pressure + i, wind + i, out + i, n - i);
+}
+
+#endif
+
+} // namespace detail
+
+// Metric batch with an explicit kernel; falls back to scalar if k is not
+// supported on this CPU. Every kernel gives bit-identical results.
+inline void calculateMetricBatch(Kernel k, const double* vpd, const double* nozzle, const double* pressure,
+                                 const double* wind, double* out, std::size_t n) {
+    if (!isSupported(k)) k = Kernel::Scalar;
+    switch (k) {
+#if defined(EVAP_SOLVER_SIMD_X86)
+        case Kernel::AVX512: detail::avx512MetricBatch(vpd, nozzle, pressure, wind, out, n); return;
+        case Kernel::AVX2: detail::avx2MetricBatch(vpd, nozzle, pressure, wind, out, n); return;
+#elif defined(EVAP_SOLVER_SIMD_NEON)
+        case Kernel::NEON: detail::neonMetricBatch(vpd, nozzle, pressure, wind, out, n); return;
+#endif
+        default: detail::scalarMetricBatch(vpd, nozzle, pressure, wind, out, n); return;
+    }
+}
+
+} // namespace Simd
+
+// Metric-unit evaporation loss calculator (same thread-safety as Calculator)
+class MetricCalculator {
+public:
+    // Calculate evaporation loss percentage
+    static double calculate(const MetricInput& in) {
+        return detail::evaluateMetric(in.vpd, in.nozzle, in.pressure, in.wind);
+    }
+
+    // Calculate evaporation loss for n metric records with the fastest
+    // supported SIMD kernel; out[i] is bit-identical to calculate()
+    static void calculateBatch(const double* vpd, const double* nozzle, const double* pressure,
+                               const double* wind, double* out, std::size_t n) {
+        Simd::calculateMetricBatch(Simd::activeKernel(), vpd, nozzle, pressure, wind, out, n);
+    }
+};
+
+} // namespace EvapSolver
+
+#endif // EVAP_SOLVER_METRIC_H
@@ -0,0 +1,223 @@
+#ifndef EVAP_SOLVER_PARALLEL_H
+#define EVAP_SOLVER_PARALLEL_H
+
+// Parallel batch evaluation on a reusable work-stealing thread pool.
+//
+// The input span is cut into fixed-size chunks. Every participating thread
+// (the pool workers plus the calling thread) starts on its own contiguous
+// run of chunks and, once that is exhausted, steals chunks from the other
+// runs. Each record is written only to its own output slot, so results are
+// deterministic and identical to the single-threaded batch.
+//
+// Usage:
+//   EvapSolver::Parallel::ThreadPool pool({8, 16384, false});
+//   EvapSolver::Parallel::calculateBatch(pool, vpd, nozzle, pressure, wind, out, n);
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "evap_solver_simd.h"
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace EvapSolver {
+namespace Parallel {
+
+// Thread pool configuration
+struct PoolOptions {
+    unsigned threads = 0;          // Participating threads incl. the caller; 0 = hardware concurrency
+    std::size_t chunkSize = 16384; // Records per work item
+    bool pinThreads = false;       // Pin worker i to CPU i (Linux only, ignored elsewhere)
+};
+
+class ThreadPool {
+public:
+    explicit ThreadPool(const PoolOptions& options = PoolOptions())
+        : chunk(options.chunkSize ? options.chunkSize : 1) {
+        unsigned count = options.threads ? options.threads : std::thread::hardware_concurrency();
+        if (count == 0) count = 1;
+
+        slots.reset(new Slot[count]);
+        participants = count;
+        // If a thread cannot be created, the ones already running are joined
+        // before the std::system_error leaves the constructor
+        try {
+            workers.reserve(count - 1);
+            for (unsigned id = 1; id < count; ++id) {
+                workers.emplace_back([this, id] { workerLoop(id); });
+                if (options.pinThreads) pin(workers.back(), id);
+            }
+        } catch (...) {
+            stop();
+            throw;
+        }
+    }
+
+    ~ThreadPool() { stop(); }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Number of threads that share a batch, including the calling thread
+    unsigned size() const { return participants; }
+    std::size_t chunkSize() const { return chunk; }
+
+    // Run body(begin, end) over every chunk of [0, n) and block until all
+    // chunks are done. The first exception thrown by body is rethrown here.
+    // Calls from several threads on the same pool are serialized.
+    template <class Body>
+    void parallelFor(std::size_t n, Body&& body) {
+        if (n == 0) return;
+
+        std::lock_guard<std::mutex> submitLock(submitMutex);
+        const std::size_t chunks = (n + chunk - 1) / chunk;
+        if (participants == 1 || chunks == 1) {
+            for (std::size_t begin = 0; begin < n; begin += chunk) {
+                body(begin, begin + chunk < n ? begin + chunk : n);
+            }
+            return;
+        }
+
+        // Give every participant a contiguous run of chunks to start from
+        for (unsigned id = 0; id < participants; ++id) {
+            slots[id].next.store(chunks * id / participants, std::memory_order_relaxed);
+            slots[id].end = chunks * (id + 1) / participants;
+        }
+        using BodyType = typename std::remove_reference<Body>::type;
+        job.context = const_cast<void*>(static_cast<const void*>(&body));
+        job.run = [](void* context, std::size_t begin, std::size_t end) {
+            (*static_cast<BodyType*>(context))(begin, end);
+        };
+        job.records = n;
+        job.error = nullptr;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            pending = participants - 1;
+            ++generation;
+        }
+        wake.notify_all();
+
+        participate(0);
+
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [this] { return pending == 0; });
+        if (job.error) std::rethrow_exception(job.error);
+    }
+
+private:
+    // Per-participant chunk run, padded so counters never share a cache line
+    struct alignas(64) Slot {
+        std::atomic<std::size_t> next{0};
+        std::size_t end = 0;
+    };
+
+    struct Job {
+        void* context = nullptr;
+        void (*run)(void*, std::size_t, std::size_t) = nullptr;
+        std::size_t records = 0;
+        std::exception_ptr error;
+    };
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& w : workers) w.join();
+    }
+
+    void workerLoop(unsigned id) {
+        unsigned long long seen = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [&] { return stopping || generation != seen; });
+                if (stopping) return;
+                seen = generation;
+            }
+            participate(id);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (--pending == 0) done.notify_one();
+            }
+        }
+    }
+
+    // Drain our own run first, then steal from the others in ring order
+    void participate(unsigned id) {
+        for (unsigned k = 0; k < participants; ++k) {
+            Slot& slot = slots[(id + k) % participants];
+            for (;;) {
+                std::size_t c = slot.next.fetch_add(1, std::memory_order_relaxed);
+                if (c >= slot.end) break;
+                runChunk(c);
+            }
+        }
+    }
+
+    void runChunk(std::size_t c) {
+        std::size_t begin = c * chunk;
+        std::size_t end = begin + chunk < job.records ? begin + chunk : job.records;
+        try {
+            job.run(job.context, begin, end);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (!job.error) job.error = std::current_exception();
+        }
+    }
+
+    static void pin(std::thread& t, unsigned id) {
+#if defined(__linux__)
+        unsigned cpus = std::thread::hardware_concurrency();
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpus ? id % cpus : 0, &set);
+        pthread_setaffinity_np(t.native_handle(), sizeof(set), &set);
+#else
+        (void)t;
+        (void)id;
+#endif
+    }
+
+    std::size_t chunk;
+    unsigned participants = 1;
+    std::unique_ptr<Slot[]> slots;
+    std::vector<std::thread> workers;
+    Job job;
+
+    std::mutex submitMutex;
+    std::mutex errorMutex;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    unsigned long long generation = 0;
+    unsigned pending = 0;
+    bool stopping = false;
+};
+
+// Calculate evaporation loss for n records on the pool's threads, using the
+// fastest SIMD kernel for every chunk. Results are bit-identical to
+// Calculator::calculateBatch().
+inline void calculateBatch(ThreadPool& pool, const double* vpd, const int* nozzle, const double* pressure,
+                           const double* wind, double* out, std::size_t n) {
+    pool.parallelFor(n, [=](std::size_t begin, std::size_t end) {
+        Simd::calculateBatch(vpd + begin, nozzle + begin, pressure + begin, wind + begin,
+                             out + begin, end - begin);
+    });
+}
+
+} // namespace Parallel
+} // namespace EvapSolver
+
+#endif // EVAP_SOLVER_PARALLEL_H
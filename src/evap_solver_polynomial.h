@@ -0,0 +1,286 @@
+#ifndef EVAP_SOLVER_POLYNOMIAL_H
+#define EVAP_SOLVER_POLYNOMIAL_H
+
+// Branch-free piecewise-polynomial engine.
+//
+// Every nomograph scale is piecewise linear: a degree-1 piecewise
+// polynomial with breakpoints at its ticks. In truncated-power form
+//   f(v) = y0 + sum_k slope[k] * min(max(v - knot[k], 0), width[k])
+// it needs no segment search and no gathers. Each piece is a subtract,
+// max, min, multiply and add on broadcast constants. The clamps at the
+// scale ends come from the first max and the last min. With the separable
+// weights (evap_solver_separable.h) folded into the input scales:
+//   loss = P6( P3w(vpd) + P5w(nozzle) + P7w(pressure) + P9w(wind) )
+//
+// polynomialFit puts a breakpoint at every tick. It differs from
+// Calculator::calculate() only by rounding of the regrouped sums: at most
+// 1e-12 percentage points (checked by tests/test_polynomial_solver.cpp).
+// Fits through fewer ticks (makePolynomialFit() with tick lists, e.g. from
+// the evap_poly_gen tool) evaluate fewer pieces per scale at a larger
+// error, which the tool reports. Global or higher-degree fits (Chebyshev up
+// to degree 32) stay above 0.3 points of max error because of the kinks at
+// the ticks, so they are not offered.
+//
+// The scalar, AVX2, AVX-512 and NEON kernels use the same operations in the
+// same order, with FMA contraction turned off (EVAP_SOLVER_NO_CONTRACT), and
+// return bit-identical results at any optimization level.
+// A NaN input contributes its scale's first tick (max(NaN, 0) is 0); the
+// result does not propagate the NaN.
+//
+// Usage:
+//   double loss = EvapSolver::PolynomialCalculator::calculate({0.6, 12, 40, 5});
+//   EvapSolver::PolynomialCalculator::calculateBatch(vpd, nozzle, pressure, wind, out, n);
+
+#include <cstddef>
+#include "evap_solver_separable.h"
+#include "evap_solver_simd.h"
+
+namespace EvapSolver {
+namespace detail {
+
+// One scale as K linear pieces in truncated-power form
+template <std::size_t K>
+struct HingeScale {
+    double y0;       // Value at and below the first breakpoint
+    double knot[K];  // Start of piece k
+    double width[K]; // Length of piece k
+    double slope[K];
+};
+
+// Contribution of one piece; NaN fails d > 0 and contributes nothing
+EVAP_SOLVER_NO_CONTRACT inline double hingeTerm(double v, double knot, double width, double slope) {
+    double d = v - knot;
+    d = d > 0 ? d : 0.0;
+    return slope * (d < width ? d : width);
+}
+
+template <std::size_t K>
+EVAP_SOLVER_NO_CONTRACT inline double hinge(const HingeScale<K>& h, double v) {
+    double y = h.y0;
+    for (std::size_t k = 0; k < K; ++k) y += hingeTerm(v, h.knot[k], h.width[k], h.slope[k]);
+    return y;
+}
+
+// Pieces through the ticks ticks[0] < ticks[1] < ... of s, ordinates times w.
+// A list from 0 to N - 1 keeps the clamps of lerp(s, v).
+template <std::size_t M, std::size_t N>
+constexpr HingeScale<M - 1> makeHinge(const Scale<N>& s, const std::size_t (&ticks)[M], double w = 1.0) {
+    HingeScale<M - 1> h{};
+    h.y0 = s.y[ticks[0]] * w;
+    for (std::size_t k = 0; k + 1 < M; ++k) {
+        std::size_t a = ticks[k], b = ticks[k + 1];
+        h.knot[k] = s.x[a];
+        h.width[k] = s.x[b] - s.x[a];
+        h.slope[k] = (s.y[b] * w - s.y[a] * w) / (s.x[b] - s.x[a]);
+    }
+    return h;
+}
+
+// Every tick of s as a breakpoint
+template <std::size_t N>
+constexpr HingeScale<N - 1> makeHinge(const Scale<N>& s, double w = 1.0) {
+    std::size_t ticks[N] = {};
+    for (std::size_t i = 0; i < N; ++i) ticks[i] = i;
+    return makeHinge(s, ticks, w);
+}
+
+// Piece counts per scale: S3, S5, S7, S9 (weighted, summing to yL) and S6^-1
+template <std::size_t K3, std::size_t K5, std::size_t K7, std::size_t K9, std::size_t K6>
+struct PolynomialFit {
+    HingeScale<K3> P3w;
+    HingeScale<K5> P5w;
+    HingeScale<K7> P7w;
+    HingeScale<K9> P9w;
+    HingeScale<K6> P6; // yL -> loss
+};
+
+using FullPolynomialFit = PolynomialFit<10, 10, 10, 14, 13>;
+
+// Every tick of table set t
+template <class Tab>
+constexpr FullPolynomialFit makePolynomialFit(const Tab& t) {
+    return {makeHinge(t.S3, w3), makeHinge(t.S5, w5), makeHinge(t.S7, w7), makeHinge(t.S9, w9),
+            makeHinge(t.S6_flip)};
+}
+
+// Only the listed ticks of each scale; every list must start at 0 and end
+// at the scale's last tick
+template <class Tab, std::size_t M3, std::size_t M5, std::size_t M7, std::size_t M9, std::size_t M6>
+constexpr PolynomialFit<M3 - 1, M5 - 1, M7 - 1, M9 - 1, M6 - 1>
+makePolynomialFit(const Tab& t, const std::size_t (&t3)[M3], const std::size_t (&t5)[M5],
+                  const std::size_t (&t7)[M7], const std::size_t (&t9)[M9], const std::size_t (&t6)[M6]) {
+    return {makeHinge(t.S3, t3, w3), makeHinge(t.S5, t5, w5), makeHinge(t.S7, t7, w7), makeHinge(t.S9, t9, w9),
+            makeHinge(t.S6_flip, t6)};
+}
+
+inline constexpr FullPolynomialFit polynomialFit = makePolynomialFit(Tables<double>{});
+
+template <class Fit>
+EVAP_SOLVER_NO_CONTRACT inline double evaluatePolynomial(const Fit& f, double vpd, int nozzle, double pressure, double wind) {
+    double yL = hinge(f.P3w, vpd) + hinge(f.P5w, nozzle) + hinge(f.P7w, pressure) + hinge(f.P9w, wind);
+    return hinge(f.P6, yL);
+}
+
+EVAP_SOLVER_NO_CONTRACT inline double evaluatePolynomial(double vpd, int nozzle, double pressure, double wind) {
+    return evaluatePolynomial(polynomialFit, vpd, nozzle, pressure, wind);
+}
+
+} // namespace detail
+
+namespace Simd {
+namespace detail {
+
+using EvapSolver::detail::HingeScale;
+
+template <class Fit>
+EVAP_SOLVER_NO_CONTRACT inline void polynomialScalarBatch(const Fit& f, const double* vpd, const int* nozzle,
+                                                          const double* pressure, const double* wind, double* out,
+                                                          std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        out[i] = EvapSolver::detail::evaluatePolynomial(f, vpd[i], nozzle[i], pressure[i], wind[i]);
+    }
+}
+
+#if defined(EVAP_SOLVER_SIMD_X86)
+
+// max_pd(d, 0) returns 0 for NaN d and min_pd(d, width) returns d if
+// d < width, exactly as hingeTerm() selects
+template <std::size_t K>
+__attribute__((target("avx2"))) EVAP_SOLVER_NO_CONTRACT inline __m256d hingeAvx2(const HingeScale<K>& h, __m256d v) {
+    __m256d y = _mm256_set1_pd(h.y0);
+    for (std::size_t k = 0; k < K; ++k) {
+        __m256d d = _mm256_max_pd(_mm256_sub_pd(v, _mm256_set1_pd(h.knot[k])), _mm256_setzero_pd());
+        d = _mm256_min_pd(d, _mm256_set1_pd(h.width[k]));
+        y = _mm256_add_pd(y, _mm256_mul_pd(_mm256_set1_pd(h.slope[k]), d));
+    }
+    return y;
+}
+
+template <class Fit>
+__attribute__((target("avx2"))) EVAP_SOLVER_NO_CONTRACT inline void polynomialAvx2Batch(const Fit& f, const double* vpd,
+                                                                                        const int* nozzle,
+                                                                                        const double* pressure,
+                                                                                        const double* wind, double* out,
+                                                                                        std::size_t n) {
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d vn = _mm256_cvtepi32_pd(_mm_loadu_si128(reinterpret_cast<const __m128i*>(nozzle + i)));
+        __m256d yL = _mm256_add_pd(hingeAvx2(f.P3w, _mm256_loadu_pd(vpd + i)), hingeAvx2(f.P5w, vn));
+        yL = _mm256_add_pd(yL, hingeAvx2(f.P7w, _mm256_loadu_pd(pressure + i)));
+        yL = _mm256_add_pd(yL, hingeAvx2(f.P9w, _mm256_loadu_pd(wind + i)));
+        _mm256_storeu_pd(out + i, hingeAvx2(f.P6, yL));
+    }
+    polynomialScalarBatch(f, vpd + i, nozzle + i, pressure + i, wind + i, out + i, n - i);
+}
+
+// -Wmaybe-uninitialized reports once the intrinsics are inlined
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+template <std::size_t K>
+__attribute__((target("avx512f"))) EVAP_SOLVER_NO_CONTRACT inline __m512d hingeAvx512(const HingeScale<K>& h, __m512d v) {
+    __m512d y = _mm512_set1_pd(h.y0);
+    for (std::size_t k = 0; k < K; ++k) {
+        __m512d d = _mm512_max_pd(_mm512_sub_pd(v, _mm512_set1_pd(h.knot[k])), _mm512_setzero_pd());
+        d = _mm512_min_pd(d, _mm512_set1_pd(h.width[k]));
+        y = _mm512_add_pd(y, _mm512_mul_pd(_mm512_set1_pd(h.slope[k]), d));
+    }
+    return y;
+}
+
+template <class Fit>
+__attribute__((target("avx512f"))) EVAP_SOLVER_NO_CONTRACT inline void polynomialAvx512Batch(const Fit& f,
+                                                                                             const double* vpd,
+                                                                                             const int* nozzle,
+                                                                                             const double* pressure,
+                                                                                             const double* wind,
+                                                                                             double* out,
+                                                                                             std::size_t n) {
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m512d vn = _mm512_cvtepi32_pd(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(nozzle + i)));
+        __m512d yL = _mm512_add_pd(hingeAvx512(f.P3w, _mm512_loadu_pd(vpd + i)), hingeAvx512(f.P5w, vn));
+        yL = _mm512_add_pd(yL, hingeAvx512(f.P7w, _mm512_loadu_pd(pressure + i)));
+        yL = _mm512_add_pd(yL, hingeAvx512(f.P9w, _mm512_loadu_pd(wind + i)));
+        _mm512_storeu_pd(out + i, hingeAvx512(f.P6, yL));
+    }
+    polynomialScalarBatch(f, vpd + i, nozzle + i, pressure + i, wind + i, out + i, n - i);
+}
+
+#pragma GCC diagnostic pop
+
+#elif defined(EVAP_SOLVER_SIMD_NEON)
+
+// vmaxnmq returns the number for a NaN lane and +0 against -0, as hingeTerm() does
+template <std::size_t K>
+EVAP_SOLVER_NO_CONTRACT inline float64x2_t hingeNeon(const HingeScale<K>& h, float64x2_t v) {
+    float64x2_t y = vdupq_n_f64(h.y0);
+    for (std::size_t k = 0; k < K; ++k) {
+        float64x2_t d = vmaxnmq_f64(vsubq_f64(v, vdupq_n_f64(h.knot[k])), vdupq_n_f64(0.0));
+        d = vminq_f64(d, vdupq_n_f64(h.width[k]));
+        y = vaddq_f64(y, vmulq_f64(vdupq_n_f64(h.slope[k]), d));
+    }
+    return y;
+}
+
+template <class Fit>
+EVAP_SOLVER_NO_CONTRACT inline void polynomialNeonBatch(const Fit& f, const double* vpd, const int* nozzle,
+                                                        const double* pressure, const double* wind, double* out,
+                                                        std::size_t n) {
+    std::size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        float64x2_t vn = vcvtq_f64_s64(vmovl_s32(vld1_s32(nozzle + i)));
+        float64x2_t yL = vaddq_f64(hingeNeon(f.P3w, vld1q_f64(vpd + i)), hingeNeon(f.P5w, vn));
+        yL = vaddq_f64(yL, hingeNeon(f.P7w, vld1q_f64(pressure + i)));
+        yL = vaddq_f64(yL, hingeNeon(f.P9w, vld1q_f64(wind + i)));
+        vst1q_f64(out + i, hingeNeon(f.P6, yL));
+    }
+    polynomialScalarBatch(f, vpd + i, nozzle + i, pressure + i, wind + i, out + i, n - i);
+}
+
+#endif
+
+} // namespace detail
+
+// Polynomial-engine batch on fit f with an explicit kernel (scalar if unsupported)
+template <class Fit>
+inline void calculatePolynomialBatch(Kernel k, const Fit& f, const double* vpd, const int* nozzle,
+                                     const double* pressure, const double* wind, double* out, std::size_t n) {
+    Instrument::BatchTimer timer(n);
+    if (!isSupported(k)) k = Kernel::Scalar;
+    switch (k) {
+#if defined(EVAP_SOLVER_SIMD_X86)
+        case Kernel::AVX512: detail::polynomialAvx512Batch(f, vpd, nozzle, pressure, wind, out, n); return;
+        case Kernel::AVX2: detail::polynomialAvx2Batch(f, vpd, nozzle, pressure, wind, out, n); return;
+#elif defined(EVAP_SOLVER_SIMD_NEON)
+        case Kernel::NEON: detail::polynomialNeonBatch(f, vpd, nozzle, pressure, wind, out, n); return;
+#endif
+        default: detail::polynomialScalarBatch(f, vpd, nozzle, pressure, wind, out, n); return;
+    }
+}
+
+template <class Fit>
+inline void calculatePolynomialBatch(const Fit& f, const double* vpd, const int* nozzle, const double* pressure,
+                                     const double* wind, double* out, std::size_t n) {
+    calculatePolynomialBatch(activeKernel(), f, vpd, nozzle, pressure, wind, out, n);
+}
+
+} // namespace Simd
+
+// Polynomial evaporation loss calculator (same interface as Calculator)
+class PolynomialCalculator {
+public:
+    static double calculate(const Input& in) {
+        return detail::evaluatePolynomial(in.vpd, in.nozzle, in.pressure, in.wind);
+    }
+
+    // Fastest supported kernel; bit-identical to calculate()
+    static void calculateBatch(const double* vpd, const int* nozzle, const double* pressure,
+                               const double* wind, double* out, std::size_t n) {
+        Simd::calculatePolynomialBatch(detail::polynomialFit, vpd, nozzle, pressure, wind, out, n);
+    }
+};
+
+} // namespace EvapSolver
+
+#endif // EVAP_SOLVER_POLYNOMIAL_H
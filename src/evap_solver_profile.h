@@ -0,0 +1,104 @@
+#ifndef EVAP_SOLVER_PROFILE_H
+#define EVAP_SOLVER_PROFILE_H
+
+// Sprinkler profiles: nozzle and pressure bound once, weather evaluated often.
+//
+// A profile stores the S5 and S7 ordinates of its hardware, so an hourly
+// evaluation only needs the S3 (vpd) and S9 (wind) lookups. evaluate() is
+// bit-identical to Calculator::calculate(); evaluateSeparable() additionally
+// pre-adds the hardware contribution to yL (see evap_solver_separable.h) and
+// is within 1e-12 percentage points of it.
+//
+// Profiles built from NomographTables store that set's ordinates and must be
+// evaluated with the same tables.
+//
+// Usage:
+//   EvapSolver::SprinklerProfile profile(12, 40);   // nozzle 12/64", 40 psi
+//   double loss = profile.evaluate(0.6, 5);         // vpd 0.6 psi, wind 5 mph
+//   profile.evaluateBatch(vpdSeries, windSeries, out, hours);
+//   EvapSolver::SprinklerProfile calibrated(tables, 12, 40);
+//   double fieldLoss = calibrated.evaluate(tables, 0.6, 5);
+
+#include <cstddef>
+#include "evap_solver_compact.h"
+#include "evap_solver_separable.h"
+#include "evap_solver_tables.h"
+
+namespace EvapSolver {
+
+// 24 bytes per sprinkler, so large fleets stay cache friendly in a flat array
+struct SprinklerProfile {
+    double y5 = 0.0;            // S5 ordinate of the nozzle diameter
+    double y7 = 0.0;            // S7 ordinate of the nozzle pressure
+    double separableBase = 0.0; // w5 * y5 + w7 * y7, the hardware part of yL
+
+    SprinklerProfile() = default;
+
+    SprinklerProfile(int nozzle, double pressure) : SprinklerProfile(detail::SeparableTables{}, nozzle, pressure) {}
+
+    // Hardware bound on runtime tables
+    SprinklerProfile(const NomographTables& tables, int nozzle, double pressure)
+        : SprinklerProfile(tables.tables(), nozzle, pressure) {}
+
+    // Evaporation loss (%) for one weather record
+    double evaluate(double vpd, double wind) const { return evaluateOn(detail::Tables<double>{}, vpd, wind); }
+
+    double evaluate(const NomographTables& tables, double vpd, double wind) const {
+        return evaluateOn(tables.tables(), vpd, wind);
+    }
+
+    // Separable form: two weighted lookups and the reverse S6 lookup
+    double evaluateSeparable(double vpd, double wind) const {
+        return evaluateSeparableOn(detail::SeparableTables{}, vpd, wind);
+    }
+
+    double evaluateSeparable(const NomographTables& tables, double vpd, double wind) const {
+        return evaluateSeparableOn(tables.tables(), vpd, wind);
+    }
+
+    // Weather time series for this sprinkler
+    void evaluateBatch(const double* vpd, const double* wind, double* out, std::size_t n) const {
+        for (std::size_t i = 0; i < n; ++i) out[i] = evaluate(vpd[i], wind[i]);
+    }
+
+    void evaluateBatch(const NomographTables& tables, const double* vpd, const double* wind, double* out,
+                       std::size_t n) const {
+        const detail::TableBlock& t = tables.tables();
+        for (std::size_t i = 0; i < n; ++i) out[i] = evaluateOn(t, vpd[i], wind[i]);
+    }
+
+    // The same on any table set (see detail::combine() and detail::evaluateSeparable())
+    template <class Tab>
+    SprinklerProfile(const Tab& t, int nozzle, double pressure)
+        : y5(detail::lerp(t.S5, t.S5_grid, nozzle)),
+          y7(detail::lerp(t.S7, t.S7_grid, pressure)),
+          separableBase(detail::nozzleContribution(t.N5w, nozzle) + detail::lerp(t.S7w, t.S7_grid, pressure)) {}
+
+    template <class Tab>
+    double evaluateOn(const Tab& t, double vpd, double wind) const {
+        return detail::combine(t, detail::lerp(t.S3, t.S3_grid, vpd), y5, y7, detail::lerp(t.S9, t.S9_grid, wind));
+    }
+
+    template <class Tab>
+    double evaluateSeparableOn(const Tab& t, double vpd, double wind) const {
+        double yL = detail::lerp(t.S3w, t.S3_grid, vpd) + separableBase + detail::lerp(t.S9w, t.S9_grid, wind);
+        return detail::lerp(t.S6_flip, t.S6_flip_grid, yL);
+    }
+};
+
+// One weather record per profile: out[i] = profiles[i].evaluate(vpd[i], wind[i])
+inline void evaluateProfiles(const SprinklerProfile* profiles, const double* vpd, const double* wind,
+                             double* out, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) out[i] = profiles[i].evaluate(vpd[i], wind[i]);
+}
+
+// The same on runtime tables (profiles built from them)
+inline void evaluateProfiles(const NomographTables& tables, const SprinklerProfile* profiles, const double* vpd,
+                             const double* wind, double* out, std::size_t n) {
+    const detail::TableBlock& t = tables.tables();
+    for (std::size_t i = 0; i < n; ++i) out[i] = profiles[i].evaluateOn(t, vpd[i], wind[i]);
+}
+
+} // namespace EvapSolver
+
+#endif // EVAP_SOLVER_PROFILE_H
@@ -0,0 +1,120 @@
+#ifndef EVAP_SOLVER_SEPARABLE_H
+#define EVAP_SOLVER_SEPARABLE_H
+
+// Separable closed-form engine.
+//
+// Once the per-axis lookups are done the nomograph geometry is linear:
+//   yA = (1 - a) y3 + a y5,   a = (x4 - x3) / (x5 - x3) = 0.237 / 0.439
+//   yB = (1 - b) y7 + b y9,   b = (x8 - x7) / (x9 - x7) = 0.132 / 0.262
+//   yL = (1 - c) yA + c yB,   c = (x6 - x4) / (x8 - x4) = 0.253 / 0.633
+// so yL = w3 y3 + w5 y5 + w7 y7 + w9 y9. The weights are folded into the
+// tick ordinates at compile time and the nozzle contribution, which only
+// takes the 57 integer values 8..64, is a dense array with no search:
+//   loss = S6^-1( lerp(S3w, vpd) + N5w[nozzle - 8] + lerp(S7w, pressure) + lerp(S9w, wind) )
+//
+// Results differ from Calculator::calculate() only by floating-point
+// rounding of the regrouped sums: at most 1e-12 percentage points over the
+// whole parameter range (checked by tests/test_separable_solver.cpp).
+
+#include <cstddef>
+#include "evap_solver_compact.h"
+
+namespace EvapSolver {
+namespace detail {
+
+// Pivot ratios of the nomograph columns
+inline constexpr double ratioA = (x4 - x3) / (x5 - x3);
+inline constexpr double ratioB = (x8 - x7) / (x9 - x7);
+inline constexpr double ratioL = (x6 - x4) / (x8 - x4);
+
+// Weight of each axis in yL
+inline constexpr double w3 = (1 - ratioL) * (1 - ratioA);
+inline constexpr double w5 = (1 - ratioL) * ratioA;
+inline constexpr double w7 = ratioL * (1 - ratioB);
+inline constexpr double w9 = ratioL * ratioB;
+
+// Scale with every ordinate multiplied by w
+template <std::size_t N>
+constexpr Scale<N> weighted(const Scale<N>& s, double w) {
+    Scale<N> out{};
+    for (std::size_t i = 0; i < N; ++i) {
+        out.x[i] = s.x[i];
+        out.y[i] = s.y[i] * w;
+    }
+    return out;
+}
+
+inline constexpr Scale<11> S3w = weighted(S3, w3);
+inline constexpr Scale<11> S7w = weighted(S7, w7);
+inline constexpr Scale<15> S9w = weighted(S9, w9);
+
+// Weighted S5 contribution for every integer nozzle size 8..64
+inline constexpr int nozzleMin = 8, nozzleMax = 64;
+
+struct NozzleTable {
+    double y[nozzleMax - nozzleMin + 1];
+};
+
+constexpr NozzleTable makeNozzleTable(const Scale<11>& s5) {
+    NozzleTable t{};
+    for (int n = nozzleMin; n <= nozzleMax; ++n) t.y[n - nozzleMin] = lerp(s5, n) * w5;
+    return t;
+}
+
+inline constexpr NozzleTable N5w = makeNozzleTable(S5);
+
+// Nozzles outside 8..64 clamp to the table ends, as lerp(S5, nozzle) does
+constexpr double nozzleContribution(const NozzleTable& t, int nozzle) {
+    int n = nozzle < nozzleMin ? nozzleMin : (nozzle > nozzleMax ? nozzleMax : nozzle);
+    return t.y[n - nozzleMin];
+}
+
+constexpr double nozzleContribution(int nozzle) {
+    return nozzleContribution(N5w, nozzle);
+}
+
+// Built-in table set extended with the weighted scales
+struct SeparableTables : Tables<double> {
+    static constexpr const Scale<11>& S3w = detail::S3w;
+    static constexpr const Scale<11>& S7w = detail::S7w;
+    static constexpr const Scale<15>& S9w = detail::S9w;
+    static constexpr const NozzleTable& N5w = detail::N5w;
+};
+
+// Separable chain on a table set that also carries S3w, S7w, S9w and N5w
+template <class Tab>
+inline double evaluateSeparable(const Tab& t, double vpd, int nozzle, double pressure, double wind) {
+    double yL = lerp(t.S3w, t.S3_grid, vpd) + nozzleContribution(t.N5w, nozzle) +
+                lerp(t.S7w, t.S7_grid, pressure) + lerp(t.S9w, t.S9_grid, wind);
+    if constexpr (Instrument::enabled) {
+        instrumentInputs<double>(t, vpd, nozzle, pressure, wind);
+        instrumentScale(Instrument::Loss, t.S6_flip, yL);
+    }
+    return lerp(t.S6_flip, t.S6_flip_grid, yL);
+}
+
+inline double evaluateSeparable(double vpd, int nozzle, double pressure, double wind) {
+    return evaluateSeparable(SeparableTables{}, vpd, nozzle, pressure, wind);
+}
+
+} // namespace detail
+
+// Separable evaporation loss calculator (same interface as Calculator)
+class SeparableCalculator {
+public:
+    static double calculate(const Input& in) {
+        return detail::evaluateSeparable(in.vpd, in.nozzle, in.pressure, in.wind);
+    }
+
+    static void calculateBatch(const double* vpd, const int* nozzle, const double* pressure,
+                               const double* wind, double* out, std::size_t n) {
+        Instrument::BatchTimer timer(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = detail::evaluateSeparable(vpd[i], nozzle[i], pressure[i], wind[i]);
+        }
+    }
+};
+
+} // namespace EvapSolver
+
+#endif // EVAP_SOLVER_SEPARABLE_H
@@ -0,0 +1,770 @@
+#ifndef EVAP_SOLVER_SERVICE_H
+#define EVAP_SOLVER_SERVICE_H
+
+// Long-running evaluation service over a stream socket (Linux).
+//
+// One event-loop thread (epoll) accepts connections on a TCP or Unix
+// socket and reads fixed-size request frames from all of them without
+// blocking. Requests from every connection are coalesced into one
+// micro-batch, which is evaluated with the batch kernel of the selected
+// engine when it holds maxBatch records or when its oldest request has
+// waited maxWait (a timerfd deadline), whichever comes first. Responses go
+// back in request order per connection. A micro-batch costs less than
+// handing it to another thread, so it runs on the loop thread.
+//
+// Wire format, little-endian. A request is a u64 id followed by the binary
+// record of evap_solver_stream.h:
+//   request   40 bytes: u64 id, f64 vpd, f64 pressure, f64 wind, i32 nozzle,
+//             u32 reserved (0)
+//   response  24 bytes: u64 id, f64 loss, u8 status, 7 zero bytes
+// The loss is the engine's (clamped as in calculateBatch()); status holds
+// the out-of-range bits of checkInputs(). A frame with non-zero reserved
+// bytes closes its connection. Clients may pipeline any number of
+// requests; a client that stops reading is not read from once maxOutput
+// bytes of its responses are queued. After a client shuts down its
+// sending side, its outstanding requests are still answered.
+//
+// metrics() returns counters, the batch-size distribution and the
+// per-request latency distribution (from the read that completed a
+// request to its response being handed to the socket) at any time, from
+// any thread.
+//
+// Usage:
+//   EvapSolver::Service::Options options;
+//   options.maxWait = std::chrono::microseconds(200);
+//   EvapSolver::Service::Server server("0.0.0.0:7878", options);   // or "unix:/run/evap.sock"
+//   std::thread loop([&] { server.run(); });
+//   ...
+//   server.stop();   // Async-signal-safe
+//   loop.join();
+//   EvapSolver::Service::writeJson(std::cerr, server.metrics());
+
+#include <atomic>
+#include <chrono>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/timerfd.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "evap_solver_engines.h"
+#include "evap_solver_stream.h"
+
+namespace EvapSolver {
+namespace Service {
+
+inline constexpr std::size_t requestSize = 8 + Stream::binaryRecordSize;
+inline constexpr std::size_t responseSize = 24;
+
+struct Request {
+    std::uint64_t id = 0;
+    Input input;
+};
+
+struct Response {
+    std::uint64_t id = 0;
+    double loss = 0.0;
+    Status status = StatusOk;
+};
+
+struct Options {
+    Engine engine = Engine::Exact;
+    std::size_t maxBatch = 256;                     // Records per micro-batch
+    std::chrono::microseconds maxWait{100};         // Longest a request waits for its batch to fill; 0 = flush
+                                                    // whatever each loop iteration read
+    std::size_t maxOutput = std::size_t(1) << 20;   // Queued response bytes before a connection is paused
+    int backlog = 128;
+};
+
+// Log-linear histogram of nanoseconds: 8 buckets per power of two, so a
+// quantile is known to within 12.5%
+class LatencyHistogram {
+public:
+    static constexpr std::size_t subBuckets = 8;
+    static constexpr std::size_t bucketCount = 64 * subBuckets;
+
+    void record(std::uint64_t ns) {
+        ++buckets[index(ns)];
+        ++total;
+        sum += ns;
+        if (ns > largest) largest = ns;
+    }
+
+    std::uint64_t count() const { return total; }
+    std::uint64_t maxNanoseconds() const { return largest; }
+    double meanNanoseconds() const { return total ? double(sum) / double(total) : 0.0; }
+
+    // Upper edge of the bucket holding quantile q, at most the maximum (ns)
+    double quantileNanoseconds(double q) const {
+        if (!total) return 0.0;
+        double rank = q * double(total);
+        std::uint64_t seen = 0;
+        for (std::size_t b = 0; b < bucketCount; ++b) {
+            seen += buckets[b];
+            if (seen && double(seen) >= rank) {
+                double edge = double(upperEdge(b));
+                return edge < double(largest) ? edge : double(largest);
+            }
+        }
+        return double(largest);
+    }
+
+private:
+    // Values below 8 have a bucket each; above, octave o >= 3 splits into 8
+    static std::size_t index(std::uint64_t ns) {
+        if (ns < subBuckets) return static_cast<std::size_t>(ns);
+        unsigned octave = 63u - static_cast<unsigned>(__builtin_clzll(ns));
+        return (octave - 2) * subBuckets + static_cast<std::size_t>((ns >> (octave - 3)) & (subBuckets - 1));
+    }
+
+    static std::uint64_t upperEdge(std::size_t b) {
+        if (b < subBuckets) return b;
+        unsigned octave = static_cast<unsigned>(b / subBuckets) + 2;
+        std::uint64_t step = std::uint64_t(1) << (octave - 3);
+        return (std::uint64_t(subBuckets + b % subBuckets) << (octave - 3)) + step - 1;
+    }
+
+    std::uint64_t buckets[bucketCount] = {};
+    std::uint64_t total = 0;
+    std::uint64_t sum = 0;
+    std::uint64_t largest = 0;
+};
+
+inline constexpr std::size_t batchBuckets = 32;
+
+struct Metrics {
+    std::uint64_t connections = 0;     // Accepted
+    std::uint64_t openConnections = 0;
+    std::uint64_t protocolErrors = 0;  // Connections closed on a malformed frame
+    std::uint64_t requests = 0;
+    std::uint64_t responses = 0;       // Written or queued; the rest were for closed connections
+    std::uint64_t batches = 0;
+    std::uint64_t fullBatches = 0;     // Flushed at maxBatch records; the others at maxWait
+    std::uint64_t batchSizes[batchBuckets] = {}; // batchSizes[b]: batches of [2^b, 2^(b+1)) records
+    LatencyHistogram latency;
+
+    double meanBatchSize() const { return batches ? double(requests) / double(batches) : 0.0; }
+};
+
+// Metrics as one JSON object, latencies in nanoseconds
+inline void writeJson(std::ostream& out, const Metrics& m) {
+    out << "{\"connections\":" << m.connections << ",\"openConnections\":" << m.openConnections
+        << ",\"protocolErrors\":" << m.protocolErrors << ",\"requests\":" << m.requests
+        << ",\"responses\":" << m.responses << ",\"batches\":" << m.batches << ",\"fullBatches\":" << m.fullBatches
+        << ",\"meanBatchSize\":" << m.meanBatchSize() << ",\"batchSizes\":[";
+    std::size_t used = batchBuckets;
+    while (used > 0 && m.batchSizes[used - 1] == 0) --used;
+    for (std::size_t b = 0; b < used; ++b) out << (b ? "," : "") << m.batchSizes[b];
+    const LatencyHistogram& l = m.latency;
+    out << "],\"latency\":{\"count\":" << l.count() << ",\"mean\":" << l.meanNanoseconds()
+        << ",\"p50\":" << l.quantileNanoseconds(0.5) << ",\"p90\":" << l.quantileNanoseconds(0.9)
+        << ",\"p99\":" << l.quantileNanoseconds(0.99) << ",\"p999\":" << l.quantileNanoseconds(0.999)
+        << ",\"max\":" << l.maxNanoseconds() << "}}";
+}
+
+inline void encodeRequest(char* p, const Request& r) {
+    using Stream::detail::storeLE64;
+    std::uint64_t bits[3];
+    std::memcpy(&bits[0], &r.input.vpd, 8);
+    std::memcpy(&bits[1], &r.input.pressure, 8);
+    std::memcpy(&bits[2], &r.input.wind, 8);
+    storeLE64(p, r.id);
+    storeLE64(p + 8, bits[0]);
+    storeLE64(p + 16, bits[1]);
+    storeLE64(p + 24, bits[2]);
+    storeLE64(p + 32, static_cast<std::uint32_t>(r.input.nozzle));
+}
+
+inline Response decodeResponse(const char* p) {
+    using Stream::detail::loadLE64;
+    Response r;
+    r.id = loadLE64(p);
+    std::uint64_t bits = loadLE64(p + 8);
+    std::memcpy(&r.loss, &bits, 8);
+    r.status = static_cast<Status>(p[16]);
+    return r;
+}
+
+namespace detail {
+
+inline std::runtime_error systemError(const std::string& what) {
+    return std::runtime_error(what + ": " + std::strerror(errno));
+}
+
+inline std::uint64_t nowNanoseconds() {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                          std::chrono::steady_clock::now().time_since_epoch())
+                                          .count());
+}
+
+// Owns a descriptor
+class Fd {
+public:
+    explicit Fd(int fd = -1) : fd(fd) {}
+    ~Fd() {
+        if (fd >= 0) ::close(fd);
+    }
+    Fd(Fd&& other) noexcept : fd(other.fd) { other.fd = -1; }
+    Fd& operator=(Fd&& other) noexcept {
+        std::swap(fd, other.fd);
+        return *this;
+    }
+    Fd(const Fd&) = delete;
+    Fd& operator=(const Fd&) = delete;
+
+    int get() const { return fd; }
+
+private:
+    int fd;
+};
+
+// "unix:/path", or "host:port" / "[v6-host]:port" resolved with getaddrinfo
+struct Address {
+    sockaddr_storage storage = {};
+    socklen_t length = 0;
+    std::string unixPath;
+};
+
+inline Address parseAddress(const std::string& text, bool passive) {
+    Address a;
+    if (text.compare(0, 5, "unix:") == 0) {
+        a.unixPath = text.substr(5);
+        sockaddr_un* un = reinterpret_cast<sockaddr_un*>(&a.storage);
+        if (a.unixPath.empty() || a.unixPath.size() >= sizeof(un->sun_path)) {
+            throw std::runtime_error("invalid unix socket path: " + text);
+        }
+        un->sun_family = AF_UNIX;
+        std::memcpy(un->sun_path, a.unixPath.c_str(), a.unixPath.size() + 1);
+        a.length = static_cast<socklen_t>(offsetof(sockaddr_un, sun_path) + a.unixPath.size() + 1);
+        return a;
+    }
+    std::size_t colon = text.rfind(':');
+    if (colon == std::string::npos) throw std::runtime_error("expected host:port or unix:path, got " + text);
+    std::string host = text.substr(0, colon), port = text.substr(colon + 1);
+    if (host.size() >= 2 && host.front() == '[' && host.back() == ']') host = host.substr(1, host.size() - 2);
+
+    addrinfo hints = {};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = passive ? AI_PASSIVE : 0;
+    addrinfo* found = nullptr;
+    int rc = getaddrinfo(host.empty() ? nullptr : host.c_str(), port.c_str(), &hints, &found);
+    if (rc != 0) throw std::runtime_error("cannot resolve " + text + ": " + gai_strerror(rc));
+    std::memcpy(&a.storage, found->ai_addr, found->ai_addrlen);
+    a.length = static_cast<socklen_t>(found->ai_addrlen);
+    freeaddrinfo(found);
+    return a;
+}
+
+inline std::string formatAddress(const sockaddr_storage& s) {
+    char host[NI_MAXHOST], port[NI_MAXSERV];
+    if (s.ss_family == AF_UNIX) return "unix:" + std::string(reinterpret_cast<const sockaddr_un&>(s).sun_path);
+    if (getnameinfo(reinterpret_cast<const sockaddr*>(&s), sizeof s, host, sizeof host, port, sizeof port,
+                    NI_NUMERICHOST | NI_NUMERICSERV) != 0) {
+        return "";
+    }
+    return s.ss_family == AF_INET6 ? "[" + std::string(host) + "]:" + port : std::string(host) + ":" + port;
+}
+
+inline void setNoDelay(int fd, const sockaddr_storage& s) {
+    if (s.ss_family == AF_UNIX) return;
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof one);
+}
+
+} // namespace detail
+
+class Server {
+public:
+    // Binds and listens; throws std::runtime_error on failure. A stale
+    // Unix socket file at the path is replaced.
+    explicit Server(const std::string& address, const Options& options = Options()) : options(options) {
+        if (this->options.maxBatch == 0) this->options.maxBatch = 1;
+        detail::Address a = detail::parseAddress(address, true);
+        listener = detail::Fd(socket(a.storage.ss_family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0));
+        if (listener.get() < 0) throw detail::systemError("socket");
+        if (a.unixPath.empty()) {
+            int one = 1;
+            setsockopt(listener.get(), SOL_SOCKET, SO_REUSEADDR, &one, sizeof one);
+        } else {
+            ::unlink(a.unixPath.c_str());
+            unixPath = a.unixPath;
+        }
+        if (bind(listener.get(), reinterpret_cast<const sockaddr*>(&a.storage), a.length) != 0) {
+            throw detail::systemError("cannot bind " + address);
+        }
+        if (listen(listener.get(), options.backlog) != 0) throw detail::systemError("listen");
+
+        sockaddr_storage bound = {};
+        socklen_t length = sizeof bound;
+        getsockname(listener.get(), reinterpret_cast<sockaddr*>(&bound), &length);
+        bound_ = detail::formatAddress(bound);
+        if (bound.ss_family == AF_INET) port_ = ntohs(reinterpret_cast<const sockaddr_in&>(bound).sin_port);
+        if (bound.ss_family == AF_INET6) port_ = ntohs(reinterpret_cast<const sockaddr_in6&>(bound).sin6_port);
+
+        epoll = detail::Fd(epoll_create1(EPOLL_CLOEXEC));
+        wake = detail::Fd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC));
+        timer = detail::Fd(timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC));
+        if (epoll.get() < 0 || wake.get() < 0 || timer.get() < 0) throw detail::systemError("event loop setup");
+        watch(listener.get(), EPOLLIN, listenerTag);
+        watch(wake.get(), EPOLLIN, wakeTag);
+        watch(timer.get(), EPOLLIN, timerTag);
+
+        const std::size_t n = this->options.maxBatch;
+        vpd.resize(n);
+        pressure.resize(n);
+        wind.resize(n);
+        loss.resize(n);
+        nozzle.resize(n);
+        origin.resize(n);
+    }
+
+    ~Server() {
+        if (!unixPath.empty()) ::unlink(unixPath.c_str());
+    }
+
+    Server(const Server&) = delete;
+    Server& operator=(const Server&) = delete;
+
+    // Bound address as "host:port", "[v6-host]:port" or "unix:path"
+    const std::string& address() const { return bound_; }
+    // Bound TCP port (resolves port 0); 0 for Unix sockets
+    int port() const { return port_; }
+
+    // Event loop on the calling thread until stop(). Connections still open
+    // are closed on return; unanswered requests are dropped.
+    void run() {
+        epoll_event events[64];
+        while (!stopping.load(std::memory_order_acquire)) {
+            int ready = epoll_wait(epoll.get(), events, 64, -1);
+            if (ready < 0) {
+                if (errno == EINTR) continue;
+                throw detail::systemError("epoll_wait");
+            }
+            for (int e = 0; e < ready; ++e) {
+                std::uint64_t tag = events[e].data.u64;
+                if (tag == listenerTag) {
+                    acceptAll();
+                } else if (tag == wakeTag) {
+                    std::uint64_t count;
+                    while (::read(wake.get(), &count, sizeof count) > 0) {
+                    }
+                } else if (tag == timerTag) {
+                    // A batch flushed full earlier in this iteration disarmed the timer
+                    std::uint64_t expirations;
+                    bool expired = false;
+                    while (::read(timer.get(), &expirations, sizeof expirations) > 0) expired = true;
+                    if (expired && pending > 0) flush(false);
+                } else {
+                    onConnection(tag, events[e].events);
+                }
+            }
+            if (options.maxWait.count() == 0 && pending > 0) flush(false);
+        }
+        for (std::size_t slot = 0; slot < connections.size(); ++slot) {
+            if (connections[slot].fd.get() >= 0) closeConnection(slot);
+        }
+    }
+
+    // Ends run() from any thread or a signal handler
+    void stop() {
+        stopping.store(true, std::memory_order_release);
+        std::uint64_t one = 1;
+        ssize_t ignored = ::write(wake.get(), &one, sizeof one);
+        (void)ignored;
+    }
+
+    Metrics metrics() const {
+        std::lock_guard<std::mutex> lock(metricsMutex);
+        return live;
+    }
+
+private:
+    // epoll tags: connection tags hold slot + 1 and a generation
+    static constexpr std::uint64_t listenerTag = 0, wakeTag = 1, timerTag = 2, firstConnectionTag = 3;
+
+    struct Connection {
+        detail::Fd fd;
+        std::uint32_t generation = 0;
+        std::vector<char> in;       // Bytes of an incomplete frame
+        std::vector<char> out;      // Queued responses
+        std::size_t sent = 0;       // Bytes of out already written
+        std::size_t outstanding = 0; // Requests in the current micro-batch
+        std::uint32_t interest = 0;
+        bool readClosed = false;
+    };
+
+    // Where a record of the micro-batch came from
+    struct Origin {
+        std::uint64_t id;
+        std::uint64_t arrival; // ns
+        std::uint32_t slot, generation;
+    };
+
+    static std::uint64_t connectionTag(std::size_t slot, std::uint32_t generation) {
+        return (std::uint64_t(generation) << 32) | (slot + firstConnectionTag);
+    }
+
+    void watch(int fd, std::uint32_t events, std::uint64_t tag) {
+        epoll_event ev = {};
+        ev.events = events;
+        ev.data.u64 = tag;
+        if (epoll_ctl(epoll.get(), EPOLL_CTL_ADD, fd, &ev) != 0) throw detail::systemError("epoll_ctl");
+    }
+
+    void setInterest(std::size_t slot, std::uint32_t events) {
+        Connection& c = connections[slot];
+        if (c.interest == events) return;
+        epoll_event ev = {};
+        ev.events = events;
+        ev.data.u64 = connectionTag(slot, c.generation);
+        epoll_ctl(epoll.get(), EPOLL_CTL_MOD, c.fd.get(), &ev);
+        c.interest = events;
+    }
+
+    // Read while output is below maxOutput and the peer still sends; write while output is queued
+    void updateInterest(std::size_t slot) {
+        Connection& c = connections[slot];
+        std::size_t queued = c.out.size() - c.sent;
+        std::uint32_t events = 0;
+        if (!c.readClosed && queued < options.maxOutput) events |= EPOLLIN;
+        if (queued > 0) events |= EPOLLOUT;
+        setInterest(slot, events);
+    }
+
+    void acceptAll() {
+        for (;;) {
+            sockaddr_storage peer = {};
+            socklen_t length = sizeof peer;
+            int fd = accept4(listener.get(), reinterpret_cast<sockaddr*>(&peer), &length,
+                             SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (fd < 0) {
+                if (errno == EINTR || errno == ECONNABORTED) continue;
+                return; // EAGAIN, or out of descriptors until a connection closes
+            }
+            detail::setNoDelay(fd, peer);
+            std::size_t slot;
+            if (!freeSlots.empty()) {
+                slot = freeSlots.back();
+                freeSlots.pop_back();
+            } else {
+                slot = connections.size();
+                connections.emplace_back();
+            }
+            Connection& c = connections[slot];
+            c.fd = detail::Fd(fd);
+            c.in.clear();
+            c.out.clear();
+            c.sent = 0;
+            c.outstanding = 0;
+            c.readClosed = false;
+            c.interest = EPOLLIN;
+            watch(fd, EPOLLIN, connectionTag(slot, c.generation));
+            std::lock_guard<std::mutex> lock(metricsMutex);
+            ++live.connections;
+            ++live.openConnections;
+        }
+    }
+
+    void closeConnection(std::size_t slot) {
+        Connection& c = connections[slot];
+        if (c.fd.get() < 0) return;
+        epoll_ctl(epoll.get(), EPOLL_CTL_DEL, c.fd.get(), nullptr);
+        c.fd = detail::Fd();
+        ++c.generation; // Responses still in the micro-batch are dropped
+        c.in = std::vector<char>();
+        c.out = std::vector<char>();
+        freeSlots.push_back(slot);
+        std::lock_guard<std::mutex> lock(metricsMutex);
+        --live.openConnections;
+    }
+
+    void onConnection(std::uint64_t tag, std::uint32_t events) {
+        std::size_t slot = static_cast<std::size_t>(tag & 0xFFFFFFFFu) - firstConnectionTag;
+        if (slot >= connections.size()) return;
+        Connection& c = connections[slot];
+        if (c.fd.get() < 0 || c.generation != static_cast<std::uint32_t>(tag >> 32)) return; // Closed earlier
+        if (events & (EPOLLERR | EPOLLHUP)) {
+            // Reset, or gone in both directions: no response can be delivered
+            closeConnection(slot);
+            return;
+        }
+        if (events & EPOLLOUT) {
+            if (!writeOut(slot)) return;
+        }
+        if (events & EPOLLIN) {
+            if (!readIn(slot)) return;
+        }
+        finishIfDone(slot);
+    }
+
+    // Close a half-closed connection once every response is written
+    void finishIfDone(std::size_t slot) {
+        Connection& c = connections[slot];
+        if (c.fd.get() >= 0 && c.readClosed && c.outstanding == 0 && c.sent == c.out.size()) {
+            closeConnection(slot);
+        }
+    }
+
+    // Frames from the socket into the micro-batch; false if the connection closed
+    bool readIn(std::size_t slot) {
+        char buffer[16384];
+        for (;;) {
+            Connection& c = connections[slot];
+            if (c.fd.get() < 0 || c.readClosed || c.out.size() - c.sent >= options.maxOutput) break;
+            ssize_t got = ::read(c.fd.get(), buffer, sizeof buffer);
+            if (got < 0) {
+                if (errno == EINTR) continue;
+                if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+                closeConnection(slot);
+                return false;
+            }
+            if (got == 0) {
+                c.readClosed = true;
+                break;
+            }
+            if (!parse(slot, buffer, static_cast<std::size_t>(got), detail::nowNanoseconds())) {
+                {
+                    std::lock_guard<std::mutex> lock(metricsMutex);
+                    ++live.protocolErrors;
+                }
+                closeConnection(slot);
+                return false;
+            }
+        }
+        if (connections[slot].fd.get() < 0) return false;
+        updateInterest(slot);
+        return true;
+    }
+
+    // Complete frames join the micro-batch; a partial one waits in c.in.
+    // False on a malformed frame. A full batch flushes in add(), which may
+    // close this connection on a write error; parsing then stops.
+    bool parse(std::size_t slot, const char* p, std::size_t n, std::uint64_t arrival) {
+        Connection& c = connections[slot];
+        if (!c.in.empty()) {
+            std::size_t take = requestSize - c.in.size();
+            if (take > n) take = n;
+            c.in.insert(c.in.end(), p, p + take);
+            p += take;
+            n -= take;
+            if (c.in.size() < requestSize) return true;
+            if (!add(slot, c.in.data(), arrival)) return false;
+            c.in.clear();
+        }
+        for (; n >= requestSize && c.fd.get() >= 0; p += requestSize, n -= requestSize) {
+            if (!add(slot, p, arrival)) return false;
+        }
+        if (c.fd.get() >= 0) c.in.assign(p, p + n);
+        return true;
+    }
+
+    bool add(std::size_t slot, const char* frame, std::uint64_t arrival) {
+        using Stream::detail::loadLE64;
+        std::uint64_t last = loadLE64(frame + 32);
+        if (last >> 32) return false; // Reserved bytes
+        std::uint64_t bits[3] = {loadLE64(frame + 8), loadLE64(frame + 16), loadLE64(frame + 24)};
+        std::memcpy(&vpd[pending], &bits[0], 8);
+        std::memcpy(&pressure[pending], &bits[1], 8);
+        std::memcpy(&wind[pending], &bits[2], 8);
+        nozzle[pending] = static_cast<std::int32_t>(static_cast<std::uint32_t>(last));
+        Connection& c = connections[slot];
+        origin[pending] = {loadLE64(frame), arrival, static_cast<std::uint32_t>(slot), c.generation};
+        ++c.outstanding;
+        if (pending++ == 0 && options.maxWait.count() > 0) armTimer(arrival);
+        if (pending == options.maxBatch) flush(true);
+        return true;
+    }
+
+    void armTimer(std::uint64_t arrival) {
+        std::uint64_t deadline = arrival + static_cast<std::uint64_t>(
+                                               std::chrono::duration_cast<std::chrono::nanoseconds>(options.maxWait)
+                                                   .count());
+        // steady_clock is CLOCK_MONOTONIC on Linux
+        itimerspec spec = {};
+        spec.it_value.tv_sec = static_cast<time_t>(deadline / 1000000000u);
+        spec.it_value.tv_nsec = static_cast<long>(deadline % 1000000000u);
+        timerfd_settime(timer.get(), TFD_TIMER_ABSTIME, &spec, nullptr);
+    }
+
+    void disarmTimer() {
+        itimerspec spec = {};
+        timerfd_settime(timer.get(), 0, &spec, nullptr);
+    }
+
+    // Evaluate the micro-batch, queue each response and write what the sockets take
+    void flush(bool full) {
+        const std::size_t n = pending;
+        pending = 0;
+        if (options.maxWait.count() > 0) disarmTimer();
+        calculateBatch(options.engine, vpd.data(), nozzle.data(), pressure.data(), wind.data(), loss.data(), n);
+
+        touched.clear();
+        std::uint64_t responses = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            const Origin& o = origin[i];
+            Connection& c = connections[o.slot];
+            if (c.generation != o.generation) continue; // Closed since
+            --c.outstanding;
+            if (c.out.size() == c.sent) {
+                c.out.clear();
+                c.sent = 0;
+                touched.push_back(o.slot);
+            }
+            std::size_t at = c.out.size();
+            c.out.resize(at + responseSize);
+            char* p = c.out.data() + at;
+            std::uint64_t bits;
+            std::memcpy(&bits, &loss[i], 8);
+            Stream::detail::storeLE64(p, o.id);
+            Stream::detail::storeLE64(p + 8, bits);
+            Stream::detail::storeLE64(p + 16, checkInputs(vpd[i], nozzle[i], pressure[i], wind[i]));
+            ++responses;
+        }
+
+        // Recorded before the writes, so a client that has its responses sees them counted
+        std::uint64_t done = detail::nowNanoseconds();
+        {
+            std::lock_guard<std::mutex> lock(metricsMutex);
+            live.requests += n;
+            live.responses += responses;
+            ++live.batches;
+            live.fullBatches += full;
+            std::size_t bucket = 63u - static_cast<unsigned>(__builtin_clzll(n));
+            ++live.batchSizes[bucket < batchBuckets ? bucket : batchBuckets - 1];
+            for (std::size_t i = 0; i < n; ++i) live.latency.record(done - origin[i].arrival);
+        }
+        for (std::uint32_t slot : touched) {
+            if (connections[slot].fd.get() >= 0 && writeOut(slot)) finishIfDone(slot);
+        }
+    }
+
+    // Write queued responses; false if the connection closed
+    bool writeOut(std::size_t slot) {
+        Connection& c = connections[slot];
+        while (c.sent < c.out.size()) {
+            ssize_t put = ::send(c.fd.get(), c.out.data() + c.sent, c.out.size() - c.sent, MSG_NOSIGNAL);
+            if (put < 0) {
+                if (errno == EINTR) continue;
+                if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+                closeConnection(slot);
+                return false;
+            }
+            c.sent += static_cast<std::size_t>(put);
+        }
+        if (c.sent == c.out.size()) {
+            c.out.clear();
+            c.sent = 0;
+        }
+        updateInterest(slot);
+        return true;
+    }
+
+    Options options;
+    detail::Fd listener, epoll, wake, timer;
+    std::string bound_, unixPath;
+    int port_ = 0;
+    std::atomic<bool> stopping{false};
+
+    std::vector<Connection> connections;
+    std::vector<std::size_t> freeSlots;
+    std::vector<std::uint32_t> touched;
+
+    // The micro-batch, as columns for the batch kernels
+    std::vector<double> vpd, pressure, wind, loss;
+    std::vector<int> nozzle;
+    std::vector<Origin> origin;
+    std::size_t pending = 0;
+
+    mutable std::mutex metricsMutex;
+    Metrics live;
+};
+
+// Blocking client for one connection
+class Client {
+public:
+    explicit Client(const std::string& address) {
+        detail::Address a = detail::parseAddress(address, false);
+        socket_ = detail::Fd(socket(a.storage.ss_family, SOCK_STREAM | SOCK_CLOEXEC, 0));
+        if (socket_.get() < 0) throw detail::systemError("socket");
+        int rc;
+        do {
+            rc = connect(socket_.get(), reinterpret_cast<const sockaddr*>(&a.storage), a.length);
+        } while (rc != 0 && errno == EINTR);
+        if (rc != 0) throw detail::systemError("cannot connect to " + address);
+        detail::setNoDelay(socket_.get(), a.storage);
+    }
+
+    // Write n requests (pipelined; responses are not awaited)
+    void send(const Request* requests, std::size_t n) {
+        std::vector<char> frames(n * requestSize);
+        for (std::size_t i = 0; i < n; ++i) encodeRequest(frames.data() + i * requestSize, requests[i]);
+        const char* p = frames.data();
+        std::size_t left = frames.size();
+        while (left > 0) {
+            ssize_t put = ::send(socket_.get(), p, left, MSG_NOSIGNAL);
+            if (put < 0) {
+                if (errno == EINTR) continue;
+                throw detail::systemError("send");
+            }
+            p += put;
+            left -= static_cast<std::size_t>(put);
+        }
+    }
+
+    // Read n responses; throws if the server closes the connection first
+    void receive(Response* responses, std::size_t n) {
+        std::vector<char> frames(n * responseSize);
+        char* p = frames.data();
+        std::size_t left = frames.size();
+        while (left > 0) {
+            ssize_t got = ::recv(socket_.get(), p, left, 0);
+            if (got < 0) {
+                if (errno == EINTR) continue;
+                throw detail::systemError("recv");
+            }
+            if (got == 0) throw std::runtime_error("connection closed by the server");
+            p += got;
+            left -= static_cast<std::size_t>(got);
+        }
+        for (std::size_t i = 0; i < n; ++i) responses[i] = decodeResponse(frames.data() + i * responseSize);
+    }
+
+    // One round trip
+    Response evaluate(const Input& input, std::uint64_t id = 0) {
+        Request request{id, input};
+        send(&request, 1);
+        Response response;
+        receive(&response, 1);
+        return response;
+    }
+
+    // No more requests; responses to those sent still arrive
+    void shutdownSend() { ::shutdown(socket_.get(), SHUT_WR); }
+
+    int fd() const { return socket_.get(); }
+
+private:
+    detail::Fd socket_;
+};
+
+} // namespace Service
+} // namespace EvapSolver
+
+#endif // EVAP_SOLVER_SERVICE_H
@@ -0,0 +1,499 @@
+#ifndef EVAP_SOLVER_SIMD_H
+#define EVAP_SOLVER_SIMD_H
+
+// Vectorized batch kernels for the compact solver with runtime CPU dispatch.
+//
+// Every kernel runs the same lerp -> lerp2 -> reverse lerp(S6_flip) chain as
+// EvapSolver::Calculator::calculate(), using compare-and-count segment lookup
+// and gathers on the flat tables, and produces bit-identical results.
+//
+// GCC contracts a * b + c into an FMA whenever the target has one (target
+// attributes, -mfma, -march=native), even for -std=c++17. The chain is safe
+// only because every lerp and lerp2 divides last: y1 + (y2 - y1) * (x - x1) /
+// (x2 - x1) leaves no multiply feeding an add. A formula change that does
+// must turn contraction off with EVAP_SOLVER_NO_CONTRACT below, as the
+// polynomial and uncertainty kernels do; tests/run_tests.sh checks the
+// kernels at -O2 and -O3 -march=native.
+//
+// The float overloads run the same chain on FloatCalculator's tables with
+// twice as many lanes per vector.
+//
+// Usage:
+//   EvapSolver::Simd::calculateBatch(vpd, nozzle, pressure, wind, out, n);
+//   EvapSolver::Simd::kernelName(EvapSolver::Simd::activeKernel()); // "avx2", ...
+
+#include <cstddef>
+#include <cstdint>
+#include "evap_solver_compact.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define EVAP_SOLVER_SIMD_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define EVAP_SOLVER_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+// GCC contracts a * b + c into an FMA whenever the target has one, even for
+// -std=c++17 and inside AVX-512 intrinsics. Kernels whose scalar and vector
+// forms must round alike put this on every function of the chain.
+#if defined(__GNUC__) && !defined(__clang__)
+#define EVAP_SOLVER_NO_CONTRACT __attribute__((optimize("fp-contract=off")))
+#else
+#define EVAP_SOLVER_NO_CONTRACT
+#endif
+
+namespace EvapSolver {
+namespace Simd {
+
+// Available batch kernels, from slowest to fastest
+enum class Kernel { Scalar, AVX2, AVX512, NEON };
+
+inline const char* kernelName(Kernel k) {
+    switch (k) {
+        case Kernel::AVX2: return "avx2";
+        case Kernel::AVX512: return "avx512";
+        case Kernel::NEON: return "neon";
+        default: return "scalar";
+    }
+}
+
+// Whether the running CPU can execute kernel k
+inline bool isSupported(Kernel k) {
+    switch (k) {
+        case Kernel::Scalar: return true;
+#if defined(EVAP_SOLVER_SIMD_X86)
+        case Kernel::AVX2: return __builtin_cpu_supports("avx2");
+        case Kernel::AVX512: return __builtin_cpu_supports("avx512f");
+#elif defined(EVAP_SOLVER_SIMD_NEON)
+        case Kernel::NEON: return true;
+#endif
+        default: return false;
+    }
+}
+
+// Fastest kernel supported by the running CPU
+inline Kernel detectKernel() {
+    if (isSupported(Kernel::AVX512)) return Kernel::AVX512;
+    if (isSupported(Kernel::AVX2)) return Kernel::AVX2;
+    if (isSupported(Kernel::NEON)) return Kernel::NEON;
+    return Kernel::Scalar;
+}
+
+// Kernel used by calculateBatch() without an explicit choice (detected once)
+inline Kernel activeKernel() {
+    static const Kernel kernel = detectKernel();
+    return kernel;
+}
+
+namespace detail {
+
+using EvapSolver::detail::Scale;
+
+// Double kernels take the table set t: EvapSolver::detail::Tables<double>
+// for the built-in tables, or a runtime block (evap_solver_tables.h)
+template <class Tab>
+inline void scalarBatch(const Tab& t, const double* vpd, const int* nozzle, const double* pressure,
+                        const double* wind, double* out, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        out[i] = EvapSolver::detail::evaluate(t, vpd[i], nozzle[i], pressure[i], wind[i]);
+    }
+}
+
+inline void scalarBatch(const float* vpd, const int* nozzle, const float* pressure,
+                        const float* wind, float* out, std::size_t n) {
+    FloatCalculator::calculateBatch(vpd, nozzle, pressure, wind, out, n);
+}
+
+#if defined(EVAP_SOLVER_SIMD_X86)
+
+template <std::size_t N>
+__attribute__((target("avx2"))) inline __m256d lerpAvx2(const Scale<N>& s, __m256d v) {
+    // Compare-and-count: every tick below v adds one (mask lanes are -1)
+    __m256i count = _mm256_setzero_si256();
+    for (std::size_t k = 0; k < N; ++k) {
+        __m256d below = _mm256_cmp_pd(_mm256_set1_pd(s.x[k]), v, _CMP_LT_OQ);
+        count = _mm256_sub_epi64(count, _mm256_castpd_si256(below));
+    }
+    // Keep the segment index in [1, N-1] so the gathers stay inside the table
+    __m256i i = _mm256_sub_epi64(count, _mm256_cmpeq_epi64(count, _mm256_setzero_si256()));
+    i = _mm256_add_epi64(i, _mm256_cmpeq_epi64(i, _mm256_set1_epi64x(static_cast<long long>(N))));
+    __m256i im1 = _mm256_sub_epi64(i, _mm256_set1_epi64x(1));
+
+    __m256d x1 = _mm256_i64gather_pd(s.x, im1, 8);
+    __m256d x2 = _mm256_i64gather_pd(s.x, i, 8);
+    __m256d y1 = _mm256_i64gather_pd(s.y, im1, 8);
+    __m256d y2 = _mm256_i64gather_pd(s.y, i, 8);
+    __m256d r = _mm256_add_pd(y1, _mm256_div_pd(_mm256_mul_pd(_mm256_sub_pd(y2, y1), _mm256_sub_pd(v, x1)),
+                                                _mm256_sub_pd(x2, x1)));
+
+    // Clamp to the table ends; the lower end wins, as in the scalar lerp
+    __m256d hi = _mm256_cmp_pd(v, _mm256_set1_pd(s.x[N - 1]), _CMP_GE_OQ);
+    __m256d lo = _mm256_cmp_pd(v, _mm256_set1_pd(s.x[0]), _CMP_LE_OQ);
+    r = _mm256_blendv_pd(r, _mm256_set1_pd(s.y[N - 1]), hi);
+    return _mm256_blendv_pd(r, _mm256_set1_pd(s.y[0]), lo);
+}
+
+__attribute__((target("avx2"))) inline __m256d lerp2Avx2(double x, double x1, __m256d y1, double x2, __m256d y2) {
+    return _mm256_add_pd(y1, _mm256_div_pd(_mm256_mul_pd(_mm256_sub_pd(y2, y1), _mm256_set1_pd(x - x1)),
+                                           _mm256_set1_pd(x2 - x1)));
+}
+
+template <class Tab>
+__attribute__((target("avx2"))) inline void avx2Batch(const Tab& t, const double* vpd, const int* nozzle,
+                                                       const double* pressure, const double* wind, double* out,
+                                                       std::size_t n) {
+    using namespace EvapSolver::detail;
+
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d vn = _mm256_cvtepi32_pd(_mm_loadu_si128(reinterpret_cast<const __m128i*>(nozzle + i)));
+        __m256d y3 = lerpAvx2(t.S3, _mm256_loadu_pd(vpd + i));
+        __m256d y5 = lerpAvx2(t.S5, vn);
+        __m256d y7 = lerpAvx2(t.S7, _mm256_loadu_pd(pressure + i));
+        __m256d y9 = lerpAvx2(t.S9, _mm256_loadu_pd(wind + i));
+
+        __m256d yA = lerp2Avx2(x4, x3, y3, x5, y5);
+        __m256d yB = lerp2Avx2(x8, x7, y7, x9, y9);
+        __m256d yL = lerp2Avx2(x6, x4, yA, x8, yB);
+
+        _mm256_storeu_pd(out + i, lerpAvx2(t.S6_flip, yL));
+    }
+    if constexpr (Instrument::enabled) EvapSolver::detail::instrumentRecords(t, vpd, nozzle, pressure, wind, i);
+    scalarBatch(t, vpd + i, nozzle + i, pressure + i, wind + i, out + i, n - i);
+}
+
+// Single precision: eight lanes, 32-bit gather indices
+template <std::size_t N>
+__attribute__((target("avx2"))) inline __m256 lerpAvx2(const Scale<N, float>& s, __m256 v) {
+    __m256i count = _mm256_setzero_si256();
+    for (std::size_t k = 0; k < N; ++k) {
+        __m256 below = _mm256_cmp_ps(_mm256_set1_ps(s.x[k]), v, _CMP_LT_OQ);
+        count = _mm256_sub_epi32(count, _mm256_castps_si256(below));
+    }
+    __m256i i = _mm256_min_epi32(_mm256_max_epi32(count, _mm256_set1_epi32(1)),
+                                 _mm256_set1_epi32(static_cast<int>(N - 1)));
+    __m256i im1 = _mm256_sub_epi32(i, _mm256_set1_epi32(1));
+
+    __m256 x1 = _mm256_i32gather_ps(s.x, im1, 4);
+    __m256 x2 = _mm256_i32gather_ps(s.x, i, 4);
+    __m256 y1 = _mm256_i32gather_ps(s.y, im1, 4);
+    __m256 y2 = _mm256_i32gather_ps(s.y, i, 4);
+    __m256 r = _mm256_add_ps(y1, _mm256_div_ps(_mm256_mul_ps(_mm256_sub_ps(y2, y1), _mm256_sub_ps(v, x1)),
+                                               _mm256_sub_ps(x2, x1)));
+
+    __m256 hi = _mm256_cmp_ps(v, _mm256_set1_ps(s.x[N - 1]), _CMP_GE_OQ);
+    __m256 lo = _mm256_cmp_ps(v, _mm256_set1_ps(s.x[0]), _CMP_LE_OQ);
+    r = _mm256_blendv_ps(r, _mm256_set1_ps(s.y[N - 1]), hi);
+    return _mm256_blendv_ps(r, _mm256_set1_ps(s.y[0]), lo);
+}
+
+__attribute__((target("avx2"))) inline __m256 lerp2Avx2(float x, float x1, __m256 y1, float x2, __m256 y2) {
+    return _mm256_add_ps(y1, _mm256_div_ps(_mm256_mul_ps(_mm256_sub_ps(y2, y1), _mm256_set1_ps(x - x1)),
+                                           _mm256_set1_ps(x2 - x1)));
+}
+
+__attribute__((target("avx2"))) inline void avx2Batch(const float* vpd, const int* nozzle, const float* pressure,
+                                                       const float* wind, float* out, std::size_t n) {
+    using namespace EvapSolver::detail;
+    using Tab = Tables<float>;
+    const float c3 = x3, c4 = x4, c5 = x5, c6 = x6, c7 = x7, c8 = x8, c9 = x9;
+
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 vn = _mm256_cvtepi32_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(nozzle + i)));
+        __m256 y3 = lerpAvx2(Tab::S3, _mm256_loadu_ps(vpd + i));
+        __m256 y5 = lerpAvx2(Tab::S5, vn);
+        __m256 y7 = lerpAvx2(Tab::S7, _mm256_loadu_ps(pressure + i));
+        __m256 y9 = lerpAvx2(Tab::S9, _mm256_loadu_ps(wind + i));
+
+        __m256 yA = lerp2Avx2(c4, c3, y3, c5, y5);
+        __m256 yB = lerp2Avx2(c8, c7, y7, c9, y9);
+        __m256 yL = lerp2Avx2(c6, c4, yA, c8, yB);
+
+        _mm256_storeu_ps(out + i, lerpAvx2(Tab::S6_flip, yL));
+    }
+    if constexpr (Instrument::enabled) EvapSolver::detail::instrumentRecords(Tab{}, vpd, nozzle, pressure, wind, i);
+    scalarBatch(vpd + i, nozzle + i, pressure + i, wind + i, out + i, n - i);
+}
+
+// GCC's AVX-512 headers self-initialize their undefined vectors, which
+// -Wmaybe-uninitialized reports once the intrinsics are inlined
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+template <std::size_t N>
+__attribute__((target("avx512f"))) inline __m512d lerpAvx512(const Scale<N>& s, __m512d v) {
+    const __m512i one = _mm512_set1_epi64(1);
+    __m512i count = _mm512_setzero_si512();
+    for (std::size_t k = 0; k < N; ++k) {
+        __mmask8 below = _mm512_cmp_pd_mask(_mm512_set1_pd(s.x[k]), v, _CMP_LT_OQ);
+        count = _mm512_mask_add_epi64(count, below, count, one);
+    }
+    __m512i i = _mm512_min_epi64(_mm512_max_epi64(count, one), _mm512_set1_epi64(static_cast<long long>(N - 1)));
+    __m512i im1 = _mm512_sub_epi64(i, one);
+
+    __m512d x1 = _mm512_i64gather_pd(im1, s.x, 8);
+    __m512d x2 = _mm512_i64gather_pd(i, s.x, 8);
+    __m512d y1 = _mm512_i64gather_pd(im1, s.y, 8);
+    __m512d y2 = _mm512_i64gather_pd(i, s.y, 8);
+    __m512d r = _mm512_add_pd(y1, _mm512_div_pd(_mm512_mul_pd(_mm512_sub_pd(y2, y1), _mm512_sub_pd(v, x1)),
+                                                _mm512_sub_pd(x2, x1)));
+
+    __mmask8 hi = _mm512_cmp_pd_mask(v, _mm512_set1_pd(s.x[N - 1]), _CMP_GE_OQ);
+    __mmask8 lo = _mm512_cmp_pd_mask(v, _mm512_set1_pd(s.x[0]), _CMP_LE_OQ);
+    r = _mm512_mask_mov_pd(r, hi, _mm512_set1_pd(s.y[N - 1]));
+    return _mm512_mask_mov_pd(r, lo, _mm512_set1_pd(s.y[0]));
+}
+
+__attribute__((target("avx512f"))) inline __m512d lerp2Avx512(double x, double x1, __m512d y1, double x2, __m512d y2) {
+    return _mm512_add_pd(y1, _mm512_div_pd(_mm512_mul_pd(_mm512_sub_pd(y2, y1), _mm512_set1_pd(x - x1)),
+                                           _mm512_set1_pd(x2 - x1)));
+}
+
+template <class Tab>
+__attribute__((target("avx512f"))) inline void avx512Batch(const Tab& t, const double* vpd, const int* nozzle,
+                                                           const double* pressure, const double* wind, double* out,
+                                                           std::size_t n) {
+    using namespace EvapSolver::detail;
+
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m512d vn = _mm512_cvtepi32_pd(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(nozzle + i)));
+        __m512d y3 = lerpAvx512(t.S3, _mm512_loadu_pd(vpd + i));
+        __m512d y5 = lerpAvx512(t.S5, vn);
+        __m512d y7 = lerpAvx512(t.S7, _mm512_loadu_pd(pressure + i));
+        __m512d y9 = lerpAvx512(t.S9, _mm512_loadu_pd(wind + i));
+
+        __m512d yA = lerp2Avx512(x4, x3, y3, x5, y5);
+        __m512d yB = lerp2Avx512(x8, x7, y7, x9, y9);
+        __m512d yL = lerp2Avx512(x6, x4, yA, x8, yB);
+
+        _mm512_storeu_pd(out + i, lerpAvx512(t.S6_flip, yL));
+    }
+    if constexpr (Instrument::enabled) EvapSolver::detail::instrumentRecords(t, vpd, nozzle, pressure, wind, i);
+    scalarBatch(t, vpd + i, nozzle + i, pressure + i, wind + i, out + i, n - i);
+}
+
+// Single precision: sixteen lanes, 32-bit gather indices
+template <std::size_t N>
+__attribute__((target("avx512f"))) inline __m512 lerpAvx512(const Scale<N, float>& s, __m512 v) {
+    const __m512i one = _mm512_set1_epi32(1);
+    __m512i count = _mm512_setzero_si512();
+    for (std::size_t k = 0; k < N; ++k) {
+        __mmask16 below = _mm512_cmp_ps_mask(_mm512_set1_ps(s.x[k]), v, _CMP_LT_OQ);
+        count = _mm512_mask_add_epi32(count, below, count, one);
+    }
+    __m512i i = _mm512_min_epi32(_mm512_max_epi32(count, one), _mm512_set1_epi32(static_cast<int>(N - 1)));
+    __m512i im1 = _mm512_sub_epi32(i, one);
+
+    __m512 x1 = _mm512_i32gather_ps(im1, s.x, 4);
+    __m512 x2 = _mm512_i32gather_ps(i, s.x, 4);
+    __m512 y1 = _mm512_i32gather_ps(im1, s.y, 4);
+    __m512 y2 = _mm512_i32gather_ps(i, s.y, 4);
+    __m512 r = _mm512_add_ps(y1, _mm512_div_ps(_mm512_mul_ps(_mm512_sub_ps(y2, y1), _mm512_sub_ps(v, x1)),
+                                               _mm512_sub_ps(x2, x1)));
+
+    __mmask16 hi = _mm512_cmp_ps_mask(v, _mm512_set1_ps(s.x[N - 1]), _CMP_GE_OQ);
+    __mmask16 lo = _mm512_cmp_ps_mask(v, _mm512_set1_ps(s.x[0]), _CMP_LE_OQ);
+    r = _mm512_mask_mov_ps(r, hi, _mm512_set1_ps(s.y[N - 1]));
+    return _mm512_mask_mov_ps(r, lo, _mm512_set1_ps(s.y[0]));
+}
+
+__attribute__((target("avx512f"))) inline __m512 lerp2Avx512(float x, float x1, __m512 y1, float x2, __m512 y2) {
+    return _mm512_add_ps(y1, _mm512_div_ps(_mm512_mul_ps(_mm512_sub_ps(y2, y1), _mm512_set1_ps(x - x1)),
+                                           _mm512_set1_ps(x2 - x1)));
+}
+
+__attribute__((target("avx512f"))) inline void avx512Batch(const float* vpd, const int* nozzle, const float* pressure,
+                                                           const float* wind, float* out, std::size_t n) {
+    using namespace EvapSolver::detail;
+    using Tab = Tables<float>;
+    const float c3 = x3, c4 = x4, c5 = x5, c6 = x6, c7 = x7, c8 = x8, c9 = x9;
+
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m512 vn = _mm512_cvtepi32_ps(_mm512_loadu_si512(nozzle + i));
+        __m512 y3 = lerpAvx512(Tab::S3, _mm512_loadu_ps(vpd + i));
+        __m512 y5 = lerpAvx512(Tab::S5, vn);
+        __m512 y7 = lerpAvx512(Tab::S7, _mm512_loadu_ps(pressure + i));
+        __m512 y9 = lerpAvx512(Tab::S9, _mm512_loadu_ps(wind + i));
+
+        __m512 yA = lerp2Avx512(c4, c3, y3, c5, y5);
+        __m512 yB = lerp2Avx512(c8, c7, y7, c9, y9);
+        __m512 yL = lerp2Avx512(c6, c4, yA, c8, yB);
+
+        _mm512_storeu_ps(out + i, lerpAvx512(Tab::S6_flip, yL));
+    }
+    if constexpr (Instrument::enabled) EvapSolver::detail::instrumentRecords(Tab{}, vpd, nozzle, pressure, wind, i);
+    scalarBatch(vpd + i, nozzle + i, pressure + i, wind + i, out + i, n - i);
+}
+
+#pragma GCC diagnostic pop
+
+#elif defined(EVAP_SOLVER_SIMD_NEON)
+
+template <std::size_t N>
+inline float64x2_t lerpNeon(const Scale<N>& s, float64x2_t v) {
+    uint64x2_t count = vdupq_n_u64(0);
+    for (std::size_t k = 0; k < N; ++k) {
+        // Mask lanes are all ones, so subtracting adds one per tick below v
+        count = vsubq_u64(count, vcltq_f64(vdupq_n_f64(s.x[k]), v));
+    }
+    // NEON has no gather; the two lanes are loaded individually
+    double r[2];
+    double vv[2];
+    vst1q_f64(vv, v);
+    for (int lane = 0; lane < 2; ++lane) {
+        std::size_t i = static_cast<std::size_t>(lane == 0 ? vgetq_lane_u64(count, 0) : vgetq_lane_u64(count, 1));
+        i += (i == 0);
+        i -= (i == N);
+        r[lane] = s.y[i - 1] + (s.y[i] - s.y[i - 1]) * (vv[lane] - s.x[i - 1]) / (s.x[i] - s.x[i - 1]);
+    }
+    float64x2_t res = vld1q_f64(r);
+    uint64x2_t hi = vcgeq_f64(v, vdupq_n_f64(s.x[N - 1]));
+    uint64x2_t lo = vcleq_f64(v, vdupq_n_f64(s.x[0]));
+    res = vbslq_f64(hi, vdupq_n_f64(s.y[N - 1]), res);
+    return vbslq_f64(lo, vdupq_n_f64(s.y[0]), res);
+}
+
+inline float64x2_t lerp2Neon(double x, double x1, float64x2_t y1, double x2, float64x2_t y2) {
+    return vaddq_f64(y1, vdivq_f64(vmulq_f64(vsubq_f64(y2, y1), vdupq_n_f64(x - x1)), vdupq_n_f64(x2 - x1)));
+}
+
+template <class Tab>
+inline void neonBatch(const Tab& t, const double* vpd, const int* nozzle, const double* pressure,
+                      const double* wind, double* out, std::size_t n) {
+    using namespace EvapSolver::detail;
+
+    std::size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        float64x2_t vn = vcvtq_f64_s64(vmovl_s32(vld1_s32(nozzle + i)));
+        float64x2_t y3 = lerpNeon(t.S3, vld1q_f64(vpd + i));
+        float64x2_t y5 = lerpNeon(t.S5, vn);
+        float64x2_t y7 = lerpNeon(t.S7, vld1q_f64(pressure + i));
+        float64x2_t y9 = lerpNeon(t.S9, vld1q_f64(wind + i));
+
+        float64x2_t yA = lerp2Neon(x4, x3, y3, x5, y5);
+        float64x2_t yB = lerp2Neon(x8, x7, y7, x9, y9);
+        float64x2_t yL = lerp2Neon(x6, x4, yA, x8, yB);
+
+        vst1q_f64(out + i, lerpNeon(t.S6_flip, yL));
+    }
+    if constexpr (Instrument::enabled) EvapSolver::detail::instrumentRecords(t, vpd, nozzle, pressure, wind, i);
+    scalarBatch(t, vpd + i, nozzle + i, pressure + i, wind + i, out + i, n - i);
+}
+
+// Single precision: four lanes
+template <std::size_t N>
+inline float32x4_t lerpNeon(const Scale<N, float>& s, float32x4_t v) {
+    uint32x4_t count = vdupq_n_u32(0);
+    for (std::size_t k = 0; k < N; ++k) {
+        count = vsubq_u32(count, vcltq_f32(vdupq_n_f32(s.x[k]), v));
+    }
+    std::uint32_t idx[4];
+    float r[4];
+    float vv[4];
+    vst1q_u32(idx, count);
+    vst1q_f32(vv, v);
+    for (int lane = 0; lane < 4; ++lane) {
+        std::size_t i = idx[lane];
+        i += (i == 0);
+        i -= (i == N);
+        r[lane] = s.y[i - 1] + (s.y[i] - s.y[i - 1]) * (vv[lane] - s.x[i - 1]) / (s.x[i] - s.x[i - 1]);
+    }
+    float32x4_t res = vld1q_f32(r);
+    uint32x4_t hi = vcgeq_f32(v, vdupq_n_f32(s.x[N - 1]));
+    uint32x4_t lo = vcleq_f32(v, vdupq_n_f32(s.x[0]));
+    res = vbslq_f32(hi, vdupq_n_f32(s.y[N - 1]), res);
+    return vbslq_f32(lo, vdupq_n_f32(s.y[0]), res);
+}
+
+inline float32x4_t lerp2Neon(float x, float x1, float32x4_t y1, float x2, float32x4_t y2) {
+    return vaddq_f32(y1, vdivq_f32(vmulq_f32(vsubq_f32(y2, y1), vdupq_n_f32(x - x1)), vdupq_n_f32(x2 - x1)));
+}
+
+inline void neonBatch(const float* vpd, const int* nozzle, const float* pressure,
+                      const float* wind, float* out, std::size_t n) {
+    using namespace EvapSolver::detail;
+    using Tab = Tables<float>;
+    const float c3 = x3, c4 = x4, c5 = x5, c6 = x6, c7 = x7, c8 = x8, c9 = x9;
+
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        float32x4_t vn = vcvtq_f32_s32(vld1q_s32(nozzle + i));
+        float32x4_t y3 = lerpNeon(Tab::S3, vld1q_f32(vpd + i));
+        float32x4_t y5 = lerpNeon(Tab::S5, vn);
+        float32x4_t y7 = lerpNeon(Tab::S7, vld1q_f32(pressure + i));
+        float32x4_t y9 = lerpNeon(Tab::S9, vld1q_f32(wind + i));
+
+        float32x4_t yA = lerp2Neon(c4, c3, y3, c5, y5);
+        float32x4_t yB = lerp2Neon(c8, c7, y7, c9, y9);
+        float32x4_t yL = lerp2Neon(c6, c4, yA, c8, yB);
+
+        vst1q_f32(out + i, lerpNeon(Tab::S6_flip, yL));
+    }
+    if constexpr (Instrument::enabled) EvapSolver::detail::instrumentRecords(Tab{}, vpd, nozzle, pressure, wind, i);
+    scalarBatch(vpd + i, nozzle + i, pressure + i, wind + i, out + i, n - i);
+}
+
+#endif
+
+// Run the double kernel k (or the scalar kernel if unsupported) on table set t
+template <class Tab>
+inline void dispatchBatch(Kernel k, const Tab& t, const double* vpd, const int* nozzle, const double* pressure,
+                          const double* wind, double* out, std::size_t n) {
+    Instrument::BatchTimer timer(n);
+    if (!isSupported(k)) k = Kernel::Scalar;
+    switch (k) {
+#if defined(EVAP_SOLVER_SIMD_X86)
+        case Kernel::AVX512: avx512Batch(t, vpd, nozzle, pressure, wind, out, n); return;
+        case Kernel::AVX2: avx2Batch(t, vpd, nozzle, pressure, wind, out, n); return;
+#elif defined(EVAP_SOLVER_SIMD_NEON)
+        case Kernel::NEON: neonBatch(t, vpd, nozzle, pressure, wind, out, n); return;
+#endif
+        default: scalarBatch(t, vpd, nozzle, pressure, wind, out, n); return;
+    }
+}
+
+} // namespace detail
+
+// Calculate evaporation loss for n records with an explicit kernel.
+// Falls back to the scalar kernel if k is not supported on this CPU.
+inline void calculateBatch(Kernel k, const double* vpd, const int* nozzle, const double* pressure,
+                           const double* wind, double* out, std::size_t n) {
+    detail::dispatchBatch(k, EvapSolver::detail::Tables<double>{}, vpd, nozzle, pressure, wind, out, n);
+}
+
+// Calculate evaporation loss for n records with the fastest supported kernel
+inline void calculateBatch(const double* vpd, const int* nozzle, const double* pressure,
+                           const double* wind, double* out, std::size_t n) {
+    calculateBatch(activeKernel(), vpd, nozzle, pressure, wind, out, n);
+}
+
+// Single-precision batch with an explicit kernel (twice the lanes of the
+// double kernels). out[i] is bit-identical to FloatCalculator::calculate().
+inline void calculateBatch(Kernel k, const float* vpd, const int* nozzle, const float* pressure,
+                           const float* wind, float* out, std::size_t n) {
+    Instrument::BatchTimer timer(n);
+    if (!isSupported(k)) k = Kernel::Scalar;
+    switch (k) {
+#if defined(EVAP_SOLVER_SIMD_X86)
+        case Kernel::AVX512: detail::avx512Batch(vpd, nozzle, pressure, wind, out, n); return;
+        case Kernel::AVX2: detail::avx2Batch(vpd, nozzle, pressure, wind, out, n); return;
+#elif defined(EVAP_SOLVER_SIMD_NEON)
+        case Kernel::NEON: detail::neonBatch(vpd, nozzle, pressure, wind, out, n); return;
+#endif
+        default: detail::scalarBatch(vpd, nozzle, pressure, wind, out, n); return;
+    }
+}
+
+inline void calculateBatch(const float* vpd, const int* nozzle, const float* pressure,
+                           const float* wind, float* out, std::size_t n) {
+    calculateBatch(activeKernel(), vpd, nozzle, pressure, wind, out, n);
+}
+
+} // namespace Simd
+} // namespace EvapSolver
+
+#endif // EVAP_SOLVER_SIMD_H
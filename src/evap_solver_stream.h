@@ -0,0 +1,480 @@
+#ifndef EVAP_SOLVER_STREAM_H
+#define EVAP_SOLVER_STREAM_H
+
+// Streaming batch processor for CSV and binary record files (POSIX).
+//
+// Three stages overlap in a bounded pipeline:
+//   parse thread    reads records into a fixed pool of column batches
+//   calling thread  evaluates each batch on the thread pool
+//   write thread    formats and writes the results
+// Batches are recycled through the pool, so memory use is set by
+// batchSize * depth and does not depend on the input size. Regular files
+// are mmap'ed and parsed in place; pipes and terminals are read in blocks.
+//
+// Input formats:
+//   csv     vpd,nozzle,pressure,wind per line. Blank lines and lines
+//           starting with '#' are skipped, as is one header line (the first
+//           other line, if it has letters and its first field is not a
+//           number). Fields may be padded with spaces, tabs or a trailing
+//           '\r'.
+//   binary  32-byte little-endian records:
+//           f64 vpd, f64 pressure, f64 wind, i32 nozzle, u32 reserved
+// Output formats:
+//   csv     one loss per line, shortest round-trip decimal
+//   binary  f64 little-endian loss per record
+//
+// Usage:
+//   EvapSolver::Stream::Options options;
+//   options.engine = EvapSolver::Engine::Separable;
+//   EvapSolver::Stream::Stats stats = EvapSolver::Stream::process("in.csv", "out.csv", options);
+
+#include <cerrno>
+#include <charconv>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "evap_solver_endian.h"
+#include "evap_solver_engines.h"
+#include "evap_solver_parallel.h"
+
+namespace EvapSolver {
+namespace Stream {
+
+enum class Format { Csv, Binary };
+
+inline const char* formatName(Format f) {
+    return f == Format::Binary ? "binary" : "csv";
+}
+
+// Parse a format name as returned by formatName(); false if unknown
+inline bool parseFormat(const char* name, Format& f) {
+    if (std::strcmp(name, "csv") == 0) {
+        f = Format::Csv;
+    } else if (std::strcmp(name, "binary") == 0) {
+        f = Format::Binary;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// Size of one binary input record
+inline constexpr std::size_t binaryRecordSize = 32;
+
+struct Options {
+    Format inputFormat = Format::Csv;
+    Format outputFormat = Format::Csv;
+    Engine engine = Engine::Exact;
+    unsigned threads = 0;                // Compute threads incl. the caller; 0 = hardware concurrency
+    std::size_t batchSize = 65536;       // Records per pipeline batch
+    std::size_t depth = 4;               // Batches in flight across the three stages
+    std::size_t readBlockSize = 1 << 20; // Read size for non-mappable inputs (pipes, terminals)
+};
+
+struct Stats {
+    std::size_t records = 0;
+    std::size_t batches = 0;
+    bool mapped = false; // Input was parsed in place from an mmap'ed file
+};
+
+namespace detail {
+
+// Column batch; capacity is fixed at construction and never grows
+struct Batch {
+    std::vector<double> vpd, pressure, wind, loss;
+    std::vector<int> nozzle;
+    std::vector<char> text; // Formatted output
+    std::size_t count = 0;
+    std::size_t textSize = 0;
+    bool last = false;
+
+    explicit Batch(std::size_t capacity)
+        : vpd(capacity), pressure(capacity), wind(capacity), loss(capacity), nozzle(capacity),
+          text(capacity * 32) {}
+};
+
+// Blocking FIFO of batch pointers. The pipeline never holds more batches
+// than it allocated, so the queues need no bound of their own.
+class BatchQueue {
+public:
+    void push(Batch* b) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            items.push_back(b);
+        }
+        ready.notify_one();
+    }
+
+    // nullptr once the queue is closed and drained
+    Batch* pop() {
+        std::unique_lock<std::mutex> lock(mutex);
+        ready.wait(lock, [this] { return !items.empty() || closed; });
+        if (items.empty()) return nullptr;
+        Batch* b = items.front();
+        items.pop_front();
+        return b;
+    }
+
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            closed = true;
+        }
+        ready.notify_all();
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable ready;
+    std::deque<Batch*> items;
+    bool closed = false;
+};
+
+// Input bytes: the whole file when it can be mapped, otherwise a block
+// buffer refilled from the descriptor that keeps any unconsumed tail
+class Source {
+public:
+    Source(int fd, std::size_t blockSize) : fd(fd) {
+        struct stat st;
+        if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+            void* p = mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p != MAP_FAILED) {
+                madvise(p, static_cast<std::size_t>(st.st_size), MADV_SEQUENTIAL);
+                map = static_cast<const char*>(p);
+                mapSize = static_cast<std::size_t>(st.st_size);
+                begin = released = map;
+                end = map + mapSize;
+                eof = true;
+                return;
+            }
+        }
+        buffer.resize(blockSize ? blockSize : 1);
+        begin = end = buffer.data();
+    }
+
+    ~Source() {
+        if (map) munmap(const_cast<char*>(map), mapSize);
+    }
+
+    Source(const Source&) = delete;
+    Source& operator=(const Source&) = delete;
+
+    bool mapped() const { return map != nullptr; }
+
+    // Drop the mapped pages already parsed, so resident memory stays flat
+    // on inputs larger than RAM
+    void release() {
+        if (!map) return;
+        static const std::size_t page = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+        const char* upTo = map + static_cast<std::size_t>(begin - map) / page * page;
+        if (upTo > released) {
+            madvise(const_cast<char*>(released), static_cast<std::size_t>(upTo - released), MADV_DONTNEED);
+            released = upTo;
+        }
+    }
+
+    // Read more bytes after the unconsumed ones; false at end of input
+    bool refill() {
+        if (eof) return false;
+        std::size_t offset = static_cast<std::size_t>(begin - buffer.data());
+        std::size_t pending = static_cast<std::size_t>(end - begin);
+        std::memmove(buffer.data(), buffer.data() + offset, pending);
+        if (pending == buffer.size()) buffer.resize(buffer.size() * 2); // Record longer than a block
+        begin = buffer.data();
+        end = begin + pending;
+        for (;;) {
+            ssize_t got = read(fd, buffer.data() + pending, buffer.size() - pending);
+            if (got > 0) {
+                end += got;
+                return true;
+            }
+            if (got == 0) {
+                eof = true;
+                return false;
+            }
+            if (errno != EINTR) throw std::runtime_error("read failed: " + std::string(std::strerror(errno)));
+        }
+    }
+
+    const char* begin = nullptr; // First unconsumed byte
+    const char* end = nullptr;
+
+private:
+    int fd;
+    const char* map = nullptr;
+    std::size_t mapSize = 0;
+    const char* released = nullptr; // Pages before this have been dropped
+    std::vector<char> buffer;
+    bool eof = false;
+};
+
+inline bool isBlank(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+template <class T>
+const char* parseField(const char* p, const char* end, T& value, bool lastField) {
+    while (p < end && isBlank(*p)) ++p;
+    auto result = std::from_chars(p, end, value);
+    if (result.ec != std::errc()) return nullptr;
+    p = result.ptr;
+    while (p < end && isBlank(*p)) ++p;
+    if (lastField) return p == end ? p : nullptr;
+    return p < end && *p == ',' ? p + 1 : nullptr;
+}
+
+// Parses CSV lines into batches
+class CsvParser {
+public:
+    explicit CsvParser(Source& source) : source(source) {}
+
+    // Fill b with up to its capacity; false when the input is exhausted
+    bool fill(Batch& b) {
+        b.count = 0;
+        const std::size_t capacity = b.vpd.size();
+        while (b.count < capacity) {
+            const char* newline;
+            for (;;) {
+                newline = static_cast<const char*>(
+                    std::memchr(source.begin, '\n', static_cast<std::size_t>(source.end - source.begin)));
+                if (newline || !source.refill()) break;
+            }
+            if (!newline && source.begin == source.end) return false;
+
+            // The last line may lack its newline
+            ++line;
+            parseLine(source.begin, newline ? newline : source.end, b);
+            source.begin = newline ? newline + 1 : source.end;
+        }
+        return true;
+    }
+
+private:
+    void parseLine(const char* p, const char* end, Batch& b) {
+        const char* first = p;
+        while (first < end && isBlank(*first)) ++first;
+        if (first == end || *first == '#') return;
+
+        std::size_t i = b.count;
+        const char* q = parseField(p, end, b.vpd[i], false);
+        if (q) q = parseField(q, end, b.nozzle[i], false);
+        if (q) q = parseField(q, end, b.pressure[i], false);
+        if (q) q = parseField(q, end, b.wind[i], true);
+        double field;
+        bool header = !sawLine && !q && !parseField(p, end, field, false) && hasLetter(p, end);
+        sawLine = true;
+        if (q) {
+            ++b.count;
+        } else if (!header) {
+            throw std::runtime_error("line " + std::to_string(line) +
+                                     ": expected vpd,nozzle,pressure,wind");
+        }
+    }
+
+    static bool hasLetter(const char* p, const char* end) {
+        for (; p < end; ++p) {
+            if ((*p >= 'a' && *p <= 'z') || (*p >= 'A' && *p <= 'Z')) return true;
+        }
+        return false;
+    }
+
+    Source& source;
+    std::size_t line = 0;
+    bool sawLine = false; // A header is only accepted as the first non-blank, non-comment line
+};
+
+using EvapSolver::detail::loadLE64;
+using EvapSolver::detail::storeLE64;
+
+// Parses fixed-width binary records into batches
+class BinaryParser {
+public:
+    explicit BinaryParser(Source& source) : source(source) {}
+
+    bool fill(Batch& b) {
+        b.count = 0;
+        const std::size_t capacity = b.vpd.size();
+        while (b.count < capacity) {
+            std::size_t available = static_cast<std::size_t>(source.end - source.begin);
+            if (available < binaryRecordSize) {
+                if (source.refill()) continue;
+                if (available != 0) {
+                    throw std::runtime_error("truncated binary record at end of input (" +
+                                             std::to_string(available) + " bytes)");
+                }
+                return false;
+            }
+            std::size_t take = available / binaryRecordSize;
+            if (take > capacity - b.count) take = capacity - b.count;
+            for (std::size_t r = 0; r < take; ++r, ++b.count, source.begin += binaryRecordSize) {
+                const char* p = source.begin;
+                b.vpd[b.count] = toDouble(loadLE64(p));
+                b.pressure[b.count] = toDouble(loadLE64(p + 8));
+                b.wind[b.count] = toDouble(loadLE64(p + 16));
+                b.nozzle[b.count] = static_cast<std::int32_t>(static_cast<std::uint32_t>(loadLE64(p + 24)));
+            }
+        }
+        return true;
+    }
+
+private:
+    static double toDouble(std::uint64_t bits) {
+        double d;
+        std::memcpy(&d, &bits, sizeof d);
+        return d;
+    }
+
+    Source& source;
+};
+
+inline void formatBatch(Batch& b, Format format) {
+    char* out = b.text.data();
+    if (format == Format::Binary) {
+        for (std::size_t i = 0; i < b.count; ++i, out += 8) {
+            std::uint64_t bits;
+            std::memcpy(&bits, &b.loss[i], sizeof bits);
+            storeLE64(out, bits);
+        }
+    } else {
+        char* end = b.text.data() + b.text.size();
+        for (std::size_t i = 0; i < b.count; ++i) {
+            out = std::to_chars(out, end, b.loss[i]).ptr;
+            *out++ = '\n';
+        }
+    }
+    b.textSize = static_cast<std::size_t>(out - b.text.data());
+}
+
+inline void writeAll(int fd, const char* p, std::size_t n) {
+    while (n > 0) {
+        ssize_t put = write(fd, p, n);
+        if (put < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error("write failed: " + std::string(std::strerror(errno)));
+        }
+        p += put;
+        n -= static_cast<std::size_t>(put);
+    }
+}
+
+} // namespace detail
+
+// Stream every record from inFd to outFd. Throws std::runtime_error on
+// malformed input or I/O errors; results written before the error remain.
+inline Stats process(int inFd, int outFd, const Options& options = Options()) {
+    using detail::Batch;
+    const std::size_t capacity = options.batchSize ? options.batchSize : 1;
+    const std::size_t depth = options.depth ? options.depth : 1;
+
+    std::vector<std::unique_ptr<Batch>> batches;
+    detail::BatchQueue freeQueue, parsedQueue, computedQueue;
+    for (std::size_t i = 0; i < depth; ++i) {
+        batches.emplace_back(new Batch(capacity));
+        freeQueue.push(batches.back().get());
+    }
+
+    Parallel::ThreadPool pool({options.threads, 16384, false});
+    detail::Source source(inFd, options.readBlockSize);
+    Stats stats;
+    stats.mapped = source.mapped();
+
+    std::exception_ptr parseError, writeError;
+
+    std::thread parser([&] {
+        try {
+            detail::CsvParser csv(source);
+            detail::BinaryParser binary(source);
+            for (;;) {
+                Batch* b = freeQueue.pop();
+                if (!b) break;
+                bool more = options.inputFormat == Format::Binary ? binary.fill(*b) : csv.fill(*b);
+                source.release();
+                b->last = !more;
+                parsedQueue.push(b);
+                if (!more) break;
+            }
+        } catch (...) {
+            parseError = std::current_exception();
+        }
+        parsedQueue.close();
+    });
+
+    std::thread writer([&] {
+        try {
+            while (Batch* b = computedQueue.pop()) {
+                detail::formatBatch(*b, options.outputFormat);
+                detail::writeAll(outFd, b->text.data(), b->textSize);
+                bool last = b->last;
+                freeQueue.push(b);
+                if (last) break;
+            }
+        } catch (...) {
+            writeError = std::current_exception();
+        }
+        // Unblock the parser if it is waiting for a free batch
+        freeQueue.close();
+        while (computedQueue.pop()) {
+        }
+    });
+
+    while (Batch* b = parsedQueue.pop()) {
+        pool.parallelFor(b->count, [&](std::size_t begin, std::size_t end) {
+            calculateBatch(options.engine, b->vpd.data() + begin, b->nozzle.data() + begin,
+                           b->pressure.data() + begin, b->wind.data() + begin, b->loss.data() + begin,
+                           end - begin);
+        });
+        stats.records += b->count;
+        stats.batches += b->count != 0;
+        computedQueue.push(b);
+    }
+    computedQueue.close();
+
+    writer.join();
+    parser.join();
+    if (parseError) std::rethrow_exception(parseError);
+    if (writeError) std::rethrow_exception(writeError);
+    return stats;
+}
+
+// Path-based form; "-" selects stdin / stdout
+inline Stats process(const std::string& inputPath, const std::string& outputPath,
+                     const Options& options = Options()) {
+    int inFd = inputPath == "-" ? STDIN_FILENO : open(inputPath.c_str(), O_RDONLY);
+    if (inFd < 0) throw std::runtime_error("cannot open " + inputPath + ": " + std::strerror(errno));
+    int outFd = outputPath == "-" ? STDOUT_FILENO : open(outputPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (outFd < 0) {
+        int err = errno;
+        if (inFd != STDIN_FILENO) close(inFd);
+        throw std::runtime_error("cannot open " + outputPath + ": " + std::strerror(err));
+    }
+
+    struct Closer {
+        int in, out;
+        ~Closer() {
+            if (in != STDIN_FILENO) close(in);
+            if (out != STDOUT_FILENO) close(out);
+        }
+    } closer{inFd, outFd};
+
+    return process(inFd, outFd, options);
+}
+
+} // namespace Stream
+} // namespace EvapSolver
+
+#endif // EVAP_SOLVER_STREAM_H
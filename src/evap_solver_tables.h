@@ -0,0 +1,443 @@
+#ifndef EVAP_SOLVER_TABLES_H
+#define EVAP_SOLVER_TABLES_H
+
+// Runtime-loadable nomograph tables.
+//
+// NomographTables holds a calibrated set of the five scales (S3 vpd, S5
+// nozzle, S7 pressure, S9 wind, S6 loss), loaded from a file or copied from
+// the built-in Frost & Schwalen ticks. On construction the scales are
+// validated, S6 is flipped for the reverse lookup, and everything the
+// engines read is laid out in one 64-byte-aligned block: each scale as
+// separate x[] and y[] arrays starting on its own cache line, the weighted
+// scales of the separable engine, and a grid index per scale. Engines take
+// the block by reference, so a call costs one pointer more than the
+// built-in tables and nothing else; with defaults() every engine returns
+// results bit-identical to its built-in form.
+//
+// Tick counts are those of the printed nomograph (11, 11, 11, 15 and 14
+// ticks); only the positions and ordinates are calibrated. Every scale must
+// have strictly increasing x and monotone y, S6 strictly monotone y, and no
+// tick gap below 1/512 of the scale's span (the grid index size limit).
+//
+// Text format: one tick per line, "<scale> <x> <y>", ticks of a scale in
+// increasing x. Blank lines and lines starting with '#' are skipped. S6 is
+// written as printed, loss (%) first:
+//   S3 0.1 0.221
+//   S6 0.5 0.252
+// Binary format (little-endian): char[4] "EVTB", u32 version (1), then for
+// S3, S5, S7, S9, S6: u32 tick count, f64 x[count], f64 y[count].
+//
+// Usage:
+//   EvapSolver::NomographTables tables = EvapSolver::NomographTables::loadText("calibrated.txt");
+//   double loss = tables.calculate({0.6, 12, 40, 5});
+//   EvapSolver::Simd::calculateBatch(tables, vpd, nozzle, pressure, wind, out, n);
+
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include "evap_solver_compact.h"
+#include "evap_solver_endian.h"
+#include "evap_solver_polynomial.h"
+#include "evap_solver_separable.h"
+#include "evap_solver_simd.h"
+
+namespace EvapSolver {
+namespace detail {
+
+// Largest grid index of a runtime scale
+inline constexpr std::size_t maxGridCells = 1024;
+
+// GridIndex with the cell count chosen at load time
+struct TableGrid {
+    double x0;
+    double invH;
+    double limit;     // Cell count - 1, for the clamp
+    std::size_t last; // The same as an index
+    unsigned char seg[maxGridCells];
+};
+
+template <std::size_t N>
+inline TableGrid makeTableGrid(const Scale<N>& s) {
+    static_assert(N < 256, "segment indices are stored as unsigned char");
+    std::size_t cells = gridCells(s);
+    TableGrid g{};
+    double span = s.x[N - 1] - s.x[0];
+    g.x0 = s.x[0];
+    g.invH = cells / span;
+    g.last = cells - 1;
+    g.limit = static_cast<double>(g.last);
+    for (std::size_t c = 0; c < cells; ++c) {
+        std::size_t i = segment(s, s.x[0] + span * c / cells);
+        g.seg[c] = static_cast<unsigned char>(i < N ? i : N - 1);
+    }
+    return g;
+}
+
+// Same as gridSegment() on a GridIndex
+template <std::size_t N>
+EVAP_SOLVER_HD inline std::size_t gridSegment(const Scale<N>& s, const TableGrid& g, double v) {
+    double t = (v - g.x0) * g.invH;
+    std::size_t c = t > 0 ? (t < g.limit ? static_cast<std::size_t>(t) : g.last) : 0;
+    std::size_t i = g.seg[c];
+    i += (s.x[i] < v);
+    i -= (s.x[i - 1] >= v);
+    return i;
+}
+
+// Linear interpolation with a runtime grid; identical to lerp(s, v)
+template <std::size_t N>
+EVAP_SOLVER_HD inline double lerp(const Scale<N>& s, const TableGrid& g, double v) {
+    if (v <= s.x[0]) return s.y[0];
+    if (v >= s.x[N - 1]) return s.y[N - 1];
+
+    std::size_t i = gridSegment(s, g, v);
+    return s.y[i - 1] + (s.y[i] - s.y[i - 1]) * (v - s.x[i - 1]) / (s.x[i] - s.x[i - 1]);
+}
+
+// Every table an engine reads, in one aligned block. Hot scales first; the
+// grids are only touched in their first (last + 1) cells.
+struct alignas(64) TableBlock {
+    alignas(64) Scale<11> S3;
+    alignas(64) Scale<11> S5;
+    alignas(64) Scale<11> S7;
+    alignas(64) Scale<15> S9;
+    alignas(64) Scale<14> S6_flip;
+    alignas(64) Scale<11> S3w; // Separable engine: ordinates times w3, w7, w9
+    alignas(64) Scale<11> S7w;
+    alignas(64) Scale<15> S9w;
+    alignas(64) NozzleTable N5w;
+    alignas(64) FullPolynomialFit poly; // Polynomial engine: a breakpoint at every tick
+    alignas(64) TableGrid S3_grid;
+    alignas(64) TableGrid S5_grid;
+    alignas(64) TableGrid S7_grid;
+    alignas(64) TableGrid S9_grid;
+    alignas(64) TableGrid S6_flip_grid;
+};
+
+// Swap x and y; a decreasing S6 is reversed so x increases
+template <std::size_t N>
+inline Scale<N> flipScale(const Scale<N>& s) {
+    bool rising = s.y[N - 1] > s.y[0];
+    Scale<N> out{};
+    for (std::size_t i = 0; i < N; ++i) {
+        std::size_t k = rising ? i : N - 1 - i;
+        out.x[i] = s.y[k];
+        out.y[i] = s.x[k];
+    }
+    return out;
+}
+
+template <std::size_t N>
+inline void validateScale(const char* name, const Scale<N>& s, bool strictY) {
+    auto fail = [&](const std::string& what) { throw std::runtime_error(std::string(name) + ": " + what); };
+    for (std::size_t i = 0; i < N; ++i) {
+        if (!std::isfinite(s.x[i]) || !std::isfinite(s.y[i])) fail("tick " + std::to_string(i) + " is not finite");
+    }
+    bool rising = s.y[N - 1] > s.y[0];
+    for (std::size_t i = 1; i < N; ++i) {
+        if (!(s.x[i] > s.x[i - 1])) fail("x must be strictly increasing (tick " + std::to_string(i) + ")");
+        double dy = rising ? s.y[i] - s.y[i - 1] : s.y[i - 1] - s.y[i];
+        if (dy < 0 || (strictY && dy == 0)) {
+            fail(std::string("y must be ") + (strictY ? "strictly " : "") + "monotone (tick " + std::to_string(i) +
+                 ")");
+        }
+    }
+}
+
+template <std::size_t N>
+inline void validateGrid(const char* name, const Scale<N>& s) {
+    if (gridCells(s) > maxGridCells) {
+        throw std::runtime_error(std::string(name) + ": ticks closer than 1/" + std::to_string(maxGridCells / 2) +
+                                 " of the scale span");
+    }
+}
+
+} // namespace detail
+
+class NomographTables {
+public:
+    // Built-in Frost & Schwalen tables
+    NomographTables()
+        : NomographTables(detail::S3, detail::S5, detail::S7, detail::S9, detail::flipScale(detail::S6_flip)) {}
+
+    // Scales as printed; s6 maps loss (%) to its ordinate and is flipped here.
+    // Throws std::runtime_error naming the first invalid scale.
+    NomographTables(const detail::Scale<11>& s3, const detail::Scale<11>& s5, const detail::Scale<11>& s7,
+                    const detail::Scale<15>& s9, const detail::Scale<14>& s6)
+        : block(std::make_unique<detail::TableBlock>()) {
+        using namespace detail;
+        validateScale("S3", s3, false);
+        validateScale("S5", s5, false);
+        validateScale("S7", s7, false);
+        validateScale("S9", s9, false);
+        validateScale("S6", s6, true);
+        Scale<14> s6Flip = flipScale(s6);
+        validateGrid("S3", s3);
+        validateGrid("S5", s5);
+        validateGrid("S7", s7);
+        validateGrid("S9", s9);
+        validateGrid("S6", s6Flip);
+
+        TableBlock& b = *block;
+        b.S3 = s3;
+        b.S5 = s5;
+        b.S7 = s7;
+        b.S9 = s9;
+        b.S6_flip = s6Flip;
+        b.S3w = weighted(s3, w3);
+        b.S7w = weighted(s7, w7);
+        b.S9w = weighted(s9, w9);
+        b.N5w = makeNozzleTable(s5);
+        b.poly = makePolynomialFit(b);
+        b.S3_grid = makeTableGrid(s3);
+        b.S5_grid = makeTableGrid(s5);
+        b.S7_grid = makeTableGrid(s7);
+        b.S9_grid = makeTableGrid(s9);
+        b.S6_flip_grid = makeTableGrid(s6Flip);
+    }
+
+    NomographTables(const NomographTables& other) : block(std::make_unique<detail::TableBlock>(*other.block)) {}
+    // A moved-from object may only be assigned to or destroyed
+    NomographTables(NomographTables&&) noexcept = default;
+
+    NomographTables& operator=(const NomographTables& other) {
+        if (this != &other) block = std::make_unique<detail::TableBlock>(*other.block);
+        return *this;
+    }
+    NomographTables& operator=(NomographTables&&) noexcept = default;
+
+    static NomographTables defaults() { return NomographTables(); }
+
+    static NomographTables readText(std::istream& in) {
+        Ticks t;
+        std::string text;
+        std::size_t line = 0;
+        while (std::getline(in, text)) {
+            ++line;
+            const char* p = text.c_str();
+            const char* end = p + text.size();
+            skipSpace(p, end);
+            if (p == end || *p == '#') continue;
+
+            auto fail = [&](const std::string& what) {
+                throw std::runtime_error("line " + std::to_string(line) + ": " + what);
+            };
+            const char* name = p;
+            while (p < end && *p != ' ' && *p != '\t') ++p;
+            Ticks::Column* c = t.find(std::string(name, p));
+            if (!c) fail("unknown scale '" + std::string(name, p) + "'");
+            double x, y;
+            if (!parseNumber(p, end, x) || !parseNumber(p, end, y)) fail("expected '<scale> <x> <y>'");
+            skipSpace(p, end);
+            if (p != end) fail("trailing characters");
+            if (c->count == c->capacity) {
+                fail(std::string(c->name) + " has more than " + std::to_string(c->capacity) + " ticks");
+            }
+            c->x[c->count] = x;
+            c->y[c->count] = y;
+            ++c->count;
+        }
+        return t.build();
+    }
+
+    static NomographTables readBinary(std::istream& in) {
+        char header[8];
+        if (!in.read(header, 8) || std::memcmp(header, binaryMagic, 4) != 0) {
+            throw std::runtime_error("not a nomograph table file");
+        }
+        std::uint32_t version = detail::loadLE32(header + 4);
+        if (version != binaryVersion) {
+            throw std::runtime_error("unsupported table file version " + std::to_string(version));
+        }
+
+        Ticks t;
+        for (Ticks::Column& c : t.columns) {
+            char word[8];
+            if (!in.read(word, 4)) throw std::runtime_error("truncated table file");
+            std::uint32_t count = detail::loadLE32(word);
+            if (count != c.capacity) {
+                throw std::runtime_error(std::string(c.name) + ": expected " + std::to_string(c.capacity) +
+                                         " ticks, got " + std::to_string(count));
+            }
+            for (double* column : {c.x, c.y}) {
+                for (std::uint32_t i = 0; i < count; ++i) {
+                    if (!in.read(word, 8)) throw std::runtime_error("truncated table file");
+                    std::uint64_t bits = detail::loadLE64(word);
+                    std::memcpy(&column[i], &bits, 8);
+                }
+            }
+            c.count = count;
+        }
+        return t.build();
+    }
+
+    static NomographTables loadText(const std::string& path) {
+        std::ifstream in(path);
+        if (!in) throw std::runtime_error("cannot open " + path);
+        return readText(in);
+    }
+
+    static NomographTables loadBinary(const std::string& path) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) throw std::runtime_error("cannot open " + path);
+        return readBinary(in);
+    }
+
+    // Shortest round-trip decimals: readText(writeText()) restores the tables exactly
+    void writeText(std::ostream& out) const {
+        out << "# Nomograph tables: <scale> <x> <y>; S6 as loss (%) then ordinate\n";
+        Ticks t;
+        fillTicks(t);
+        for (const Ticks::Column& c : t.columns) {
+            for (std::size_t i = 0; i < c.capacity; ++i) {
+                char buf[64];
+                char* p = std::to_chars(buf, buf + 32, c.x[i]).ptr;
+                *p++ = ' ';
+                p = std::to_chars(p, buf + sizeof(buf), c.y[i]).ptr;
+                out << c.name << ' ' << std::string(buf, p) << '\n';
+            }
+        }
+    }
+
+    void writeBinary(std::ostream& out) const {
+        char header[8];
+        std::memcpy(header, binaryMagic, 4);
+        detail::storeLE32(header + 4, binaryVersion);
+        out.write(header, 8);
+        Ticks t;
+        fillTicks(t);
+        for (const Ticks::Column& c : t.columns) {
+            char word[8];
+            detail::storeLE32(word, static_cast<std::uint32_t>(c.capacity));
+            out.write(word, 4);
+            for (const double* column : {c.x, c.y}) {
+                for (std::size_t i = 0; i < c.capacity; ++i) {
+                    std::uint64_t bits;
+                    std::memcpy(&bits, &column[i], 8);
+                    detail::storeLE64(word, bits);
+                    out.write(word, 8);
+                }
+            }
+        }
+    }
+
+    void saveText(const std::string& path) const {
+        std::ofstream out(path);
+        writeText(out);
+        if (!out.flush()) throw std::runtime_error("cannot write " + path);
+    }
+
+    void saveBinary(const std::string& path) const {
+        std::ofstream out(path, std::ios::binary);
+        writeBinary(out);
+        if (!out.flush()) throw std::runtime_error("cannot write " + path);
+    }
+
+    // Evaporation loss (%) on these tables; Calculator::calculate() for defaults()
+    double calculate(const Input& in) const {
+        return detail::evaluate(*block, in.vpd, in.nozzle, in.pressure, in.wind);
+    }
+
+    // Separable engine on these tables; SeparableCalculator::calculate() for defaults()
+    double calculateSeparable(const Input& in) const {
+        return detail::evaluateSeparable(*block, in.vpd, in.nozzle, in.pressure, in.wind);
+    }
+
+    // Polynomial engine on these tables; PolynomialCalculator::calculate() for defaults()
+    double calculatePolynomial(const Input& in) const {
+        return detail::evaluatePolynomial(block->poly, in.vpd, in.nozzle, in.pressure, in.wind);
+    }
+
+    // The table block, for engines and for code that reads individual scales
+    const detail::TableBlock& tables() const { return *block; }
+
+private:
+    static constexpr char binaryMagic[4] = {'E', 'V', 'T', 'B'};
+    static constexpr std::uint32_t binaryVersion = 1;
+
+    // Ticks of the five scales as printed, in file order
+    struct Ticks {
+        struct Column {
+            const char* name;
+            std::size_t capacity;
+            double* x;
+            double* y;
+            std::size_t count;
+        };
+
+        detail::Scale<11> s3{}, s5{}, s7{};
+        detail::Scale<15> s9{};
+        detail::Scale<14> s6{};
+        Column columns[5] = {{"S3", 11, s3.x, s3.y, 0}, {"S5", 11, s5.x, s5.y, 0}, {"S7", 11, s7.x, s7.y, 0},
+                             {"S9", 15, s9.x, s9.y, 0}, {"S6", 14, s6.x, s6.y, 0}};
+
+        // Columns point into this object
+        Ticks() = default;
+        Ticks(const Ticks&) = delete;
+        Ticks& operator=(const Ticks&) = delete;
+
+        Column* find(const std::string& name) {
+            for (Column& c : columns) {
+                if (name == c.name) return &c;
+            }
+            return nullptr;
+        }
+
+        NomographTables build() const {
+            for (const Column& c : columns) {
+                if (c.count != c.capacity) {
+                    throw std::runtime_error(std::string(c.name) + ": expected " + std::to_string(c.capacity) +
+                                             " ticks, got " + std::to_string(c.count));
+                }
+            }
+            return NomographTables(s3, s5, s7, s9, s6);
+        }
+    };
+
+    void fillTicks(Ticks& t) const {
+        t.s3 = block->S3;
+        t.s5 = block->S5;
+        t.s7 = block->S7;
+        t.s9 = block->S9;
+        t.s6 = detail::flipScale(block->S6_flip);
+    }
+
+    static void skipSpace(const char*& p, const char* end) {
+        while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) ++p;
+    }
+
+    static bool parseNumber(const char*& p, const char* end, double& value) {
+        skipSpace(p, end);
+        auto result = std::from_chars(p, end, value);
+        if (result.ec != std::errc()) return false;
+        p = result.ptr;
+        return true;
+    }
+
+    std::unique_ptr<detail::TableBlock> block;
+};
+
+namespace Simd {
+
+// Batch on runtime tables with an explicit kernel (scalar if unsupported);
+// bit-identical to NomographTables::calculate()
+inline void calculateBatch(Kernel k, const NomographTables& tables, const double* vpd, const int* nozzle,
+                           const double* pressure, const double* wind, double* out, std::size_t n) {
+    detail::dispatchBatch(k, tables.tables(), vpd, nozzle, pressure, wind, out, n);
+}
+
+inline void calculateBatch(const NomographTables& tables, const double* vpd, const int* nozzle,
+                           const double* pressure, const double* wind, double* out, std::size_t n) {
+    calculateBatch(activeKernel(), tables, vpd, nozzle, pressure, wind, out, n);
+}
+
+} // namespace Simd
+} // namespace EvapSolver
+
+#endif // EVAP_SOLVER_TABLES_H
@@ -0,0 +1,571 @@
+#ifndef EVAP_SOLVER_UNCERTAINTY_H
+#define EVAP_SOLVER_UNCERTAINTY_H
+
+// Monte Carlo propagation of sensor noise through the nomograph.
+//
+// Each record is evaluated at `samples` perturbed inputs
+//   vpd + sigma_vpd * z1, pressure + sigma_pressure * z2, wind + sigma_wind * z3
+// with z1..z3 independent standard normals, and summarized by its mean, its
+// sample variance and the requested quantiles. Samples are drawn and
+// evaluated a block at a time through the SIMD batch kernel and folded into
+// running moments and one P^2 quantile sketch (Jain & Chlamtac) per
+// quantile, so no sample is stored and memory per thread is constant.
+// Perturbed inputs are clamped by the tables like any other input.
+//
+// Random numbers are counter-based: sample j of record r is a pure function
+// of (seed, r, j): SplitMix64 indexed by counter, turned into normals with
+// Box-Muller. The log and sincos are polynomials built from +, *, / and
+// sqrt only, so the AVX2 and AVX-512 generator kernels (runtime-dispatched
+// like the batch kernels) produce the same bits as the scalar one. Results
+// are therefore bit-identical for any CPU, thread count or chunking, and a
+// slice of a batch reproduces the full batch when firstRecord is set to the
+// slice's offset. The uniforms have 32-bit resolution, so normals are
+// bounded by about 6.8 sigma.
+//
+// Usage:
+//   EvapSolver::Uncertainty::SensorNoise noise{0.02, 1.0, 0.5};   // 1-sigma, psi / psi / mph
+//   EvapSolver::Uncertainty::Options options;                     // 1000 samples, 5/50/95%
+//   EvapSolver::Uncertainty::Result r = EvapSolver::Uncertainty::propagate({0.6, 12, 40, 5}, noise, options);
+//   // r.mean, r.variance, r.quantiles[0..2]
+//   EvapSolver::Uncertainty::propagateBatch(pool, vpd, nozzle, pressure, wind, noise, options,
+//                                           mean, variance, quantiles, n);   // quantiles: n x 3
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "evap_solver_parallel.h"
+#include "evap_solver_simd.h"
+
+namespace EvapSolver {
+namespace Uncertainty {
+
+// Standard deviation of each sensor's error, in input units
+struct SensorNoise {
+    double vpd = 0.0;      // psi
+    double pressure = 0.0; // psi
+    double wind = 0.0;     // mph
+};
+
+struct Options {
+    std::size_t samples = 1000;
+    std::uint64_t seed = 0;
+    std::uint64_t firstRecord = 0; // Counter of the first record, for slices of a larger batch
+    std::vector<double> quantiles = {0.05, 0.5, 0.95};
+};
+
+struct Result {
+    double mean;
+    double variance; // Sample variance (n - 1 denominator); 0 for a single sample
+    std::vector<double> quantiles;
+};
+
+// Streaming estimate of one quantile from five markers (P^2 algorithm).
+// Exact for fewer than five observations.
+class P2Quantile {
+public:
+    explicit P2Quantile(double p = 0.5) : p(p) { reset(); }
+
+    void add(double x) {
+        if (count < 5) {
+            q[count++] = x;
+            if (count == 5) std::sort(q, q + 5);
+            return;
+        }
+        ++count;
+
+        // Cell of x by compare-and-count; the extreme markers track the
+        // minimum and maximum
+        q[0] = x < q[0] ? x : q[0];
+        q[4] = x > q[4] ? x : q[4];
+        int k = (x >= q[1]) + (x >= q[2]) + (x >= q[3]);
+        for (int i = 1; i < 5; ++i) n[i] += i > k;
+        for (int i = 1; i < 4; ++i) desired[i] += step[i];
+        desired[4] += 1;
+
+        // Move the middle markers toward their desired positions
+        for (int i = 1; i < 4; ++i) {
+            double d = desired[i] - n[i];
+            if ((d >= 1 && n[i + 1] - n[i] > 1) || (d <= -1 && n[i - 1] - n[i] < -1)) {
+                double s = d >= 0 ? 1.0 : -1.0;
+                double parabolic = q[i] + s / (n[i + 1] - n[i - 1]) *
+                                              ((n[i] - n[i - 1] + s) * (q[i + 1] - q[i]) / (n[i + 1] - n[i]) +
+                                               (n[i + 1] - n[i] - s) * (q[i] - q[i - 1]) / (n[i] - n[i - 1]));
+                if (q[i - 1] < parabolic && parabolic < q[i + 1]) {
+                    q[i] = parabolic;
+                } else {
+                    int j = i + static_cast<int>(s);
+                    q[i] += s * (q[j] - q[i]) / (n[j] - n[i]);
+                }
+                n[i] += s;
+            }
+        }
+    }
+
+    double value() const {
+        if (count >= 5) return q[2];
+        if (count == 0) return NAN;
+        // Linear interpolation between order statistics
+        double sorted[5];
+        std::copy(q, q + count, sorted);
+        std::sort(sorted, sorted + count);
+        double h = p * (count - 1);
+        std::size_t i = static_cast<std::size_t>(h);
+        return i + 1 < count ? sorted[i] + (h - i) * (sorted[i + 1] - sorted[i]) : sorted[i];
+    }
+
+    std::size_t size() const { return count; }
+
+    void reset() {
+        count = 0;
+        for (int i = 0; i < 5; ++i) n[i] = i + 1;
+        const double d[5] = {1, 1 + 2 * p, 1 + 4 * p, 3 + 2 * p, 5};
+        const double s[5] = {0, p / 2, p, (1 + p) / 2, 1};
+        std::copy(d, d + 5, desired);
+        std::copy(s, s + 5, step);
+    }
+
+private:
+    double p;
+    double q[5];       // Marker heights
+    double n[5];       // Marker positions (1-based)
+    double desired[5]; // Desired positions
+    double step[5];    // Desired position increments
+    std::size_t count;
+};
+
+namespace detail {
+
+// SplitMix64 output function
+inline std::uint64_t mix64(std::uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+inline constexpr std::uint64_t golden = 0x9E3779B97F4A7C15ull;
+
+// Stream key of one record
+inline std::uint64_t recordKey(std::uint64_t seed, std::uint64_t record) {
+    return mix64(mix64(seed) + record);
+}
+
+// Natural log for positive normal u, within a few ulp. u = m * 2^e with
+// m in [sqrt(1/2), sqrt(2)), log m = 2 atanh(s), s = (m - 1) / (m + 1).
+EVAP_SOLVER_NO_CONTRACT inline double logPositive(double u) {
+    std::uint64_t bits;
+    std::memcpy(&bits, &u, sizeof(bits));
+    std::int64_t e = static_cast<std::int64_t>(bits >> 52) - 1023;
+    bits = (bits & 0x000FFFFFFFFFFFFFull) | 0x3FF0000000000000ull;
+    double m;
+    std::memcpy(&m, &bits, sizeof(m));
+    bool high = m > 1.4142135623730951;
+    m = high ? m * 0.5 : m;
+    e += high;
+
+    double s = (m - 1) / (m + 1), s2 = s * s;
+    double series = 1.0 / 19;
+    series = series * s2 + 1.0 / 17;
+    series = series * s2 + 1.0 / 15;
+    series = series * s2 + 1.0 / 13;
+    series = series * s2 + 1.0 / 11;
+    series = series * s2 + 1.0 / 9;
+    series = series * s2 + 1.0 / 7;
+    series = series * s2 + 1.0 / 5;
+    series = series * s2 + 1.0 / 3;
+    series = series * s2 + 1.0;
+    return e * 0.6931471805599453 + 2 * s * series;
+}
+
+// sin and cos of 2 pi v for v in [0, 1): the nearest quarter turn is taken
+// out and the rest, |phi| <= pi / 4, goes through Taylor polynomials
+EVAP_SOLVER_NO_CONTRACT inline void sinCos2Pi(double v, double& sine, double& cosine) {
+    double w = 4 * v;
+    double q = std::floor(w + 0.5);
+    double phi = (w - q) * 1.5707963267948966, p2 = phi * phi;
+    double sp = -1.0 / 1307674368000;
+    sp = sp * p2 + 1.0 / 6227020800;
+    sp = sp * p2 - 1.0 / 39916800;
+    sp = sp * p2 + 1.0 / 362880;
+    sp = sp * p2 - 1.0 / 5040;
+    sp = sp * p2 + 1.0 / 120;
+    sp = sp * p2 - 1.0 / 6;
+    sp = sp * p2 + 1.0;
+    double cp = 1.0 / 20922789888000;
+    cp = cp * p2 - 1.0 / 87178291200;
+    cp = cp * p2 + 1.0 / 479001600;
+    cp = cp * p2 - 1.0 / 3628800;
+    cp = cp * p2 + 1.0 / 40320;
+    cp = cp * p2 - 1.0 / 720;
+    cp = cp * p2 + 1.0 / 24;
+    cp = cp * p2 - 1.0 / 2;
+    cp = cp * p2 + 1.0;
+    double s = phi * sp, c = cp;
+
+    // Rotate by q quarter turns
+    int quadrant = static_cast<int>(q) & 3;
+    double rs = (quadrant & 1) ? c : s;
+    double rc = (quadrant & 1) ? s : c;
+    sine = (quadrant & 2) ? -rs : rs;
+    cosine = ((quadrant + 1) & 2) ? -rc : rc;
+}
+
+// Three standard normals for sample j of the record with the given key
+EVAP_SOLVER_NO_CONTRACT inline void drawNormals(std::uint64_t key, std::uint64_t j, double& z1, double& z2, double& z3) {
+    constexpr double scale = 1.0 / 4294967296.0;
+    std::uint64_t a = mix64(key + (2 * j + 1) * golden);
+    std::uint64_t b = mix64(key + (2 * j + 2) * golden);
+    // u in (0, 1] for the radius, v in [0, 1) for the angle
+    double r1 = std::sqrt(-2 * logPositive((static_cast<double>(a >> 32) + 0.5) * scale));
+    double r2 = std::sqrt(-2 * logPositive((static_cast<double>(b >> 32) + 0.5) * scale));
+    double s1, c1, s2, c2;
+    sinCos2Pi(static_cast<double>(a & 0xFFFFFFFFu) * scale, s1, c1);
+    sinCos2Pi(static_cast<double>(b & 0xFFFFFFFFu) * scale, s2, c2);
+    z1 = r1 * c1;
+    z2 = r1 * s1;
+    z3 = r2 * c2;
+}
+
+// Running mean and sum of squared deviations, updated a block at a time:
+// two passes over the block, then Chan et al.'s pairwise merge
+struct Moments {
+    std::size_t n = 0;
+    double mean = 0.0;
+    double m2 = 0.0;
+
+    void addBlock(const double* x, std::size_t k) {
+        if (k == 0) return;
+        double sum = 0.0;
+        for (std::size_t i = 0; i < k; ++i) sum += x[i];
+        double blockMean = sum / k, blockM2 = 0.0;
+        for (std::size_t i = 0; i < k; ++i) blockM2 += (x[i] - blockMean) * (x[i] - blockMean);
+
+        std::size_t total = n + k;
+        double delta = blockMean - mean;
+        mean += delta * k / total;
+        m2 += blockM2 + delta * delta * (static_cast<double>(n) * k / total);
+        n = total;
+    }
+
+    double variance() const { return n > 1 ? m2 / (n - 1) : 0.0; }
+};
+
+} // namespace detail
+} // namespace Uncertainty
+
+namespace Simd {
+namespace detail {
+
+inline void scalarNormalBatch(std::uint64_t key, std::uint64_t first, double* z1, double* z2, double* z3,
+                              std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) Uncertainty::detail::drawNormals(key, first + i, z1[i], z2[i], z3[i]);
+}
+
+#if defined(EVAP_SOLVER_SIMD_X86)
+
+// 64-bit lane multiply from 32-bit products (AVX2 has no vpmullq)
+__attribute__((target("avx2"))) inline __m256i mulloAvx2(__m256i a, std::uint64_t c) {
+    const __m256i lo = _mm256_set1_epi64x(static_cast<long long>(c & 0xFFFFFFFFu));
+    const __m256i hi = _mm256_set1_epi64x(static_cast<long long>(c >> 32));
+    __m256i cross = _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(a, 32), lo), _mm256_mul_epu32(a, hi));
+    return _mm256_add_epi64(_mm256_mul_epu32(a, lo), _mm256_slli_epi64(cross, 32));
+}
+
+__attribute__((target("avx2"))) inline __m256i mix64Avx2(__m256i z) {
+    z = mulloAvx2(_mm256_xor_si256(z, _mm256_srli_epi64(z, 30)), 0xBF58476D1CE4E5B9ull);
+    z = mulloAvx2(_mm256_xor_si256(z, _mm256_srli_epi64(z, 27)), 0x94D049BB133111EBull);
+    return _mm256_xor_si256(z, _mm256_srli_epi64(z, 31));
+}
+
+// Exact conversion of lanes below 2^52 to double
+__attribute__((target("avx2"))) inline __m256d smallToDoubleAvx2(__m256i x) {
+    const __m256i magic = _mm256_set1_epi64x(0x4330000000000000ll);
+    return _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(x, magic)), _mm256_set1_pd(4503599627370496.0));
+}
+
+__attribute__((target("avx2"))) EVAP_SOLVER_NO_CONTRACT inline __m256d logAvx2(__m256d u) {
+    __m256i bits = _mm256_castpd_si256(u);
+    __m256d e = _mm256_sub_pd(smallToDoubleAvx2(_mm256_srli_epi64(bits, 52)), _mm256_set1_pd(1023.0));
+    bits = _mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi64x(0x000FFFFFFFFFFFFFll)),
+                           _mm256_set1_epi64x(0x3FF0000000000000ll));
+    __m256d m = _mm256_castsi256_pd(bits);
+    __m256d high = _mm256_cmp_pd(m, _mm256_set1_pd(1.4142135623730951), _CMP_GT_OQ);
+    m = _mm256_blendv_pd(m, _mm256_mul_pd(m, _mm256_set1_pd(0.5)), high);
+    e = _mm256_blendv_pd(e, _mm256_add_pd(e, _mm256_set1_pd(1.0)), high);
+
+    const __m256d one = _mm256_set1_pd(1.0);
+    __m256d s = _mm256_div_pd(_mm256_sub_pd(m, one), _mm256_add_pd(m, one)), s2 = _mm256_mul_pd(s, s);
+    __m256d series = _mm256_set1_pd(1.0 / 19);
+    for (double c : {1.0 / 17, 1.0 / 15, 1.0 / 13, 1.0 / 11, 1.0 / 9, 1.0 / 7, 1.0 / 5, 1.0 / 3, 1.0}) {
+        series = _mm256_add_pd(_mm256_mul_pd(series, s2), _mm256_set1_pd(c));
+    }
+    return _mm256_add_pd(_mm256_mul_pd(e, _mm256_set1_pd(0.6931471805599453)),
+                         _mm256_mul_pd(_mm256_mul_pd(_mm256_set1_pd(2.0), s), series));
+}
+
+__attribute__((target("avx2"))) EVAP_SOLVER_NO_CONTRACT inline void sinCos2PiAvx2(__m256d v, __m256d& sine, __m256d& cosine) {
+    __m256d w = _mm256_mul_pd(_mm256_set1_pd(4.0), v);
+    __m256d q = _mm256_floor_pd(_mm256_add_pd(w, _mm256_set1_pd(0.5)));
+    __m256d phi = _mm256_mul_pd(_mm256_sub_pd(w, q), _mm256_set1_pd(1.5707963267948966));
+    __m256d p2 = _mm256_mul_pd(phi, phi);
+    __m256d sp = _mm256_set1_pd(-1.0 / 1307674368000);
+    for (double c : {1.0 / 6227020800, -1.0 / 39916800, 1.0 / 362880, -1.0 / 5040, 1.0 / 120, -1.0 / 6, 1.0}) {
+        sp = _mm256_add_pd(_mm256_mul_pd(sp, p2), _mm256_set1_pd(c));
+    }
+    __m256d cp = _mm256_set1_pd(1.0 / 20922789888000);
+    for (double c : {-1.0 / 87178291200, 1.0 / 479001600, -1.0 / 3628800, 1.0 / 40320, -1.0 / 720, 1.0 / 24,
+                     -1.0 / 2, 1.0}) {
+        cp = _mm256_add_pd(_mm256_mul_pd(cp, p2), _mm256_set1_pd(c));
+    }
+    __m256d s = _mm256_mul_pd(phi, sp);
+
+    // q is a small whole number, so adding 2^52 leaves it in the low mantissa bits
+    __m256i quadrant = _mm256_castpd_si256(_mm256_add_pd(q, _mm256_set1_pd(4503599627370496.0)));
+    const __m256i zero = _mm256_setzero_si256(), sign = _mm256_set1_epi64x(static_cast<long long>(1ull << 63));
+    __m256d odd = _mm256_castsi256_pd(
+        _mm256_cmpgt_epi64(_mm256_and_si256(quadrant, _mm256_set1_epi64x(1)), zero));
+    __m256i negSine = _mm256_cmpgt_epi64(_mm256_and_si256(quadrant, _mm256_set1_epi64x(2)), zero);
+    __m256i negCosine = _mm256_cmpgt_epi64(
+        _mm256_and_si256(_mm256_add_epi64(quadrant, _mm256_set1_epi64x(1)), _mm256_set1_epi64x(2)), zero);
+    __m256d rs = _mm256_blendv_pd(s, cp, odd), rc = _mm256_blendv_pd(cp, s, odd);
+    sine = _mm256_xor_pd(rs, _mm256_castsi256_pd(_mm256_and_si256(negSine, sign)));
+    cosine = _mm256_xor_pd(rc, _mm256_castsi256_pd(_mm256_and_si256(negCosine, sign)));
+}
+
+// Same counters and arithmetic as drawNormals(), four samples at a time
+__attribute__((target("avx2"))) EVAP_SOLVER_NO_CONTRACT inline void avx2NormalBatch(std::uint64_t key, std::uint64_t first, double* z1,
+                                                             double* z2, double* z3, std::size_t n) {
+    using Uncertainty::detail::golden;
+    const __m256d scale = _mm256_set1_pd(1.0 / 4294967296.0), half = _mm256_set1_pd(0.5),
+                  minusTwo = _mm256_set1_pd(-2.0);
+    const __m256i low = _mm256_set1_epi64x(0xFFFFFFFFll);
+    const __m256i step = _mm256_set1_epi64x(static_cast<long long>(8 * golden));
+    __m256i counter = _mm256_set_epi64x(
+        static_cast<long long>(key + (2 * (first + 3) + 1) * golden), static_cast<long long>(key + (2 * (first + 2) + 1) * golden),
+        static_cast<long long>(key + (2 * (first + 1) + 1) * golden), static_cast<long long>(key + (2 * first + 1) * golden));
+    const __m256i next = _mm256_set1_epi64x(static_cast<long long>(golden));
+
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4, counter = _mm256_add_epi64(counter, step)) {
+        __m256i a = mix64Avx2(counter);
+        __m256i b = mix64Avx2(_mm256_add_epi64(counter, next));
+        __m256d r1 = _mm256_sqrt_pd(_mm256_mul_pd(
+            minusTwo, logAvx2(_mm256_mul_pd(_mm256_add_pd(smallToDoubleAvx2(_mm256_srli_epi64(a, 32)), half), scale))));
+        __m256d r2 = _mm256_sqrt_pd(_mm256_mul_pd(
+            minusTwo, logAvx2(_mm256_mul_pd(_mm256_add_pd(smallToDoubleAvx2(_mm256_srli_epi64(b, 32)), half), scale))));
+        __m256d s1, c1, s2, c2;
+        sinCos2PiAvx2(_mm256_mul_pd(smallToDoubleAvx2(_mm256_and_si256(a, low)), scale), s1, c1);
+        sinCos2PiAvx2(_mm256_mul_pd(smallToDoubleAvx2(_mm256_and_si256(b, low)), scale), s2, c2);
+        _mm256_storeu_pd(z1 + i, _mm256_mul_pd(r1, c1));
+        _mm256_storeu_pd(z2 + i, _mm256_mul_pd(r1, s1));
+        _mm256_storeu_pd(z3 + i, _mm256_mul_pd(r2, c2));
+    }
+    scalarNormalBatch(key, first + i, z1 + i, z2 + i, z3 + i, n - i);
+}
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#pragma GCC diagnostic ignored "-Wuninitialized"
+
+// AVX-512F has no vpmullq either (that is AVX-512DQ)
+__attribute__((target("avx512f"))) inline __m512i mulloAvx512(__m512i a, std::uint64_t c) {
+    const __m512i lo = _mm512_set1_epi64(static_cast<long long>(c & 0xFFFFFFFFu));
+    const __m512i hi = _mm512_set1_epi64(static_cast<long long>(c >> 32));
+    __m512i cross = _mm512_add_epi64(_mm512_mul_epu32(_mm512_srli_epi64(a, 32), lo), _mm512_mul_epu32(a, hi));
+    return _mm512_add_epi64(_mm512_mul_epu32(a, lo), _mm512_slli_epi64(cross, 32));
+}
+
+__attribute__((target("avx512f"))) inline __m512i mix64Avx512(__m512i z) {
+    z = mulloAvx512(_mm512_xor_si512(z, _mm512_srli_epi64(z, 30)), 0xBF58476D1CE4E5B9ull);
+    z = mulloAvx512(_mm512_xor_si512(z, _mm512_srli_epi64(z, 27)), 0x94D049BB133111EBull);
+    return _mm512_xor_si512(z, _mm512_srli_epi64(z, 31));
+}
+
+__attribute__((target("avx512f"))) inline __m512d smallToDoubleAvx512(__m512i x) {
+    const __m512i magic = _mm512_set1_epi64(0x4330000000000000ll);
+    return _mm512_sub_pd(_mm512_castsi512_pd(_mm512_or_si512(x, magic)), _mm512_set1_pd(4503599627370496.0));
+}
+
+__attribute__((target("avx512f"))) EVAP_SOLVER_NO_CONTRACT inline __m512d logAvx512(__m512d u) {
+    __m512i bits = _mm512_castpd_si512(u);
+    __m512d e = _mm512_sub_pd(smallToDoubleAvx512(_mm512_srli_epi64(bits, 52)), _mm512_set1_pd(1023.0));
+    bits = _mm512_or_si512(_mm512_and_si512(bits, _mm512_set1_epi64(0x000FFFFFFFFFFFFFll)),
+                           _mm512_set1_epi64(0x3FF0000000000000ll));
+    __m512d m = _mm512_castsi512_pd(bits);
+    __mmask8 high = _mm512_cmp_pd_mask(m, _mm512_set1_pd(1.4142135623730951), _CMP_GT_OQ);
+    m = _mm512_mask_mul_pd(m, high, m, _mm512_set1_pd(0.5));
+    e = _mm512_mask_add_pd(e, high, e, _mm512_set1_pd(1.0));
+
+    const __m512d one = _mm512_set1_pd(1.0);
+    __m512d s = _mm512_div_pd(_mm512_sub_pd(m, one), _mm512_add_pd(m, one)), s2 = _mm512_mul_pd(s, s);
+    __m512d series = _mm512_set1_pd(1.0 / 19);
+    for (double c : {1.0 / 17, 1.0 / 15, 1.0 / 13, 1.0 / 11, 1.0 / 9, 1.0 / 7, 1.0 / 5, 1.0 / 3, 1.0}) {
+        series = _mm512_add_pd(_mm512_mul_pd(series, s2), _mm512_set1_pd(c));
+    }
+    return _mm512_add_pd(_mm512_mul_pd(e, _mm512_set1_pd(0.6931471805599453)),
+                         _mm512_mul_pd(_mm512_mul_pd(_mm512_set1_pd(2.0), s), series));
+}
+
+__attribute__((target("avx512f"))) EVAP_SOLVER_NO_CONTRACT inline void sinCos2PiAvx512(__m512d v, __m512d& sine, __m512d& cosine) {
+    __m512d w = _mm512_mul_pd(_mm512_set1_pd(4.0), v);
+    __m512d q = _mm512_roundscale_pd(_mm512_add_pd(w, _mm512_set1_pd(0.5)), _MM_FROUND_TO_NEG_INF);
+    __m512d phi = _mm512_mul_pd(_mm512_sub_pd(w, q), _mm512_set1_pd(1.5707963267948966));
+    __m512d p2 = _mm512_mul_pd(phi, phi);
+    __m512d sp = _mm512_set1_pd(-1.0 / 1307674368000);
+    for (double c : {1.0 / 6227020800, -1.0 / 39916800, 1.0 / 362880, -1.0 / 5040, 1.0 / 120, -1.0 / 6, 1.0}) {
+        sp = _mm512_add_pd(_mm512_mul_pd(sp, p2), _mm512_set1_pd(c));
+    }
+    __m512d cp = _mm512_set1_pd(1.0 / 20922789888000);
+    for (double c : {-1.0 / 87178291200, 1.0 / 479001600, -1.0 / 3628800, 1.0 / 40320, -1.0 / 720, 1.0 / 24,
+                     -1.0 / 2, 1.0}) {
+        cp = _mm512_add_pd(_mm512_mul_pd(cp, p2), _mm512_set1_pd(c));
+    }
+    __m512d s = _mm512_mul_pd(phi, sp);
+
+    __m512i quadrant = _mm512_castpd_si512(_mm512_add_pd(q, _mm512_set1_pd(4503599627370496.0)));
+    const __m512i sign = _mm512_set1_epi64(static_cast<long long>(1ull << 63));
+    __mmask8 odd = _mm512_test_epi64_mask(quadrant, _mm512_set1_epi64(1));
+    __mmask8 negSine = _mm512_test_epi64_mask(quadrant, _mm512_set1_epi64(2));
+    __mmask8 negCosine = _mm512_test_epi64_mask(_mm512_add_epi64(quadrant, _mm512_set1_epi64(1)), _mm512_set1_epi64(2));
+    __m512d rs = _mm512_mask_mov_pd(s, odd, cp), rc = _mm512_mask_mov_pd(cp, odd, s);
+    sine = _mm512_castsi512_pd(_mm512_mask_xor_epi64(_mm512_castpd_si512(rs), negSine, _mm512_castpd_si512(rs), sign));
+    cosine = _mm512_castsi512_pd(
+        _mm512_mask_xor_epi64(_mm512_castpd_si512(rc), negCosine, _mm512_castpd_si512(rc), sign));
+}
+
+__attribute__((target("avx512f"))) EVAP_SOLVER_NO_CONTRACT inline void avx512NormalBatch(std::uint64_t key, std::uint64_t first, double* z1,
+                                                                 double* z2, double* z3, std::size_t n) {
+    using Uncertainty::detail::golden;
+    const __m512d scale = _mm512_set1_pd(1.0 / 4294967296.0), half = _mm512_set1_pd(0.5),
+                  minusTwo = _mm512_set1_pd(-2.0);
+    const __m512i low = _mm512_set1_epi64(0xFFFFFFFFll);
+    const __m512i step = _mm512_set1_epi64(static_cast<long long>(16 * golden));
+    const __m512i lane = _mm512_set_epi64(7, 6, 5, 4, 3, 2, 1, 0);
+    __m512i counter = _mm512_add_epi64(_mm512_set1_epi64(static_cast<long long>(key + (2 * first + 1) * golden)),
+                                       mulloAvx512(lane, 2 * golden));
+    const __m512i next = _mm512_set1_epi64(static_cast<long long>(golden));
+
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8, counter = _mm512_add_epi64(counter, step)) {
+        __m512i a = mix64Avx512(counter);
+        __m512i b = mix64Avx512(_mm512_add_epi64(counter, next));
+        __m512d r1 = _mm512_sqrt_pd(_mm512_mul_pd(
+            minusTwo, logAvx512(_mm512_mul_pd(_mm512_add_pd(smallToDoubleAvx512(_mm512_srli_epi64(a, 32)), half), scale))));
+        __m512d r2 = _mm512_sqrt_pd(_mm512_mul_pd(
+            minusTwo, logAvx512(_mm512_mul_pd(_mm512_add_pd(smallToDoubleAvx512(_mm512_srli_epi64(b, 32)), half), scale))));
+        __m512d s1, c1, s2, c2;
+        sinCos2PiAvx512(_mm512_mul_pd(smallToDoubleAvx512(_mm512_and_si512(a, low)), scale), s1, c1);
+        sinCos2PiAvx512(_mm512_mul_pd(smallToDoubleAvx512(_mm512_and_si512(b, low)), scale), s2, c2);
+        _mm512_storeu_pd(z1 + i, _mm512_mul_pd(r1, c1));
+        _mm512_storeu_pd(z2 + i, _mm512_mul_pd(r1, s1));
+        _mm512_storeu_pd(z3 + i, _mm512_mul_pd(r2, c2));
+    }
+    scalarNormalBatch(key, first + i, z1 + i, z2 + i, z3 + i, n - i);
+}
+
+#pragma GCC diagnostic pop
+
+#endif
+
+} // namespace detail
+
+// Normals for samples first .. first + n - 1 of the record with this key
+// (Uncertainty::detail::recordKey). No NEON kernel: NEON has no 64-bit
+// lane multiply, so it uses the scalar generator. Every kernel gives
+// bit-identical results.
+inline void normalBatch(Kernel k, std::uint64_t key, std::uint64_t first, double* z1, double* z2, double* z3,
+                        std::size_t n) {
+    if (!isSupported(k)) k = Kernel::Scalar;
+    switch (k) {
+#if defined(EVAP_SOLVER_SIMD_X86)
+        case Kernel::AVX512: detail::avx512NormalBatch(key, first, z1, z2, z3, n); return;
+        case Kernel::AVX2: detail::avx2NormalBatch(key, first, z1, z2, z3, n); return;
+#endif
+        default: detail::scalarNormalBatch(key, first, z1, z2, z3, n); return;
+    }
+}
+
+} // namespace Simd
+
+namespace Uncertainty {
+namespace detail {
+
+inline constexpr std::size_t sampleBlock = 256;
+
+// All samples of one record; sketches must hold one P2Quantile per quantile
+inline Moments propagateRecord(double vpd, int nozzle, double pressure, double wind, const SensorNoise& noise,
+                               std::size_t samples, std::uint64_t key, std::vector<P2Quantile>& sketches) {
+    alignas(64) double z1[sampleBlock], z2[sampleBlock], z3[sampleBlock];
+    alignas(64) double pv[sampleBlock], pp[sampleBlock], pw[sampleBlock], loss[sampleBlock];
+    alignas(64) int pn[sampleBlock];
+    for (std::size_t i = 0; i < sampleBlock; ++i) pn[i] = nozzle;
+    for (P2Quantile& s : sketches) s.reset();
+    const Simd::Kernel kernel = Simd::activeKernel();
+
+    Moments m;
+    for (std::size_t first = 0; first < samples; first += sampleBlock) {
+        std::size_t count = samples - first < sampleBlock ? samples - first : sampleBlock;
+        Simd::normalBatch(kernel, key, first, z1, z2, z3, count);
+        for (std::size_t i = 0; i < count; ++i) {
+            pv[i] = vpd + noise.vpd * z1[i];
+            pp[i] = pressure + noise.pressure * z2[i];
+            pw[i] = wind + noise.wind * z3[i];
+        }
+        Simd::calculateBatch(pv, pn, pp, pw, loss, count);
+        m.addBlock(loss, count);
+        for (std::size_t i = 0; i < count; ++i) {
+            for (P2Quantile& s : sketches) s.add(loss[i]);
+        }
+    }
+    return m;
+}
+
+inline void propagateRange(const double* vpd, const int* nozzle, const double* pressure, const double* wind,
+                           const SensorNoise& noise, const Options& options, double* mean, double* variance,
+                           double* quantiles, std::size_t begin, std::size_t end) {
+    const std::size_t nq = options.quantiles.size();
+    std::vector<P2Quantile> sketches(options.quantiles.begin(), options.quantiles.end());
+    for (std::size_t r = begin; r < end; ++r) {
+        std::uint64_t key = recordKey(options.seed, options.firstRecord + r);
+        Moments m = propagateRecord(vpd[r], nozzle[r], pressure[r], wind[r], noise, options.samples, key, sketches);
+        mean[r] = m.mean;
+        variance[r] = m.variance();
+        for (std::size_t k = 0; k < nq; ++k) quantiles[r * nq + k] = sketches[k].value();
+    }
+}
+
+} // namespace detail
+
+// Distribution of the loss of one record under the given sensor noise
+inline Result propagate(const Input& in, const SensorNoise& noise, const Options& options = Options()) {
+    std::vector<P2Quantile> sketches(options.quantiles.begin(), options.quantiles.end());
+    detail::Moments m = detail::propagateRecord(in.vpd, in.nozzle, in.pressure, in.wind, noise, options.samples,
+                                                detail::recordKey(options.seed, options.firstRecord), sketches);
+    Result r{m.mean, m.variance(), {}};
+    for (const P2Quantile& s : sketches) r.quantiles.push_back(s.value());
+    return r;
+}
+
+// n records as parallel arrays; quantiles is n x options.quantiles.size(),
+// row-major. Record i uses counter options.firstRecord + i.
+inline void propagateBatch(const double* vpd, const int* nozzle, const double* pressure, const double* wind,
+                           const SensorNoise& noise, const Options& options, double* mean, double* variance,
+                           double* quantiles, std::size_t n) {
+    detail::propagateRange(vpd, nozzle, pressure, wind, noise, options, mean, variance, quantiles, 0, n);
+}
+
+// Same on the pool's threads; bit-identical to the serial batch
+inline void propagateBatch(Parallel::ThreadPool& pool, const double* vpd, const int* nozzle, const double* pressure,
+                           const double* wind, const SensorNoise& noise, const Options& options, double* mean,
+                           double* variance, double* quantiles, std::size_t n) {
+    pool.parallelFor(n, [&](std::size_t begin, std::size_t end) {
+        detail::propagateRange(vpd, nozzle, pressure, wind, noise, options, mean, variance, quantiles, begin, end);
+    });
+}
+
+} // namespace Uncertainty
+} // namespace EvapSolver
+
+#endif // EVAP_SOLVER_UNCERTAINTY_H
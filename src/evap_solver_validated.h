@@ -1,13 +1,27 @@
 #ifndef EVAP_SOLVER_VALIDATED_H
 #define EVAP_SOLVER_VALIDATED_H
 
-#include <vector>
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <stdexcept>
 #include <string>
+#include "evap_solver_compact.h"
 
 namespace EvapSolverValidated {
 
+// Validation status bits and messages, shared with the core (see
+// evap_solver_core.h): one bit per parameter outside its valid range.
+using EvapSolver::Status;
+using EvapSolver::StatusOk;
+using EvapSolver::VpdOutOfRange;
+using EvapSolver::NozzleOutOfRange;
+using EvapSolver::PressureOutOfRange;
+using EvapSolver::WindOutOfRange;
+using EvapSolver::checkInputs;
+using EvapSolver::statusMessage;
+using EvapSolver::firstViolation;
+
 // Input structure with validation
 struct Input {
     double vpd;      // Vapor-Pressure Deficit (psi): 0.0 to 1.0
@@ -24,20 +38,34 @@ struct Input {
     // Default constructor
     Input() : vpd(0.6), nozzle(12), pressure(40), wind(5) {}
     
-    // Validation function
+    // Construct without validating; check() reports the status instead
+    static Input unchecked(double vpd_val, int nozzle_val, double pressure_val, double wind_val) noexcept {
+        Input in;
+        in.vpd = vpd_val;
+        in.nozzle = nozzle_val;
+        in.pressure = pressure_val;
+        in.wind = wind_val;
+        return in;
+    }
+    
+    // Non-throwing validation
+    Status check() const noexcept {
+        return checkInputs(vpd, nozzle, pressure, wind);
+    }
+    
+    // Message for every violated parameter (empty if valid)
+    std::string message(Status status) const {
+        return statusMessage(status, vpd, nozzle, pressure, wind);
+    }
+    
+    // Validation function (throws on the first violated parameter)
     void validate() const {
-        if (vpd < 0.0 || vpd > 1.0) {
-            throw std::runtime_error("Vapor-Pressure Deficit must be between 0.0 and 1.0 psi (got " + std::to_string(vpd) + ")");
-        }
-        if (nozzle < 8 || nozzle > 64) {
-            throw std::runtime_error("Nozzle diameter must be between 8 and 64 (64ths of an inch) (got " + std::to_string(nozzle) + ")");
-        }
-        if (pressure < 20 || pressure > 80) {
-            throw std::runtime_error("Nozzle pressure must be between 20 and 80 psi (got " + std::to_string(pressure) + ")");
-        }
-        if (wind < 0 || wind > 15) {
-            throw std::runtime_error("Wind velocity must be between 0 and 15 mph (got " + std::to_string(wind) + ")");
-        }
+        EvapSolver::ThrowingValidation<>::check(core());
+    }
+    
+    // Same record as the core's input type
+    EvapSolver::Input core() const noexcept {
+        return {vpd, nozzle, pressure, wind};
     }
 };
 
@@ -47,108 +75,63 @@ struct ValidationResult {
     std::string errorMessage;
     double calculatedValue;
     bool isOutOfRange;
+    Status status;
     
-    ValidationResult(bool valid, const std::string& error = "", double value = 0.0, bool outOfRange = false)
-        : isValid(valid), errorMessage(error), calculatedValue(value), isOutOfRange(outOfRange) {}
+    ValidationResult(bool valid, const std::string& error = "", double value = 0.0, bool outOfRange = false,
+                     Status statusBits = StatusOk)
+        : isValid(valid), errorMessage(error), calculatedValue(value), isOutOfRange(outOfRange), status(statusBits) {}
 };
 
-// Validated evaporation loss calculator
+// Validated evaporation loss calculator: wrappers over the core's
+// Nomograph with the throwing and status-code validation policies.
+// All member functions are stateless and read only compile-time tables, so
+// they may be called concurrently from any number of threads.
 class Calculator {
-private:
-    // Linear interpolation
-    static double lerp(const std::vector<std::pair<double, double>>& table, double x) {
-        if (table.empty()) throw std::runtime_error("Empty interpolation table");
-        if (x <= table.front().first) return table.front().second;
-        if (x >= table.back().first) return table.back().second;
-        
-        auto it = std::lower_bound(table.begin(), table.end(), x,
-            [](const auto& a, double val) { return a.first < val; });
-        
-        auto [x2, y2] = *it;
-        auto [x1, y1] = *(it - 1);
-        return y1 + (y2 - y1) * (x - x1) / (x2 - x1);
-    }
+    using Throwing = EvapSolver::Nomograph<double, EvapSolver::ThrowingValidation<>>;
+    using Checked = EvapSolver::Nomograph<double, EvapSolver::StatusValidation>;
+    using Unchecked = EvapSolver::Nomograph<double>;
     
-    // Linear interpolation between two points
-    static double lerp2(double x, double x1, double y1, double x2, double y2) {
-        return y1 + (y2 - y1) * (x - x1) / (x2 - x1);
-    }
-
 public:
     // Calculate evaporation loss with validation
     static ValidationResult calculateWithValidation(const Input& in) {
-        try {
-            // Validate input
-            in.validate();
-            
-            // Perform calculation
-            double result = calculateUnchecked(in);
-            
-            // Check if result is within expected range
-            bool outOfRange = (result < 0.0 || result > 40.0);
-            
-            return ValidationResult(true, "", result, outOfRange);
-            
-        } catch (const std::exception& e) {
-            return ValidationResult(false, e.what(), 0.0, false);
+        // Validate input
+        Status status = in.check();
+        if (status != StatusOk) {
+            return ValidationResult(false, in.message(firstViolation(status)), 0.0, false, status);
         }
+        
+        // Perform calculation
+        double result = calculateUnchecked(in);
+        
+        // Check if result is within expected range
+        bool outOfRange = (result < 0.0 || result > 40.0);
+        
+        return ValidationResult(true, "", result, outOfRange);
+    }
+    
+    // Calculate evaporation loss without throwing: writes the validation
+    // status and returns defaultValue if any parameter is out of range
+    static double calculateWithStatus(const Input& in, Status& status, double defaultValue = 0.0) noexcept {
+        return Checked::calculate(in.core(), status, defaultValue);
+    }
+    
+    // Validate and calculate n records. status[i] receives the record's
+    // status bits and out[i] its loss, or defaultValue if it is invalid.
+    // Returns the number of invalid records. Never throws or allocates.
+    static std::size_t calculateBatch(const double* vpd, const int* nozzle, const double* pressure,
+                                      const double* wind, double* out, Status* status, std::size_t n,
+                                      double defaultValue = 0.0) noexcept {
+        return Checked::calculateBatch(vpd, nozzle, pressure, wind, out, status, n, defaultValue);
     }
     
     // Calculate evaporation loss (throws on invalid input)
     static double calculate(const Input& in) {
-        in.validate();
-        return calculateUnchecked(in);
+        return Throwing::calculate(in.core());
     }
     
     // Calculate without validation (for internal use)
     static double calculateUnchecked(const Input& in) {
-        // Nomograph data tables
-        static const std::vector<std::pair<double, double>> S3 = {
-            {0,0}, {0.1,0.221}, {0.2,0.381}, {0.3,0.508}, {0.4,0.613}, 
-            {0.5,0.695}, {0.6,0.762}, {0.7,0.829}, {0.8,0.887}, {0.9,0.949}, {1.0,1.0}
-        };
-        static const std::vector<std::pair<double, double>> S5 = {
-            {8,1.002}, {10,0.895}, {12,0.815}, {14,0.742}, {16,0.675}, {20,0.563}, 
-            {24,0.483}, {32,0.352}, {40,0.233}, {48,0.152}, {64,-0.001}
-        };
-        static const std::vector<std::pair<double, double>> S7 = {
-            {20,0.0}, {25,0.159}, {30,0.296}, {35,0.407}, {40,0.499}, {45,0.589}, 
-            {50,0.665}, {55,0.735}, {60,0.800}, {70,0.900}, {80,0.996}
-        };
-        static const std::vector<std::pair<double, double>> S9 = {
-            {0,0.0}, {1,0.140}, {2,0.246}, {3,0.356}, {4,0.435}, {5,0.508}, 
-            {6,0.578}, {7,0.651}, {8,0.706}, {9,0.760}, {10,0.811}, {11,0.854}, 
-            {12,0.895}, {13,0.930}, {15,0.994}
-        };
-        static const std::vector<std::pair<double, double>> S6 = {
-            {0,0.102}, {0.5,0.252}, {1,0.360}, {2,0.460}, {3,0.521}, {4,0.563}, 
-            {5,0.599}, {6,0.633}, {8,0.671}, {10,0.702}, {15,0.758}, {20,0.812}, 
-            {30,0.883}, {40,0.917}
-        };
-        
-        // Column X coordinates
-        constexpr double x3 = 0.0, x4 = 0.237, x5 = 0.439, x6 = 0.490, 
-                        x7 = 0.738, x8 = 0.870, x9 = 1.000;
-        
-        // Interpolate Y coordinates
-        double y3 = lerp(S3, in.vpd);
-        double y5 = lerp(S5, in.nozzle);
-        double y7 = lerp(S7, in.pressure);
-        double y9 = lerp(S9, in.wind);
-        
-        // Calculate pivot points and intersection
-        double yA = lerp2(x4, x3, y3, x5, y5);
-        double yB = lerp2(x8, x7, y7, x9, y9);
-        double yL = lerp2(x6, x4, yA, x8, yB);
-        
-        // Reverse interpolation on S6 (flip x/y)
-        static std::vector<std::pair<double, double>> S6_flip;
-        if (S6_flip.empty()) {
-            for (const auto& [val, y] : S6) S6_flip.emplace_back(y, val);
-            std::sort(S6_flip.begin(), S6_flip.end());
-        }
-        
-        return lerp(S6_flip, yL);
+        return Unchecked::calculate(in.core());
     }
     
     // Get valid parameter ranges
@@ -164,12 +147,7 @@ public:
 
 // Convenience functions with validation
 inline ValidationResult calculateEvaporationLossWithValidation(double vpd, int nozzle, double pressure, double wind) {
-    try {
-        Input input(vpd, nozzle, pressure, wind);
-        return Calculator::calculateWithValidation(input);
-    } catch (const std::exception& e) {
-        return ValidationResult(false, e.what(), 0.0, false);
-    }
+    return Calculator::calculateWithValidation(Input::unchecked(vpd, nozzle, pressure, wind));
 }
 
 inline double calculateEvaporationLoss(double vpd, int nozzle, double pressure, double wind) {
@@ -179,11 +157,8 @@ inline double calculateEvaporationLoss(double vpd, int nozzle, double pressure,
 
 // Safe convenience function that returns a default value on error
 inline double calculateEvaporationLossSafe(double vpd, int nozzle, double pressure, double wind, double defaultValue = 0.0) {
-    try {
-        return calculateEvaporationLoss(vpd, nozzle, pressure, wind);
-    } catch (const std::exception&) {
-        return defaultValue;
-    }
+    Status status;
+    return Calculator::calculateWithStatus(Input::unchecked(vpd, nozzle, pressure, wind), status, defaultValue);
 }
 
 } // namespace EvapSolverValidated
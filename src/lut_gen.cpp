@@ -0,0 +1,162 @@
+// evap_lut_gen: precompute the profile LUTs of a sprinkler fleet into one
+// memory-mapped LUT file (see evap_solver_lut_file.h).
+#include "evap_solver_lut_file.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace {
+
+void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " [options] OUTPUT\n"
+              << "\n"
+              << "Samples one profile LUT per (nozzle, pressure) and writes them to OUTPUT.\n"
+              << "\n"
+              << "Options:\n"
+              << "  --tables FILE                    Nomograph tables, text or binary (default built-in)\n"
+              << "  --nozzles A-B|A,B,...            Nozzle sizes in 64ths of an inch (default 8-64)\n"
+              << "  --pressures FROM:TO:STEP         Pressures in psi (default 20:80:5)\n"
+              << "  --vpd-step PSI                   Grid step in vpd (default 0.001)\n"
+              << "  --wind-step MPH                  Grid step in wind (default 0.1)\n"
+              << "  --interpolation nearest|bilinear Lookup mode (default nearest)\n";
+}
+
+// "8-64" or "8,12,16"
+bool parseNozzles(const char* text, std::vector<int>& nozzles) {
+    nozzles.clear();
+    char* end = nullptr;
+    long first = std::strtol(text, &end, 10);
+    if (end == text) return false;
+    if (*end == '-') {
+        const char* rest = end + 1;
+        long last = std::strtol(rest, &end, 10);
+        if (end == rest || *end != '\0' || last < first) return false;
+        for (long n = first; n <= last; ++n) nozzles.push_back(static_cast<int>(n));
+        return true;
+    }
+    nozzles.push_back(static_cast<int>(first));
+    while (*end == ',') {
+        const char* rest = end + 1;
+        nozzles.push_back(static_cast<int>(std::strtol(rest, &end, 10)));
+        if (end == rest) return false;
+    }
+    return *end == '\0';
+}
+
+// "20:80:5", or a single pressure
+bool parsePressures(const char* text, std::vector<double>& pressures) {
+    pressures.clear();
+    char* end = nullptr;
+    double from = std::strtod(text, &end);
+    if (end == text) return false;
+    if (*end == '\0') {
+        pressures.push_back(from);
+        return true;
+    }
+    double to = 0, step = 0;
+    if (*end != ':') return false;
+    const char* rest = end + 1;
+    to = std::strtod(rest, &end);
+    if (end == rest || *end != ':') return false;
+    rest = end + 1;
+    step = std::strtod(rest, &end);
+    if (end == rest || *end != '\0' || !(step > 0) || to < from) return false;
+    // Index-based, so 20:80:5 ends on exactly 80
+    for (long k = 0; from + k * step <= to + step * 1e-9; ++k) pressures.push_back(from + k * step);
+    return true;
+}
+
+bool parseStep(const char* text, double& step) {
+    char* end = nullptr;
+    step = std::strtod(text, &end);
+    return end != text && *end == '\0' && step > 0;
+}
+
+EvapSolver::NomographTables loadTables(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) throw std::runtime_error("cannot open " + path);
+    char magic[4] = {};
+    in.read(magic, 4);
+    bool binary = in.gcount() == 4 && std::memcmp(magic, "EVTB", 4) == 0;
+    return binary ? EvapSolver::NomographTables::loadBinary(path) : EvapSolver::NomographTables::loadText(path);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    using namespace EvapSolver;
+    std::string tablesPath, output;
+    std::vector<int> nozzles;
+    std::vector<double> pressures;
+    parseNozzles("8-64", nozzles);
+    parsePressures("20:80:5", pressures);
+    LutOptions options;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        bool ok = true;
+        if (std::strcmp(arg, "--tables") == 0 && value) {
+            tablesPath = value;
+            i++;
+        } else if (std::strcmp(arg, "--nozzles") == 0 && value) {
+            ok = parseNozzles(value, nozzles);
+            i++;
+        } else if (std::strcmp(arg, "--pressures") == 0 && value) {
+            ok = parsePressures(value, pressures);
+            i++;
+        } else if (std::strcmp(arg, "--vpd-step") == 0 && value) {
+            ok = parseStep(value, options.vpdStep);
+            i++;
+        } else if (std::strcmp(arg, "--wind-step") == 0 && value) {
+            ok = parseStep(value, options.windStep);
+            i++;
+        } else if (std::strcmp(arg, "--interpolation") == 0 && value) {
+            if (std::strcmp(value, "nearest") == 0) {
+                options.interpolation = LutInterpolation::Nearest;
+            } else if (std::strcmp(value, "bilinear") == 0) {
+                options.interpolation = LutInterpolation::Bilinear;
+            } else {
+                ok = false;
+            }
+            i++;
+        } else if (std::strcmp(arg, "-h") == 0 || std::strcmp(arg, "--help") == 0) {
+            printUsage(argv[0]);
+            return 0;
+        } else if (arg[0] != '-' && output.empty()) {
+            output = arg;
+        } else {
+            ok = false;
+        }
+        if (!ok) {
+            printUsage(argv[0]);
+            return 2;
+        }
+    }
+    if (output.empty()) {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    try {
+        NomographTables tables = tablesPath.empty() ? NomographTables::defaults() : loadTables(tablesPath);
+        std::vector<LutProfileKey> profiles;
+        for (int nozzle : nozzles) {
+            for (double pressure : pressures) profiles.push_back({nozzle, pressure});
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        writeLutFile(output, tables, profiles, options);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        LutFile file(output);
+        std::cerr << file.profileCount() << " profiles on a " << file.vpdPoints() << " x " << file.windPoints()
+                  << " grid, " << file.bytes() << " bytes, written in " << seconds << " s" << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -1,13 +1,180 @@
 #include "solver.h"
+#include "evap_solver_service.h"
+#include "evap_solver_stream.h"
+#include <chrono>
+#include <condition_variable>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <thread>
 
-// Example usage
-int main() {
+namespace {
+
+void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " [options] [INPUT|-]\n"
+              << "       " << program << " --serve ADDRESS [options]\n"
+              << "\n"
+              << "Without arguments, evaluates the built-in example.\n"
+              << "Otherwise streams records from INPUT and writes one loss per record. To read\n"
+              << "stdin, pass - (with no arguments at all, the example runs instead).\n"
+              << "With --serve, answers binary requests on a socket until SIGINT or SIGTERM\n"
+              << "(see src/evap_solver_service.h for the protocol).\n"
+              << "\n"
+              << "Options:\n"
+              << "  --input-format csv|binary   Record format (default csv: vpd,nozzle,pressure,wind)\n"
+              << "  --output-format csv|binary  Result format (default csv)\n"
+              << "  --engine NAME               Evaluation engine: exact, separable, polynomial (default exact)\n"
+              << "  --threads N                 Compute threads, 0 = all cores (default 0)\n"
+              << "  --batch N                   Records per pipeline batch (default 65536)\n"
+              << "  -o, --output FILE           Output file (default stdout)\n"
+              << "  --stats                     Print record and batch counts to stderr\n"
+              << "                              (with --serve: metrics JSON on exit)\n"
+              << "\n"
+              << "Service options:\n"
+              << "  --serve ADDRESS             Listen on HOST:PORT or unix:PATH\n"
+              << "  --max-batch N               Requests per micro-batch (default 256)\n"
+              << "  --max-wait-us N             Longest wait for a batch to fill, microseconds (default 100)\n"
+              << "  --metrics-interval S        Print metrics JSON to stderr every S seconds\n";
+}
+
+EvapSolver::Service::Server* activeServer = nullptr;
+
+void stopServer(int) {
+    if (activeServer) activeServer->stop();
+}
+
+int runService(const std::string& address, const EvapSolver::Service::Options& options, unsigned interval,
+               bool printStats) {
+    using namespace EvapSolver;
+    Service::Server server(address, options);
+    activeServer = &server;
+    std::signal(SIGINT, stopServer);
+    std::signal(SIGTERM, stopServer);
+    std::cerr << "Serving on " << server.address() << " (" << engineName(options.engine) << " engine)" << std::endl;
+
+    std::mutex mutex;
+    std::condition_variable stopped;
+    bool done = false;
+    std::thread reporter([&] {
+        if (interval == 0) return;
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!stopped.wait_for(lock, std::chrono::seconds(interval), [&] { return done; })) {
+            Service::writeJson(std::cerr, server.metrics());
+            std::cerr << std::endl;
+        }
+    });
+
+    server.run();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        done = true;
+    }
+    stopped.notify_all();
+    reporter.join();
+    std::signal(SIGINT, SIG_DFL);
+    std::signal(SIGTERM, SIG_DFL);
+    activeServer = nullptr;
+    if (printStats) {
+        Service::writeJson(std::cerr, server.metrics());
+        std::cerr << std::endl;
+    }
+    return 0;
+}
+
+int runExample() {
     Inputs inputs;
     inputs.vpd = 0.6;
     inputs.nozzle = 12;
     inputs.pressure = 40;
     inputs.wind = 5;
 
+    // Print the result to the console (the solver is silent by default)
+    ConsoleSink console;
+    setDiagnosticsSink(&console);
+
     solveEvaporationLoss(inputs);
     return 0;
 }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    // Example usage
+    if (argc == 1) return runExample();
+
+    using namespace EvapSolver;
+    Stream::Options options;
+    Service::Options service;
+    std::string input = "-", output = "-", serve;
+    unsigned metricsInterval = 0;
+    bool printStats = false;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        bool ok = true;
+        if (std::strcmp(arg, "--input-format") == 0 && value) {
+            ok = Stream::parseFormat(value, options.inputFormat);
+            i++;
+        } else if (std::strcmp(arg, "--output-format") == 0 && value) {
+            ok = Stream::parseFormat(value, options.outputFormat);
+            i++;
+        } else if (std::strcmp(arg, "--engine") == 0 && value) {
+            ok = parseEngine(value, options.engine);
+            i++;
+        } else if (std::strcmp(arg, "--threads") == 0 && value) {
+            options.threads = static_cast<unsigned>(std::strtoul(value, nullptr, 10));
+            i++;
+        } else if (std::strcmp(arg, "--batch") == 0 && value) {
+            options.batchSize = std::strtoull(value, nullptr, 10);
+            i++;
+        } else if ((std::strcmp(arg, "-o") == 0 || std::strcmp(arg, "--output") == 0) && value) {
+            output = value;
+            i++;
+        } else if (std::strcmp(arg, "--serve") == 0 && value) {
+            serve = value;
+            i++;
+        } else if (std::strcmp(arg, "--max-batch") == 0 && value) {
+            service.maxBatch = std::strtoull(value, nullptr, 10);
+            i++;
+        } else if (std::strcmp(arg, "--max-wait-us") == 0 && value) {
+            service.maxWait = std::chrono::microseconds(std::strtoll(value, nullptr, 10));
+            i++;
+        } else if (std::strcmp(arg, "--metrics-interval") == 0 && value) {
+            metricsInterval = static_cast<unsigned>(std::strtoul(value, nullptr, 10));
+            i++;
+        } else if (std::strcmp(arg, "--stats") == 0) {
+            printStats = true;
+        } else if (std::strcmp(arg, "-h") == 0 || std::strcmp(arg, "--help") == 0) {
+            printUsage(argv[0]);
+            return 0;
+        } else if (arg[0] != '-' || std::strcmp(arg, "-") == 0) {
+            input = arg;
+        } else {
+            ok = false;
+        }
+        if (!ok) {
+            printUsage(argv[0]);
+            return 2;
+        }
+    }
+
+    try {
+        if (!serve.empty()) {
+            service.engine = options.engine;
+            return runService(serve, service, metricsInterval, printStats);
+        }
+        Stream::Stats stats = Stream::process(input, output, options);
+        if (printStats) {
+            std::cerr << stats.records << " records in " << stats.batches << " batches ("
+                      << (stats.mapped ? "mapped" : "streamed") << " input, " << engineName(options.engine)
+                      << " engine)" << std::endl;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,309 @@
+// evap_poly_gen: choose breakpoints for the polynomial engine and report the
+// error of the fit against the exact chain (see evap_solver_polynomial.h).
+#include "evap_solver_polynomial.h"
+#include "evap_solver_tables.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace EvapSolver;
+
+const char* const scaleNames[5] = {"S3", "S5", "S7", "S9", "S6"};
+
+void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " [options]\n"
+              << "\n"
+              << "Reports max and RMS error of a polynomial-engine fit against the exact engine,\n"
+              << "over a sweep of the valid range and the Trimmer (1987) validation rows.\n"
+              << "\n"
+              << "Options:\n"
+              << "  --tables FILE         Nomograph tables, text or binary (default built-in)\n"
+              << "  --pieces A,B,C,D,E    Pieces for S3, S5, S7, S9, S6 (default every tick: 10,10,10,14,13)\n"
+              << "  --sweep               Report every per-scale piece limit from the full fit down to 1\n"
+              << "  --emit FILE           Write the chosen tick lists as a C++ header\n"
+              << "  --name NAME           Name of the emitted fit (default generatedFit)\n";
+}
+
+// One scale as tick positions and (weighted) ordinates
+struct Points {
+    std::vector<double> x, y;
+};
+
+template <std::size_t N>
+Points points(const detail::Scale<N>& s, double w) {
+    Points p;
+    for (std::size_t i = 0; i < N; ++i) {
+        p.x.push_back(s.x[i]);
+        p.y.push_back(s.y[i] * w);
+    }
+    return p;
+}
+
+// Runtime counterpart of detail::HingeScale, same arithmetic as makeHinge() and hinge()
+struct Hinge {
+    double y0 = 0;
+    std::vector<double> knot, width, slope;
+
+    Hinge(const Points& p, const std::vector<std::size_t>& ticks) {
+        y0 = p.y[ticks[0]];
+        for (std::size_t k = 0; k + 1 < ticks.size(); ++k) {
+            std::size_t a = ticks[k], b = ticks[k + 1];
+            knot.push_back(p.x[a]);
+            width.push_back(p.x[b] - p.x[a]);
+            slope.push_back((p.y[b] - p.y[a]) / (p.x[b] - p.x[a]));
+        }
+    }
+
+    double operator()(double v) const {
+        double y = y0;
+        for (std::size_t k = 0; k < knot.size(); ++k) y += detail::hingeTerm(v, knot[k], width[k], slope[k]);
+        return y;
+    }
+};
+
+// Largest deviation at the ticks of p from the interpolant through ticks
+double dropError(const Points& p, const std::vector<std::size_t>& ticks) {
+    Hinge h(p, ticks);
+    double worst = 0;
+    for (std::size_t i = 0; i < p.x.size(); ++i) worst = std::fmax(worst, std::fabs(h(p.x[i]) - p.y[i]));
+    return worst;
+}
+
+// Greedily drop the interior tick whose removal deviates least until pieces remain
+std::vector<std::size_t> chooseTicks(const Points& p, std::size_t pieces) {
+    std::vector<std::size_t> ticks;
+    for (std::size_t i = 0; i < p.x.size(); ++i) ticks.push_back(i);
+    while (ticks.size() > pieces + 1 && ticks.size() > 2) {
+        std::size_t best = 1;
+        double bestError = INFINITY;
+        for (std::size_t k = 1; k + 1 < ticks.size(); ++k) {
+            std::vector<std::size_t> trial = ticks;
+            trial.erase(trial.begin() + static_cast<std::ptrdiff_t>(k));
+            double e = dropError(p, trial);
+            if (e < bestError) {
+                bestError = e;
+                best = k;
+            }
+        }
+        ticks.erase(ticks.begin() + static_cast<std::ptrdiff_t>(best));
+    }
+    return ticks;
+}
+
+struct Fit {
+    std::vector<std::size_t> ticks[5];
+    std::vector<Hinge> scales;
+
+    double operator()(double vpd, int nozzle, double pressure, double wind) const {
+        double yL = scales[0](vpd) + scales[1](nozzle) + scales[2](pressure) + scales[3](wind);
+        return scales[4](yL);
+    }
+};
+
+// Trimmer (1987) rows of tests/test_all_solvers_validation.cpp, converted the same way
+struct TrimmerCase {
+    double nozzleMm, pressureKpa, vpdKpa, windMs, expected;
+};
+
+const TrimmerCase trimmerCases[] = {
+    {3.18, 207, 2.8, 1.3, 5.5},  {3.18, 207, 4.5, 4.5, 16.0}, {4.76, 207, 4.5, 4.5, 10.0}, {4.76, 414, 4.5, 2.2, 13.0},
+    {4.76, 414, 2.8, 1.3, 7.0},  {4.76, 414, 2.8, 4.5, 14.0}, {6.35, 414, 2.8, 4.5, 11.0}, {6.35, 414, 4.5, 2.7, 9.5},
+    {6.35, 414, 4.5, 1.3, 7.5},  {6.35, 552, 4.5, 4.5, 18.0}, {12.7, 552, 4.5, 4.5, 9.0},
+};
+
+Input trimmerInput(const TrimmerCase& c) {
+    double pressure = c.pressureKpa * 0.145038;
+    if (pressure > 80.0 && pressure <= 80.2) pressure = 80.0;
+    return {c.vpdKpa * 0.145038, static_cast<int>(std::round(c.nozzleMm / 25.4 * 64.0)), pressure, c.windMs * 2.237};
+}
+
+struct Report {
+    double maxError = 0, rmsError = 0;        // Against the exact engine over the sweep
+    double trimmerMax = 0, trimmerExactMax = 0; // Against the published losses
+    double trimmerShift = 0;                  // Largest change from the exact engine on a Trimmer row
+};
+
+class Generator {
+public:
+    explicit Generator(const NomographTables& t) : tables(t) {
+        const detail::TableBlock& b = tables.tables();
+        scales[0] = points(b.S3, detail::w3);
+        scales[1] = points(b.S5, detail::w5);
+        scales[2] = points(b.S7, detail::w7);
+        scales[3] = points(b.S9, detail::w9);
+        scales[4] = points(b.S6_flip, 1.0);
+    }
+
+    std::size_t fullPieces(std::size_t scale) const { return scales[scale].x.size() - 1; }
+
+    Fit fit(const std::size_t (&pieces)[5]) const {
+        Fit f;
+        for (std::size_t s = 0; s < 5; ++s) {
+            f.ticks[s] = chooseTicks(scales[s], pieces[s]);
+            f.scales.emplace_back(scales[s], f.ticks[s]);
+        }
+        return f;
+    }
+
+    Report report(const Fit& f) const {
+        Report r;
+        double squares = 0;
+        std::size_t count = 0;
+        for (double vpd = 0; vpd <= 1.0 + 1e-9; vpd += 0.02) {
+            for (int nozzle = 8; nozzle <= 64; nozzle++) {
+                for (double pressure = 20; pressure <= 80 + 1e-9; pressure += 2) {
+                    for (double wind = 0; wind <= 15 + 1e-9; wind += 0.5) {
+                        double e = f(vpd, nozzle, pressure, wind) - tables.calculate({vpd, nozzle, pressure, wind});
+                        r.maxError = std::fmax(r.maxError, std::fabs(e));
+                        squares += e * e;
+                        count++;
+                    }
+                }
+            }
+        }
+        r.rmsError = std::sqrt(squares / count);
+        for (const TrimmerCase& c : trimmerCases) {
+            Input in = trimmerInput(c);
+            double exact = tables.calculate(in), approx = f(in.vpd, in.nozzle, in.pressure, in.wind);
+            r.trimmerMax = std::fmax(r.trimmerMax, std::fabs(approx - c.expected));
+            r.trimmerExactMax = std::fmax(r.trimmerExactMax, std::fabs(exact - c.expected));
+            r.trimmerShift = std::fmax(r.trimmerShift, std::fabs(approx - exact));
+        }
+        return r;
+    }
+
+private:
+    NomographTables tables;
+    Points scales[5];
+};
+
+void printPieces(std::ostream& out, const Fit& f) {
+    for (std::size_t s = 0; s < 5; ++s) out << (s ? " " : "") << scaleNames[s] << "=" << f.ticks[s].size() - 1;
+}
+
+void emitHeader(const std::string& path, const std::string& name, const Fit& f, const Report& r) {
+    std::ofstream out(path);
+    if (!out) throw std::runtime_error("cannot open " + path);
+    out << "// Generated by evap_poly_gen: ";
+    printPieces(out, f);
+    out << " pieces\n"
+        << "// Max error " << r.maxError << " points, RMS " << r.rmsError << " against the exact engine\n"
+        << "#pragma once\n"
+        << "#include <cstddef>\n"
+        << "#include \"evap_solver_polynomial.h\"\n\n";
+    for (std::size_t s = 0; s < 5; ++s) {
+        out << "inline constexpr std::size_t " << name << "_" << scaleNames[s] << "[] = {";
+        for (std::size_t k = 0; k < f.ticks[s].size(); ++k) out << (k ? ", " : "") << f.ticks[s][k];
+        out << "};\n";
+    }
+    out << "\n// On runtime tables: makePolynomialFit(tables.tables(), " << name << "_S3, ...)\n"
+        << "inline constexpr auto " << name << " = EvapSolver::detail::makePolynomialFit(\n"
+        << "    EvapSolver::detail::Tables<double>{}, " << name << "_S3, " << name << "_S5, " << name << "_S7, "
+        << name << "_S9, " << name << "_S6);\n";
+    if (!out.flush()) throw std::runtime_error("cannot write " + path);
+}
+
+bool parsePieces(const char* text, std::size_t (&pieces)[5]) {
+    const char* p = text;
+    for (std::size_t s = 0; s < 5; ++s) {
+        char* end = nullptr;
+        long v = std::strtol(p, &end, 10);
+        if (end == p || v < 1) return false;
+        pieces[s] = static_cast<std::size_t>(v);
+        if (s < 4 && *end != ',') return false;
+        p = end + 1;
+        if (s == 4 && *end != '\0') return false;
+    }
+    return true;
+}
+
+NomographTables loadTables(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) throw std::runtime_error("cannot open " + path);
+    char magic[4] = {};
+    in.read(magic, 4);
+    bool binary = in.gcount() == 4 && std::memcmp(magic, "EVTB", 4) == 0;
+    return binary ? NomographTables::loadBinary(path) : NomographTables::loadText(path);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string tablesPath, emitPath, name = "generatedFit";
+    std::size_t pieces[5] = {10, 10, 10, 14, 13};
+    bool sweep = false;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        bool ok = true;
+        if (std::strcmp(arg, "--tables") == 0 && value) {
+            tablesPath = value;
+            i++;
+        } else if (std::strcmp(arg, "--pieces") == 0 && value) {
+            ok = parsePieces(value, pieces);
+            i++;
+        } else if (std::strcmp(arg, "--sweep") == 0) {
+            sweep = true;
+        } else if (std::strcmp(arg, "--emit") == 0 && value) {
+            emitPath = value;
+            i++;
+        } else if (std::strcmp(arg, "--name") == 0 && value) {
+            name = value;
+            i++;
+        } else if (std::strcmp(arg, "-h") == 0 || std::strcmp(arg, "--help") == 0) {
+            printUsage(argv[0]);
+            return 0;
+        } else {
+            ok = false;
+        }
+        if (!ok) {
+            printUsage(argv[0]);
+            return 2;
+        }
+    }
+
+    try {
+        Generator gen(tablesPath.empty() ? NomographTables::defaults() : loadTables(tablesPath));
+        for (std::size_t s = 0; s < 5; ++s) {
+            if (pieces[s] > gen.fullPieces(s)) pieces[s] = gen.fullPieces(s);
+        }
+
+        std::cout << "pieces                        max error   RMS error   Trimmer max  (exact)  shift\n";
+        auto print = [](const Fit& f, const Report& r) {
+            std::ostringstream label;
+            printPieces(label, f);
+            std::printf("%-28s  %10.3g  %10.3g  %11.3f  %7.3f  %6.3g\n", label.str().c_str(), r.maxError,
+                        r.rmsError, r.trimmerMax, r.trimmerExactMax, r.trimmerShift);
+        };
+
+        if (sweep) {
+            for (std::size_t limit = 14; limit >= 1; --limit) {
+                std::size_t capped[5];
+                for (std::size_t s = 0; s < 5; ++s) capped[s] = std::min(limit, gen.fullPieces(s));
+                Fit f = gen.fit(capped);
+                print(f, gen.report(f));
+            }
+        }
+        Fit f = gen.fit(pieces);
+        Report r = gen.report(f);
+        if (!sweep) print(f, r);
+        if (!emitPath.empty()) {
+            emitHeader(emitPath, name, f, r);
+            std::cerr << "Wrote " << emitPath << std::endl;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
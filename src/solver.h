@@ -2,6 +2,11 @@
 #define SOLVER_H
 
 #include <vector>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <ostream>
+#include <string>
 
 // Structure to hold input parameters
 // Physical parameter ranges:
@@ -17,9 +22,71 @@ struct Inputs {
     double wind = 5;
 };
 
+// Receives diagnostics from solveEvaporationLoss() instead of the solver
+// writing to std::cout. Sinks shared between threads must be thread-safe;
+// all sinks below are.
+class DiagnosticsSink {
+public:
+    virtual ~DiagnosticsSink() = default;
+
+    // Called with every computed evaporation loss
+    virtual void onResult(double evapLoss) { (void)evapLoss; }
+
+    // Called when the loss falls outside the expected range (0-40%)
+    virtual void onOutOfRange(double evapLoss) { (void)evapLoss; }
+};
+
+// Discards all diagnostics (the default sink)
+class NullSink : public DiagnosticsSink {};
+
+// Prints the classic "Evaporation Loss: ...%" messages to std::cout
+class ConsoleSink : public DiagnosticsSink {
+public:
+    void onResult(double evapLoss) override;
+    void onOutOfRange(double evapLoss) override;
+};
+
+// Collects the console messages in memory; flush() writes them in one go
+class BufferedSink : public DiagnosticsSink {
+public:
+    void onResult(double evapLoss) override;
+    void onOutOfRange(double evapLoss) override;
+
+    std::string str() const;
+    void flush(std::ostream& os);
+
+private:
+    mutable std::mutex mutex;
+    std::string buffer;
+};
+
+// Counts results and out-of-range events without formatting anything
+class CountingSink : public DiagnosticsSink {
+public:
+    void onResult(double) override { results.fetch_add(1, std::memory_order_relaxed); }
+    void onOutOfRange(double) override { outOfRange.fetch_add(1, std::memory_order_relaxed); }
+
+    std::size_t resultCount() const { return results.load(std::memory_order_relaxed); }
+    std::size_t outOfRangeCount() const { return outOfRange.load(std::memory_order_relaxed); }
+    void reset() {
+        results.store(0, std::memory_order_relaxed);
+        outOfRange.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<std::size_t> results{0};
+    std::atomic<std::size_t> outOfRange{0};
+};
+
+// Select the sink used by solveEvaporationLoss(in); nullptr restores the null
+// sink. The sink must outlive every solver call that can observe it.
+void setDiagnosticsSink(DiagnosticsSink* sink);
+DiagnosticsSink& getDiagnosticsSink();
+
 // Function declarations
 double interpolate(const std::vector<std::pair<double, double>>& table, double xq);
 double linearBetween(double x, double x1, double y1, double x2, double y2);
 double solveEvaporationLoss(const Inputs& in);
+double solveEvaporationLoss(const Inputs& in, DiagnosticsSink& sink);
 
 #endif // SOLVER_H
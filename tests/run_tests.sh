@@ -3,126 +3,120 @@
 echo "🔧 Running Complete Test Suite..."
 echo ""
 
-# Test 1: Original solver
-echo "📋 Test 1: Original Solver"
-echo "🔧 Compiling..."
-g++ -std=c++17 -o test_solver test_solver.cpp ../src/solver.cpp
-
-if [ $? -ne 0 ]; then
-    echo "❌ Original solver compilation failed."
-    exit 1
-fi
-
-echo "✅ Running..."
-./test_solver
-ORIG_EXIT_CODE=$?
-
-if [ $ORIG_EXIT_CODE -eq 0 ]; then
-    echo "✅ Original solver test passed."
-else
-    echo "❌ Original solver test failed."
-fi
-
-echo ""
-
-# Test 2: Compact solver
-echo "📋 Test 2: Compact Solver"
-echo "🔧 Compiling..."
-g++ -std=c++17 -o test_compact_solver test_compact_solver.cpp
-
-if [ $? -ne 0 ]; then
-    echo "❌ Compact solver compilation failed."
-    exit 1
-fi
-
-echo "✅ Running..."
-./test_compact_solver
-COMPACT_EXIT_CODE=$?
-
-if [ $COMPACT_EXIT_CODE -eq 0 ]; then
-    echo "✅ Compact solver test passed."
-else
-    echo "❌ Compact solver test failed."
-fi
-
-echo ""
-
-# Test 3: Validated solver
-echo "📋 Test 3: Validated Solver"
-echo "🔧 Compiling..."
-g++ -std=c++17 -o test_validated_solver test_validated_solver.cpp
-
-if [ $? -ne 0 ]; then
-    echo "❌ Validated solver compilation failed."
-    exit 1
-fi
-
-echo "✅ Running..."
-./test_validated_solver
-VALIDATED_EXIT_CODE=$?
-
-if [ $VALIDATED_EXIT_CODE -eq 0 ]; then
-    echo "✅ Validated solver test passed."
-else
-    echo "❌ Validated solver test failed."
-fi
-
-echo ""
-
-# Test 4: Table validation
-echo "📋 Test 4: Table Validation"
-echo "🔧 Compiling..."
-g++ -std=c++17 -o test_table_validation test_table_validation.cpp
-
-if [ $? -ne 0 ]; then
-    echo "❌ Table validation compilation failed."
+NAMES=()
+RESULTS=()
+BINARIES=()
+
+# Usage: run_test "<label>" <binary> <g++ arguments...>
+run_test() {
+    local label="$1"
+    local binary="$2"
+    shift 2
+
+    echo "📋 Test $(( ${#NAMES[@]} + 1 )): $label"
+    echo "🔧 Compiling..."
+    g++ -std=c++17 -o "$binary" "$@"
+
+    if [ $? -ne 0 ]; then
+        echo "❌ $label compilation failed."
+        exit 1
+    fi
+
+    echo "✅ Running..."
+    ./"$binary"
+    local exit_code=$?
+
+    if [ $exit_code -eq 0 ]; then
+        echo "✅ $label test passed."
+    else
+        echo "❌ $label test failed."
+    fi
+    echo ""
+
+    NAMES+=("$label")
+    RESULTS+=($exit_code)
+    BINARIES+=("$binary")
+}
+
+run_test "Original Solver" test_solver test_solver.cpp ../src/solver.cpp
+run_test "Original Solver Allocations" test_solver_allocations test_solver_allocations.cpp ../src/solver.cpp
+run_test "Original Solver Diagnostics" test_solver_diagnostics test_solver_diagnostics.cpp ../src/solver.cpp
+run_test "Compact Solver" test_compact_solver test_compact_solver.cpp
+run_test "Validated Solver" test_validated_solver test_validated_solver.cpp
+run_test "Validation Status" test_validation_status test_validation_status.cpp
+run_test "Core Consistency" test_core_consistency test_core_consistency.cpp ../src/solver.cpp
+run_test "Table Validation" test_table_validation test_table_validation.cpp
+run_test "Batch Solver" test_batch_solver test_batch_solver.cpp
+run_test "Grid Lookup" test_grid_lookup test_grid_lookup.cpp
+run_test "Float Precision" test_float_solver test_float_solver.cpp
+run_test "SIMD Kernels" test_simd_solver test_simd_solver.cpp
+run_test "SIMD Kernels -O2" test_simd_solver_o2 test_simd_solver.cpp -O2
+run_test "SIMD Kernels -O3 native" test_simd_solver_native test_simd_solver.cpp -O3 -march=native
+run_test "Thread Safety" test_thread_safety test_thread_safety.cpp -pthread
+run_test "Parallel Batch" test_parallel_solver test_parallel_solver.cpp -pthread
+run_test "Grouped Aggregation" test_aggregate_solver test_aggregate_solver.cpp -pthread
+run_test "Uncertainty Propagation" test_uncertainty_solver test_uncertainty_solver.cpp -pthread
+run_test "Separable Engine" test_separable_solver test_separable_solver.cpp
+run_test "Polynomial Engine" test_polynomial_solver test_polynomial_solver.cpp
+run_test "Polynomial Engine -O2" test_polynomial_solver_o2 test_polynomial_solver.cpp -O2
+run_test "Polynomial Engine -O3 native" test_polynomial_solver_native test_polynomial_solver.cpp -O3 -march=native
+run_test "Sprinkler Profiles" test_profile_solver test_profile_solver.cpp
+run_test "Profile LUT" test_lut_solver test_lut_solver.cpp
+run_test "Nomograph Tables" test_nomograph_tables test_nomograph_tables.cpp
+run_test "Nomograph Tables -O2" test_nomograph_tables_o2 test_nomograph_tables.cpp -O2
+run_test "Nomograph Tables -O3 native" test_nomograph_tables_native test_nomograph_tables.cpp -O3 -march=native
+run_test "LUT File" test_lut_file test_lut_file.cpp
+run_test "Incremental Evaluator" test_incremental_solver test_incremental_solver.cpp
+run_test "Memoization Cache" test_memo_cache test_memo_cache.cpp -pthread
+run_test "Metric Input" test_metric_solver test_metric_solver.cpp
+run_test "Inverse Solver" test_inverse_solver test_inverse_solver.cpp
+run_test "Gradients" test_gradient_solver test_gradient_solver.cpp
+run_test "Stream Processor" test_stream_processor test_stream_processor.cpp -pthread
+run_test "Evaluation Service" test_service test_service.cpp -pthread
+run_test "Instrumentation" test_instrumentation test_instrumentation.cpp -pthread -DEVAP_SOLVER_INSTRUMENT=1
+run_test "Instrumentation Disabled" test_instrumentation_disabled test_instrumentation.cpp -pthread
+run_test "Engine Differential" test_engine_differential test_engine_differential.cpp ../src/solver.cpp -O2 -pthread
+
+# C ABI: the shared library and a C99 caller linked against it
+if ! ../build_c_library.sh . > /dev/null || ! gcc -std=c99 -Wall -Wextra -pedantic -c test_c_api.c -o test_c_api.o; then
+    echo "❌ C ABI compilation failed."
     exit 1
 fi
-
-echo "✅ Running..."
-./test_table_validation
-TABLE_EXIT_CODE=$?
-
-if [ $TABLE_EXIT_CODE -eq 0 ]; then
-    echo "✅ Table validation test passed."
+BINARIES+=("libevap_solver.so" "libevap_solver.so.1" "test_c_api.o")
+run_test "C ABI" test_c_api test_c_api.o -L. -levap_solver -Wl,-rpath,'$ORIGIN'
+
+# GPU backend: needs the CUDA toolkit; the test skips itself without a device
+if command -v nvcc > /dev/null; then
+    CUDA_LIB="$(dirname "$(command -v nvcc)")/../lib64"
+    if ! nvcc -std=c++17 -O3 -fmad=false -c ../src/evap_solver_gpu.cu -o evap_solver_gpu.o; then
+        echo "❌ GPU Backend compilation failed."
+        exit 1
+    fi
+    BINARIES+=("evap_solver_gpu.o")
+    run_test "GPU Backend" test_gpu_solver test_gpu_solver.cpp evap_solver_gpu.o -pthread -L"$CUDA_LIB" -lcudart
 else
-    echo "❌ Table validation test failed."
+    echo "⏭️  GPU Backend skipped: nvcc not found"
+    echo ""
 fi
 
-echo ""
-
 # Summary
 echo "📊 Test Summary:"
-if [ $ORIG_EXIT_CODE -eq 0 ]; then
-    echo "✅ Original solver: PASSED"
-else
-    echo "❌ Original solver: FAILED"
-fi
-
-if [ $COMPACT_EXIT_CODE -eq 0 ]; then
-    echo "✅ Compact solver: PASSED"
-else
-    echo "❌ Compact solver: FAILED"
-fi
-
-if [ $VALIDATED_EXIT_CODE -eq 0 ]; then
-    echo "✅ Validated solver: PASSED"
-else
-    echo "❌ Validated solver: FAILED"
-fi
-
-if [ $TABLE_EXIT_CODE -eq 0 ]; then
-    echo "✅ Table validation: PASSED"
-else
-    echo "❌ Table validation: FAILED"
-fi
+ALL_PASSED=1
+for i in "${!NAMES[@]}"; do
+    if [ ${RESULTS[$i]} -eq 0 ]; then
+        echo "✅ ${NAMES[$i]}: PASSED"
+    else
+        echo "❌ ${NAMES[$i]}: FAILED"
+        ALL_PASSED=0
+    fi
+done
 
 echo ""
 echo "🧹 Cleaning up..."
-rm -f test_solver test_compact_solver test_validated_solver test_table_validation
+rm -f "${BINARIES[@]}"
 
 # Check overall result
-if [ $ORIG_EXIT_CODE -eq 0 ] && [ $COMPACT_EXIT_CODE -eq 0 ] && [ $VALIDATED_EXIT_CODE -eq 0 ] && [ $TABLE_EXIT_CODE -eq 0 ]; then
+if [ $ALL_PASSED -eq 1 ]; then
     echo "🎉 All tests passed!"
     exit 0
 else
@@ -0,0 +1,176 @@
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "../src/evap_solver_aggregate.h"
+
+bool bitEqual(double a, double b) {
+    return std::memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+struct FieldData {
+    std::vector<double> vpd, pressure, wind, volume;
+    std::vector<int> nozzle;
+    std::vector<uint32_t> key;
+
+    FieldData(size_t n, uint32_t groups) {
+        std::mt19937 rng(11);
+        std::uniform_real_distribution<double> v(0.0, 1.0), p(20, 80), w(0, 15), q(0.5, 500.0);
+        std::uniform_int_distribution<int> z(8, 64);
+        std::uniform_int_distribution<uint32_t> k(0, groups - 1);
+        for (size_t i = 0; i < n; i++) {
+            vpd.push_back(v(rng));
+            nozzle.push_back(z(rng));
+            pressure.push_back(p(rng));
+            wind.push_back(w(rng));
+            volume.push_back(q(rng));
+            // Runs of records per field, as in sorted telemetry, with some scatter
+            key.push_back(i % 7 == 0 ? k(rng) : static_cast<uint32_t>(i / 5000 % groups));
+        }
+    }
+    size_t size() const { return vpd.size(); }
+
+    void addTo(EvapSolver::Parallel::Aggregator& agg, size_t begin, size_t end) const {
+        agg.add(&vpd[begin], &nozzle[begin], &pressure[begin], &wind[begin], &volume[begin], &key[begin],
+                end - begin);
+    }
+};
+
+void assertSameTotals(const std::vector<EvapSolver::Parallel::GroupTotal>& a,
+                      const std::vector<EvapSolver::Parallel::GroupTotal>& b) {
+    assert(a.size() == b.size());
+    for (size_t k = 0; k < a.size(); k++) {
+        assert(a[k].records == b[k].records);
+        assert(bitEqual(a[k].volume, b[k].volume));
+        assert(bitEqual(a[k].lost, b[k].lost));
+    }
+}
+
+void testReproducibleAcrossThreads() {
+    using namespace EvapSolver::Parallel;
+
+    const uint32_t groups = 37;
+    FieldData data(200003, groups);
+    Aggregator serial({groups, 1000});
+    data.addTo(serial, 0, data.size());
+    std::vector<GroupTotal> expected = serial.totals();
+
+    struct Config { unsigned threads; size_t chunk; };
+    const Config configs[] = {{1, 4096}, {2, 1}, {3, 777}, {4, 1000}, {8, 16384}, {0, 100000}};
+    for (const Config& c : configs) {
+        ThreadPool pool({c.threads, c.chunk, false});
+        Aggregator agg(pool, {groups, 1000});
+        data.addTo(agg, 0, data.size());
+        assertSameTotals(agg.totals(), expected);
+        std::cout << "[PASS] " << pool.size() << " threads, chunk " << pool.chunkSize()
+                  << ": totals bit-identical to the serial aggregator" << std::endl;
+    }
+}
+
+void testReproducibleAcrossCallSplits() {
+    using namespace EvapSolver::Parallel;
+
+    const uint32_t groups = 13;
+    FieldData data(50000, groups);
+    Aggregator whole({groups, 512});
+    data.addTo(whole, 0, data.size());
+
+    ThreadPool pool({4, 300, false});
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<size_t> step(0, 3000);
+    Aggregator pieces(pool, {groups, 512});
+    for (size_t begin = 0; begin < data.size();) {
+        size_t end = std::min(data.size(), begin + step(rng));
+        data.addTo(pieces, begin, end);
+        begin = end;
+    }
+    assert(pieces.records() == data.size());
+    assertSameTotals(pieces.totals(), whole.totals());
+    std::cout << "[PASS] Random add() splits give the same totals as one call" << std::endl;
+}
+
+void testMatchesReference() {
+    using namespace EvapSolver;
+
+    const uint32_t groups = 20;
+    FieldData data(30011, groups);
+    std::vector<long double> volume(groups), lost(groups);
+    std::vector<size_t> records(groups);
+    for (size_t i = 0; i < data.size(); i++) {
+        double loss = Calculator::calculate({data.vpd[i], data.nozzle[i], data.pressure[i], data.wind[i]});
+        volume[data.key[i]] += data.volume[i];
+        lost[data.key[i]] += data.volume[i] * loss / 100.0;
+        records[data.key[i]]++;
+    }
+
+    Parallel::ThreadPool pool({3, 1024, false});
+    std::vector<Parallel::GroupTotal> totals =
+        Parallel::aggregateByKey(pool, data.vpd.data(), data.nozzle.data(), data.pressure.data(),
+                                 data.wind.data(), data.volume.data(), data.key.data(), data.size(), groups);
+    for (uint32_t k = 0; k < groups; k++) {
+        assert(totals[k].records == records[k]);
+        assert(std::fabs(totals[k].volume - static_cast<double>(volume[k])) <= 1e-15 * totals[k].volume);
+        assert(std::fabs(totals[k].lost - static_cast<double>(lost[k])) <= 1e-15 * totals[k].lost);
+        assert(std::fabs(totals[k].meanLoss() - 100.0 * static_cast<double>(lost[k] / volume[k])) < 1e-12);
+    }
+    std::cout << "[PASS] Totals match a long double reference to 1e-15 relative" << std::endl;
+}
+
+void testCompensation() {
+    using namespace EvapSolver::Parallel;
+
+    // One large record followed by many small ones: a plain double sum drops
+    // every small volume, the compensated sum keeps them
+    const size_t n = 100001;
+    std::vector<double> vpd(n, 0.5), pressure(n, 40), wind(n, 5), volume(n, 1.0);
+    std::vector<int> nozzle(n, 12);
+    std::vector<uint32_t> key(n, 0);
+    volume[0] = 1e17;
+
+    Aggregator agg({1, 4096});
+    agg.add(vpd.data(), nozzle.data(), pressure.data(), wind.data(), volume.data(), key.data(), n);
+    double naive = 0;
+    for (double v : volume) naive += v;
+    assert(naive == 1e17);
+    assert(agg.totals()[0].volume == 1e17 + 100000);
+    std::cout << "[PASS] Compensated sums keep small volumes after a large one" << std::endl;
+}
+
+void testSkippedKeysAndReset() {
+    using namespace EvapSolver::Parallel;
+
+    std::vector<double> vpd = {0.5, 0.5, 0.5, 0.5}, pressure = {40, 40, 40, 40}, wind = {5, 5, 5, 5};
+    std::vector<double> volume = {10, 20, 30, 40};
+    std::vector<int> nozzle = {12, 12, 12, 12};
+    std::vector<uint32_t> key = {0, 3, 2, 0};
+
+    Aggregator agg({3});
+    agg.add(vpd.data(), nozzle.data(), pressure.data(), wind.data(), volume.data(), key.data(), 4);
+    std::vector<GroupTotal> t = agg.totals();
+    assert(agg.records() == 4 && agg.skipped() == 1);
+    assert(t[0].records == 2 && t[0].volume == 50);
+    assert(t[1].records == 0 && t[1].volume == 0 && t[1].meanLoss() == 0);
+    assert(t[2].records == 1 && t[2].volume == 30);
+    double loss = EvapSolver::Calculator::calculate({0.5, 12, 40, 5});
+    assert(std::fabs(t[0].meanLoss() - loss) < 1e-12);
+
+    agg.reset();
+    assert(agg.records() == 0 && agg.skipped() == 0 && agg.totals()[0].records == 0);
+    std::cout << "[PASS] Out-of-range keys are skipped; reset() clears totals" << std::endl;
+}
+
+int main() {
+    std::cout << "=== Grouped Aggregation Tests ===" << std::endl;
+
+    testReproducibleAcrossThreads();
+    testReproducibleAcrossCallSplits();
+    testMatchesReference();
+    testCompensation();
+    testSkippedKeysAndReset();
+
+    std::cout << "\n✅ All aggregation tests passed!" << std::endl;
+    return 0;
+}
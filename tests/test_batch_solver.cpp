@@ -0,0 +1,101 @@
+#include <iostream>
+#include <cassert>
+#include <cstring>
+#include <vector>
+#include "../src/evap_solver_compact.h"
+#include "../examples/evap_calculator.h"
+
+// Bitwise comparison so that rounding differences are not hidden by a tolerance
+bool bitEqual(double a, double b) {
+    return std::memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+struct BatchData {
+    std::vector<double> vpd, pressure, wind;
+    std::vector<int> nozzle;
+
+    void add(double v, int n, double p, double w) {
+        vpd.push_back(v);
+        nozzle.push_back(n);
+        pressure.push_back(p);
+        wind.push_back(w);
+    }
+    size_t size() const { return vpd.size(); }
+};
+
+BatchData makeGrid() {
+    BatchData data;
+    // Sweep every parameter across its range, including exact tick values,
+    // points between ticks and values outside the tables (clamped)
+    for (double vpd = -0.1; vpd <= 1.15; vpd += 0.05) {
+        for (int nozzle = 6; nozzle <= 66; nozzle += 3) {
+            for (double pressure = 15; pressure <= 85; pressure += 5.5) {
+                for (double wind = -1; wind <= 16; wind += 1.25) {
+                    data.add(vpd, nozzle, pressure, wind);
+                }
+            }
+        }
+    }
+    // Exact breakpoints of every scale
+    data.add(0.3, 12, 60, 13);
+    data.add(0.0, 8, 20, 0);
+    data.add(1.0, 64, 80, 15);
+    data.add(0.6, 12, 40, 5);
+    return data;
+}
+
+void testBatchMatchesScalar() {
+    using namespace EvapSolver;
+
+    BatchData data = makeGrid();
+    std::vector<double> out(data.size());
+    Calculator::calculateBatch(data.vpd.data(), data.nozzle.data(), data.pressure.data(),
+                               data.wind.data(), out.data(), data.size());
+
+    for (size_t i = 0; i < data.size(); i++) {
+        double scalar = Calculator::calculate({data.vpd[i], data.nozzle[i], data.pressure[i], data.wind[i]});
+        assert(bitEqual(out[i], scalar));
+    }
+    std::cout << "[PASS] Batch matches calculate() bit for bit on " << data.size() << " records" << std::endl;
+}
+
+void testBatchMatchesReference() {
+    using namespace EvapSolver;
+
+    // examples/evap_calculator.h keeps the std::lower_bound implementation
+    BatchData data = makeGrid();
+    std::vector<double> out(data.size());
+    Calculator::calculateBatch(data.vpd.data(), data.nozzle.data(), data.pressure.data(),
+                               data.wind.data(), out.data(), data.size());
+
+    for (size_t i = 0; i < data.size(); i++) {
+        double reference = ::calculateEvaporationLoss(data.vpd[i], data.nozzle[i], data.pressure[i], data.wind[i]);
+        assert(bitEqual(out[i], reference));
+    }
+    std::cout << "[PASS] Batch matches lower_bound reference bit for bit" << std::endl;
+}
+
+void testEmptyAndSingleBatch() {
+    using namespace EvapSolver;
+
+    double sentinel = -1.0;
+    Calculator::calculateBatch(nullptr, nullptr, nullptr, nullptr, &sentinel, 0);
+    assert(sentinel == -1.0);
+
+    double vpd = 0.6, pressure = 40, wind = 5, out = 0.0;
+    int nozzle = 12;
+    Calculator::calculateBatch(&vpd, &nozzle, &pressure, &wind, &out, 1);
+    assert(bitEqual(out, Calculator::calculate({0.6, 12, 40, 5})));
+    std::cout << "[PASS] Empty and single-record batches: " << out << "%" << std::endl;
+}
+
+int main() {
+    std::cout << "=== Batch Evaporation Loss Solver Tests ===" << std::endl;
+
+    testBatchMatchesScalar();
+    testBatchMatchesReference();
+    testEmptyAndSingleBatch();
+
+    std::cout << "\n✅ All batch tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,198 @@
+// C99 caller of libevap_solver.so; run_tests.sh builds the library first
+#define _POSIX_C_SOURCE 200809L
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include "../src/evap_solver_c.h"
+
+#define RECORDS 100003 // Several pool chunks, not a multiple of any block
+
+static double vpd[RECORDS], pressure[RECORDS], wind[RECORDS], out[RECORDS], expected[RECORDS];
+static int32_t nozzle[RECORDS];
+
+// Deterministic inputs, slightly wider than the tables
+static void fillRecords(void) {
+    uint32_t state = 28;
+    for (size_t i = 0; i < RECORDS; i++) {
+        state = state * 1664525u + 1013904223u;
+        double u = (state >> 8) / 16777216.0;
+        vpd[i] = -0.05 + 1.1 * u;
+        nozzle[i] = 6 + (int32_t)(i % 61);
+        pressure[i] = 18 + 64 * fmod(u * 7.0, 1.0);
+        wind[i] = -0.5 + 16 * fmod(u * 13.0, 1.0);
+    }
+}
+
+static int sameBits(const double* a, const double* b, size_t n) {
+    return memcmp(a, b, n * sizeof(double)) == 0;
+}
+
+static void testBatch(void) {
+    assert(evap_abi_version() == EVAP_ABI_VERSION);
+
+    // Reference example of the README
+    double v = 0.6, p = 40, w = 5, loss = 0;
+    int32_t z = 12;
+    assert(evap_batch(&v, &z, &p, &w, &loss, 1, 0) == EVAP_OK);
+    assert(fabs(loss - 8.314328922193823) < 1e-12);
+
+    assert(evap_batch(vpd, nozzle, pressure, wind, expected, RECORDS, EVAP_ENGINE_EXACT) == EVAP_OK);
+    assert(evap_batch(vpd, nozzle, pressure, wind, out, RECORDS, EVAP_FLAG_PARALLEL) == EVAP_OK);
+    assert(sameBits(out, expected, RECORDS));
+    assert(evap_set_threads(3) == EVAP_OK && evap_threads() == 3);
+    memset(out, 0, sizeof(out));
+    assert(evap_batch(vpd, nozzle, pressure, wind, out, RECORDS, EVAP_FLAG_PARALLEL) == EVAP_OK);
+    assert(sameBits(out, expected, RECORDS));
+
+    // Other engines stay within their bound
+    uint32_t engines[2] = {EVAP_ENGINE_SEPARABLE, EVAP_ENGINE_POLYNOMIAL};
+    for (int e = 0; e < 2; e++) {
+        assert(evap_batch(vpd, nozzle, pressure, wind, out, RECORDS, engines[e] | EVAP_FLAG_PARALLEL) == EVAP_OK);
+        for (size_t i = 0; i < RECORDS; i++) assert(fabs(out[i] - expected[i]) <= 1e-12);
+    }
+    printf("[PASS] %d records: serial, 3-thread parallel and engine flags agree with the exact chain\n", RECORDS);
+}
+
+struct Record {
+    double vpd;
+    int32_t nozzle;
+    float pad;
+    double pressure, wind, loss;
+};
+
+static void testStrided(void) {
+    struct Record* records = malloc(RECORDS * sizeof(struct Record));
+    assert(records);
+    for (size_t i = 0; i < RECORDS; i++) {
+        records[i].vpd = vpd[i];
+        records[i].nozzle = nozzle[i];
+        records[i].pressure = pressure[i];
+        records[i].wind = wind[i];
+        records[i].loss = -1;
+    }
+    ptrdiff_t s = sizeof(struct Record);
+    for (uint32_t flags = 0; flags <= EVAP_FLAG_PARALLEL; flags++) {
+        assert(evap_batch_strided(&records[0].vpd, s, &records[0].nozzle, s, &records[0].pressure, s,
+                                  &records[0].wind, s, &records[0].loss, s, RECORDS, flags) == EVAP_OK);
+        for (size_t i = 0; i < RECORDS; i++) assert(memcmp(&records[i].loss, &expected[i], sizeof(double)) == 0);
+    }
+
+    // A stride of 0 repeats one nozzle and pressure; a negative stride walks backwards
+    int32_t oneNozzle = 24;
+    double onePressure = 50;
+    double* reversed = malloc(RECORDS * sizeof(double));
+    assert(reversed);
+    assert(evap_batch_strided(vpd, sizeof(double), &oneNozzle, 0, &onePressure, 0, wind, sizeof(double),
+                              reversed + RECORDS - 1, -(ptrdiff_t)sizeof(double), RECORDS, 0) == EVAP_OK);
+    for (size_t i = 0; i < RECORDS; i += 101) {
+        double loss;
+        assert(evap_batch(&vpd[i], &oneNozzle, &onePressure, &wind[i], &loss, 1, 0) == EVAP_OK);
+        assert(memcmp(&loss, &reversed[RECORDS - 1 - i], sizeof(double)) == 0);
+    }
+    free(reversed);
+    free(records);
+    printf("[PASS] Record structs, broadcast and reversed columns read in place, bit-identical\n");
+}
+
+static void testFloat(void) {
+    static float fv[RECORDS], fp[RECORDS], fw[RECORDS], fout[RECORDS], fserial[RECORDS];
+    for (size_t i = 0; i < RECORDS; i++) {
+        fv[i] = (float)vpd[i];
+        fp[i] = (float)pressure[i];
+        fw[i] = (float)wind[i];
+    }
+    assert(evap_batch_f32(fv, nozzle, fp, fw, fserial, RECORDS, 0) == EVAP_OK);
+    assert(evap_batch_f32(fv, nozzle, fp, fw, fout, RECORDS, EVAP_FLAG_PARALLEL) == EVAP_OK);
+    assert(memcmp(fout, fserial, sizeof(fout)) == 0);
+    double worst = 0;
+    for (size_t i = 0; i < RECORDS; i++) {
+        double d = fabs(fout[i] - expected[i]);
+        if (d > worst) worst = d;
+    }
+    assert(worst < 1e-3);
+    assert(evap_batch_f32(fv, nozzle, fp, fw, fout, RECORDS, EVAP_ENGINE_SEPARABLE) == EVAP_ERROR_FLAGS);
+    printf("[PASS] Float32 columns: max deviation from double %g\n", worst);
+}
+
+static void testStatus(void) {
+    static uint8_t status[RECORDS];
+    size_t invalid = 0, counted = 0;
+    assert(evap_batch_status(vpd, nozzle, pressure, wind, out, status, RECORDS, -1.0, EVAP_FLAG_PARALLEL,
+                             &invalid) == EVAP_OK);
+    for (size_t i = 0; i < RECORDS; i++) {
+        uint8_t s = (vpd[i] < 0 || vpd[i] > 1 ? EVAP_STATUS_VPD : 0) |
+                    (nozzle[i] < 8 || nozzle[i] > 64 ? EVAP_STATUS_NOZZLE : 0) |
+                    (pressure[i] < 20 || pressure[i] > 80 ? EVAP_STATUS_PRESSURE : 0) |
+                    (wind[i] < 0 || wind[i] > 15 ? EVAP_STATUS_WIND : 0);
+        assert(status[i] == s);
+        if (s) {
+            assert(out[i] == -1.0);
+            counted++;
+        } else {
+            assert(memcmp(&out[i], &expected[i], sizeof(double)) == 0);
+        }
+    }
+    assert(invalid == counted && invalid > 0);
+    assert(evap_batch_status(vpd, nozzle, pressure, wind, out, status, RECORDS, NAN, 0, NULL) == EVAP_OK);
+    printf("[PASS] Status masks: %zu of %d records rejected, the rest bit-identical\n", invalid, RECORDS);
+}
+
+static void testErrors(void) {
+    double loss = 123;
+    assert(evap_batch(NULL, nozzle, pressure, wind, &loss, 1, 0) == EVAP_ERROR_ARGUMENT);
+    assert(evap_batch(vpd, nozzle, pressure, wind, &loss, 1, 0x100) == EVAP_ERROR_FLAGS);
+    assert(evap_batch(vpd, nozzle, pressure, wind, &loss, 1, 0x30) == EVAP_ERROR_FLAGS);
+    assert(evap_batch_status(vpd, nozzle, pressure, wind, &loss, NULL, 1, 0, 0, NULL) == EVAP_ERROR_ARGUMENT);
+    assert(loss == 123);
+    assert(evap_batch(NULL, NULL, NULL, NULL, NULL, 0, EVAP_FLAG_PARALLEL) == EVAP_OK);
+    assert(strcmp(evap_strerror(EVAP_ERROR_FLAGS), "unsupported flags") == 0);
+    assert(strcmp(evap_strerror(42), "unknown error") == 0);
+    assert(evap_set_threads(0) == EVAP_OK && evap_threads() >= 1);
+    printf("[PASS] Null buffers and unknown flags are reported without writing\n");
+}
+
+// Thread creation failing inside the library is reported, not fatal
+static void testThreadFailure(void) {
+    // Address space a little above the current size: a few 8 MiB stacks fit, not 256
+    unsigned long pages = 0;
+    FILE* statm = fopen("/proc/self/statm", "r");
+    assert(statm && fscanf(statm, "%lu", &pages) == 1);
+    fclose(statm);
+    struct rlimit saved, cap;
+    assert(getrlimit(RLIMIT_AS, &saved) == 0);
+    cap = saved;
+    cap.rlim_cur = pages * 4096 + (64UL << 20);
+
+    double loss = 123;
+    assert(evap_set_threads(256) == EVAP_OK);
+    assert(setrlimit(RLIMIT_AS, &cap) == 0);
+    int rc = evap_batch(vpd, nozzle, pressure, wind, &loss, 1, EVAP_FLAG_PARALLEL);
+    unsigned threads = evap_threads();
+    assert(setrlimit(RLIMIT_AS, &saved) == 0);
+    assert(rc == EVAP_ERROR_INTERNAL && loss == 123 && threads == 0);
+
+    // Once threads can be created again, the next call builds the pool
+    assert(evap_set_threads(3) == EVAP_OK);
+    assert(evap_batch(vpd, nozzle, pressure, wind, out, RECORDS, EVAP_FLAG_PARALLEL) == EVAP_OK);
+    assert(sameBits(out, expected, RECORDS) && evap_threads() == 3);
+    assert(evap_set_threads(0) == EVAP_OK);
+    printf("[PASS] Failed thread creation returns EVAP_ERROR_INTERNAL; the pool recovers\n");
+}
+
+int main(void) {
+    printf("=== C ABI Tests ===\n");
+
+    fillRecords();
+    testBatch();
+    testStrided();
+    testFloat();
+    testStatus();
+    testErrors();
+    testThreadFailure();
+
+    printf("\n✅ All C ABI tests passed!\n");
+    return 0;
+}
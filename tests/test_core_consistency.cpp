@@ -0,0 +1,158 @@
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "../src/solver.h"
+#include "../src/evap_solver_core.h"
+#include "../src/evap_solver_compact.h"
+#include "../src/evap_solver_validated.h"
+#include "../examples/evap_calculator.h"
+
+// The copy-paste calculator is a complete program; compile its function in
+// a namespace and rename its example main so it can be linked in here
+namespace CopyPaste {
+#define main copyPasteExampleMain
+#include "../examples/copy_paste_calculator.cpp"
+#undef main
+}
+
+using namespace EvapSolver;
+
+bool bitEqual(double a, double b) {
+    return std::memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+// Every shipped front end over the core returns the same bits; the
+// standalone example copies stay within rounding of it
+void testFrontEndsAgree() {
+    size_t count = 0;
+    double maxCopyPaste = 0.0;
+    for (double vpd = 0.0; vpd <= 1.0; vpd += 0.04) {
+        for (int nozzle = 8; nozzle <= 64; nozzle += 4) {
+            for (double pressure = 20; pressure <= 80; pressure += 3.75) {
+                for (double wind = 0; wind <= 15; wind += 0.6) {
+                    double core = Nomograph<double>::calculate({vpd, nozzle, pressure, wind});
+                    Inputs in;
+                    in.vpd = vpd;
+                    in.nozzle = nozzle;
+                    in.pressure = pressure;
+                    in.wind = wind;
+                    EvapSolverValidated::Status status;
+                    assert(bitEqual(Calculator::calculate({vpd, nozzle, pressure, wind}), core));
+                    assert(bitEqual(solveEvaporationLoss(in), core));
+                    assert(bitEqual(EvapSolverValidated::calculateEvaporationLoss(vpd, nozzle, pressure, wind), core));
+                    assert(bitEqual(EvapSolverValidated::Calculator::calculateWithStatus(
+                                        EvapSolverValidated::Input::unchecked(vpd, nozzle, pressure, wind), status),
+                                    core));
+                    assert(bitEqual(::calculateEvaporationLoss(vpd, nozzle, pressure, wind), core));
+                    maxCopyPaste = std::fmax(
+                        maxCopyPaste, std::abs(CopyPaste::calculateEvaporationLoss(vpd, nozzle, pressure, wind) - core));
+
+                    float f = Nomograph<float>::calculate({float(vpd), nozzle, float(pressure), float(wind)});
+                    float g = FloatCalculator::calculate({float(vpd), nozzle, float(pressure), float(wind)});
+                    assert(std::memcmp(&f, &g, sizeof(float)) == 0);
+                    count++;
+                }
+            }
+        }
+    }
+    assert(maxCopyPaste <= 1e-12);
+    std::cout << "[PASS] solver.cpp, compact, validated, float and evap_calculator.h agree bit for bit on " << count
+              << " points (copy-paste within " << maxCopyPaste << ")" << std::endl;
+}
+
+std::string thrownMessage(double (*f)(double, int, double, double), double vpd, int nozzle, double pressure,
+                          double wind) {
+    try {
+        f(vpd, nozzle, pressure, wind);
+    } catch (const std::runtime_error& e) {
+        return e.what();
+    }
+    return "";
+}
+
+double solveRaw(double vpd, int nozzle, double pressure, double wind) {
+    Inputs in;
+    in.vpd = vpd;
+    in.nozzle = nozzle;
+    in.pressure = pressure;
+    in.wind = wind;
+    return solveEvaporationLoss(in);
+}
+
+double throwingCore(double vpd, int nozzle, double pressure, double wind) {
+    return Nomograph<double, ThrowingValidation<>>::calculate({vpd, nozzle, pressure, wind});
+}
+
+void testValidationPolicies() {
+    // Each front end keeps its own message style
+    assert(thrownMessage(solveRaw, 0.6, 70, 90, 5) == "Nozzle diameter must be between 8 and 64 (64ths of an inch)");
+    assert(thrownMessage(EvapSolverValidated::calculateEvaporationLoss, 0.6, 70, 90, 5) ==
+           "Nozzle diameter must be between 8 and 64 (64ths of an inch) (got 70)");
+    assert(thrownMessage(throwingCore, 0.6, 70, 90, 5) ==
+           thrownMessage(EvapSolverValidated::calculateEvaporationLoss, 0.6, 70, 90, 5));
+
+    // Status policy reports every bit and returns the caller's value
+    Status status;
+    double loss = Nomograph<double, StatusValidation>::calculate({1.5, 70, 90, 5}, status, -1.0);
+    assert(loss == -1.0 && status == (VpdOutOfRange | NozzleOutOfRange | PressureOutOfRange));
+
+    // No validation clamps to the table ends
+    loss = Nomograph<double>::calculate({1.5, 70, 90, 20}, status);
+    assert(status == StatusOk && bitEqual(loss, Nomograph<double>::calculate({1.0, 64, 80, 15})));
+    std::cout << "[PASS] Throwing, status and unchecked policies" << std::endl;
+}
+
+// Diagnostics policy: any type with onResult/onOutOfRange
+struct Tally {
+    int results = 0;
+    int outOfRange = 0;
+    void onResult(double) { results++; }
+    void onOutOfRange(double) { outOfRange++; }
+};
+
+void testDiagnosticsPolicy() {
+    using Reporting = Nomograph<double, StatusValidation, Tally>;
+    Tally tally;
+    Status status;
+    Reporting::calculate({0.6, 12, 40, 5}, status, 0.0, tally);
+    Reporting::calculate({0.6, 99, 40, 5}, status, 0.0, tally);
+    assert(tally.results == 1 && tally.outOfRange == 0);
+
+    CountingSink counter;
+    Nomograph<double, NoValidation, DiagnosticsSink>::calculate({0.6, 12, 40, 5}, status, 0.0, counter);
+    assert(counter.resultCount() == 1);
+    std::cout << "[PASS] Diagnostics reach the policy object; rejected records are not reported" << std::endl;
+}
+
+void testBatch() {
+    std::vector<double> vpd = {0.6, -0.2, 0.3}, pressure = {40, 40, 85}, wind = {5, 5, 7};
+    std::vector<int> nozzle = {12, 12, 24};
+    std::vector<double> out(3), checked(3);
+    std::vector<Status> status(3);
+    Nomograph<double>::calculateBatch(vpd.data(), nozzle.data(), pressure.data(), wind.data(), out.data(), nullptr,
+                                      3);
+    size_t invalid = Nomograph<double, StatusValidation>::calculateBatch(
+        vpd.data(), nozzle.data(), pressure.data(), wind.data(), checked.data(), status.data(), 3, -1.0);
+    assert(invalid == 2 && status[1] == VpdOutOfRange && status[2] == PressureOutOfRange);
+    assert(bitEqual(out[0], checked[0]) && checked[1] == -1.0 && checked[2] == -1.0);
+    for (size_t i = 0; i < 3; i++) {
+        assert(bitEqual(out[i], Nomograph<double>::calculate({vpd[i], nozzle[i], pressure[i], wind[i]})));
+    }
+    std::cout << "[PASS] Batch front ends match the scalar ones" << std::endl;
+}
+
+int main() {
+    std::cout << "=== Core Consistency Tests ===" << std::endl;
+
+    testFrontEndsAgree();
+    testValidationPolicies();
+    testDiagnosticsPolicy();
+    testBatch();
+
+    std::cout << "\n✅ All core consistency tests passed!" << std::endl;
+    return 0;
+}
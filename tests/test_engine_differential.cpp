@@ -0,0 +1,675 @@
+/*
+ * Differential fuzz and performance-regression harness for every engine.
+ *
+ * Each record is generated from (seed, index) alone, so any run can be
+ * split across threads or repeated bit for bit. Per axis, a record draws
+ * a uniform in-range value, an exact table tick, a tick moved by one ULP,
+ * a value in the clamp region beyond a limit, an extreme (+-inf,
+ * +-DBL_MAX, denormals, -0.0) or a NaN; nozzles also take INT_MIN/INT_MAX.
+ *
+ * The oracle is the reference solveEvaporationLoss() for records within
+ * the physical limits, and Calculator::calculate() (the shared core's
+ * clamping) for the others. A sample of the latter also checks that the
+ * reference rejects them. Every engine runs on the same records and is
+ * reported with its max absolute and max ULP deviation from the oracle.
+ * It then has to meet three sets of limits:
+ *   contract   the engine's documented guarantee (bit-identical, <= 1e-12
+ *              points, LUT errorBound(), NaN behaviour); always checked
+ *   accuracy   max_abs / max_ulp lines of a --baseline file (drift)
+ *   throughput Mrecords/s lines of a --baseline file, less --max-slowdown
+ *
+ * Baseline files are text, one limit per line ('#' starts a comment):
+ *   accuracy <engine> <max_abs> <max_ulp|->
+ *   throughput <engine> <mrecords_per_sec>
+ * tests/engine_baseline.txt holds the accuracy limits and is read from the
+ * working directory unless --baseline is given (--baseline "" for none).
+ * Throughput depends
+ * on the machine, so run_multi_solver_validation.sh records it per
+ * checkout with --write-throughput.
+ *
+ * Build: g++ -std=c++17 -O2 -pthread -o test_engine_differential test_engine_differential.cpp ../src/solver.cpp
+ *        (add -DEVAP_SOLVER_DIFF_GPU=1 and link evap_solver_gpu.o -lcudart for the GPU backend)
+ * Usage: ./test_engine_differential [--records N] [--seed S] [--threads N] [--filter SUBSTRING]
+ *                                   [--baseline FILE]... [--max-slowdown F] [--perf-time SECONDS]
+ *                                   [--write-accuracy FILE] [--write-throughput FILE]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../src/solver.h"
+#include "../src/evap_solver_compact.h"
+#include "../src/evap_solver_simd.h"
+#include "../src/evap_solver_parallel.h"
+#include "../src/evap_solver_separable.h"
+#include "../src/evap_solver_polynomial.h"
+#include "../src/evap_solver_profile.h"
+#include "../src/evap_solver_lut.h"
+#include "../src/evap_solver_tables.h"
+#include "../src/evap_solver_memo.h"
+#if EVAP_SOLVER_DIFF_GPU
+#include "../src/evap_solver_gpu.h"
+#endif
+
+using namespace EvapSolver;
+
+// ---------------------------------------------------------------------------
+// Fuzz records
+
+std::uint64_t splitMix(std::uint64_t& state) {
+    std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+double unit(std::uint64_t& state) {
+    return (splitMix(state) >> 11) * 0x1.0p-53;
+}
+
+template <std::size_t N>
+double fuzzAxis(std::uint64_t& state, const detail::Scale<N>& s) {
+    const double lo = s.x[0], hi = s.x[N - 1], span = hi - lo;
+    const double tick = s.x[splitMix(state) % N];
+    std::uint64_t mode = splitMix(state) % 100;
+    if (mode < 55) return lo + span * unit(state);
+    if (mode < 70) return tick;
+    if (mode < 80) return std::nextafter(tick, splitMix(state) & 1 ? INFINITY : -INFINITY);
+    if (mode < 90) return splitMix(state) & 1 ? lo - span * unit(state) : hi + span * unit(state);
+    if (mode < 97) {
+        static const double extremes[] = {INFINITY, -INFINITY, std::numeric_limits<double>::max(),
+                                          -std::numeric_limits<double>::max(), std::numeric_limits<double>::denorm_min(),
+                                          -std::numeric_limits<double>::denorm_min(), -0.0, 0.0};
+        return extremes[splitMix(state) % 8];
+    }
+    return std::numeric_limits<double>::quiet_NaN();
+}
+
+int fuzzNozzle(std::uint64_t& state) {
+    const detail::Scale<11>& s = detail::S5;
+    const int tick = static_cast<int>(s.x[splitMix(state) % 11]);
+    std::uint64_t mode = splitMix(state) % 100;
+    if (mode < 60) return 8 + static_cast<int>(splitMix(state) % 57);
+    if (mode < 75) return tick;
+    if (mode < 85) return tick + (splitMix(state) & 1 ? 1 : -1);
+    if (mode < 95) return splitMix(state) & 1 ? static_cast<int>(splitMix(state) % 8) : 65 + static_cast<int>(splitMix(state) % 64);
+    static const int extremes[] = {std::numeric_limits<int>::min(), std::numeric_limits<int>::max(), 0, -1};
+    return extremes[splitMix(state) % 4];
+}
+
+// One block of records as columns, with float copies for the float kernels
+struct Chunk {
+    std::vector<double> vpd, pressure, wind;
+    std::vector<int> nozzle;
+    std::vector<float> fvpd, fpressure, fwind;
+    std::size_t n = 0;
+
+    void resize(std::size_t size) {
+        vpd.resize(size);
+        pressure.resize(size);
+        wind.resize(size);
+        nozzle.resize(size);
+        fvpd.resize(size);
+        fpressure.resize(size);
+        fwind.resize(size);
+        n = size;
+    }
+
+    void fill(std::uint64_t seed, std::size_t first, bool inRange) {
+        for (std::size_t i = 0; i < n; i++) {
+            std::uint64_t state = seed ^ ((first + i) * 0xD1B54A32D192ED03ull);
+            if (inRange) {
+                vpd[i] = unit(state);
+                nozzle[i] = 8 + static_cast<int>(splitMix(state) % 57);
+                pressure[i] = 20 + 60 * unit(state);
+                wind[i] = 15 * unit(state);
+            } else {
+                vpd[i] = fuzzAxis(state, detail::S3);
+                nozzle[i] = fuzzNozzle(state);
+                pressure[i] = fuzzAxis(state, detail::S7);
+                wind[i] = fuzzAxis(state, detail::S9);
+            }
+            fvpd[i] = static_cast<float>(vpd[i]);
+            fpressure[i] = static_cast<float>(pressure[i]);
+            fwind[i] = static_cast<float>(wind[i]);
+        }
+    }
+
+    Input input(std::size_t i) const { return {vpd[i], nozzle[i], pressure[i], wind[i]}; }
+
+    bool hasNaN(std::size_t i) const { return std::isnan(vpd[i]) || std::isnan(pressure[i]) || std::isnan(wind[i]); }
+};
+
+// ---------------------------------------------------------------------------
+// Engines under test
+
+enum class NanPolicy {
+    Propagate, // A NaN input gives a NaN loss, as in the reference
+    LowerTick  // A NaN input counts as its scale's first tick
+};
+
+struct EngineCase {
+    std::string name;
+    NanPolicy nan = NanPolicy::Propagate;
+    long long contractUlp = -1; // -1: no ULP guarantee
+    double contractAbs = -1;    // -1: no absolute guarantee
+    std::function<void(const Chunk&, double*)> run;
+    // Engines evaluated on other inputs than the record (LUT grid) supply
+    // their own expected values and per-record bounds
+    std::function<void(const Chunk&, double* expected, double* bound)> expect;
+};
+
+// Coarse bilinear LUTs for every nozzle and a 5 psi pressure grid; each
+// record is evaluated on the LUT of its nozzle (clamped) and nearest pressure
+class LutFleet {
+public:
+    LutFleet() {
+        LutOptions options;
+        options.vpdStep = 0.01;
+        options.windStep = 0.5;
+        options.interpolation = LutInterpolation::Bilinear;
+        for (int z = 8; z <= 64; z++) {
+            for (int p = 0; p < pressures; p++) luts.emplace_back(z, pressureAt(p), options);
+        }
+    }
+
+    // Nozzle and pressure the record is evaluated at
+    void snap(int& nozzle, double& pressure, std::size_t& index) const {
+        int z = std::min(std::max(nozzle, 8), 64);
+        double t = std::isnan(pressure) ? 0.0 : (std::min(std::max(pressure, 20.0), 80.0) - 20.0) / 5.0;
+        int p = static_cast<int>(std::lround(t));
+        nozzle = z;
+        pressure = pressureAt(p);
+        index = static_cast<std::size_t>(z - 8) * pressures + p;
+    }
+
+    const ProfileLut& operator[](std::size_t i) const { return luts[i]; }
+
+private:
+    static constexpr int pressures = 13;
+    static double pressureAt(int p) { return 20.0 + 5.0 * p; }
+    std::vector<ProfileLut> luts;
+};
+
+double lowerTickIfNaN(double v, double tick) {
+    return std::isnan(v) ? tick : v;
+}
+
+std::vector<EngineCase> makeEngines(const LutFleet& fleet) {
+    using Simd::Kernel;
+    std::vector<EngineCase> engines;
+    const Kernel kernels[] = {Kernel::Scalar, Kernel::AVX2, Kernel::AVX512, Kernel::NEON};
+    auto bitIdentical = [](std::string name, std::function<void(const Chunk&, double*)> run) {
+        EngineCase e;
+        e.name = std::move(name);
+        e.contractUlp = 0;
+        e.run = std::move(run);
+        return e;
+    };
+
+    engines.push_back(bitIdentical("calculate", [](const Chunk& c, double* out) {
+        for (std::size_t i = 0; i < c.n; i++) out[i] = Calculator::calculate(c.input(i));
+    }));
+    engines.push_back(bitIdentical("batch", [](const Chunk& c, double* out) {
+        Calculator::calculateBatch(c.vpd.data(), c.nozzle.data(), c.pressure.data(), c.wind.data(), out, c.n);
+    }));
+    for (Kernel k : kernels) {
+        if (!Simd::isSupported(k)) continue;
+        engines.push_back(bitIdentical(std::string("simd_") + Simd::kernelName(k), [k](const Chunk& c, double* out) {
+            Simd::calculateBatch(k, c.vpd.data(), c.nozzle.data(), c.pressure.data(), c.wind.data(), out, c.n);
+        }));
+    }
+    engines.push_back(bitIdentical("tables_defaults", [](const Chunk& c, double* out) {
+        Simd::calculateBatch(NomographTables::defaults(), c.vpd.data(), c.nozzle.data(), c.pressure.data(),
+                             c.wind.data(), out, c.n);
+    }));
+    engines.push_back(bitIdentical("profile", [](const Chunk& c, double* out) {
+        for (std::size_t i = 0; i < c.n; i++) {
+            out[i] = SprinklerProfile(c.nozzle[i], c.pressure[i]).evaluate(c.vpd[i], c.wind[i]);
+        }
+    }));
+    engines.push_back(bitIdentical("memo", [](const Chunk& c, double* out) {
+        MemoizedCalculator::calculateBatch(c.vpd.data(), c.nozzle.data(), c.pressure.data(), c.wind.data(), out,
+                                           c.n);
+    }));
+
+    EngineCase separable;
+    separable.name = "separable";
+    separable.contractAbs = 1e-12;
+    separable.run = [](const Chunk& c, double* out) {
+        SeparableCalculator::calculateBatch(c.vpd.data(), c.nozzle.data(), c.pressure.data(), c.wind.data(), out,
+                                            c.n);
+    };
+    engines.push_back(separable);
+
+    for (Kernel k : kernels) {
+        if (!Simd::isSupported(k)) continue;
+        EngineCase e;
+        e.name = std::string("polynomial_") + Simd::kernelName(k);
+        e.nan = NanPolicy::LowerTick;
+        e.contractAbs = 1e-12;
+        e.run = [k](const Chunk& c, double* out) {
+            Simd::calculatePolynomialBatch(k, detail::polynomialFit, c.vpd.data(), c.nozzle.data(), c.pressure.data(),
+                                           c.wind.data(), out, c.n);
+        };
+        engines.push_back(e);
+    }
+
+    // Single precision against the double oracle; limited by the baseline only
+    for (Kernel k : kernels) {
+        if (!Simd::isSupported(k)) continue;
+        EngineCase e;
+        e.name = std::string("float_") + Simd::kernelName(k);
+        e.run = [k](const Chunk& c, double* out) {
+            std::vector<float> loss(c.n);
+            Simd::calculateBatch(k, c.fvpd.data(), c.nozzle.data(), c.fpressure.data(), c.fwind.data(), loss.data(),
+                                 c.n);
+            for (std::size_t i = 0; i < c.n; i++) out[i] = loss[i];
+        };
+        engines.push_back(e);
+    }
+
+    // NaN weather maps to the grid's lower edge, so expected values are taken there
+    EngineCase lut;
+    lut.name = "lut_bilinear";
+    lut.run = [&fleet](const Chunk& c, double* out) {
+        for (std::size_t i = 0; i < c.n; i++) {
+            int z = c.nozzle[i];
+            double p = c.pressure[i];
+            std::size_t index;
+            fleet.snap(z, p, index);
+            out[i] = fleet[index].evaluate(c.vpd[i], c.wind[i]);
+        }
+    };
+    lut.expect = [&fleet](const Chunk& c, double* expected, double* bound) {
+        for (std::size_t i = 0; i < c.n; i++) {
+            int z = c.nozzle[i];
+            double p = c.pressure[i];
+            std::size_t index;
+            fleet.snap(z, p, index);
+            expected[i] = Calculator::calculate({lowerTickIfNaN(c.vpd[i], 0.0), z, p, lowerTickIfNaN(c.wind[i], 0.0)});
+            bound[i] = fleet[index].errorBound();
+        }
+    };
+    engines.push_back(lut);
+
+#if EVAP_SOLVER_DIFF_GPU
+    if (Gpu::available()) {
+        static Gpu::Engine gpu;
+        static std::mutex gpuMutex;
+        engines.push_back(bitIdentical("gpu", [](const Chunk& c, double* out) {
+            std::lock_guard<std::mutex> lock(gpuMutex);
+            gpu.calculateBatch(c.vpd.data(), c.nozzle.data(), c.pressure.data(), c.wind.data(), out, c.n);
+        }));
+    }
+#endif
+    return engines;
+}
+
+// ---------------------------------------------------------------------------
+// Deviation statistics
+
+// Distance in representable doubles; +0 and -0 are the same value
+std::uint64_t ulpDistance(double a, double b) {
+    auto ordered = [](double d) {
+        std::int64_t i;
+        std::memcpy(&i, &d, sizeof i);
+        return i < 0 ? std::numeric_limits<std::int64_t>::min() - i : i;
+    };
+    std::int64_t x = ordered(a), y = ordered(b);
+    return x > y ? std::uint64_t(x) - std::uint64_t(y) : std::uint64_t(y) - std::uint64_t(x);
+}
+
+struct Deviation {
+    std::uint64_t records = 0;
+    std::uint64_t nanInputs = 0;
+    std::uint64_t nanMismatches = 0;      // NaN on one side only
+    std::uint64_t contractViolations = 0;
+    double maxAbs = 0;
+    std::uint64_t maxUlp = 0;
+    Input worst = {0, 0, 0, 0};           // Record with the largest absolute deviation
+    double worstValue = 0, worstExpected = 0;
+
+    void merge(const Deviation& o) {
+        records += o.records;
+        nanInputs += o.nanInputs;
+        nanMismatches += o.nanMismatches;
+        contractViolations += o.contractViolations;
+        maxUlp = std::max(maxUlp, o.maxUlp);
+        if (o.maxAbs > maxAbs) {
+            maxAbs = o.maxAbs;
+            worst = o.worst;
+            worstValue = o.worstValue;
+            worstExpected = o.worstExpected;
+        }
+    }
+};
+
+struct ReferenceCheck {
+    std::uint64_t inRange = 0;
+    std::uint64_t rejectionsChecked = 0;
+    std::uint64_t rejectionMismatches = 0; // Out-of-range records the reference accepted
+
+    void merge(const ReferenceCheck& o) {
+        inRange += o.inRange;
+        rejectionsChecked += o.rejectionsChecked;
+        rejectionMismatches += o.rejectionMismatches;
+    }
+};
+
+// Out-of-range records of which the reference's rejection is checked (exceptions are slow)
+constexpr std::uint64_t rejectionSample = 64;
+
+void computeOracle(const Chunk& c, std::size_t first, double* oracle, ReferenceCheck& check) {
+    Inputs in;
+    for (std::size_t i = 0; i < c.n; i++) {
+        in.vpd = c.vpd[i];
+        in.nozzle = c.nozzle[i];
+        in.pressure = c.pressure[i];
+        in.wind = c.wind[i];
+        if (checkInputs(in.vpd, in.nozzle, in.pressure, in.wind) == StatusOk) {
+            oracle[i] = solveEvaporationLoss(in);
+            check.inRange++;
+            continue;
+        }
+        oracle[i] = Calculator::calculate(c.input(i));
+        if ((first + i) % rejectionSample == 0) {
+            check.rejectionsChecked++;
+            try {
+                solveEvaporationLoss(in);
+                check.rejectionMismatches++;
+            } catch (const std::runtime_error&) {
+            }
+        }
+    }
+}
+
+void compare(const EngineCase& e, const Chunk& c, const double* out, const double* oracle, const double* bound,
+             Deviation& d) {
+    for (std::size_t i = 0; i < c.n; i++) {
+        double expected = oracle[i];
+        bool nanInput = c.hasNaN(i);
+        d.nanInputs += nanInput;
+        if (nanInput && e.nan == NanPolicy::LowerTick && !e.expect) {
+            expected = Calculator::calculate({lowerTickIfNaN(c.vpd[i], detail::S3.x[0]), c.nozzle[i],
+                                              lowerTickIfNaN(c.pressure[i], detail::S7.x[0]),
+                                              lowerTickIfNaN(c.wind[i], detail::S9.x[0])});
+        }
+        double value = out[i];
+        d.records++;
+        if (std::isnan(value) || std::isnan(expected)) {
+            if (std::isnan(value) != std::isnan(expected)) d.nanMismatches++;
+            continue;
+        }
+        double abs = std::fabs(value - expected);
+        std::uint64_t ulp = ulpDistance(value, expected);
+        d.maxUlp = std::max(d.maxUlp, ulp);
+        if (abs > d.maxAbs) {
+            d.maxAbs = abs;
+            d.worst = c.input(i);
+            d.worstValue = value;
+            d.worstExpected = expected;
+        }
+        if ((e.contractUlp >= 0 && ulp > std::uint64_t(e.contractUlp)) ||
+            (e.contractAbs >= 0 && abs > e.contractAbs) || (bound && abs > bound[i])) {
+            d.contractViolations++;
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Baselines
+
+struct Baseline {
+    struct Accuracy {
+        double maxAbs;
+        long long maxUlp; // -1: not limited
+    };
+    std::map<std::string, Accuracy> accuracy;
+    std::map<std::string, double> throughput; // Mrecords/s
+
+    void load(const std::string& path) {
+        std::ifstream file(path);
+        if (!file) throw std::runtime_error("cannot open baseline " + path);
+        std::string line;
+        for (int number = 1; std::getline(file, line); number++) {
+            line = line.substr(0, line.find('#'));
+            std::istringstream fields(line);
+            std::string kind, engine, a, b;
+            if (!(fields >> kind)) continue;
+            bool ok = static_cast<bool>(fields >> engine >> a);
+            if (ok && kind == "accuracy" && fields >> b) {
+                accuracy[engine] = {std::stod(a), b == "-" ? -1 : std::stoll(b)};
+            } else if (ok && kind == "throughput") {
+                throughput[engine] = std::stod(a);
+            } else {
+                throw std::runtime_error(path + ":" + std::to_string(number) + ": expected 'accuracy ENGINE ABS ULP'"
+                                         " or 'throughput ENGINE MRECORDS'");
+            }
+        }
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Runner
+
+struct Options {
+    std::uint64_t records = 4000000;
+    std::uint64_t seed = 30;
+    unsigned threads = 0;
+    std::size_t chunk = 65536;
+    double perfTime = 0.05; // Seconds per throughput measurement; 0 skips them
+    double maxSlowdown = 0.25;
+    std::string filter;
+    std::vector<std::string> baselines = {"engine_baseline.txt"}; // Replaced by --baseline
+    std::string writeAccuracy, writeThroughput;
+};
+
+// Best of three timings of e over one in-range chunk (Mrecords/s)
+double measureThroughput(const EngineCase& e, double seconds) {
+    using Clock = std::chrono::steady_clock;
+    Chunk c;
+    c.resize(1 << 16);
+    c.fill(0x5EED, 0, true);
+    std::vector<double> out(c.n);
+    e.run(c, out.data()); // Warm caches, thread-local state and LUTs
+    double best = 0;
+    for (int round = 0; round < 3; round++) {
+        std::uint64_t done = 0;
+        Clock::time_point start = Clock::now();
+        double elapsed;
+        do {
+            e.run(c, out.data());
+            done += c.n;
+            elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+        } while (elapsed < seconds / 3);
+        best = std::max(best, done / elapsed / 1e6);
+    }
+    return best;
+}
+
+bool parseArguments(int argc, char** argv, Options& o) {
+    bool defaultBaseline = true;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (!value) return false;
+        if (arg == "--records") {
+            o.records = std::strtoull(value, nullptr, 10);
+        } else if (arg == "--seed") {
+            o.seed = std::strtoull(value, nullptr, 10);
+        } else if (arg == "--threads") {
+            o.threads = static_cast<unsigned>(std::strtoul(value, nullptr, 10));
+        } else if (arg == "--filter") {
+            o.filter = value;
+        } else if (arg == "--baseline") {
+            if (defaultBaseline) o.baselines.clear();
+            defaultBaseline = false;
+            if (*value) o.baselines.push_back(value);
+        } else if (arg == "--max-slowdown") {
+            o.maxSlowdown = std::strtod(value, nullptr);
+        } else if (arg == "--perf-time") {
+            o.perfTime = std::strtod(value, nullptr);
+        } else if (arg == "--write-accuracy") {
+            o.writeAccuracy = value;
+        } else if (arg == "--write-throughput") {
+            o.writeThroughput = value;
+        } else {
+            return false;
+        }
+        i++;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    Options o;
+    if (!parseArguments(argc, argv, o)) {
+        std::cerr << "Usage: " << argv[0] << " [--records N] [--seed S] [--threads N] [--filter SUBSTRING]\n"
+                  << "       [--baseline FILE]... [--max-slowdown F] [--perf-time SECONDS]\n"
+                  << "       [--write-accuracy FILE] [--write-throughput FILE]" << std::endl;
+        return 2;
+    }
+
+    std::cout << "=== Engine Differential Tests ===" << std::endl;
+    Baseline baseline;
+    try {
+        for (const std::string& path : o.baselines) baseline.load(path);
+    } catch (const std::exception& error) {
+        std::cerr << "❌ " << error.what() << std::endl;
+        return 2;
+    }
+
+    LutFleet fleet;
+    std::vector<EngineCase> engines;
+    for (EngineCase& e : makeEngines(fleet)) {
+        if (e.name.find(o.filter) != std::string::npos) engines.push_back(std::move(e));
+    }
+
+    // Fuzz: every chunk is generated, evaluated by the oracle and every engine, and compared
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point start = Clock::now();
+    std::vector<Deviation> deviations(engines.size());
+    ReferenceCheck reference;
+    std::mutex mergeMutex;
+    Parallel::ThreadPool pool({o.threads, 1, false});
+    const std::size_t chunks = static_cast<std::size_t>((o.records + o.chunk - 1) / o.chunk);
+    pool.parallelFor(chunks, [&](std::size_t begin, std::size_t end) {
+        Chunk c;
+        std::vector<double> oracle, out, expected, bound;
+        for (std::size_t k = begin; k < end; k++) {
+            std::size_t first = k * o.chunk;
+            c.resize(static_cast<std::size_t>(std::min<std::uint64_t>(o.chunk, o.records - first)));
+            c.fill(o.seed, first, false);
+            oracle.resize(c.n);
+            out.resize(c.n);
+            ReferenceCheck check;
+            computeOracle(c, first, oracle.data(), check);
+
+            std::vector<Deviation> local(engines.size());
+            for (std::size_t e = 0; e < engines.size(); e++) {
+                engines[e].run(c, out.data());
+                if (engines[e].expect) {
+                    expected.resize(c.n);
+                    bound.resize(c.n);
+                    engines[e].expect(c, expected.data(), bound.data());
+                    compare(engines[e], c, out.data(), expected.data(), bound.data(), local[e]);
+                } else {
+                    compare(engines[e], c, out.data(), oracle.data(), nullptr, local[e]);
+                }
+            }
+            std::lock_guard<std::mutex> lock(mergeMutex);
+            reference.merge(check);
+            for (std::size_t e = 0; e < engines.size(); e++) deviations[e].merge(local[e]);
+        }
+    });
+    double fuzzSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+    std::cout << o.records << " records (seed " << o.seed << ") on " << pool.size() << " threads in " << std::fixed
+              << std::setprecision(1) << fuzzSeconds << " s; " << reference.inRange
+              << " within the physical limits" << std::endl;
+
+    int failures = 0;
+    if (reference.rejectionMismatches) {
+        std::cout << "❌ reference accepted " << reference.rejectionMismatches << " of " << reference.rejectionsChecked
+                  << " sampled out-of-range records" << std::endl;
+        failures++;
+    }
+
+    std::cout << std::left << std::setw(20) << "engine" << std::right << std::setw(12) << "max_abs" << std::setw(22)
+              << "max_ulp" << std::setw(10) << "Mrec/s" << "  result" << std::endl;
+    std::ostringstream accuracyOut, throughputOut;
+    for (std::size_t e = 0; e < engines.size(); e++) {
+        const EngineCase& engine = engines[e];
+        const Deviation& d = deviations[e];
+        double mps = o.perfTime > 0 ? measureThroughput(engine, o.perfTime) : 0;
+        std::vector<std::string> problems;
+
+        if (d.nanMismatches) problems.push_back(std::to_string(d.nanMismatches) + " NaN mismatches");
+        if (d.contractViolations) problems.push_back(std::to_string(d.contractViolations) + " contract violations");
+        auto a = baseline.accuracy.find(engine.name);
+        if (a != baseline.accuracy.end()) {
+            if (d.maxAbs > a->second.maxAbs) problems.push_back("max_abs above baseline");
+            if (a->second.maxUlp >= 0 && d.maxUlp > std::uint64_t(a->second.maxUlp)) {
+                problems.push_back("max_ulp above baseline");
+            }
+        }
+        auto t = baseline.throughput.find(engine.name);
+        if (o.perfTime > 0 && t != baseline.throughput.end() && mps < t->second * (1 - o.maxSlowdown)) {
+            std::ostringstream p;
+            p << "throughput " << std::fixed << std::setprecision(1) << mps << " < " << t->second << " Mrec/s baseline";
+            problems.push_back(p.str());
+        }
+
+        std::cout << std::left << std::setw(20) << engine.name << std::right << std::scientific << std::setprecision(2)
+                  << std::setw(12) << d.maxAbs << std::setw(22) << d.maxUlp << std::fixed << std::setprecision(1)
+                  << std::setw(10) << mps << "  ";
+        if (problems.empty()) {
+            std::cout << "[PASS]" << std::endl;
+        } else {
+            failures++;
+            std::cout << "[FAIL]";
+            for (const std::string& p : problems) std::cout << ' ' << p << ';';
+            std::cout << std::endl;
+        }
+        if (!problems.empty() && d.maxAbs > 0) {
+            std::cout << std::setprecision(17) << std::defaultfloat << "    worst: vpd " << d.worst.vpd << " nozzle "
+                      << d.worst.nozzle << " pressure " << d.worst.pressure << " wind " << d.worst.wind << " -> "
+                      << d.worstValue << " vs " << d.worstExpected << std::endl;
+        }
+
+        accuracyOut << "accuracy " << engine.name << ' ' << std::setprecision(17) << std::defaultfloat << d.maxAbs
+                    << ' ' << d.maxUlp << '\n';
+        throughputOut << "throughput " << engine.name << ' ' << std::fixed << std::setprecision(1) << mps << '\n';
+    }
+
+    if (!o.writeAccuracy.empty()) {
+        std::ofstream(o.writeAccuracy) << "# Observed by " << o.records << " records, seed " << o.seed << '\n'
+                                       << accuracyOut.str();
+    }
+    if (!o.writeThroughput.empty() && o.perfTime > 0) {
+        std::ofstream(o.writeThroughput) << "# Single-thread Mrecords/s on in-range records\n" << throughputOut.str();
+    }
+
+    if (failures) {
+        std::cout << "\n❌ " << failures << " engine differential checks failed" << std::endl;
+        return 1;
+    }
+    std::cout << "\n✅ All engine differential checks passed!" << std::endl;
+    return 0;
+}
@@ -3,6 +3,8 @@
 #include <cassert>
 #include <vector>
 #include <iomanip>
+#include <algorithm>
+#include <stdexcept>
 #include "../src/evap_solver_compact.h"
 
 bool approxEqual(double a, double b, double tol = 1.0) {
@@ -221,6 +223,60 @@ void testParameterSensitivity() {
     std::cout << std::endl;
 }
 
+void testFloatPrecision() {
+    std::cout << "=== Float vs Double Precision ===" << std::endl;
+    std::cout << "Maximum deviation of FloatCalculator from Calculator" << std::endl;
+    std::cout << std::endl;
+    
+    // Validation table cases (converted as in testTableDataWithCompactSolver)
+    struct TableCase {
+        double D_mm, h_kPa, es_e_kPa, W_ms;
+    };
+    std::vector<TableCase> tableCases = {
+        {3.18, 207, 2.8, 1.3}, {3.18, 207, 4.5, 4.5}, {4.76, 207, 4.5, 4.5},
+        {4.76, 414, 4.5, 2.2}, {4.76, 414, 2.8, 1.3}, {4.76, 414, 2.8, 4.5},
+        {6.35, 414, 2.8, 4.5}, {6.35, 414, 4.5, 2.7}, {6.35, 414, 4.5, 1.3},
+    };
+    
+    double tableMax = 0.0;
+    for (const auto& test : tableCases) {
+        int nozzle = static_cast<int>(std::round(mmToSixtyFourthsInch(test.D_mm)));
+        double vpd = kPaToPsi(test.es_e_kPa), pressure = kPaToPsi(test.h_kPa), wind = msToMph(test.W_ms);
+        double d = EvapSolver::Calculator::calculate({vpd, nozzle, pressure, wind});
+        float f = EvapSolver::FloatCalculator::calculate(
+            {static_cast<float>(vpd), nozzle, static_cast<float>(pressure), static_cast<float>(wind)});
+        tableMax = std::max(tableMax, std::abs(d - f));
+    }
+    
+    // Whole parameter range
+    double sweepMax = 0.0;
+    for (int nozzle = 8; nozzle <= 64; nozzle++) {
+        for (double vpd = 0.0; vpd <= 1.0; vpd += 0.02) {
+            for (double pressure = 20; pressure <= 80; pressure += 1.0) {
+                for (double wind = 0; wind <= 15; wind += 0.5) {
+                    double d = EvapSolver::Calculator::calculate({vpd, nozzle, pressure, wind});
+                    float f = EvapSolver::FloatCalculator::calculate(
+                        {static_cast<float>(vpd), nozzle, static_cast<float>(pressure), static_cast<float>(wind)});
+                    sweepMax = std::max(sweepMax, std::abs(d - f));
+                }
+            }
+        }
+    }
+    
+    std::cout << std::scientific << std::setprecision(2);
+    std::cout << "  Validation table cases: max deviation " << tableMax << " percentage points" << std::endl;
+    std::cout << "  Full parameter sweep:   max deviation " << sweepMax << " percentage points" << std::endl;
+    std::cout << std::fixed;
+    
+    if (tableMax <= 1e-4 && sweepMax <= 1e-4) {
+        std::cout << "  ✅ Float precision within 1e-4 points" << std::endl;
+    } else {
+        std::cout << "  ❌ Float precision outside 1e-4 points" << std::endl;
+        throw std::runtime_error("float deviation too large");
+    }
+    std::cout << std::endl;
+}
+
 int main() {
     std::cout << "=== Extended Table Validation Test Suite ===" << std::endl;
     std::cout << "Testing compact solver with extended validation scenarios" << std::endl;
@@ -230,6 +286,7 @@ int main() {
         testTableDataWithCompactSolver();
         testExtremeCases();
         testParameterSensitivity();
+        testFloatPrecision();
         
         std::cout << "✅ All extended table validation tests completed!" << std::endl;
         return 0;
@@ -0,0 +1,99 @@
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <vector>
+#include "../src/evap_solver_compact.h"
+#include "../src/evap_solver_simd.h"
+
+// Explicit instantiations: every member of both precisions must compile
+template class EvapSolver::BasicCalculator<float>;
+template class EvapSolver::BasicCalculator<double>;
+
+using namespace EvapSolver;
+
+bool bitEqual(float a, float b) {
+    return std::memcmp(&a, &b, sizeof(float)) == 0;
+}
+
+// The float grid index must reproduce segment() on the float tables
+template <std::size_t N, std::size_t Cells>
+void checkGrid(const char* name, const detail::Scale<N, float>& s, const detail::GridIndex<N, Cells, float>& g) {
+    for (std::size_t k = 0; k + 1 < N; ++k) {
+        // Ticks, their float neighbours and a sweep across each segment
+        float lo = s.x[k], hi = s.x[k + 1];
+        std::vector<float> probes = {lo, std::nextafter(lo, hi), std::nextafter(hi, lo), hi};
+        for (int j = 1; j < 64; ++j) probes.push_back(lo + (hi - lo) * j / 64);
+        for (float v : probes) {
+            if (v <= s.x[0] || v >= s.x[N - 1]) continue;
+            assert(detail::gridSegment(s, g, v) == detail::segment(s, v));
+        }
+    }
+    std::cout << "[PASS] " << name << " float grid matches compare-and-count" << std::endl;
+}
+
+void testGrids() {
+    using Tab = detail::Tables<float>;
+    checkGrid("S3", Tab::S3, Tab::S3_grid);
+    checkGrid("S5", Tab::S5, Tab::S5_grid);
+    checkGrid("S7", Tab::S7, Tab::S7_grid);
+    checkGrid("S9", Tab::S9, Tab::S9_grid);
+    checkGrid("S6_flip", Tab::S6_flip, Tab::S6_flip_grid);
+}
+
+void testDeviationFromDouble() {
+    double maxDiff = 0.0;
+    for (int nozzle = 8; nozzle <= 64; nozzle += 2) {
+        for (double vpd = 0.0; vpd <= 1.0; vpd += 0.05) {
+            for (double pressure = 20; pressure <= 80; pressure += 2.5) {
+                for (double wind = 0; wind <= 15; wind += 0.5) {
+                    double d = Calculator::calculate({vpd, nozzle, pressure, wind});
+                    float f = FloatCalculator::calculate(
+                        {static_cast<float>(vpd), nozzle, static_cast<float>(pressure), static_cast<float>(wind)});
+                    maxDiff = std::fmax(maxDiff, std::abs(d - f));
+                }
+            }
+        }
+    }
+    assert(maxDiff <= 1e-4);
+    std::cout << "[PASS] Float within 1e-4 points of double (max diff " << maxDiff << ")" << std::endl;
+}
+
+void testBatchKernels() {
+    std::vector<float> vpd, pressure, wind;
+    std::vector<int> nozzle;
+    for (int i = 0; i < 1013; i++) {
+        // Includes out-of-range values on every axis
+        vpd.push_back(-0.1f + (i % 121) / 100.0f);
+        nozzle.push_back(4 + (i % 65));
+        pressure.push_back(15.0f + (i % 71) * 0.97f);
+        wind.push_back((i % 171) / 10.0f);
+    }
+    const size_t n = vpd.size();
+    std::vector<float> reference(n);
+    FloatCalculator::calculateBatch(vpd.data(), nozzle.data(), pressure.data(), wind.data(), reference.data(), n);
+    for (size_t i = 0; i < n; i++) {
+        assert(bitEqual(reference[i], FloatCalculator::calculate({vpd[i], nozzle[i], pressure[i], wind[i]})));
+    }
+
+    const Simd::Kernel kernels[] = {Simd::Kernel::Scalar, Simd::Kernel::AVX2, Simd::Kernel::AVX512,
+                                    Simd::Kernel::NEON};
+    for (Simd::Kernel k : kernels) {
+        if (!Simd::isSupported(k)) continue;
+        std::vector<float> out(n);
+        Simd::calculateBatch(k, vpd.data(), nozzle.data(), pressure.data(), wind.data(), out.data(), n);
+        for (size_t i = 0; i < n; i++) assert(bitEqual(out[i], reference[i]));
+        std::cout << "[PASS] " << Simd::kernelName(k) << " float kernel bit-identical" << std::endl;
+    }
+}
+
+int main() {
+    std::cout << "=== Float Precision Tests ===" << std::endl;
+
+    testGrids();
+    testDeviationFromDouble();
+    testBatchKernels();
+
+    std::cout << "\n✅ All float precision tests passed!" << std::endl;
+    return 0;
+}
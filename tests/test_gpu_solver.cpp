@@ -0,0 +1,166 @@
+// Built by run_tests.sh only where nvcc is found; skips itself without a device
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../src/evap_solver_gpu.h"
+
+bool bitEqual(double a, double b) {
+    return std::memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+struct Records {
+    std::vector<double> vpd, pressure, wind, volume;
+    std::vector<int> nozzle;
+    std::vector<std::uint32_t> key;
+
+    Records(size_t n, std::uint32_t groups) {
+        // Slightly wider than the tables, with out-of-range keys
+        std::mt19937 rng(27);
+        std::uniform_real_distribution<double> v(-0.05, 1.05), p(18, 82), w(-0.5, 15.5), q(0.5, 2.0);
+        std::uniform_int_distribution<int> z(6, 66);
+        std::uniform_int_distribution<std::uint32_t> k(0, groups);
+        for (size_t i = 0; i < n; i++) {
+            vpd.push_back(v(rng));
+            nozzle.push_back(z(rng));
+            pressure.push_back(p(rng));
+            wind.push_back(w(rng));
+            volume.push_back(q(rng));
+            key.push_back(k(rng));
+        }
+    }
+    size_t size() const { return vpd.size(); }
+};
+
+// Small chunks so every call streams several chunks through every slot
+EvapSolver::Gpu::Options smallChunks() {
+    EvapSolver::Gpu::Options options;
+    options.chunkRecords = 5500; // Rounded up to 6000
+    options.streams = 3;
+    options.blockSize = 1000;
+    return options;
+}
+
+void testMatchesCpu() {
+    using namespace EvapSolver;
+
+    Records r(40013, 1);
+    for (size_t i = 0; i < r.size(); i += 997) r.vpd[i] = NAN;
+    std::vector<double> out(r.size(), -1.0);
+    Gpu::Engine gpu(NomographTables::defaults(), smallChunks());
+    assert(gpu.options().chunkRecords == 6000);
+    gpu.calculateBatch(r.vpd.data(), r.nozzle.data(), r.pressure.data(), r.wind.data(), out.data(), r.size());
+    for (size_t i = 0; i < r.size(); i++) {
+        assert(bitEqual(out[i], Calculator::calculate({r.vpd[i], r.nozzle[i], r.pressure[i], r.wind[i]})));
+    }
+
+    // Recalibrated tables reach the device too
+    std::ostringstream text;
+    NomographTables::defaults().writeText(text);
+    std::string t = text.str();
+    t.replace(t.find("S3 0.1 0.221"), 12, "S3 0.1 0.231");
+    std::istringstream in(t);
+    NomographTables tables = NomographTables::readText(in);
+    Gpu::Engine recalibrated(tables, smallChunks());
+    recalibrated.calculateBatch(r.vpd.data(), r.nozzle.data(), r.pressure.data(), r.wind.data(), out.data(),
+                                r.size());
+    size_t moved = 0;
+    for (size_t i = 0; i < r.size(); i++) {
+        Input record = {r.vpd[i], r.nozzle[i], r.pressure[i], r.wind[i]};
+        assert(bitEqual(out[i], tables.calculate(record)));
+        moved += !bitEqual(out[i], Calculator::calculate(record));
+    }
+    assert(moved > 0);
+    std::cout << "[PASS] " << r.size() << " records in 6000-record chunks bit-identical to the CPU chain, "
+              << "built-in and recalibrated tables" << std::endl;
+}
+
+void testAggregate() {
+    using namespace EvapSolver;
+
+    const std::uint32_t groups = 37;
+    Records r(25500, groups);
+    Parallel::Aggregator cpu({groups, smallChunks().blockSize});
+    cpu.add(r.vpd.data(), r.nozzle.data(), r.pressure.data(), r.wind.data(), r.volume.data(), r.key.data(),
+            r.size());
+    std::vector<Parallel::GroupTotal> host = cpu.totals();
+
+    // Whole 6-block chunks per pass, and 2-block passes (three per chunk)
+    for (std::size_t passBlocks : {6, 2}) {
+        Gpu::Options options = smallChunks();
+        options.partialBytes = passBlocks * groups * sizeof(Parallel::detail::GroupSums);
+        Gpu::Engine gpu(NomographTables::defaults(), options);
+        std::vector<Parallel::GroupTotal> device = gpu.aggregate(r.vpd.data(), r.nozzle.data(), r.pressure.data(),
+                                                                 r.wind.data(), r.volume.data(), r.key.data(),
+                                                                 r.size(), groups);
+        assert(device.size() == groups);
+        size_t records = 0;
+        for (std::uint32_t k = 0; k < groups; k++) {
+            assert(device[k].records == host[k].records);
+            assert(bitEqual(device[k].volume, host[k].volume));
+            assert(bitEqual(device[k].lost, host[k].lost));
+            records += device[k].records;
+        }
+        assert(records + cpu.skipped() == r.size());
+    }
+    std::cout << "[PASS] On-device grouped totals bit-identical to Parallel::Aggregator (" << groups << " groups, "
+              << cpu.skipped() << " skipped), whole-chunk and split passes" << std::endl;
+}
+
+void testSweep() {
+    using namespace EvapSolver;
+
+    // Three years of synthetic hourly weather, 40 designs
+    std::mt19937 rng(270);
+    std::uniform_real_distribution<double> v(0, 1), w(0, 15);
+    std::vector<double> vpd, wind;
+    for (int h = 0; h < 3 * 8760; h++) {
+        vpd.push_back(v(rng));
+        wind.push_back(w(rng));
+    }
+    std::vector<int> nozzle;
+    std::vector<double> pressure;
+    for (int d = 0; d < 40; d++) {
+        nozzle.push_back(8 + (d * 7) % 57);
+        pressure.push_back(20 + (d * 11) % 61);
+    }
+
+    Gpu::Engine gpu;
+    std::vector<Parallel::GroupTotal> a = gpu.sweep(nozzle.data(), pressure.data(), nozzle.size(), vpd.data(),
+                                                    wind.data(), vpd.size());
+    std::vector<Parallel::GroupTotal> b = gpu.sweep(nozzle.data(), pressure.data(), nozzle.size(), vpd.data(),
+                                                    wind.data(), vpd.size());
+    double worst = 0;
+    for (size_t d = 0; d < nozzle.size(); d++) {
+        Parallel::detail::CompensatedSum lost;
+        for (size_t h = 0; h < vpd.size(); h++) {
+            lost.add(Calculator::calculate({vpd[h], nozzle[d], pressure[d], wind[h]}) / 100.0);
+        }
+        assert(a[d].records == vpd.size() && a[d].volume == vpd.size());
+        assert(bitEqual(a[d].lost, b[d].lost));
+        worst = std::fmax(worst, std::fabs(a[d].lost - lost.value()) / lost.value());
+    }
+    assert(worst < 1e-14);
+    std::cout << "[PASS] " << nozzle.size() << " designs x " << vpd.size() << " hours: repeatable bits, relative "
+              << "difference from the CPU sums " << worst << std::endl;
+}
+
+int main() {
+    std::cout << "=== GPU Backend Tests ===" << std::endl;
+
+    if (!EvapSolver::Gpu::available()) {
+        std::cout << "[SKIP] No CUDA device" << std::endl;
+        return 0;
+    }
+    testMatchesCpu();
+    testAggregate();
+    testSweep();
+
+    std::cout << "\n✅ All GPU backend tests passed!" << std::endl;
+    return 0;
+}
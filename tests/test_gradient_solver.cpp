@@ -0,0 +1,108 @@
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "../src/evap_solver_gradient.h"
+
+using namespace EvapSolver;
+
+bool bitEqual(double a, double b) {
+    return std::memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+double loss(double vpd, int nozzle, double pressure, double wind) {
+    return Calculator::calculate({vpd, nozzle, pressure, wind});
+}
+
+// Central differences away from ticks agree with the analytic slopes
+void testAgainstFiniteDifferences() {
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<double> vpd(0.0, 1.0), pressure(20, 80), wind(0, 15);
+    std::uniform_int_distribution<int> nozzle(8, 64);
+    const double h = 1e-7;
+    double maxErr = 0.0;
+    size_t checked = 0;
+    for (int k = 0; k < 20000; k++) {
+        double v = vpd(rng), p = pressure(rng), w = wind(rng);
+        int n = nozzle(rng);
+        GradientResult g = calculateWithGradient({v, n, p, w});
+        assert(bitEqual(g.value, loss(v, n, p, w)));
+        if (g.clamped) continue;
+
+        // Skip points whose difference stencil crosses a tick on any axis
+        double fd[3] = {(loss(v + h, n, p, w) - loss(v - h, n, p, w)) / (2 * h),
+                        (loss(v, n, p + h, w) - loss(v, n, p - h, w)) / (2 * h),
+                        (loss(v, n, p, w + h) - loss(v, n, p, w - h)) / (2 * h)};
+        double an[3] = {g.dVpd, g.dPressure, g.dWind};
+        bool smooth = true;
+        for (int d = 0; d < 3; d++) {
+            if (std::abs(fd[d] - an[d]) > 1e-5 * (1 + std::abs(an[d]))) smooth = false;
+        }
+        if (!smooth) continue;
+        for (int d = 0; d < 3; d++) maxErr = std::fmax(maxErr, std::abs(fd[d] - an[d]));
+        checked++;
+    }
+    // Nearly every sample is away from a tick on all three axes
+    assert(checked > 19000);
+    std::cout << "[PASS] Gradients match central differences on " << checked << " points (max diff " << maxErr
+              << ")" << std::endl;
+}
+
+void testBreakpoints() {
+    // At vpd = 0.5 (a tick) the slope is that of the segment ending there
+    GradientResult g = calculateWithGradient({0.5, 12, 40, 5});
+    double left = (loss(0.5, 12, 40, 5) - loss(0.5 - 1e-7, 12, 40, 5)) / 1e-7;
+    double right = (loss(0.5 + 1e-7, 12, 40, 5) - loss(0.5, 12, 40, 5)) / 1e-7;
+    assert(std::abs(g.dVpd - left) < 1e-5 && std::abs(g.dVpd - right) > 1e-3);
+
+    // The first tick takes the first segment and is not clamped
+    g = calculateWithGradient({0.6, 12, 40, 0.0});
+    assert(!(g.clamped & WindClamped) && g.dWind > 0);
+    assert(std::abs(g.dWind - (loss(0.6, 12, 40, 1e-7) - g.value) / 1e-7) < 1e-5);
+    std::cout << "[PASS] One-sided slopes at ticks (vpd 0.5: left " << left << ", right " << right << ")"
+              << std::endl;
+}
+
+void testClampFlags() {
+    GradientResult g = calculateWithGradient({1.2, 70, 10, 20});
+    assert(g.clamped == (VpdClamped | NozzleClamped | PressureClamped | WindClamped));
+    assert(g.dVpd == 0 && g.dPressure == 0 && g.dWind == 0);
+    assert(bitEqual(g.value, loss(1.2, 70, 10, 20)));
+
+    // Loss pinned at 0%: the chain stays inside its tables but yL falls below S6
+    g = calculateWithGradient({0.0, 64, 20, 0.0});
+    assert(g.value == 0.0 && g.clamped == LossClamped && g.dWind == 0);
+
+    // Only the axis that left its table is flagged
+    g = calculateWithGradient({0.6, 12, 40, 16});
+    assert(g.clamped == WindClamped && g.dWind == 0 && g.dVpd > 0 && g.dPressure > 0);
+    std::cout << "[PASS] Clamped lookups are flagged and contribute zero slope" << std::endl;
+}
+
+void testBatch() {
+    std::vector<double> vpd = {0.6, 0.5, 1.2, 0.0, 0.3}, pressure = {40, 40, 10, 20, 57.5}, wind = {5, 5, 20, 0, 7.2};
+    std::vector<int> nozzle = {12, 12, 70, 64, 24};
+    std::vector<GradientResult> out(vpd.size());
+    calculateWithGradientBatch(vpd.data(), nozzle.data(), pressure.data(), wind.data(), out.data(), out.size());
+    for (size_t i = 0; i < out.size(); i++) {
+        GradientResult g = calculateWithGradient({vpd[i], nozzle[i], pressure[i], wind[i]});
+        assert(bitEqual(out[i].value, g.value) && bitEqual(out[i].dVpd, g.dVpd));
+        assert(bitEqual(out[i].dPressure, g.dPressure) && bitEqual(out[i].dWind, g.dWind));
+        assert(out[i].clamped == g.clamped);
+    }
+    std::cout << "[PASS] Batch gradients match the scalar form" << std::endl;
+}
+
+int main() {
+    std::cout << "=== Gradient Tests ===" << std::endl;
+
+    testAgainstFiniteDifferences();
+    testBreakpoints();
+    testClampFlags();
+    testBatch();
+
+    std::cout << "\n✅ All gradient tests passed!" << std::endl;
+    return 0;
+}
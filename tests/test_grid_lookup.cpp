@@ -0,0 +1,58 @@
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "../src/evap_solver_compact.h"
+
+// Values where an off-by-one segment would show up: every tick, every grid
+// cell edge, their floating-point neighbours and random points in between
+template <std::size_t N, std::size_t Cells>
+std::vector<double> probeValues(const EvapSolver::detail::Scale<N>& s,
+                                const EvapSolver::detail::GridIndex<N, Cells>& g) {
+    std::vector<double> values;
+    auto addWithNeighbours = [&](double v) {
+        values.push_back(v);
+        values.push_back(std::nextafter(v, -INFINITY));
+        values.push_back(std::nextafter(v, INFINITY));
+    };
+    for (std::size_t k = 0; k < N; ++k) addWithNeighbours(s.x[k]);
+    for (std::size_t c = 0; c <= Cells; ++c) addWithNeighbours(g.x0 + c / g.invH);
+
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<double> dist(s.x[0], s.x[N - 1]);
+    for (int i = 0; i < 20000; i++) values.push_back(dist(rng));
+    return values;
+}
+
+template <std::size_t N, std::size_t Cells>
+void checkScale(const char* name, const EvapSolver::detail::Scale<N>& s,
+                const EvapSolver::detail::GridIndex<N, Cells>& g) {
+    using namespace EvapSolver::detail;
+
+    size_t checked = 0;
+    for (double v : probeValues(s, g)) {
+        // The grid is only consulted strictly inside the table
+        if (!(v > s.x[0] && v < s.x[N - 1])) continue;
+        assert(gridSegment(s, g, v) == segment(s, v));
+        assert(lerp(s, g, v) == lerp(s, v));
+        checked++;
+    }
+    assert(std::isnan(lerp(s, g, NAN)));
+    std::cout << "[PASS] " << name << ": " << Cells << " grid cells, " << checked
+              << " probes match the compare-and-count segment" << std::endl;
+}
+
+int main() {
+    std::cout << "=== Uniform Grid Lookup Tests ===" << std::endl;
+
+    using namespace EvapSolver::detail;
+    checkScale("S3", S3, S3_grid);
+    checkScale("S5", S5, S5_grid);
+    checkScale("S7", S7, S7_grid);
+    checkScale("S9", S9, S9_grid);
+    checkScale("S6_flip", S6_flip, S6_flip_grid);
+
+    std::cout << "\n✅ All grid lookup tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,97 @@
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "../src/evap_solver_incremental.h"
+
+bool bitEqual(double a, double b) {
+    return std::memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+// Hourly series where vpd and wind each hold for a few hours at a time
+void makeSeries(std::vector<double>& vpd, std::vector<double>& wind, size_t hours) {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> vpdDist(-0.05, 1.05), windDist(-0.5, 15.5);
+    std::uniform_int_distribution<int> hold(0, 3);
+    double v = vpdDist(rng), w = windDist(rng);
+    for (size_t h = 0; h < hours; h++) {
+        if (hold(rng) == 0) v = vpdDist(rng);
+        if (hold(rng) != 0) w = windDist(rng);
+        vpd.push_back(v);
+        wind.push_back(w);
+    }
+}
+
+void testMatchesCalculator() {
+    using namespace EvapSolver;
+
+    std::vector<double> vpd, wind;
+    makeSeries(vpd, wind, 5000);
+    size_t count = 0;
+    for (int nozzle = 6; nozzle <= 66; nozzle += 6) {
+        for (double pressure = 18; pressure <= 82; pressure += 8) {
+            IncrementalEvaluator eval(nozzle, pressure);
+            for (size_t h = 0; h < vpd.size(); h++) {
+                assert(bitEqual(eval.push(vpd[h], wind[h]), Calculator::calculate({vpd[h], nozzle, pressure, wind[h]})));
+                count++;
+            }
+        }
+    }
+    std::cout << "[PASS] push() matches calculate() bit for bit on " << count << " records" << std::endl;
+}
+
+void testRecomputesOnlyChangedBranch() {
+    using namespace EvapSolver;
+
+    IncrementalEvaluator eval(12, 40);
+    eval.push(0.6, 5);
+    eval.push(0.6, 6);
+    eval.push(0.6, 6);
+    eval.push(0.7, 6);
+    const IncrementalStats& s = eval.stats();
+    assert(s.pushes == 4 && s.vpdUpdates == 2 && s.windUpdates == 2);
+
+    // reset() forgets the cached record
+    eval.reset();
+    assert(bitEqual(eval.push(0.7, 6), Calculator::calculate({0.7, 12, 40, 6})));
+    assert(s.vpdUpdates == 3 && s.windUpdates == 3);
+
+    // NaN is never cached, and does not leave stale pivots behind
+    assert(std::isnan(eval.push(NAN, 6)));
+    assert(bitEqual(eval.push(0.7, 6), Calculator::calculate({0.7, 12, 40, 6})));
+    std::cout << "[PASS] Only the branch of the changed input is recomputed" << std::endl;
+}
+
+void testBatchContinuesState() {
+    using namespace EvapSolver;
+
+    std::vector<double> vpd, wind;
+    makeSeries(vpd, wind, 1000);
+    SprinklerProfile profile(24, 57.5);
+    IncrementalEvaluator eval(profile);
+    std::vector<double> out(vpd.size()), expected(vpd.size());
+
+    // Two batches back to back behave like one series
+    eval.pushBatch(vpd.data(), wind.data(), out.data(), 400);
+    eval.pushBatch(vpd.data() + 400, wind.data() + 400, out.data() + 400, vpd.size() - 400);
+    profile.evaluateBatch(vpd.data(), wind.data(), expected.data(), vpd.size());
+    for (size_t h = 0; h < out.size(); h++) assert(bitEqual(out[h], expected[h]));
+
+    const IncrementalStats& s = eval.stats();
+    assert(s.pushes == vpd.size() && s.vpdUpdates < vpd.size() / 2);
+    std::cout << "[PASS] pushBatch() over " << s.pushes << " hours: " << s.vpdUpdates << " vpd and "
+              << s.windUpdates << " wind recomputations" << std::endl;
+}
+
+int main() {
+    std::cout << "=== Incremental Evaluator Tests ===" << std::endl;
+
+    testMatchesCalculator();
+    testRecomputesOnlyChangedBranch();
+    testBatchContinuesState();
+
+    std::cout << "\n✅ All incremental evaluator tests passed!" << std::endl;
+    return 0;
+}
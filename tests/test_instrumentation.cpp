@@ -0,0 +1,269 @@
+// Built twice by run_tests.sh: with -DEVAP_SOLVER_INSTRUMENT=1, and without
+// to check that the disabled hooks record nothing
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../src/evap_solver_engines.h"
+#include "../src/evap_solver_simd.h"
+
+using EvapSolver::Instrument::AxisCounts;
+using EvapSolver::Instrument::Snapshot;
+
+bool sameAxes(const Snapshot& a, const Snapshot& b, std::size_t axes = EvapSolver::Instrument::axisCount) {
+    for (std::size_t i = 0; i < axes; i++) {
+        const AxisCounts &x = a.axes[i], &y = b.axes[i];
+        if (x.below != y.below || x.above != y.above || x.nan != y.nan) return false;
+        if (std::memcmp(x.segments, y.segments, sizeof(x.segments)) != 0) return false;
+    }
+    return true;
+}
+
+struct Records {
+    std::vector<double> vpd, pressure, wind;
+    std::vector<int> nozzle;
+
+    explicit Records(size_t n) {
+        // Slightly wider than the tables so the clamped ends are counted
+        std::mt19937 rng(25);
+        std::uniform_real_distribution<double> v(-0.05, 1.05), p(18, 82), w(-0.5, 15.5);
+        std::uniform_int_distribution<int> z(6, 66);
+        for (size_t i = 0; i < n; i++) {
+            vpd.push_back(v(rng));
+            nozzle.push_back(z(rng));
+            pressure.push_back(p(rng));
+            wind.push_back(w(rng));
+        }
+    }
+    size_t size() const { return vpd.size(); }
+};
+
+// Index k with x[k] < v <= x[k+1]
+template <std::size_t N>
+std::size_t expectedSegment(const double (&x)[N], double v) {
+    std::size_t k = 0;
+    while (k + 2 < N && v > x[k + 1]) k++;
+    return k;
+}
+
+#if EVAP_SOLVER_INSTRUMENT
+
+void testSingleRecord() {
+    using namespace EvapSolver;
+    namespace I = Instrument;
+
+    I::reset();
+    double loss = Calculator::calculate({0.55, 12, 42, 5.5});
+    Snapshot s = I::snapshot();
+    for (std::size_t a = 0; a < I::axisCount; a++) assert(s.axes[a].total() == 1 && s.axes[a].clamped() == 0);
+    assert(s.axes[I::Vpd].segments[5] == 1);
+    assert(s.axes[I::Nozzle].segments[1] == 1); // 10 < 12 <= 12
+    assert(s.axes[I::Pressure].segments[4] == 1);
+    assert(s.axes[I::Wind].segments[5] == 1);
+    assert(s.axes[I::Loss].segments[expectedSegment(detail::S6_flip.y, loss)] == 1);
+    assert(s.threads >= 1);
+
+    // Clamps and NaN, per axis; NaN reaches the S6 lookup too
+    I::reset();
+    Calculator::calculate({-0.1, 70, 40, 20});
+    Calculator::calculate({NAN, 12, 10, 5});
+    s = I::snapshot();
+    assert(s.axes[I::Vpd].below == 1 && s.axes[I::Vpd].nan == 1);
+    assert(s.axes[I::Nozzle].above == 1 && s.axes[I::Nozzle].segments[1] == 1);
+    assert(s.axes[I::Pressure].below == 1 && s.axes[I::Pressure].segments[3] == 1);
+    assert(s.axes[I::Wind].above == 1 && s.axes[I::Wind].segments[4] == 1);
+    assert(s.axes[I::Loss].nan == 1 && s.axes[I::Loss].total() == 2);
+    std::cout << "[PASS] One lookup per scale lands in its tick segment, clamp or NaN bin" << std::endl;
+}
+
+void testKernelsAgree() {
+    using namespace EvapSolver;
+    namespace I = Instrument;
+
+    Records r(20011);
+    std::vector<double> expected(r.size()), out(r.size());
+    I::reset();
+    for (size_t i = 0; i < r.size(); i++) {
+        expected[i] = Calculator::calculate({r.vpd[i], r.nozzle[i], r.pressure[i], r.wind[i]});
+    }
+    Snapshot scalar = I::snapshot();
+    assert(scalar.axes[I::Vpd].total() == r.size());
+    assert(scalar.axes[I::Vpd].below > 0 && scalar.axes[I::Wind].above > 0);
+
+    // Vector kernels count the records they evaluate outside the scalar chain
+    for (Simd::Kernel k : {Simd::Kernel::Scalar, Simd::Kernel::AVX2, Simd::Kernel::AVX512, Simd::Kernel::NEON}) {
+        if (!Simd::isSupported(k)) continue;
+        I::reset();
+        Simd::calculateBatch(k, r.vpd.data(), r.nozzle.data(), r.pressure.data(), r.wind.data(), out.data(),
+                             r.size());
+        assert(std::memcmp(out.data(), expected.data(), out.size() * sizeof(double)) == 0);
+        assert(sameAxes(I::snapshot(), scalar));
+    }
+
+    NomographTables tables;
+    I::reset();
+    calculateBatch(Engine::Exact, tables, r.vpd.data(), r.nozzle.data(), r.pressure.data(), r.wind.data(),
+                   out.data(), r.size());
+    assert(sameAxes(I::snapshot(), scalar));
+
+    // The separable engine sees the same inputs; its S6 lookups differ by regrouping only
+    I::reset();
+    calculateBatch(Engine::Separable, r.vpd.data(), r.nozzle.data(), r.pressure.data(), r.wind.data(), out.data(),
+                   r.size());
+    Snapshot separable = I::snapshot();
+    assert(sameAxes(separable, scalar, I::Loss));
+    assert(separable.axes[I::Loss].total() == r.size());
+
+    // Float chain
+    std::vector<float> fv(r.vpd.begin(), r.vpd.end()), fp(r.pressure.begin(), r.pressure.end()),
+        fw(r.wind.begin(), r.wind.end()), fout(r.size());
+    I::reset();
+    FloatCalculator::calculateBatch(fv.data(), r.nozzle.data(), fp.data(), fw.data(), fout.data(), r.size());
+    Snapshot floatScalar = I::snapshot();
+    assert(floatScalar.axes[I::Loss].total() == r.size());
+    for (Simd::Kernel k : {Simd::Kernel::AVX2, Simd::Kernel::AVX512, Simd::Kernel::NEON}) {
+        if (!Simd::isSupported(k)) continue;
+        I::reset();
+        Simd::calculateBatch(k, fv.data(), r.nozzle.data(), fp.data(), fw.data(), fout.data(), r.size());
+        assert(sameAxes(I::snapshot(), floatScalar));
+    }
+    std::cout << "[PASS] Scalar, vector, runtime-table and separable paths produce the same histograms"
+              << std::endl;
+}
+
+void testThreads() {
+    using namespace EvapSolver;
+    namespace I = Instrument;
+
+    I::reset();
+    Records r(5000);
+    const int workers = 4;
+    std::vector<std::thread> threads;
+    for (int w = 0; w < workers; w++) {
+        threads.emplace_back([&r] {
+            std::vector<double> out(r.size());
+            Simd::calculateBatch(r.vpd.data(), r.nozzle.data(), r.pressure.data(), r.wind.data(), out.data(),
+                                 r.size());
+        });
+    }
+    for (std::thread& t : threads) t.join();
+
+    // Exited threads leave their counts behind
+    Snapshot s = I::snapshot();
+    for (std::size_t a = 0; a < I::axisCount; a++) assert(s.axes[a].total() == workers * r.size());
+    assert(s.latency.batches == workers);
+    assert(s.threads >= workers + 1);
+
+    I::reset();
+    assert(I::snapshot().axes[I::Vpd].total() == 0);
+    std::cout << "[PASS] " << workers << " threads, " << workers * r.size()
+              << " records: per-thread counters sum exactly, also after the threads exit" << std::endl;
+}
+
+void testLatency() {
+    using namespace EvapSolver;
+    namespace I = Instrument;
+
+    Records r(4096);
+    std::vector<double> out(r.size());
+    I::reset();
+    I::setSampleInterval(4);
+    for (int b = 0; b < 10; b++) {
+        Simd::calculateBatch(r.vpd.data(), r.nozzle.data(), r.pressure.data(), r.wind.data(), out.data(),
+                             r.size());
+    }
+    Snapshot s = I::snapshot();
+    assert(s.latency.batches == 10 && s.latency.sampled == 3 && s.latency.records == 3 * r.size());
+    std::uint64_t bucketed = 0;
+    for (std::uint64_t b : s.latency.buckets) bucketed += b;
+    assert(bucketed == 3);
+    assert(s.latency.maxNanoseconds * 3 >= s.latency.nanoseconds && s.latency.nanoseconds > 0);
+    assert(s.latency.quantileNanoseconds(1.0) >= s.latency.maxNanoseconds);
+
+    // Nested entry points count once: engine -> SIMD dispatch, float SIMD -> FloatCalculator
+    I::reset();
+    I::setSampleInterval(1);
+    calculateBatch(Engine::Exact, r.vpd.data(), r.nozzle.data(), r.pressure.data(), r.wind.data(), out.data(),
+                   r.size());
+    std::vector<float> fv(r.vpd.begin(), r.vpd.end()), fp(r.pressure.begin(), r.pressure.end()),
+        fw(r.wind.begin(), r.wind.end()), fout(r.size());
+    Simd::calculateBatch(Simd::Kernel::Scalar, fv.data(), r.nozzle.data(), fp.data(), fw.data(), fout.data(),
+                         r.size());
+    s = I::snapshot();
+    assert(s.latency.batches == 2 && s.latency.sampled == 2);
+
+    I::reset();
+    I::setSampleInterval(0);
+    Simd::calculateBatch(r.vpd.data(), r.nozzle.data(), r.pressure.data(), r.wind.data(), out.data(), r.size());
+    assert(I::snapshot().latency.batches == 1 && I::snapshot().latency.sampled == 0);
+    I::setSampleInterval(16);
+    std::cout << "[PASS] Every 4th batch timed (" << s.latency.nsPerRecord() << " ns/record instrumented)"
+              << std::endl;
+}
+
+void testExport() {
+    using namespace EvapSolver;
+    namespace I = Instrument;
+
+    I::reset();
+    Calculator::calculate({0.55, 12, 42, 5.5});
+    std::ostringstream out;
+    I::writeJson(out, I::snapshot());
+    std::string json = out.str();
+    assert(json.find("\"enabled\":true") != std::string::npos);
+    assert(json.find("\"vpd\":{\"below\":0,\"above\":0,\"nan\":0,\"segments\":[0,0,0,0,0,1,0,0,0,0]}") !=
+           std::string::npos);
+    assert(json.find("\"wind\":{\"below\":0,\"above\":0,\"nan\":0,\"segments\":[0,0,0,0,0,1,0,0,0,0,0,0,0,0]}") !=
+           std::string::npos);
+    assert(json.front() == '{' && json.back() == '}');
+
+    static_assert(alignof(I::detail::ThreadCounters) == 64, "counter blocks start on a cache line");
+    static_assert(sizeof(I::detail::ThreadCounters) % 64 == 0, "and own every line they touch");
+    std::cout << "[PASS] Snapshot exports as JSON; counter blocks own their cache lines" << std::endl;
+}
+
+#else
+
+void testDisabled() {
+    using namespace EvapSolver;
+    namespace I = Instrument;
+
+    Records r(1000);
+    std::vector<double> out(r.size());
+    Simd::calculateBatch(r.vpd.data(), r.nozzle.data(), r.pressure.data(), r.wind.data(), out.data(), r.size());
+    Calculator::calculate({0.55, 12, 42, 5.5});
+    Snapshot s = I::snapshot();
+    assert(!s.enabled && s.threads == 0 && s.latency.batches == 0);
+    for (std::size_t a = 0; a < I::axisCount; a++) assert(s.axes[a].total() == 0);
+    std::ostringstream json;
+    I::writeJson(json, s);
+    assert(json.str().find("\"enabled\":false") != std::string::npos);
+    static_assert(sizeof(I::BatchTimer) == 1, "disabled timers are empty");
+    std::cout << "[PASS] Disabled build records nothing and keeps the API" << std::endl;
+}
+
+#endif
+
+int main() {
+    std::cout << "=== Instrumentation Tests (" << (EvapSolver::Instrument::enabled ? "enabled" : "disabled")
+              << ") ===" << std::endl;
+
+#if EVAP_SOLVER_INSTRUMENT
+    testSingleRecord();
+    testKernelsAgree();
+    testThreads();
+    testLatency();
+    testExport();
+#else
+    testDisabled();
+#endif
+
+    std::cout << "\n✅ All instrumentation tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,135 @@
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "../src/evap_solver_inverse.h"
+
+using namespace EvapSolver;
+
+bool bitEqual(double a, double b) {
+    return std::memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+// Forward loss with the solved axis set to x
+double loss(bool wind, double vpd, int nozzle, double known, double x) {
+    return wind ? Calculator::calculate({vpd, nozzle, known, x}) : Calculator::calculate({vpd, nozzle, x, known});
+}
+
+// Every result is checked against the forward chain: Exact limits reproduce
+// the target and are exceeded just above; clamped limits bound the whole axis
+void checkInverse(bool wind, double vpd, int nozzle, double known, double target, const InverseResult& r,
+                  size_t counts[3]) {
+    double lower = wind ? 0.0 : 20.0, upper = wind ? 15.0 : 80.0;
+    counts[static_cast<int>(r.status)]++;
+    switch (r.status) {
+        case InverseStatus::Exact:
+            assert(r.value >= lower && r.value <= upper);
+            assert(std::abs(loss(wind, vpd, nozzle, known, r.value) - target) <= 1e-9);
+            if (r.value + 1e-3 <= upper) assert(loss(wind, vpd, nozzle, known, r.value + 1e-3) > target);
+            break;
+        case InverseStatus::BelowRange:
+            assert(r.value == lower && loss(wind, vpd, nozzle, known, lower) > target);
+            break;
+        case InverseStatus::AboveRange:
+            assert(r.value == upper && loss(wind, vpd, nozzle, known, upper) <= target + 1e-12);
+            break;
+    }
+}
+
+void testAgainstForwardChain() {
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<double> vpd(0.0, 1.0), pressure(20, 80), wind(0, 15), target(0.01, 39.99);
+    std::uniform_int_distribution<int> nozzle(8, 64);
+    size_t windCounts[3] = {}, pressureCounts[3] = {};
+    for (int k = 0; k < 20000; k++) {
+        double v = vpd(rng), p = pressure(rng), w = wind(rng), t = target(rng);
+        int n = nozzle(rng);
+        checkInverse(true, v, n, p, t, InverseSolver::maxWind(v, n, p, t), windCounts);
+        checkInverse(false, v, n, w, t, InverseSolver::maxPressure(v, n, w, t), pressureCounts);
+    }
+    for (size_t c : windCounts) assert(c > 0);
+    for (size_t c : pressureCounts) assert(c > 0);
+    std::cout << "[PASS] maxWind (" << windCounts[0] << " exact, " << windCounts[1] << " below, " << windCounts[2]
+              << " above) and maxPressure (" << pressureCounts[0] << " exact, " << pressureCounts[1] << " below, "
+              << pressureCounts[2] << " above) agree with calculate()" << std::endl;
+}
+
+void testAgainstBisection() {
+    // The bisection this replaces: 50 forward evaluations per query
+    double lo = 0.0, hi = 15.0;
+    for (int k = 0; k < 50; k++) {
+        double mid = (lo + hi) / 2;
+        (Calculator::calculate({0.6, 12, 40, mid}) <= 15.0 ? lo : hi) = mid;
+    }
+    InverseResult r = InverseSolver::maxWind(0.6, 12, 40, 15.0);
+    assert(r.status == InverseStatus::Exact && std::abs(r.value - lo) <= 1e-9);
+    std::cout << "[PASS] Max wind for 15% at 0.6 psi, 12/64\", 40 psi: " << r.value << " mph (bisection " << lo
+              << ")" << std::endl;
+}
+
+void testTargetEdges() {
+    const double targets[] = {-1.0, NAN, 0.0, 40.0, 55.0};
+    const InverseStatus expected[] = {InverseStatus::BelowRange, InverseStatus::BelowRange, InverseStatus::BelowRange,
+                                      InverseStatus::AboveRange, InverseStatus::AboveRange};
+    for (int k = 0; k < 5; k++) {
+        InverseResult r = InverseSolver::maxWind(0.6, 12, 40, targets[k]);
+        assert(r.status == expected[k]);
+        assert(r.value == (expected[k] == InverseStatus::BelowRange ? 0.0 : 15.0));
+    }
+
+    // A 0% target is met exactly where the chain reaches the bottom of S6
+    InverseResult r = InverseSolver::maxWind(0.05, 64, 20, 0.0);
+    assert(r.status == InverseStatus::Exact && Calculator::calculate({0.05, 64, 20, r.value}) <= 1e-12);
+    assert(Calculator::calculate({0.05, 64, 20, r.value + 1e-3}) > 0.0);
+    std::cout << "[PASS] Targets outside [0, 40) clamp with status" << std::endl;
+}
+
+void testBatchKernels() {
+    const size_t n = 1003;
+    std::mt19937 rng(9);
+    std::uniform_real_distribution<double> vpd(-0.1, 1.1), axis(-2, 85), target(-2.0, 42.0);
+    std::uniform_int_distribution<int> nozzle(6, 66);
+    std::vector<double> v(n), known(n), t(n), out(n);
+    std::vector<int> nz(n);
+    std::vector<InverseStatus> status(n);
+    for (size_t i = 0; i < n; i++) {
+        v[i] = vpd(rng);
+        known[i] = axis(rng);
+        t[i] = target(rng);
+        nz[i] = nozzle(rng);
+    }
+    t[3] = NAN;
+
+    const Simd::Kernel kernels[] = {Simd::Kernel::Scalar, Simd::Kernel::AVX2, Simd::Kernel::AVX512,
+                                    Simd::Kernel::NEON};
+    for (Simd::Kernel k : kernels) {
+        if (!Simd::isSupported(k)) continue;
+        Simd::maxWindBatch(k, v.data(), nz.data(), known.data(), t.data(), out.data(), status.data(), n);
+        for (size_t i = 0; i < n; i++) {
+            InverseResult r = InverseSolver::maxWind(v[i], nz[i], known[i], t[i]);
+            assert(bitEqual(out[i], r.value) && status[i] == r.status);
+        }
+        Simd::maxPressureBatch(k, v.data(), nz.data(), known.data(), t.data(), out.data(), status.data(), n);
+        for (size_t i = 0; i < n; i++) {
+            InverseResult r = InverseSolver::maxPressure(v[i], nz[i], known[i], t[i]);
+            assert(bitEqual(out[i], r.value) && status[i] == r.status);
+        }
+        std::cout << "[PASS] " << Simd::kernelName(k) << " inverse batches match the scalar queries" << std::endl;
+    }
+    InverseSolver::maxWindBatch(v.data(), nz.data(), known.data(), t.data(), out.data(), status.data(), n);
+    assert(bitEqual(out[0], InverseSolver::maxWind(v[0], nz[0], known[0], t[0]).value));
+}
+
+int main() {
+    std::cout << "=== Inverse Solver Tests ===" << std::endl;
+
+    testAgainstForwardChain();
+    testAgainstBisection();
+    testTargetEdges();
+    testBatchKernels();
+
+    std::cout << "\n✅ All inverse solver tests passed!" << std::endl;
+    return 0;
+}
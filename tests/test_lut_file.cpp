@@ -0,0 +1,266 @@
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include "../src/evap_solver_lut_file.h"
+
+bool bitEqual(double a, double b) {
+    return std::memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+std::string tempPath(const std::string& name) {
+    return "/tmp/evap_lut_file_test_" + std::to_string(getpid()) + "_" + name;
+}
+
+std::string readFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+void writeFile(const std::string& path, const std::string& bytes) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+const std::vector<EvapSolver::LutProfileKey> fleet = {{8, 20}, {12, 40}, {16, 52.5}, {32, 60}, {64, 80}};
+
+// Off-grid and on-grid records, slightly wider than the domain
+void records(std::vector<double>& vpd, std::vector<double>& wind) {
+    std::mt19937 rng(24);
+    std::uniform_real_distribution<double> v(-0.05, 1.05), w(-0.5, 15.5);
+    for (int i = 0; i < 2000; i++) {
+        vpd.push_back(v(rng));
+        wind.push_back(w(rng));
+    }
+    for (int i = 0; i <= 100; i++) {
+        vpd.push_back(i * 0.01);
+        wind.push_back(i * 0.15);
+    }
+}
+
+void testMatchesProfileLut() {
+    using namespace EvapSolver;
+
+    NomographTables tables = NomographTables::defaults();
+    std::vector<double> vpd, wind;
+    records(vpd, wind);
+    LutOptions nearest;
+    nearest.vpdStep = 0.01;
+    LutOptions bilinear;
+    bilinear.vpdStep = 0.05;
+    bilinear.windStep = 0.5;
+    bilinear.interpolation = LutInterpolation::Bilinear;
+
+    for (const LutOptions& options : {nearest, bilinear}) {
+        std::string path = tempPath("fleet.lut");
+        writeLutFile(path, tables, fleet, options);
+        LutFile file(path);
+        assert(file.profileCount() == fleet.size());
+        assert(file.tablesChecksum() == tablesChecksum(tables));
+        assert(file.bytes() % 64 == 0);
+
+        for (size_t k = 0; k < fleet.size(); k++) {
+            ProfileLut lut(tables, fleet[k].nozzle, fleet[k].pressure, options);
+            LutView view = file.profile(k);
+            assert(view.nozzle() == fleet[k].nozzle && view.pressure() == fleet[k].pressure);
+            assert(file.vpdPoints() == lut.vpdPoints() && file.windPoints() == lut.windPoints());
+            assert(bitEqual(view.errorBound(), lut.errorBound()));
+            assert(bitEqual(view.errorBound(true), lut.errorBound(true)));
+            std::vector<double> out(vpd.size());
+            view.evaluateBatch(vpd.data(), wind.data(), out.data(), vpd.size());
+            for (size_t i = 0; i < vpd.size(); i++) {
+                assert(bitEqual(out[i], lut.evaluate(vpd[i], wind[i])));
+            }
+        }
+        std::remove(path.c_str());
+    }
+
+    // The built-in ProfileLut uses the same grid and samples
+    std::string path = tempPath("builtin.lut");
+    writeLutFile(path, tables, fleet, nearest);
+    LutFile file(path);
+    ProfileLut builtin(12, 40, nearest);
+    LutView view = file.profile(file.find(12, 40));
+    for (size_t i = 0; i < vpd.size(); i++) {
+        assert(bitEqual(view.evaluate(vpd[i], wind[i]), builtin.evaluate(vpd[i], wind[i])));
+    }
+    std::remove(path.c_str());
+    std::cout << "[PASS] Mapped profiles are bit-identical to ProfileLut, error bounds included (nearest and bilinear)"
+              << std::endl;
+}
+
+void testDirectory() {
+    using namespace EvapSolver;
+
+    std::string path = tempPath("directory.lut");
+    LutOptions options;
+    options.vpdStep = 0.1;
+    options.windStep = 1.0;
+    NomographTables tables = NomographTables::defaults();
+    writeLutFile(path, tables, fleet, options);
+    LutFile file(path);
+    assert(file.find(16, 52.5) == 2);
+    assert(file.find(64, 80) == 4);
+    assert(file.find(16, 52.4) == LutFile::npos);
+    assert(file.find(20, 40) == LutFile::npos);
+
+    // Moving keeps the mapping; views stay valid
+    LutView view = file.profile(1);
+    double before = view.evaluate(0.6, 5);
+    LutFile moved(std::move(file));
+    assert(moved.profileCount() == fleet.size());
+    assert(bitEqual(moved.profile(1).evaluate(0.6, 5), before));
+
+    // A recalibrated set is told apart by its checksum
+    std::ostringstream out;
+    tables.writeText(out);
+    std::string text = out.str();
+    text.replace(text.find("S3 0.1 0.221"), 12, "S3 0.1 0.222");
+    std::istringstream in(text);
+    assert(tablesChecksum(NomographTables::readText(in)) != moved.tablesChecksum());
+
+    // An empty fleet is a valid file
+    writeLutFile(path, tables, {}, options);
+    LutFile empty(path);
+    assert(empty.profileCount() == 0 && empty.find(12, 40) == LutFile::npos);
+    std::remove(path.c_str());
+    std::cout << "[PASS] find() looks profiles up exactly; moved files keep their mapping" << std::endl;
+}
+
+// Expect opening path to throw a message containing what
+void expectOpenError(const std::string& path, const std::string& what, bool verify = true) {
+    try {
+        EvapSolver::LutFile file(path, verify);
+    } catch (const std::runtime_error& e) {
+        if (std::string(e.what()).find(what) == std::string::npos) {
+            std::cerr << "unexpected message: " << e.what() << std::endl;
+            assert(false);
+        }
+        return;
+    }
+    assert(false && "no exception");
+}
+
+void testCorruption() {
+    using namespace EvapSolver;
+
+    std::string path = tempPath("good.lut"), bad = tempPath("bad.lut");
+    LutOptions options;
+    options.vpdStep = 0.05;
+    options.windStep = 0.5;
+    writeLutFile(path, NomographTables::defaults(), fleet, options);
+    std::string bytes = readFile(path);
+
+    // Header fields are little-endian whatever the host: version 1, nearest,
+    // the file size, and the first directory entry's nozzle
+    assert(bytes.compare(8, 8, std::string("\x01\0\0\0\0\0\0\0", 8)) == 0);
+    std::uint64_t size = 0;
+    for (int k = 7; k >= 0; --k) size = (size << 8) | static_cast<unsigned char>(bytes[16 + k]);
+    assert(size == bytes.size());
+    assert(static_cast<unsigned char>(bytes[128]) == fleet[0].nozzle && bytes.compare(129, 3, std::string(3, '\0')) == 0);
+
+    // One flipped bit in a stored table
+    std::string flipped = bytes;
+    flipped[bytes.size() - 100] ^= 0x10;
+    writeFile(bad, flipped);
+    expectOpenError(bad, "LUT file checksum mismatch");
+    LutFile unchecked(bad, false);
+    assert(unchecked.profileCount() == fleet.size());
+
+    // ... and in the directory
+    flipped = bytes;
+    flipped[128 + 32 + 8] ^= 1;
+    writeFile(bad, flipped);
+    expectOpenError(bad, "checksum mismatch");
+
+    writeFile(bad, bytes.substr(0, bytes.size() - 64));
+    expectOpenError(bad, "truncated LUT file", false);
+    writeFile(bad, bytes.substr(0, 100));
+    expectOpenError(bad, "not a LUT file");
+    writeFile(bad, "EVAPLUX" + bytes.substr(7));
+    expectOpenError(bad, "not a LUT file");
+    std::string version = bytes;
+    version[8] = 2;
+    writeFile(bad, version);
+    expectOpenError(bad, "unsupported LUT file version 2");
+    std::string stride = bytes;
+    stride[96] = 0;
+    stride[97] = 1;
+    writeFile(bad, stride);
+    expectOpenError(bad, "inconsistent LUT file layout", false);
+    expectOpenError(tempPath("missing.lut"), "cannot open");
+
+    std::remove(path.c_str());
+    std::remove(bad.c_str());
+    std::cout << "[PASS] Corrupt, truncated and foreign files are rejected" << std::endl;
+}
+
+void testAtomicReplace() {
+    using namespace EvapSolver;
+
+    std::string path = tempPath("replace.lut");
+    LutOptions options;
+    options.vpdStep = 0.05;
+    options.windStep = 0.5;
+    writeLutFile(path, NomographTables::defaults(), fleet, options);
+    LutFile old(path);
+    double before = old.profile(0).evaluate(0.4, 3);
+
+    // Readers of the old file keep their data while it is replaced
+    writeLutFile(path, NomographTables::defaults(), {{40, 70}}, options);
+    LutFile current(path);
+    assert(current.profileCount() == 1 && current.profile(0).nozzle() == 40);
+    assert(old.profileCount() == fleet.size());
+    assert(bitEqual(old.profile(0).evaluate(0.4, 3), before));
+    assert(access((path + ".tmp" + std::to_string(getpid())).c_str(), F_OK) != 0);
+    std::remove(path.c_str());
+    std::cout << "[PASS] Rewriting a file leaves existing mappings intact" << std::endl;
+}
+
+void testStartup() {
+    using namespace EvapSolver;
+    using Clock = std::chrono::steady_clock;
+
+    std::string path = tempPath("startup.lut");
+    NomographTables tables = NomographTables::defaults();
+    std::vector<LutProfileKey> profiles;
+    for (int nozzle = 8; nozzle <= 64; nozzle += 8) profiles.push_back({nozzle, 40});
+    writeLutFile(path, tables, profiles);
+
+    auto start = Clock::now();
+    for (const LutProfileKey& key : profiles) ProfileLut lut(tables, key.nozzle, key.pressure);
+    double build = std::chrono::duration<double>(Clock::now() - start).count();
+    start = Clock::now();
+    LutFile lazy(path, false);
+    double open = std::chrono::duration<double>(Clock::now() - start).count();
+    start = Clock::now();
+    LutFile verified(path);
+    double verify = std::chrono::duration<double>(Clock::now() - start).count();
+    assert(lazy.profileCount() == profiles.size());
+    std::remove(path.c_str());
+    std::cout << "[PASS] " << profiles.size() << " default-grid profiles (" << verified.bytes() / 1024
+              << " KiB): built in " << build * 1e3 << " ms, mapped in " << open * 1e3 << " ms, "
+              << verify * 1e3 << " ms with checksum" << std::endl;
+}
+
+int main() {
+    std::cout << "=== LUT File Tests ===" << std::endl;
+
+    testMatchesProfileLut();
+    testDirectory();
+    testCorruption();
+    testAtomicReplace();
+    testStartup();
+
+    std::cout << "\n✅ All LUT file tests passed!" << std::endl;
+    return 0;
+}
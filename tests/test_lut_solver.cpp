@@ -0,0 +1,90 @@
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "../src/evap_solver_lut.h"
+
+using namespace EvapSolver;
+
+// Largest |lut - calculate()| over the sensor grid (0.001 psi x 0.1 mph)
+double onGridError(const ProfileLut& lut, int nozzle, double pressure) {
+    double maxErr = 0.0;
+    for (int i = 0; i <= 1000; i++) {
+        for (int j = 0; j <= 150; j++) {
+            double vpd = i / 1000.0, wind = j / 10.0;
+            maxErr = std::fmax(maxErr, std::abs(lut.evaluate(vpd, wind) - Calculator::calculate({vpd, nozzle, pressure, wind})));
+        }
+    }
+    return maxErr;
+}
+
+// Largest |lut - calculate()| over random inputs, some outside the domain
+double randomError(const ProfileLut& lut, int nozzle, double pressure) {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> vpd(-0.1, 1.1), wind(-1.0, 16.0);
+    double maxErr = 0.0;
+    for (int k = 0; k < 20000; k++) {
+        double v = vpd(rng), w = wind(rng);
+        maxErr = std::fmax(maxErr, std::abs(lut.evaluate(v, w) - Calculator::calculate({v, nozzle, pressure, w})));
+    }
+    return maxErr;
+}
+
+void testSensorResolution() {
+    const int nozzles[] = {8, 12, 24, 64};
+    const double pressures[] = {20, 40, 57.5, 80};
+    for (int k = 0; k < 4; k++) {
+        ProfileLut lut(nozzles[k], pressures[k]);
+        assert(lut.vpdPoints() == 1001 && lut.windPoints() == 151);
+        double err = onGridError(lut, nozzles[k], pressures[k]);
+        assert(err <= lut.errorBound(true));
+        assert(randomError(lut, nozzles[k], pressures[k]) <= lut.errorBound());
+        std::cout << "[PASS] Nozzle " << nozzles[k] << ", " << pressures[k] << " psi: " << lut.bytes() / 1024
+                  << " KiB, on-grid error " << err << " <= " << lut.errorBound(true) << std::endl;
+    }
+}
+
+void testCoarseBilinear() {
+    LutOptions options;
+    options.vpdStep = 0.05;
+    options.windStep = 0.5;
+    options.interpolation = LutInterpolation::Bilinear;
+    ProfileLut lut(12, 40, options);
+    assert(lut.vpdPoints() == 21 && lut.windPoints() == 31);
+
+    double err = randomError(lut, 12, 40);
+    assert(err <= lut.errorBound());
+
+    // Nearest on the same grid is worse off-grid, but within the same bound
+    options.interpolation = LutInterpolation::Nearest;
+    ProfileLut nearest(12, 40, options);
+    double nearestErr = randomError(nearest, 12, 40);
+    assert(nearestErr <= nearest.errorBound());
+    assert(err < nearestErr);
+    std::cout << "[PASS] Coarse " << lut.bytes() << "-byte grid: bilinear error " << err << ", nearest "
+              << nearestErr << " (bound " << lut.errorBound() << ")" << std::endl;
+}
+
+void testBatchAndClamping() {
+    ProfileLut lut(SprinklerProfile(16, 50));
+    std::vector<double> vpd = {0.0, 0.5, 1.0, -3.0, 7.0, 0.333}, wind = {0.0, 7.5, 15.0, -2.0, 99.0, 4.4};
+    std::vector<double> out(vpd.size());
+    lut.evaluateBatch(vpd.data(), wind.data(), out.data(), out.size());
+    for (size_t i = 0; i < out.size(); i++) assert(out[i] == lut.evaluate(vpd[i], wind[i]));
+    assert(out[3] == lut.evaluate(0.0, 0.0));
+    assert(out[4] == lut.evaluate(1.0, 15.0));
+    assert(lut.evaluate(NAN, NAN) == lut.evaluate(0.0, 0.0));
+    std::cout << "[PASS] Batch lookup and clamping to the domain edges" << std::endl;
+}
+
+int main() {
+    std::cout << "=== Profile LUT Tests ===" << std::endl;
+
+    testSensorResolution();
+    testCoarseBilinear();
+    testBatchAndClamping();
+
+    std::cout << "\n✅ All profile LUT tests passed!" << std::endl;
+    return 0;
+}
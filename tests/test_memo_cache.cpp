@@ -0,0 +1,132 @@
+#include <iostream>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <random>
+#include <thread>
+#include <vector>
+#include "../src/evap_solver_memo.h"
+
+// Count heap allocations so lookups can be checked to stay off the heap
+static std::atomic<size_t> allocationCount{0};
+
+void* operator new(std::size_t size) {
+    ++allocationCount;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+using namespace EvapSolver;
+
+bool bitEqual(double a, double b) {
+    return std::memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+// Optimizer-like workload: a few nozzles, pressure setpoints and forecast bins
+std::vector<Input> makeWorkload(size_t n, unsigned seed) {
+    const int nozzles[] = {8, 12, 16, 24};
+    const double pressures[] = {30, 40, 50};
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> pick(0, 1 << 20);
+    std::vector<Input> records;
+    for (size_t i = 0; i < n; i++) {
+        records.push_back({(pick(rng) % 11) * 0.1, nozzles[pick(rng) % 4], pressures[pick(rng) % 3],
+                           (pick(rng) % 16) * 1.0});
+    }
+    return records;
+}
+
+void testMatchesCalculator() {
+    MemoCache cache({256});
+    std::vector<Input> records = makeWorkload(50000, 1);
+    for (const Input& in : records) assert(bitEqual(cache.calculate(in), Calculator::calculate(in)));
+
+    // 11 * 4 * 3 * 16 = 2112 distinct keys do not fit in 256 entries; evictions stay correct
+    const MemoStats& s = cache.stats();
+    assert(s.hits + s.misses == records.size() && s.hits > 0 && s.misses > 2112);
+    std::cout << "[PASS] Cached results match calculate() bit for bit (" << s.hits << " hits, " << s.misses
+              << " misses, capacity " << cache.capacity() << ")" << std::endl;
+}
+
+void testHitsAndNoAllocation() {
+    MemoCache cache({1 << 14});
+    std::vector<Input> records = makeWorkload(100000, 2);
+    std::vector<double> out(records.size());
+
+    size_t before = allocationCount;
+    for (size_t i = 0; i < records.size(); i++) out[i] = cache.calculate(records[i]);
+    assert(allocationCount == before);
+
+    // 2112 distinct keys in 8192 buckets: nearly every repeat hits
+    MemoStats s = cache.stats();
+    assert(s.hits + s.misses == records.size() && s.misses < records.size() / 20);
+
+    cache.resetStats();
+    cache.clear();
+    cache.calculate(records[0]);
+    cache.calculate(records[0]);
+    assert(cache.stats().misses == 1 && cache.stats().hits == 1);
+    std::cout << "[PASS] " << s.misses << " misses over " << records.size()
+              << " repeated records, no heap allocation after construction" << std::endl;
+}
+
+void testQuantization() {
+    MemoCache cache({1024, 0.01, 1.0, 0.5});
+    double loss = cache.calculate({0.6132, 12, 40.3, 5.1});
+    assert(bitEqual(loss, Calculator::calculate({0.61, 12, 40, 5.0})));
+    assert(bitEqual(cache.calculate({0.6089, 12, 39.7, 4.9}), loss));
+    assert(cache.stats().hits == 1 && cache.stats().misses == 1);
+
+    // The nozzle is never quantized
+    cache.calculate({0.6132, 14, 40.3, 5.1});
+    assert(cache.stats().misses == 2);
+    std::cout << "[PASS] Quantized keys share one entry and return calculate() of the rounded record"
+              << std::endl;
+}
+
+void testThreadLocalCaches() {
+    const unsigned threads = 4;
+    std::vector<std::thread> workers;
+    std::vector<size_t> lookups(threads);
+    std::atomic<bool> ok{true};
+    for (unsigned t = 0; t < threads; t++) {
+        workers.emplace_back([&, t] {
+            std::vector<Input> records = makeWorkload(20000, 10 + t);
+            for (const Input& in : records) {
+                if (!bitEqual(MemoizedCalculator::calculate(in), Calculator::calculate(in))) ok = false;
+            }
+            lookups[t] = MemoizedCalculator::stats().hits + MemoizedCalculator::stats().misses;
+        });
+    }
+    for (std::thread& w : workers) w.join();
+    assert(ok);
+
+    // Every thread counted only its own lookups
+    for (size_t n : lookups) assert(n == 20000);
+    assert(MemoizedCalculator::stats().hits + MemoizedCalculator::stats().misses == 0);
+    assert(bitEqual(calculateEvaporationLossMemoized(0.6, 12, 40, 5), Calculator::calculate({0.6, 12, 40, 5})));
+    std::cout << "[PASS] " << threads << " threads with independent caches" << std::endl;
+}
+
+int main() {
+    std::cout << "=== Memoization Cache Tests ===" << std::endl;
+
+    testMatchesCalculator();
+    testHitsAndNoAllocation();
+    testQuantization();
+    testThreadLocalCaches();
+
+    std::cout << "\n✅ All memoization cache tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,94 @@
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <vector>
+#include "../src/evap_solver_metric.h"
+
+using namespace EvapSolver;
+
+// Conversions used by the Trimmer (1987) validation cases
+double mmToSixtyFourthsInch(double mm) { return mm / 25.4 * 64.0; }
+double kPaToPsi(double kPa) { return kPa * 0.145038; }
+double msToMph(double ms) { return ms * 2.237; }
+
+bool bitEqual(double a, double b) {
+    return std::memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+// Convert first, then interpolate the imperial tables with a fractional nozzle
+double convertedReference(double vpd, double nozzle, double pressure, double wind) {
+    using namespace EvapSolver::detail;
+    return combine(lerp(S3, S3_grid, kPaToPsi(vpd)), lerp(S5, S5_grid, mmToSixtyFourthsInch(nozzle)),
+                   lerp(S7, S7_grid, kPaToPsi(pressure)), lerp(S9, S9_grid, msToMph(wind)));
+}
+
+void testMatchesConversion() {
+    double maxDiff = 0.0;
+    // Sweep slightly beyond the limits so the clamps are covered
+    for (double vpd = -0.5; vpd <= 7.5; vpd += 0.37) {
+        for (double nozzle = 2.5; nozzle <= 26.5; nozzle += 0.53) {
+            for (double pressure = 120; pressure <= 570; pressure += 23.0) {
+                for (double wind = -0.5; wind <= 7.2; wind += 0.41) {
+                    double diff = std::abs(MetricCalculator::calculate({vpd, nozzle, pressure, wind}) -
+                                           convertedReference(vpd, nozzle, pressure, wind));
+                    if (diff > maxDiff) maxDiff = diff;
+                }
+            }
+        }
+    }
+    assert(maxDiff <= 1e-12);
+    std::cout << "[PASS] Metric tables match convert-then-interpolate (max diff " << maxDiff << ")" << std::endl;
+}
+
+void testFractionalNozzle() {
+    // 4.0 mm is 10.08/64": the old path rounded it to 10 before interpolating
+    double metric = MetricCalculator::calculate({4.14, 4.0, 276, 2.2});
+    double rounded = Calculator::calculate({kPaToPsi(4.14), 10, kPaToPsi(276), msToMph(2.2)});
+    assert(std::abs(metric - convertedReference(4.14, 4.0, 276, 2.2)) <= 1e-12);
+    assert(std::abs(metric - rounded) > 1e-4);
+
+    // An exact 64ths-of-an-inch diameter agrees with the integer-nozzle path
+    double exact = MetricCalculator::calculate({4.14, 12 * 25.4 / 64, 276, 2.2});
+    double integer = Calculator::calculate({kPaToPsi(4.14), 12, kPaToPsi(276), msToMph(2.2)});
+    assert(std::abs(exact - integer) <= 1e-12);
+    std::cout << "[PASS] Nozzle diameter interpolated without rounding: " << metric << "% vs "
+              << rounded << "% rounded" << std::endl;
+}
+
+void testBatchKernels() {
+    std::vector<double> vpd, nozzle, pressure, wind;
+    for (int i = 0; i < 1003; i++) {
+        vpd.push_back(-0.3 + (i % 83) * 0.09);
+        nozzle.push_back(2.0 + (i % 97) * 0.25);
+        pressure.push_back(100.0 + (i % 89) * 5.3);
+        wind.push_back(-0.2 + (i % 79) * 0.09);
+    }
+    const size_t n = vpd.size();
+    std::vector<double> batch(n);
+    MetricCalculator::calculateBatch(vpd.data(), nozzle.data(), pressure.data(), wind.data(), batch.data(), n);
+    for (size_t i = 0; i < n; i++) {
+        assert(bitEqual(batch[i], MetricCalculator::calculate({vpd[i], nozzle[i], pressure[i], wind[i]})));
+    }
+
+    const Simd::Kernel kernels[] = {Simd::Kernel::Scalar, Simd::Kernel::AVX2, Simd::Kernel::AVX512,
+                                    Simd::Kernel::NEON};
+    for (Simd::Kernel k : kernels) {
+        if (!Simd::isSupported(k)) continue;
+        std::vector<double> out(n);
+        Simd::calculateMetricBatch(k, vpd.data(), nozzle.data(), pressure.data(), wind.data(), out.data(), n);
+        for (size_t i = 0; i < n; i++) assert(bitEqual(out[i], batch[i]));
+        std::cout << "[PASS] " << Simd::kernelName(k) << " metric kernel bit-identical" << std::endl;
+    }
+}
+
+int main() {
+    std::cout << "=== Metric Input Tests ===" << std::endl;
+
+    testMatchesConversion();
+    testFractionalNozzle();
+    testBatchKernels();
+
+    std::cout << "\n✅ All metric input tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,338 @@
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include "../src/evap_solver_engines.h"
+#include "../src/evap_solver_lut.h"
+
+bool bitEqual(double a, double b) {
+    return std::memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+std::string tempPath(const std::string& name) {
+    return "/tmp/evap_tables_test_" + std::to_string(getpid()) + "_" + name;
+}
+
+struct Records {
+    std::vector<double> vpd, pressure, wind;
+    std::vector<int> nozzle;
+
+    explicit Records(size_t n) {
+        // Slightly wider than the tables so the clamped ends are covered
+        std::mt19937 rng(23);
+        std::uniform_real_distribution<double> v(-0.05, 1.05), p(18, 82), w(-0.5, 15.5);
+        std::uniform_int_distribution<int> z(6, 66);
+        for (size_t i = 0; i < n; i++) {
+            vpd.push_back(v(rng));
+            nozzle.push_back(z(rng));
+            pressure.push_back(p(rng));
+            wind.push_back(w(rng));
+        }
+    }
+    size_t size() const { return vpd.size(); }
+};
+
+// Published ticks with S6 as printed (loss, ordinate)
+struct PrintedScales {
+    EvapSolver::detail::Scale<11> s3 = EvapSolver::detail::S3, s5 = EvapSolver::detail::S5,
+                                  s7 = EvapSolver::detail::S7;
+    EvapSolver::detail::Scale<15> s9 = EvapSolver::detail::S9;
+    EvapSolver::detail::Scale<14> s6 = EvapSolver::detail::flipScale(EvapSolver::detail::S6_flip);
+
+    EvapSolver::NomographTables build() const { return EvapSolver::NomographTables(s3, s5, s7, s9, s6); }
+};
+
+// Recalibrated set: shifted pressure ordinates and a steeper S6 top
+PrintedScales recalibrated() {
+    PrintedScales p;
+    for (int i = 1; i < 11; i++) p.s7.y[i] = p.s7.y[i] * 0.97 + 0.01;
+    p.s6.y[13] = 0.95;
+    p.s9.x[14] = 16;
+    return p;
+}
+
+void testLayout() {
+    using namespace EvapSolver;
+
+    NomographTables tables;
+    const detail::TableBlock& b = tables.tables();
+    auto aligned = [](const void* p) { return reinterpret_cast<std::uintptr_t>(p) % 64 == 0; };
+    assert(aligned(&b) && aligned(b.S3.x) && aligned(b.S5.x) && aligned(b.S7.x) && aligned(b.S9.x));
+    assert(aligned(b.S6_flip.x) && aligned(b.S3w.x) && aligned(b.N5w.y) && aligned(&b.S6_flip_grid));
+
+    // S6 is flipped in the block and restored as printed
+    for (int i = 0; i < 14; i++) {
+        assert(b.S6_flip.x[i] == detail::S6_flip.x[i] && b.S6_flip.y[i] == detail::S6_flip.y[i]);
+    }
+    assert(b.S3_grid.last + 1 == sizeof(detail::S3_grid.seg));
+    assert(b.S6_flip_grid.last + 1 == sizeof(detail::S6_flip_grid.seg));
+    assert(std::memcmp(b.S6_flip_grid.seg, detail::S6_flip_grid.seg, sizeof(detail::S6_flip_grid.seg)) == 0);
+
+    // Copies own their block
+    NomographTables copy = tables;
+    assert(&copy.tables() != &tables.tables() && aligned(&copy.tables()));
+    std::cout << "[PASS] One 64-byte-aligned block; grids match the built-in indices" << std::endl;
+}
+
+void testDefaultsMatchEveryEngine() {
+    using namespace EvapSolver;
+
+    NomographTables tables = NomographTables::defaults();
+    Records r(20011);
+    const size_t n = r.size();
+    std::vector<double> expected(n), out(n);
+    Simd::calculateBatch(Simd::Kernel::Scalar, r.vpd.data(), r.nozzle.data(), r.pressure.data(), r.wind.data(),
+                         expected.data(), n);
+
+    for (size_t i = 0; i < n; i++) {
+        Input in{r.vpd[i], r.nozzle[i], r.pressure[i], r.wind[i]};
+        assert(bitEqual(tables.calculate(in), expected[i]));
+        assert(bitEqual(tables.calculateSeparable(in), SeparableCalculator::calculate(in)));
+    }
+    for (Simd::Kernel k : {Simd::Kernel::Scalar, Simd::Kernel::AVX2, Simd::Kernel::AVX512, Simd::Kernel::NEON}) {
+        if (!Simd::isSupported(k)) continue;
+        Simd::calculateBatch(k, tables, r.vpd.data(), r.nozzle.data(), r.pressure.data(), r.wind.data(),
+                             out.data(), n);
+        for (size_t i = 0; i < n; i++) assert(bitEqual(out[i], expected[i]));
+        std::cout << "[PASS] " << Simd::kernelName(k) << " kernel on default tables bit-identical" << std::endl;
+    }
+
+    std::vector<double> separable(n);
+    calculateBatch(Engine::Separable, r.vpd.data(), r.nozzle.data(), r.pressure.data(), r.wind.data(),
+                   separable.data(), n);
+    calculateBatch(Engine::Separable, tables, r.vpd.data(), r.nozzle.data(), r.pressure.data(), r.wind.data(),
+                   out.data(), n);
+    for (size_t i = 0; i < n; i++) assert(bitEqual(out[i], separable[i]));
+
+    // Profiles and LUTs
+    std::vector<SprinklerProfile> profiles;
+    for (size_t i = 0; i < n; i++) {
+        SprinklerProfile a(tables, r.nozzle[i], r.pressure[i]), b(r.nozzle[i], r.pressure[i]);
+        assert(bitEqual(a.y5, b.y5) && bitEqual(a.y7, b.y7) && bitEqual(a.separableBase, b.separableBase));
+        assert(bitEqual(a.evaluate(tables, r.vpd[i], r.wind[i]), expected[i]));
+        assert(bitEqual(a.evaluateSeparable(tables, r.vpd[i], r.wind[i]),
+                        b.evaluateSeparable(r.vpd[i], r.wind[i])));
+        profiles.push_back(a);
+    }
+    evaluateProfiles(tables, profiles.data(), r.vpd.data(), r.wind.data(), out.data(), n);
+    for (size_t i = 0; i < n; i++) assert(bitEqual(out[i], expected[i]));
+
+    for (LutInterpolation mode : {LutInterpolation::Nearest, LutInterpolation::Bilinear}) {
+        LutOptions options{0.01, 0.5, mode};
+        ProfileLut a(tables, 16, 50, options), b(16, 50, options);
+        assert(a.errorBound() == b.errorBound());
+        for (size_t i = 0; i < 2000; i++) {
+            assert(bitEqual(a.evaluate(r.vpd[i], r.wind[i]), b.evaluate(r.vpd[i], r.wind[i])));
+        }
+    }
+    std::cout << "[PASS] Scalar, separable, engine, profile and LUT paths match their built-in forms" << std::endl;
+}
+
+void testRecalibratedTables() {
+    using namespace EvapSolver;
+
+    PrintedScales p = recalibrated();
+    NomographTables tables = p.build();
+    const detail::TableBlock& b = tables.tables();
+    Records r(5003);
+    const size_t n = r.size();
+
+    // Reference: the plain search lerp on the same scales
+    detail::Scale<14> s6Flip = detail::flipScale(p.s6);
+    size_t differing = 0;
+    std::vector<double> expected(n), out(n);
+    for (size_t i = 0; i < n; i++) {
+        using detail::lerp;
+        double y3 = lerp(p.s3, r.vpd[i]), y5 = lerp(p.s5, r.nozzle[i]);
+        double y7 = lerp(p.s7, r.pressure[i]), y9 = lerp(p.s9, r.wind[i]);
+        double yA = detail::lerp2(detail::x4, detail::x3, y3, detail::x5, y5);
+        double yB = detail::lerp2(detail::x8, detail::x7, y7, detail::x9, y9);
+        expected[i] = lerp(s6Flip, detail::lerp2(detail::x6, detail::x4, yA, detail::x8, yB));
+        Input in{r.vpd[i], r.nozzle[i], r.pressure[i], r.wind[i]};
+        assert(bitEqual(tables.calculate(in), expected[i]));
+        differing += !bitEqual(expected[i], Calculator::calculate(in));
+        assert(std::fabs(tables.calculateSeparable(in) - expected[i]) < 1e-12);
+        assert(std::fabs(tables.calculatePolynomial(in) - expected[i]) < 1e-12);
+    }
+    assert(differing > n / 2);
+    assert(b.S6_flip.x[13] == 0.95 && b.S9.x[14] == 16);
+
+    for (Simd::Kernel k : {Simd::Kernel::Scalar, Simd::Kernel::AVX2, Simd::Kernel::AVX512, Simd::Kernel::NEON}) {
+        if (!Simd::isSupported(k)) continue;
+        Simd::calculateBatch(k, tables, r.vpd.data(), r.nozzle.data(), r.pressure.data(), r.wind.data(),
+                             out.data(), n);
+        for (size_t i = 0; i < n; i++) assert(bitEqual(out[i], expected[i]));
+    }
+    calculateBatch(Engine::Polynomial, tables, r.vpd.data(), r.nozzle.data(), r.pressure.data(), r.wind.data(),
+                   out.data(), n);
+    for (size_t i = 0; i < n; i++) {
+        assert(bitEqual(out[i], tables.calculatePolynomial({r.vpd[i], r.nozzle[i], r.pressure[i], r.wind[i]})));
+    }
+    for (size_t i = 0; i < 500; i++) {
+        SprinklerProfile profile(tables, r.nozzle[i], r.pressure[i]);
+        assert(bitEqual(profile.evaluate(tables, r.vpd[i], r.wind[i]), expected[i]));
+    }
+    ProfileLut lut(tables, 20, 45, {0.001, 0.1, LutInterpolation::Bilinear});
+    double worst = 0;
+    for (size_t i = 0; i < n; i++) {
+        double exact = tables.calculate({r.vpd[i], 20, 45, r.wind[i]});
+        worst = std::fmax(worst, std::fabs(lut.evaluate(r.vpd[i], r.wind[i]) - exact));
+    }
+    assert(worst <= lut.errorBound());
+    std::cout << "[PASS] Recalibrated tables: every engine matches the reference chain (" << differing << "/" << n
+              << " results moved, LUT error " << worst << " <= " << lut.errorBound() << ")" << std::endl;
+}
+
+void testFileRoundTrip() {
+    using namespace EvapSolver;
+
+    NomographTables tables = recalibrated().build();
+    std::string text = tempPath("tables.txt"), binary = tempPath("tables.bin");
+    tables.saveText(text);
+    tables.saveBinary(binary);
+    NomographTables fromText = NomographTables::loadText(text), fromBinary = NomographTables::loadBinary(binary);
+    assert(std::memcmp(&fromText.tables(), &tables.tables(), sizeof(detail::TableBlock)) == 0);
+    assert(std::memcmp(&fromBinary.tables(), &tables.tables(), sizeof(detail::TableBlock)) == 0);
+
+    std::ifstream in(binary, std::ios::binary | std::ios::ate);
+    size_t bytes = static_cast<size_t>(in.tellg());
+    assert(bytes == 8 + 5 * 4 + (11 + 11 + 11 + 15 + 14) * 16);
+    std::remove(text.c_str());
+    std::remove(binary.c_str());
+
+    // Hand-written text: comments, blank lines, padding, shortest decimals
+    std::ostringstream defaults;
+    NomographTables().writeText(defaults);
+    std::string written = defaults.str();
+    assert(written.find("S3 0.1 0.221\n") != std::string::npos);
+    assert(written.find("S6 40 0.917\n") != std::string::npos);
+    std::istringstream padded("# calibration 2024\n\n" + written + "  \t\r\n");
+    NomographTables parsed = NomographTables::readText(padded);
+    assert(std::memcmp(&parsed.tables(), &NomographTables().tables(), sizeof(detail::TableBlock)) == 0);
+    std::cout << "[PASS] Text and binary files restore the block byte for byte (" << bytes << "-byte binary)"
+              << std::endl;
+}
+
+// Expect construction from in to throw a message containing what
+void expectTextError(const std::string& text, const std::string& what) {
+    try {
+        std::istringstream in(text);
+        EvapSolver::NomographTables::readText(in);
+    } catch (const std::runtime_error& e) {
+        if (std::string(e.what()).find(what) == std::string::npos) {
+            std::cerr << "unexpected message: " << e.what() << std::endl;
+            assert(false);
+        }
+        return;
+    }
+    assert(false && "no exception");
+}
+
+void expectScaleError(const PrintedScales& p, const std::string& what) {
+    try {
+        p.build();
+    } catch (const std::runtime_error& e) {
+        if (std::string(e.what()).find(what) == std::string::npos) {
+            std::cerr << "unexpected message: " << e.what() << std::endl;
+            assert(false);
+        }
+        return;
+    }
+    assert(false && "no exception");
+}
+
+void testValidation() {
+    using namespace EvapSolver;
+
+    PrintedScales p;
+    p.s7.x[4] = p.s7.x[3];
+    expectScaleError(p, "S7: x must be strictly increasing (tick 4)");
+
+    p = PrintedScales();
+    p.s3.y[5] = 0.5;
+    expectScaleError(p, "S3: y must be monotone (tick 5)");
+
+    p = PrintedScales();
+    p.s6.y[3] = p.s6.y[2];
+    expectScaleError(p, "S6: y must be strictly monotone (tick 3)");
+
+    p = PrintedScales();
+    p.s9.y[2] = NAN;
+    expectScaleError(p, "S9: tick 2 is not finite");
+
+    p = PrintedScales();
+    p.s5.x[1] = 8.01;
+    expectScaleError(p, "S5: ticks closer than 1/512");
+
+    // A flat stretch is fine outside S6
+    p = PrintedScales();
+    p.s9.y[3] = p.s9.y[2];
+    p.build();
+
+    std::ostringstream good;
+    NomographTables().writeText(good);
+    std::string text = good.str();
+    expectTextError(text + "S4 1 2\n", "unknown scale 'S4'");
+    expectTextError(text + "S3 1\n", "expected '<scale> <x> <y>'");
+    expectTextError("S3 0 0 junk\n", "trailing characters");
+    expectTextError(text + "S3 1.1 1\n", "S3 has more than 11 ticks");
+    expectTextError(text.substr(0, text.rfind("S6")), "S6: expected 14 ticks, got 13");
+
+    std::ostringstream bin;
+    NomographTables().writeBinary(bin);
+    std::string bytes = bin.str();
+    // Little-endian on every host: version 1, 11 S3 ticks, then S3's first x
+    assert(bytes.compare(4, 8, std::string("\x01\0\0\0\x0b\0\0\0", 8)) == 0);
+    std::uint64_t bits = 0;
+    for (int k = 7; k >= 0; --k) bits = (bits << 8) | static_cast<unsigned char>(bytes[12 + k]);
+    double x0;
+    std::memcpy(&x0, &bits, 8);
+    assert(x0 == detail::S3.x[0]);
+    auto binaryError = [](const std::string& data, const std::string& what) {
+        try {
+            std::istringstream in(data);
+            NomographTables::readBinary(in);
+        } catch (const std::runtime_error& e) {
+            assert(std::string(e.what()).find(what) != std::string::npos);
+            return;
+        }
+        assert(false && "no exception");
+    };
+    binaryError("EVTX" + bytes.substr(4), "not a nomograph table file");
+    binaryError(bytes.substr(0, bytes.size() - 1), "truncated table file");
+    std::string wrongCount = bytes;
+    wrongCount[8] = 10;
+    binaryError(wrongCount, "S3: expected 11 ticks, got 10");
+    std::string wrongVersion = bytes;
+    wrongVersion[4] = 2;
+    binaryError(wrongVersion, "unsupported table file version 2");
+
+    try {
+        NomographTables::loadText(tempPath("missing.txt"));
+        assert(false);
+    } catch (const std::runtime_error& e) {
+        assert(std::string(e.what()).find("cannot open") == 0);
+    }
+    std::cout << "[PASS] Invalid scales and malformed files are rejected with the scale or line named" << std::endl;
+}
+
+int main() {
+    std::cout << "=== Nomograph Tables Tests ===" << std::endl;
+
+    testLayout();
+    testDefaultsMatchEveryEngine();
+    testRecalibratedTables();
+    testFileRoundTrip();
+    testValidation();
+
+    std::cout << "\n✅ All nomograph table tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,142 @@
+#include <iostream>
+#include <atomic>
+#include <cassert>
+#include <cstring>
+#include <random>
+#include <fstream>
+#include <stdexcept>
+#include <system_error>
+#include <vector>
+#include <sys/resource.h>
+#include "../src/evap_solver_parallel.h"
+
+bool bitEqual(double a, double b) {
+    return std::memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+struct BatchData {
+    std::vector<double> vpd, pressure, wind;
+    std::vector<int> nozzle;
+
+    explicit BatchData(size_t n) {
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<double> v(0.0, 1.0), p(20, 80), w(0, 15);
+        std::uniform_int_distribution<int> z(8, 64);
+        for (size_t i = 0; i < n; i++) {
+            vpd.push_back(v(rng));
+            nozzle.push_back(z(rng));
+            pressure.push_back(p(rng));
+            wind.push_back(w(rng));
+        }
+    }
+    size_t size() const { return vpd.size(); }
+};
+
+void testMatchesSerialBatch() {
+    using namespace EvapSolver;
+
+    BatchData data(100003);
+    std::vector<double> expected(data.size());
+    Calculator::calculateBatch(data.vpd.data(), data.nozzle.data(), data.pressure.data(),
+                               data.wind.data(), expected.data(), data.size());
+
+    struct Config { unsigned threads; size_t chunk; bool pin; };
+    const Config configs[] = {{1, 4096, false}, {3, 1, false}, {4, 777, true}, {8, 16384, false}, {0, 100000, false}};
+    for (const Config& c : configs) {
+        Parallel::ThreadPool pool({c.threads, c.chunk, c.pin});
+        std::vector<double> out(data.size(), -1.0);
+        Parallel::calculateBatch(pool, data.vpd.data(), data.nozzle.data(), data.pressure.data(),
+                                 data.wind.data(), out.data(), data.size());
+        for (size_t i = 0; i < data.size(); i++) {
+            assert(bitEqual(out[i], expected[i]));
+        }
+        std::cout << "[PASS] " << pool.size() << " threads, chunk " << pool.chunkSize()
+                  << ": bit-identical to the serial batch" << std::endl;
+    }
+}
+
+void testEveryIndexVisitedOnce() {
+    EvapSolver::Parallel::ThreadPool pool({6, 13, false});
+
+    // Reuse the same pool across many batches of different sizes
+    for (size_t n : {0, 1, 12, 13, 14, 1000, 65537}) {
+        std::vector<std::atomic<int>> visits(n);
+        pool.parallelFor(n, [&](size_t begin, size_t end) {
+            assert(begin < end && end <= visits.size());
+            for (size_t i = begin; i < end; i++) visits[i].fetch_add(1);
+        });
+        for (size_t i = 0; i < n; i++) {
+            assert(visits[i].load() == 1);
+        }
+    }
+    std::cout << "[PASS] Every index is visited exactly once across reused batches" << std::endl;
+}
+
+void testExceptionPropagates() {
+    EvapSolver::Parallel::ThreadPool pool({4, 10, false});
+
+    bool caught = false;
+    try {
+        pool.parallelFor(1000, [](size_t begin, size_t) {
+            if (begin == 500) throw std::runtime_error("chunk failed");
+        });
+    } catch (const std::runtime_error& e) {
+        caught = true;
+        std::cout << "[PASS] Exception from a worker chunk reached the caller: " << e.what() << std::endl;
+    }
+    assert(caught);
+
+    // The pool stays usable after a failed batch
+    std::atomic<size_t> total{0};
+    pool.parallelFor(1000, [&](size_t begin, size_t end) { total += end - begin; });
+    assert(total.load() == 1000);
+}
+
+// Caps the address space a little above its current size, so only a few
+// thread stacks fit; restores the old limit on destruction
+struct AddressSpaceCap {
+    rlimit saved;
+
+    explicit AddressSpaceCap(size_t headroom) {
+        size_t pages = 0;
+        std::ifstream("/proc/self/statm") >> pages;
+        getrlimit(RLIMIT_AS, &saved);
+        rlimit cap = saved;
+        cap.rlim_cur = pages * 4096 + headroom;
+        assert(setrlimit(RLIMIT_AS, &cap) == 0);
+    }
+    ~AddressSpaceCap() { setrlimit(RLIMIT_AS, &saved); }
+};
+
+void testThreadCreationFailure() {
+    bool caught = false;
+    {
+        // Default stacks are 8 MiB: 64 MiB of headroom fails long before 256 threads
+        AddressSpaceCap cap(64 << 20);
+        try {
+            EvapSolver::Parallel::ThreadPool pool({256, 10, false});
+        } catch (const std::system_error&) {
+            caught = true;
+        }
+    }
+    assert(caught);
+
+    EvapSolver::Parallel::ThreadPool pool({4, 10, false});
+    std::atomic<size_t> total{0};
+    pool.parallelFor(1000, [&](size_t begin, size_t end) { total += end - begin; });
+    assert(total.load() == 1000);
+    std::cout << "[PASS] Failed thread creation joins the started workers and throws std::system_error"
+              << std::endl;
+}
+
+int main() {
+    std::cout << "=== Parallel Evaporation Loss Solver Tests ===" << std::endl;
+
+    testMatchesSerialBatch();
+    testEveryIndexVisitedOnce();
+    testExceptionPropagates();
+    testThreadCreationFailure();
+
+    std::cout << "\n✅ All parallel tests passed!" << std::endl;
+    return 0;
+}
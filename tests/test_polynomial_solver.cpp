@@ -0,0 +1,209 @@
+#include <iostream>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "../src/evap_solver_engines.h"
+
+// Documented bound in evap_solver_polynomial.h
+const double kMaxDeviation = 1e-12;
+
+bool bitEqual(double a, double b) {
+    return std::memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+void testDeviationFromReference() {
+    using namespace EvapSolver;
+
+    double maxDeviation = 0.0;
+    size_t count = 0;
+    // Dense sweep across (and slightly beyond) every parameter limit
+    for (double vpd = -0.05; vpd <= 1.05; vpd += 0.02) {
+        for (int nozzle = 6; nozzle <= 66; nozzle++) {
+            for (double pressure = 18; pressure <= 82; pressure += 3.5) {
+                for (double wind = -0.5; wind <= 15.5; wind += 0.5) {
+                    Input in = {vpd, nozzle, pressure, wind};
+                    double deviation = std::abs(PolynomialCalculator::calculate(in) - Calculator::calculate(in));
+                    if (deviation > maxDeviation) maxDeviation = deviation;
+                    count++;
+                }
+            }
+        }
+    }
+
+    // Every tick of every scale, where the pieces meet
+    using detail::S3;
+    using detail::S5;
+    using detail::S7;
+    using detail::S9;
+    for (double vpd : S3.x) {
+        for (double nozzle : S5.x) {
+            for (double pressure : S7.x) {
+                for (double wind : S9.x) {
+                    Input in = {vpd, static_cast<int>(nozzle), pressure, wind};
+                    double deviation = std::abs(PolynomialCalculator::calculate(in) - Calculator::calculate(in));
+                    if (deviation > maxDeviation) maxDeviation = deviation;
+                    count++;
+                }
+            }
+        }
+    }
+    assert(maxDeviation <= kMaxDeviation);
+    std::cout << "[PASS] Max deviation from calculate() over " << count << " points: " << maxDeviation
+              << " (bound " << kMaxDeviation << ")" << std::endl;
+}
+
+void testKernelsBitIdentical() {
+    using namespace EvapSolver;
+
+    std::mt19937 rng(26);
+    std::uniform_real_distribution<double> v(-0.05, 1.05), p(18, 82), w(-0.5, 15.5);
+    std::uniform_int_distribution<int> z(6, 66);
+    const size_t n = 10007; // Not a multiple of any vector width
+    std::vector<double> vpd(n), pressure(n), wind(n), expected(n), out(n);
+    std::vector<int> nozzle(n);
+    for (size_t i = 0; i < n; i++) {
+        vpd[i] = v(rng);
+        nozzle[i] = z(rng);
+        pressure[i] = p(rng);
+        wind[i] = w(rng);
+        expected[i] = PolynomialCalculator::calculate({vpd[i], nozzle[i], pressure[i], wind[i]});
+    }
+
+    int kernels = 0;
+    for (Simd::Kernel k : {Simd::Kernel::Scalar, Simd::Kernel::AVX2, Simd::Kernel::AVX512, Simd::Kernel::NEON}) {
+        if (!Simd::isSupported(k)) continue;
+        std::fill(out.begin(), out.end(), -1.0);
+        Simd::calculatePolynomialBatch(k, detail::polynomialFit, vpd.data(), nozzle.data(), pressure.data(),
+                                       wind.data(), out.data(), n);
+        assert(std::memcmp(out.data(), expected.data(), n * sizeof(double)) == 0);
+        kernels++;
+    }
+    std::cout << "[PASS] " << kernels << " supported kernels bit-identical to calculate() over " << n << " records"
+              << std::endl;
+}
+
+void testClampsAndNaN() {
+    using namespace EvapSolver;
+
+    // Out-of-range inputs clamp to the table ends, like the exact chain
+    const Input clamped[] = {{-0.3, 4, 10, -2}, {1.4, 80, 95, 22}, {0.5, 12, 15, 16}, {0, 8, 20, 0}, {1, 64, 80, 15}};
+    for (const Input& in : clamped) {
+        assert(std::abs(PolynomialCalculator::calculate(in) - Calculator::calculate(in)) <= kMaxDeviation);
+    }
+
+    // NaN contributes the scale's first tick, on every kernel
+    double vpd[4] = {NAN, 0.6, 0.6, 0.6};
+    int nozzle[4] = {12, 12, 12, 12};
+    double pressure[4] = {40, NAN, 40, 40};
+    double wind[4] = {5, 5, NAN, 5};
+    double first[4] = {detail::S3.x[0], 0.6, 0.6, 0.6};
+    double firstPressure[4] = {40, detail::S7.x[0], 40, 40};
+    double firstWind[4] = {5, 5, detail::S9.x[0], 5};
+    for (int i = 0; i < 3; i++) {
+        double loss = PolynomialCalculator::calculate({vpd[i], nozzle[i], pressure[i], wind[i]});
+        assert(!std::isnan(loss));
+        assert(bitEqual(loss, PolynomialCalculator::calculate({first[i], nozzle[i], firstPressure[i], firstWind[i]})));
+    }
+    for (Simd::Kernel k : {Simd::Kernel::Scalar, Simd::Kernel::AVX2, Simd::Kernel::AVX512, Simd::Kernel::NEON}) {
+        if (!Simd::isSupported(k)) continue;
+        double out[4];
+        Simd::calculatePolynomialBatch(k, detail::polynomialFit, vpd, nozzle, pressure, wind, out, 4);
+        for (int i = 0; i < 4; i++) {
+            assert(bitEqual(out[i], PolynomialCalculator::calculate({vpd[i], nozzle[i], pressure[i], wind[i]})));
+        }
+    }
+    std::cout << "[PASS] Clamped inputs match the exact chain; NaN maps to the first tick on every kernel"
+              << std::endl;
+}
+
+void testReducedFit() {
+    using namespace EvapSolver;
+
+    // Keeping every other tick: exact at the kept ticks of an input scale
+    constexpr std::size_t t3[] = {0, 2, 4, 6, 8, 10};
+    constexpr std::size_t t5[] = {0, 2, 4, 6, 8, 10};
+    constexpr std::size_t t7[] = {0, 2, 4, 6, 8, 10};
+    constexpr std::size_t t9[] = {0, 2, 4, 6, 8, 10, 12, 14};
+    constexpr std::size_t t6[] = {0, 2, 4, 6, 8, 10, 12, 13};
+    constexpr auto fit = detail::makePolynomialFit(detail::Tables<double>{}, t3, t5, t7, t9, t6);
+    static_assert(sizeof(fit.P3w.knot) / sizeof(double) == 5 && sizeof(fit.P6.knot) / sizeof(double) == 7,
+                  "one piece between consecutive kept ticks");
+
+    for (std::size_t k : t3) {
+        double x = detail::S3.x[k];
+        assert(std::abs(detail::hinge(fit.P3w, x) - detail::S3.y[k] * detail::w3) <= 1e-15);
+    }
+    for (std::size_t k : t6) {
+        double x = detail::S6_flip.x[k];
+        assert(std::abs(detail::hinge(fit.P6, x) - detail::S6_flip.y[k]) <= 1e-12);
+    }
+
+    // Fewer pieces, larger but bounded error
+    double maxDeviation = 0.0;
+    for (double vpd = 0; vpd <= 1.0; vpd += 0.05) {
+        for (int nozzle = 8; nozzle <= 64; nozzle += 4) {
+            for (double pressure = 20; pressure <= 80; pressure += 5) {
+                for (double wind = 0; wind <= 15; wind += 1) {
+                    double approx = detail::evaluatePolynomial(fit, vpd, nozzle, pressure, wind);
+                    double exact = Calculator::calculate({vpd, nozzle, pressure, wind});
+                    maxDeviation = std::fmax(maxDeviation, std::abs(approx - exact));
+                }
+            }
+        }
+    }
+    assert(maxDeviation > kMaxDeviation && maxDeviation < 5.0);
+
+    double vpd[2] = {0.3, 0.75}, pressure[2] = {35, 62}, wind[2] = {2.5, 11}, out[2];
+    int nozzle[2] = {10, 40};
+    for (Simd::Kernel k : {Simd::Kernel::Scalar, Simd::Kernel::AVX2, Simd::Kernel::AVX512, Simd::Kernel::NEON}) {
+        if (!Simd::isSupported(k)) continue;
+        Simd::calculatePolynomialBatch(k, fit, vpd, nozzle, pressure, wind, out, 2);
+        for (int i = 0; i < 2; i++) {
+            assert(bitEqual(out[i], detail::evaluatePolynomial(fit, vpd[i], nozzle[i], pressure[i], wind[i])));
+        }
+    }
+    std::cout << "[PASS] Reduced fit (every other tick) is exact at its ticks, max deviation " << maxDeviation
+              << std::endl;
+}
+
+void testEngineSelection() {
+    using namespace EvapSolver;
+
+    Engine e = Engine::Exact;
+    assert(parseEngine("polynomial", e) && e == Engine::Polynomial);
+    assert(std::strcmp(engineName(Engine::Polynomial), "polynomial") == 0);
+
+    double vpd[3] = {0.6, 0.3, 0.9};
+    int nozzle[3] = {12, 64, 8};
+    double pressure[3] = {40, 80, 20};
+    double wind[3] = {5, 0, 15};
+    double out[3], tablesOut[3];
+    NomographTables tables = NomographTables::defaults();
+    calculateBatch(Engine::Polynomial, vpd, nozzle, pressure, wind, out, 3);
+    calculateBatch(Engine::Polynomial, tables, vpd, nozzle, pressure, wind, tablesOut, 3);
+    for (int i = 0; i < 3; i++) {
+        Input in = {vpd[i], nozzle[i], pressure[i], wind[i]};
+        assert(bitEqual(out[i], PolynomialCalculator::calculate(in)));
+        assert(bitEqual(out[i], calculate(Engine::Polynomial, in)));
+        // Runtime tables build the same fit as the compile-time one
+        assert(bitEqual(tablesOut[i], out[i]));
+        assert(bitEqual(calculate(Engine::Polynomial, tables, in), out[i]));
+    }
+    std::cout << "[PASS] Engine::Polynomial selectable by name, built-in and runtime tables agree" << std::endl;
+}
+
+int main() {
+    std::cout << "=== Polynomial Engine Tests ===" << std::endl;
+
+    testDeviationFromReference();
+    testKernelsBitIdentical();
+    testClampsAndNaN();
+    testReducedFit();
+    testEngineSelection();
+
+    std::cout << "\n✅ All polynomial engine tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,89 @@
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <vector>
+#include "../src/evap_solver_profile.h"
+
+bool bitEqual(double a, double b) {
+    return std::memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+void testProfileMatchesCalculator() {
+    using namespace EvapSolver;
+
+    double maxSeparableDeviation = 0.0;
+    size_t count = 0;
+    for (int nozzle = 6; nozzle <= 66; nozzle += 2) {
+        for (double pressure = 18; pressure <= 82; pressure += 3.25) {
+            SprinklerProfile profile(nozzle, pressure);
+            for (double vpd = -0.05; vpd <= 1.05; vpd += 0.05) {
+                for (double wind = -0.5; wind <= 15.5; wind += 0.75) {
+                    double expected = Calculator::calculate({vpd, nozzle, pressure, wind});
+                    assert(bitEqual(profile.evaluate(vpd, wind), expected));
+                    double deviation = std::abs(profile.evaluateSeparable(vpd, wind) - expected);
+                    if (deviation > maxSeparableDeviation) maxSeparableDeviation = deviation;
+                    count++;
+                }
+            }
+        }
+    }
+    assert(maxSeparableDeviation <= 1e-12);
+    std::cout << "[PASS] Profiles match calculate() bit for bit on " << count
+              << " points (separable max deviation " << maxSeparableDeviation << ")" << std::endl;
+}
+
+void testWeatherSeries() {
+    using namespace EvapSolver;
+
+    SprinklerProfile profile(12, 40);
+    std::vector<double> vpd, wind;
+    for (int hour = 0; hour < 24 * 7; hour++) {
+        vpd.push_back(0.5 + 0.4 * std::sin(hour * 0.26));
+        wind.push_back(7.0 + 6.5 * std::cos(hour * 0.11));
+    }
+    std::vector<double> out(vpd.size());
+    profile.evaluateBatch(vpd.data(), wind.data(), out.data(), out.size());
+    for (size_t i = 0; i < out.size(); i++) {
+        assert(bitEqual(out[i], calculateEvaporationLoss(vpd[i], 12, 40, wind[i])));
+    }
+    assert(std::abs(profile.evaluate(0.6, 5) - 8.31433) < 0.001);
+    std::cout << "[PASS] Weekly weather series for one profile: first hour " << out[0] << "%" << std::endl;
+}
+
+void testProfileFleet() {
+    using namespace EvapSolver;
+
+    const int nozzles[] = {8, 12, 16, 24, 32};
+    const double pressures[] = {20, 35, 50, 65, 80};
+    std::vector<SprinklerProfile> fleet;
+    std::vector<int> fleetNozzle;
+    std::vector<double> fleetPressure, vpd, wind;
+    for (int n : nozzles) {
+        for (double p : pressures) {
+            fleet.emplace_back(n, p);
+            fleetNozzle.push_back(n);
+            fleetPressure.push_back(p);
+            vpd.push_back(0.02 * fleet.size());
+            wind.push_back(0.55 * fleet.size());
+        }
+    }
+    std::vector<double> out(fleet.size());
+    evaluateProfiles(fleet.data(), vpd.data(), wind.data(), out.data(), fleet.size());
+    for (size_t i = 0; i < fleet.size(); i++) {
+        assert(bitEqual(out[i], calculateEvaporationLoss(vpd[i], fleetNozzle[i], fleetPressure[i], wind[i])));
+    }
+    static_assert(sizeof(SprinklerProfile) == 24, "profiles are three doubles");
+    std::cout << "[PASS] Fleet of " << fleet.size() << " profiles evaluated in one call" << std::endl;
+}
+
+int main() {
+    std::cout << "=== Sprinkler Profile Tests ===" << std::endl;
+
+    testProfileMatchesCalculator();
+    testWeatherSeries();
+    testProfileFleet();
+
+    std::cout << "\n✅ All sprinkler profile tests passed!" << std::endl;
+    return 0;
+}
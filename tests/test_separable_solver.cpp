@@ -0,0 +1,78 @@
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <vector>
+#include "../src/evap_solver_engines.h"
+
+// Documented bound in evap_solver_separable.h
+const double kMaxDeviation = 1e-12;
+
+void testDeviationFromReference() {
+    using namespace EvapSolver;
+
+    double maxDeviation = 0.0;
+    size_t count = 0;
+    // Dense sweep across (and slightly beyond) every parameter limit
+    for (double vpd = -0.05; vpd <= 1.05; vpd += 0.02) {
+        for (int nozzle = 6; nozzle <= 66; nozzle++) {
+            for (double pressure = 18; pressure <= 82; pressure += 3.5) {
+                for (double wind = -0.5; wind <= 15.5; wind += 0.5) {
+                    Input in = {vpd, nozzle, pressure, wind};
+                    double deviation = std::abs(SeparableCalculator::calculate(in) - Calculator::calculate(in));
+                    if (deviation > maxDeviation) maxDeviation = deviation;
+                    count++;
+                }
+            }
+        }
+    }
+    assert(maxDeviation <= kMaxDeviation);
+    std::cout << "[PASS] Max deviation from calculate() over " << count << " points: "
+              << maxDeviation << " (bound " << kMaxDeviation << ")" << std::endl;
+}
+
+void testWeightsReproduceGeometry() {
+    using namespace EvapSolver::detail;
+
+    // The four weights partition yL and match the copy-paste calculator ratios
+    assert(std::abs(w3 + w5 + w7 + w9 - 1.0) < 1e-15);
+    assert(std::abs(ratioA - 0.237 / 0.439) < 1e-15);
+    assert(std::abs(ratioB - 0.132 / 0.262) < 1e-15);
+    assert(std::abs(ratioL - 0.253 / 0.633) < 1e-15);
+    std::cout << "[PASS] Axis weights: w3=" << w3 << " w5=" << w5 << " w7=" << w7 << " w9=" << w9 << std::endl;
+}
+
+void testEngineSelection() {
+    using namespace EvapSolver;
+
+    double vpd[3] = {0.6, 0.3, 0.9};
+    int nozzle[3] = {12, 64, 8};
+    double pressure[3] = {40, 80, 20};
+    double wind[3] = {5, 0, 15};
+
+    const Engine engines[] = {Engine::Exact, Engine::Separable};
+    for (Engine e : engines) {
+        double out[3];
+        calculateBatch(e, vpd, nozzle, pressure, wind, out, 3);
+        for (int i = 0; i < 3; i++) {
+            Input in = {vpd[i], nozzle[i], pressure[i], wind[i]};
+            assert(out[i] == calculate(e, in));
+            assert(std::abs(out[i] - Calculator::calculate(in)) <= kMaxDeviation);
+        }
+        Engine parsed;
+        assert(parseEngine(engineName(e), parsed) && parsed == e);
+        std::cout << "[PASS] Engine " << engineName(e) << ": " << out[0] << "%" << std::endl;
+    }
+    Engine unused;
+    assert(!parseEngine("unknown", unused));
+}
+
+int main() {
+    std::cout << "=== Separable Engine Tests ===" << std::endl;
+
+    testWeightsReproduceGeometry();
+    testDeviationFromReference();
+    testEngineSelection();
+
+    std::cout << "\n✅ All separable engine tests passed!" << std::endl;
+    return 0;
+}
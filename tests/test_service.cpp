@@ -0,0 +1,215 @@
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "../src/evap_solver_service.h"
+
+using namespace EvapSolver;
+
+bool bitEqual(double a, double b) {
+    return std::memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+// Server with its event loop on a background thread
+struct Running {
+    Service::Server server;
+    std::thread loop;
+
+    explicit Running(const std::string& address, const Service::Options& options = Service::Options())
+        : server(address, options), loop([this] { server.run(); }) {}
+    ~Running() {
+        server.stop();
+        loop.join();
+    }
+};
+
+std::vector<Service::Request> makeRequests(int n, std::uint64_t firstId) {
+    std::vector<Service::Request> requests;
+    for (int i = 0; i < n; i++) {
+        // Include out-of-range values, which clamp as in Calculator::calculate()
+        Input in = {(i % 121) / 100.0 - 0.1, 4 + (i % 65), 15.0 + (i % 71) * 0.97, (i % 171) / 10.0};
+        requests.push_back({firstId + i, in});
+    }
+    return requests;
+}
+
+void checkResponses(const std::vector<Service::Request>& requests, const std::vector<Service::Response>& responses) {
+    assert(responses.size() == requests.size());
+    for (size_t i = 0; i < requests.size(); i++) {
+        const Input& in = requests[i].input;
+        assert(responses[i].id == requests[i].id);
+        assert(bitEqual(responses[i].loss, Calculator::calculate(in)));
+        assert(responses[i].status == checkInputs(in.vpd, in.nozzle, in.pressure, in.wind));
+    }
+}
+
+void testPipelined() {
+    Service::Options options;
+    options.maxBatch = 64;
+    Running r("127.0.0.1:0", options);
+    assert(r.server.port() > 0);
+    assert(r.server.address() == "127.0.0.1:" + std::to_string(r.server.port()));
+
+    Service::Client client(r.server.address());
+    std::vector<Service::Request> requests = makeRequests(20000, 1000);
+    std::vector<Service::Response> responses(requests.size());
+    std::thread sender([&] { client.send(requests.data(), requests.size()); });
+    client.receive(responses.data(), responses.size());
+    sender.join();
+    checkResponses(requests, responses);
+
+    Service::Metrics m = r.server.metrics();
+    assert(m.connections == 1 && m.openConnections == 1);
+    assert(m.requests == requests.size() && m.responses == requests.size());
+    assert(m.fullBatches > 0 && m.batches >= requests.size() / 64);
+    for (size_t b = 7; b < Service::batchBuckets; b++) assert(m.batchSizes[b] == 0); // Never above 64
+    assert(m.latency.count() == requests.size());
+    std::cout << "[PASS] " << requests.size() << " pipelined requests bit-identical to calculate(), in order, in "
+              << m.batches << " batches (" << m.fullBatches << " full)" << std::endl;
+}
+
+void testCoalescing() {
+    Service::Options options;
+    options.maxWait = std::chrono::milliseconds(2);
+    Running r("127.0.0.1:0", options);
+
+    // Clients waiting on one round trip each still share batches
+    const int clients = 8, perClient = 300;
+    std::vector<std::thread> threads;
+    for (int c = 0; c < clients; c++) {
+        threads.emplace_back([&, c] {
+            Service::Client client(r.server.address());
+            std::vector<Service::Request> requests = makeRequests(perClient, std::uint64_t(c) << 32);
+            for (const Service::Request& q : requests) {
+                Service::Response response = client.evaluate(q.input, q.id);
+                assert(response.id == q.id && bitEqual(response.loss, Calculator::calculate(q.input)));
+            }
+        });
+    }
+    for (std::thread& t : threads) t.join();
+
+    Service::Metrics m = r.server.metrics();
+    assert(m.requests == unsigned(clients * perClient) && m.latency.count() == m.requests);
+    assert(m.batches < m.requests && m.fullBatches == 0);
+    assert(m.latency.quantileNanoseconds(0.5) <= m.latency.quantileNanoseconds(0.99));
+    assert(m.latency.quantileNanoseconds(0.99) <= double(m.latency.maxNanoseconds()));
+    std::cout << "[PASS] " << clients << " closed-loop clients coalesced: mean batch " << m.meanBatchSize()
+              << " records" << std::endl;
+}
+
+void testMaxWait() {
+    using Clock = std::chrono::steady_clock;
+    Input in = {0.6, 12, 40, 5};
+
+    // A lone request waits for its batch deadline, unless maxBatch is 1
+    Service::Options waiting;
+    waiting.maxWait = std::chrono::milliseconds(50);
+    Running slow("127.0.0.1:0", waiting);
+    Service::Client a(slow.server.address());
+    Clock::time_point start = Clock::now();
+    assert(std::fabs(a.evaluate(in, 7).loss - 8.314328922193823) < 1e-12);
+    double waited = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    assert(waited >= 45);
+
+    Service::Options immediate = waiting;
+    immediate.maxBatch = 1;
+    Running fast("127.0.0.1:0", immediate);
+    Service::Client b(fast.server.address());
+    start = Clock::now();
+    assert(b.evaluate(in, 8).id == 8);
+    double direct = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    assert(direct < 45 && fast.server.metrics().fullBatches == 1);
+    std::cout << "[PASS] 50 ms maxWait held a lone request " << waited << " ms; maxBatch 1 answered in " << direct
+              << " ms" << std::endl;
+}
+
+void testConnectionLifecycle() {
+    std::string path = "unix:/tmp/evap_service_test_" + std::to_string(getpid()) + ".sock";
+    Service::Options options;
+    options.engine = Engine::Separable;
+    options.maxWait = std::chrono::microseconds(0);
+    Running r(path, options);
+    assert(r.server.address() == path && r.server.port() == 0);
+
+    // Frames split across writes, then a half close: every response still arrives, then EOF
+    Service::Client client(path);
+    std::vector<Service::Request> requests = makeRequests(500, 0);
+    std::vector<char> frames(requests.size() * Service::requestSize);
+    for (size_t i = 0; i < requests.size(); i++) Service::encodeRequest(&frames[i * Service::requestSize], requests[i]);
+    for (size_t at = 0; at < frames.size();) {
+        size_t piece = std::min<size_t>(frames.size() - at, 17 + at % 61);
+        assert(::send(client.fd(), frames.data() + at, piece, 0) == ssize_t(piece));
+        at += piece;
+    }
+    client.shutdownSend();
+    std::vector<Service::Response> responses(requests.size());
+    client.receive(responses.data(), responses.size());
+    for (size_t i = 0; i < requests.size(); i++) {
+        assert(responses[i].id == requests[i].id);
+        assert(std::fabs(responses[i].loss - Calculator::calculate(requests[i].input)) <= 1e-12);
+    }
+    char more;
+    assert(::recv(client.fd(), &more, 1, 0) == 0);
+
+    // A malformed frame closes only its own connection
+    Service::Client bad(path);
+    char frame[Service::requestSize];
+    Service::encodeRequest(frame, requests[1]);
+    frame[39] = 1;
+    assert(::send(bad.fd(), frame, sizeof frame, 0) == ssize_t(sizeof frame));
+    assert(::recv(bad.fd(), &more, 1, 0) == 0);
+    bool refused = false;
+    try {
+        Service::Response ignored;
+        bad.receive(&ignored, 1);
+    } catch (const std::runtime_error&) {
+        refused = true;
+    }
+    assert(refused);
+    Service::Client good(path);
+    assert(good.evaluate(requests[2].input, 42).id == 42);
+
+    Service::Metrics m = r.server.metrics();
+    assert(m.protocolErrors == 1 && m.connections == 3 && m.openConnections == 1);
+    std::ostringstream json;
+    Service::writeJson(json, m);
+    assert(json.str().find("\"protocolErrors\":1") != std::string::npos);
+    assert(json.str().find("\"p99\":") != std::string::npos);
+    std::cout << "[PASS] Unix socket: split frames, half close, and a malformed frame closing one connection"
+              << std::endl;
+}
+
+void testHistogram() {
+    Service::LatencyHistogram h;
+    for (std::uint64_t ns = 1; ns <= 100000; ns++) h.record(ns);
+    assert(h.count() == 100000 && h.maxNanoseconds() == 100000);
+    for (double q : {0.5, 0.9, 0.99, 0.999}) {
+        double exact = q * 100000;
+        double estimate = h.quantileNanoseconds(q);
+        assert(estimate >= exact && estimate <= exact * 1.125 + 1);
+    }
+    assert(h.quantileNanoseconds(1.0) == 100000);
+    std::cout << "[PASS] Latency quantiles within one 12.5% bucket" << std::endl;
+}
+
+int main() {
+    std::cout << "=== Service Tests ===" << std::endl;
+
+    testPipelined();
+    testCoalescing();
+    testMaxWait();
+    testConnectionLifecycle();
+    testHistogram();
+
+    std::cout << "\n✅ All service tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,51 @@
+#include <iostream>
+#include <cmath>
+#include <cstdlib>
+#include <new>
+#include "../src/solver.h"
+
+// Count every global heap allocation made by the process
+static size_t allocationCount = 0;
+
+void* operator new(std::size_t size) {
+    allocationCount++;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+int main() {
+    Inputs testInput;
+    double expected = 8.31433;
+
+    // Suppress the solver's console output while measuring
+    std::streambuf* orig = std::cout.rdbuf();
+    std::cout.rdbuf(nullptr);
+
+    double result = solveEvaporationLoss(testInput);
+    size_t before = allocationCount;
+    for (int i = 0; i < 1000; i++) {
+        result = solveEvaporationLoss(testInput);
+    }
+    size_t allocations = allocationCount - before;
+
+    std::cout.rdbuf(orig);
+
+    if (std::abs(result - expected) >= 0.001) {
+        std::cerr << "[FAIL] Expected " << expected << "% but got " << result << "%\n";
+        return 1;
+    }
+    if (allocations != 0) {
+        std::cerr << "[FAIL] solveEvaporationLoss made " << allocations << " heap allocations in 1000 calls\n";
+        return 1;
+    }
+    std::cout << "[PASS] solveEvaporationLoss made no heap allocations in 1000 calls: " << result << "%\n";
+    return 0;
+}
@@ -0,0 +1,90 @@
+#include <iostream>
+#include <sstream>
+#include <cassert>
+#include "../src/solver.h"
+
+// Run the solver while capturing everything it writes to std::cout
+std::string captureStdout(const Inputs& in, double& result) {
+    std::ostringstream captured;
+    std::streambuf* orig = std::cout.rdbuf(captured.rdbuf());
+    result = solveEvaporationLoss(in);
+    std::cout.rdbuf(orig);
+    return captured.str();
+}
+
+void testDefaultSinkIsSilent() {
+    Inputs in;
+    double result = 0.0;
+    std::string output = captureStdout(in, result);
+
+    assert(output.empty());
+    assert(&getDiagnosticsSink() != nullptr);
+    std::cout << "[PASS] Default sink prints nothing: " << result << "%" << std::endl;
+}
+
+void testConsoleSinkKeepsOriginalOutput() {
+    ConsoleSink console;
+    setDiagnosticsSink(&console);
+
+    Inputs in;
+    double result = 0.0;
+    std::string output = captureStdout(in, result);
+    setDiagnosticsSink(nullptr);
+
+    assert(output == "Evaporation Loss: 8.31433%\n");
+    std::cout << "[PASS] Console sink output: " << output;
+}
+
+void testBufferedSink() {
+    BufferedSink buffered;
+    Inputs in;
+    double result = solveEvaporationLoss(in, buffered);
+    in.vpd = 0.0;
+    solveEvaporationLoss(in, buffered);
+    buffered.onOutOfRange(45.0);
+
+    std::ostringstream expected;
+    expected << "Evaporation Loss: " << result << "%\n"
+             << "Evaporation Loss: " << solveEvaporationLoss(in) << "%\n"
+             << "Warning: Calculated evaporation loss (45%) is outside expected range (0-40%)\n";
+    assert(buffered.str() == expected.str());
+
+    std::ostringstream flushed;
+    buffered.flush(flushed);
+    assert(flushed.str() == expected.str());
+    assert(buffered.str().empty());
+    std::cout << "[PASS] Buffered sink collects and flushes messages" << std::endl;
+}
+
+void testCountingSink() {
+    CountingSink counter;
+    setDiagnosticsSink(&counter);
+
+    Inputs in;
+    for (int i = 0; i < 100; i++) {
+        solveEvaporationLoss(in);
+    }
+    setDiagnosticsSink(nullptr);
+
+    // The reverse S6 lookup clamps to 0-40%, so valid inputs never warn
+    assert(counter.resultCount() == 100);
+    assert(counter.outOfRangeCount() == 0);
+
+    counter.onOutOfRange(-1.0);
+    assert(counter.outOfRangeCount() == 1);
+    counter.reset();
+    assert(counter.resultCount() == 0 && counter.outOfRangeCount() == 0);
+    std::cout << "[PASS] Counting sink counted 100 results" << std::endl;
+}
+
+int main() {
+    std::cout << "=== Solver Diagnostics Sink Tests ===" << std::endl;
+
+    testDefaultSinkIsSilent();
+    testConsoleSinkKeepsOriginalOutput();
+    testBufferedSink();
+    testCountingSink();
+
+    std::cout << "\n✅ All diagnostics tests passed!" << std::endl;
+    return 0;
+}
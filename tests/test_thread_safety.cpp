@@ -0,0 +1,92 @@
+#include <iostream>
+#include <atomic>
+#include <cassert>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include "../src/evap_solver_compact.h"
+#include "../src/evap_solver_validated.h"
+#include "../src/evap_solver_simd.h"
+#include "../examples/evap_calculator.h"
+
+// Calculators are called from many threads at once without any warm-up call,
+// so the very first evaluation in the process races between all workers.
+// Build with -fsanitize=thread to have TSan check the same scenario.
+
+const int kThreads = 8;
+const int kRecords = 2000;
+
+bool bitEqual(double a, double b) {
+    return std::memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+struct Record {
+    double vpd;
+    int nozzle;
+    double pressure;
+    double wind;
+};
+
+std::vector<Record> makeRecords() {
+    std::vector<Record> records;
+    for (int i = 0; i < kRecords; i++) {
+        records.push_back({(i % 101) / 100.0, 8 + (i % 57), 20.0 + (i % 61), (i % 151) / 10.0});
+    }
+    return records;
+}
+
+int main() {
+    std::cout << "=== Multi-Threaded Calculator Tests ===" << std::endl;
+
+    const std::vector<Record> records = makeRecords();
+    std::vector<std::vector<double>> compact(kThreads), validated(kThreads), simd(kThreads);
+    std::atomic<int> ready{0};
+    std::atomic<bool> go{false};
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < kThreads; t++) {
+        workers.emplace_back([&, t] {
+            // Release every thread at the same moment
+            ready.fetch_add(1);
+            while (!go.load()) std::this_thread::yield();
+
+            for (const Record& r : records) {
+                compact[t].push_back(EvapSolver::Calculator::calculate({r.vpd, r.nozzle, r.pressure, r.wind}));
+                validated[t].push_back(EvapSolverValidated::Calculator::calculateUnchecked(
+                    EvapSolverValidated::Input(r.vpd, r.nozzle, r.pressure, r.wind)));
+            }
+
+            std::vector<double> vpd, pressure, wind;
+            std::vector<int> nozzle;
+            for (const Record& r : records) {
+                vpd.push_back(r.vpd);
+                nozzle.push_back(r.nozzle);
+                pressure.push_back(r.pressure);
+                wind.push_back(r.wind);
+            }
+            simd[t].resize(records.size());
+            EvapSolver::Simd::calculateBatch(vpd.data(), nozzle.data(), pressure.data(),
+                                             wind.data(), simd[t].data(), records.size());
+        });
+    }
+
+    while (ready.load() < kThreads) std::this_thread::yield();
+    go.store(true);
+    for (auto& w : workers) w.join();
+
+    // Every thread must see the same results as the single-threaded reference
+    for (int t = 0; t < kThreads; t++) {
+        for (size_t i = 0; i < records.size(); i++) {
+            const Record& r = records[i];
+            double expected = ::calculateEvaporationLoss(r.vpd, r.nozzle, r.pressure, r.wind);
+            assert(bitEqual(compact[t][i], expected));
+            assert(bitEqual(validated[t][i], expected));
+            assert(bitEqual(simd[t][i], expected));
+        }
+    }
+    std::cout << "[PASS] " << kThreads << " threads x " << records.size()
+              << " records match the single-threaded reference" << std::endl;
+
+    std::cout << "\n✅ All thread safety tests passed!" << std::endl;
+    return 0;
+}
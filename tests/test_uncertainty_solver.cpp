@@ -0,0 +1,229 @@
+#include <iostream>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "../src/evap_solver_uncertainty.h"
+
+bool bitEqual(double a, double b) {
+    return std::memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+struct BatchData {
+    std::vector<double> vpd, pressure, wind;
+    std::vector<int> nozzle;
+
+    explicit BatchData(size_t n) {
+        std::mt19937 rng(5);
+        std::uniform_real_distribution<double> v(0.1, 0.9), p(25, 75), w(1, 14);
+        std::uniform_int_distribution<int> z(8, 64);
+        for (size_t i = 0; i < n; i++) {
+            vpd.push_back(v(rng));
+            nozzle.push_back(z(rng));
+            pressure.push_back(p(rng));
+            wind.push_back(w(rng));
+        }
+    }
+    size_t size() const { return vpd.size(); }
+};
+
+void testPolynomialKernels() {
+    using namespace EvapSolver::Uncertainty::detail;
+
+    double worstLog = 0, worstTrig = 0;
+    for (uint64_t k = 0; k < 100000; k++) {
+        double u = (static_cast<double>(mix64(k) >> 32) + 0.5) / 4294967296.0;
+        worstLog = std::max(worstLog, std::fabs(logPositive(u) - std::log(u)));
+        double v = static_cast<double>(mix64(k) & 0xFFFFFFFFu) / 4294967296.0, s, c;
+        sinCos2Pi(v, s, c);
+        worstTrig = std::max(worstTrig, std::fabs(s - std::sin(2 * M_PI * v)));
+        worstTrig = std::max(worstTrig, std::fabs(c - std::cos(2 * M_PI * v)));
+    }
+    assert(worstLog < 1e-13);
+    assert(worstTrig < 1e-14);
+    std::cout << "[PASS] log max error " << worstLog << ", sincos max error " << worstTrig << std::endl;
+}
+
+void testNormalDraws() {
+    using namespace EvapSolver::Uncertainty::detail;
+
+    // Moments of one million draws of each of the three normals
+    const size_t n = 1000000;
+    std::vector<double> z[3] = {std::vector<double>(n), std::vector<double>(n), std::vector<double>(n)};
+    EvapSolver::Simd::normalBatch(EvapSolver::Simd::activeKernel(), recordKey(42, 0), 0, z[0].data(), z[1].data(),
+                                  z[2].data(), n);
+    size_t beyond2 = 0;
+    for (int a = 0; a < 3; a++) {
+        Moments m;
+        m.addBlock(z[a].data(), n);
+        assert(std::fabs(m.mean) < 0.005);
+        assert(std::fabs(m.variance() - 1) < 0.005);
+        for (double x : z[a]) beyond2 += std::fabs(x) > 2;
+    }
+    // P(|z| > 2) = 4.55%
+    assert(std::fabs(beyond2 / (3.0 * n) - 0.0455) < 0.001);
+    std::cout << "[PASS] Draws have mean 0, variance 1 and normal tails" << std::endl;
+}
+
+void testKernelsAgree() {
+    using namespace EvapSolver;
+
+    // Odd offsets and lengths exercise the lane counters and the scalar tails
+    const size_t n = 1029;
+    uint64_t key = Uncertainty::detail::recordKey(7, 99);
+    std::vector<double> e1(n), e2(n), e3(n);
+    Simd::normalBatch(Simd::Kernel::Scalar, key, 13, e1.data(), e2.data(), e3.data(), n);
+    for (Simd::Kernel k : {Simd::Kernel::AVX2, Simd::Kernel::AVX512, Simd::Kernel::NEON}) {
+        if (!Simd::isSupported(k)) continue;
+        std::vector<double> z1(n), z2(n), z3(n);
+        Simd::normalBatch(k, key, 13, z1.data(), z2.data(), z3.data(), n);
+        for (size_t i = 0; i < n; i++) {
+            assert(bitEqual(z1[i], e1[i]) && bitEqual(z2[i], e2[i]) && bitEqual(z3[i], e3[i]));
+        }
+        std::cout << "[PASS] " << Simd::kernelName(k) << " normals bit-identical to scalar" << std::endl;
+    }
+}
+
+void testP2Quantile() {
+    using EvapSolver::Uncertainty::P2Quantile;
+
+    std::mt19937 rng(9);
+    std::uniform_real_distribution<double> u(0, 1);
+    P2Quantile p10(0.1), p50(0.5), p99(0.99);
+    for (int i = 0; i < 100000; i++) {
+        double x = u(rng);
+        p10.add(x);
+        p50.add(x);
+        p99.add(x);
+    }
+    assert(std::fabs(p10.value() - 0.1) < 0.005);
+    assert(std::fabs(p50.value() - 0.5) < 0.005);
+    assert(std::fabs(p99.value() - 0.99) < 0.005);
+
+    // Exact below five observations
+    P2Quantile small(0.5);
+    assert(std::isnan(small.value()));
+    small.add(3);
+    small.add(1);
+    small.add(2);
+    assert(small.value() == 2);
+    std::cout << "[PASS] P^2 sketch tracks uniform quantiles within 0.005" << std::endl;
+}
+
+void testZeroNoiseIsExact() {
+    using namespace EvapSolver;
+
+    Uncertainty::Options options;
+    options.samples = 300;
+    Input in{0.6, 12, 40, 5};
+    Uncertainty::Result r = Uncertainty::propagate(in, Uncertainty::SensorNoise(), options);
+    double loss = Calculator::calculate(in);
+    assert(std::fabs(r.mean - loss) < 1e-12);
+    assert(r.variance < 1e-24);
+    assert(r.quantiles.size() == 3);
+    for (double q : r.quantiles) assert(bitEqual(q, loss));
+    std::cout << "[PASS] Without noise the mean and every quantile equal calculate()" << std::endl;
+}
+
+void testAgainstStoredSamples() {
+    using namespace EvapSolver;
+
+    // Reference: keep every sample, two-pass variance and sorted quantiles
+    Uncertainty::SensorNoise noise{0.03, 2.0, 0.8};
+    Uncertainty::Options options;
+    options.seed = 17;
+    options.quantiles = {0.05, 0.25, 0.5, 0.75, 0.95};
+    Input in{0.55, 16, 45, 7};
+
+    uint64_t key = Uncertainty::detail::recordKey(options.seed, 0);
+    std::vector<double> samples;
+    for (size_t j = 0; j < options.samples; j++) {
+        double z1, z2, z3;
+        Uncertainty::detail::drawNormals(key, j, z1, z2, z3);
+        samples.push_back(Calculator::calculate(
+            {in.vpd + noise.vpd * z1, in.nozzle, in.pressure + noise.pressure * z2, in.wind + noise.wind * z3}));
+    }
+    double mean = 0, ss = 0;
+    for (double s : samples) mean += s;
+    mean /= samples.size();
+    for (double s : samples) ss += (s - mean) * (s - mean);
+    double variance = ss / (samples.size() - 1);
+    std::sort(samples.begin(), samples.end());
+
+    Uncertainty::Result r = Uncertainty::propagate(in, noise, options);
+    assert(std::fabs(r.mean - mean) < 1e-12);
+    assert(std::fabs(r.variance - variance) < 1e-12);
+    double sigma = std::sqrt(variance);
+    for (size_t k = 0; k < options.quantiles.size(); k++) {
+        double exact = samples[static_cast<size_t>(options.quantiles[k] * (samples.size() - 1) + 0.5)];
+        assert(std::fabs(r.quantiles[k] - exact) < 0.1 * sigma);
+    }
+    std::cout << "[PASS] Mean/variance match stored samples; quantiles within 0.1 sigma (sigma "
+              << sigma << ")" << std::endl;
+}
+
+void testReproducibleBatches() {
+    using namespace EvapSolver;
+
+    BatchData data(1001);
+    Uncertainty::SensorNoise noise{0.02, 1.5, 0.5};
+    Uncertainty::Options options;
+    options.samples = 200;
+    options.seed = 3;
+    const size_t nq = options.quantiles.size(), n = data.size();
+
+    std::vector<double> mean(n), variance(n), quantiles(n * nq);
+    Uncertainty::propagateBatch(data.vpd.data(), data.nozzle.data(), data.pressure.data(), data.wind.data(), noise,
+                                options, mean.data(), variance.data(), quantiles.data(), n);
+
+    for (unsigned threads : {2u, 3u, 8u}) {
+        Parallel::ThreadPool pool({threads, 37, false});
+        std::vector<double> m(n), v(n), q(n * nq);
+        Uncertainty::propagateBatch(pool, data.vpd.data(), data.nozzle.data(), data.pressure.data(),
+                                    data.wind.data(), noise, options, m.data(), v.data(), q.data(), n);
+        for (size_t i = 0; i < n; i++) assert(bitEqual(m[i], mean[i]) && bitEqual(v[i], variance[i]));
+        for (size_t i = 0; i < n * nq; i++) assert(bitEqual(q[i], quantiles[i]));
+    }
+
+    // A slice with firstRecord set reproduces its part of the batch
+    Uncertainty::Options slice = options;
+    slice.firstRecord = 600;
+    std::vector<double> m(n - 600), v(n - 600), q((n - 600) * nq);
+    Uncertainty::propagateBatch(&data.vpd[600], &data.nozzle[600], &data.pressure[600], &data.wind[600], noise,
+                                slice, m.data(), v.data(), q.data(), n - 600);
+    for (size_t i = 0; i < n - 600; i++) assert(bitEqual(m[i], mean[600 + i]));
+    for (size_t i = 0; i < (n - 600) * nq; i++) assert(bitEqual(q[i], quantiles[600 * nq + i]));
+
+    // Single-record form agrees with the batch
+    Uncertainty::Options one = options;
+    one.firstRecord = 5;
+    Uncertainty::Result r = Uncertainty::propagate({data.vpd[5], data.nozzle[5], data.pressure[5], data.wind[5]},
+                                                   noise, one);
+    assert(bitEqual(r.mean, mean[5]) && bitEqual(r.quantiles[1], quantiles[5 * nq + 1]));
+
+    // Another seed gives other draws
+    Uncertainty::Options reseeded = options;
+    reseeded.seed = 4;
+    Uncertainty::Result other = Uncertainty::propagate({data.vpd[0], data.nozzle[0], data.pressure[0], data.wind[0]},
+                                                       noise, reseeded);
+    assert(!bitEqual(other.mean, mean[0]));
+    std::cout << "[PASS] Batches are bit-identical across pools, slices and the single-record form" << std::endl;
+}
+
+int main() {
+    std::cout << "=== Uncertainty Propagation Tests ===" << std::endl;
+
+    testPolynomialKernels();
+    testNormalDraws();
+    testKernelsAgree();
+    testP2Quantile();
+    testZeroNoiseIsExact();
+    testAgainstStoredSamples();
+    testReproducibleBatches();
+
+    std::cout << "\n✅ All uncertainty tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,151 @@
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "../src/evap_solver_validated.h"
+
+// Count heap allocations so the non-throwing paths can be checked to stay off the heap
+static size_t allocationCount = 0;
+
+void* operator new(std::size_t size) {
+    ++allocationCount;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+using namespace EvapSolverValidated;
+
+bool bitEqual(double a, double b) {
+    return std::memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+// Message thrown by validate(), or "" if it does not throw
+std::string thrownMessage(double vpd, int nozzle, double pressure, double wind) {
+    try {
+        Input::unchecked(vpd, nozzle, pressure, wind).validate();
+    } catch (const std::runtime_error& e) {
+        return e.what();
+    }
+    return "";
+}
+
+void testStatusBits() {
+    assert(checkInputs(0.6, 12, 40, 5) == StatusOk);
+    assert(checkInputs(0.0, 8, 20, 0) == StatusOk);
+    assert(checkInputs(1.0, 64, 80, 15) == StatusOk);
+    assert(checkInputs(-0.1, 12, 40, 5) == VpdOutOfRange);
+    assert(checkInputs(0.6, 65, 40, 5) == NozzleOutOfRange);
+    assert(checkInputs(0.6, 12, 19.9, 5) == PressureOutOfRange);
+    assert(checkInputs(0.6, 12, 40, 15.1) == WindOutOfRange);
+    assert(checkInputs(2.0, 4, 100, -1) == (VpdOutOfRange | NozzleOutOfRange | PressureOutOfRange | WindOutOfRange));
+    assert(Input::unchecked(0.6, 12, 10, 20).check() == (PressureOutOfRange | WindOutOfRange));
+    std::cout << "[PASS] One status bit per violated parameter" << std::endl;
+
+    // NaN is not rejected by validate(), so it is not flagged either
+    double nan = std::numeric_limits<double>::quiet_NaN();
+    assert(checkInputs(nan, 12, nan, nan) == StatusOk);
+    assert(thrownMessage(nan, 12, nan, nan).empty());
+    std::cout << "[PASS] NaN semantics match validate()" << std::endl;
+}
+
+void testMessages() {
+    // validate() still throws the same message for the first violated parameter
+    assert(thrownMessage(1.5, 12, 40, 5) == "Vapor-Pressure Deficit must be between 0.0 and 1.0 psi (got 1.500000)");
+    assert(thrownMessage(0.6, 5, 40, 5) == "Nozzle diameter must be between 8 and 64 (64ths of an inch) (got 5)");
+    assert(thrownMessage(0.6, 12, 100, 5) == "Nozzle pressure must be between 20 and 80 psi (got 100.000000)");
+    assert(thrownMessage(0.6, 12, 40, -1) == "Wind velocity must be between 0 and 15 mph (got -1.000000)");
+    assert(thrownMessage(1.5, 5, 100, -1) == thrownMessage(1.5, 12, 40, 5));
+    std::cout << "[PASS] validate() messages unchanged" << std::endl;
+
+    // On request, every violation is described
+    Input in = Input::unchecked(0.6, 5, 100, 5);
+    assert(in.message(in.check()) == "Nozzle diameter must be between 8 and 64 (64ths of an inch) (got 5); "
+                                     "Nozzle pressure must be between 20 and 80 psi (got 100.000000)");
+    assert(in.message(StatusOk).empty());
+
+    ValidationResult result = calculateEvaporationLossWithValidation(0.6, 5, 100, 5);
+    assert(!result.isValid);
+    assert(result.status == (NozzleOutOfRange | PressureOutOfRange));
+    assert(result.errorMessage == thrownMessage(0.6, 5, 100, 5));
+    std::cout << "[PASS] Messages formatted on request" << std::endl;
+}
+
+void testNonThrowingPaths() {
+    size_t before = allocationCount;
+    Status status = 0xFF;
+    double value = Calculator::calculateWithStatus(Input::unchecked(0.6, 12, 40, 5), status);
+    assert(status == StatusOk);
+    assert(bitEqual(value, Calculator::calculateUnchecked(Input::unchecked(0.6, 12, 40, 5))));
+
+    value = Calculator::calculateWithStatus(Input::unchecked(0.6, 12, 40, 20), status, -1.0);
+    assert(status == WindOutOfRange);
+    assert(value == -1.0);
+
+    assert(calculateEvaporationLossSafe(1.5, 12, 40, 5, -2.0) == -2.0);
+    assert(bitEqual(calculateEvaporationLossSafe(0.6, 12, 40, 5), calculateEvaporationLoss(0.6, 12, 40, 5)));
+    assert(allocationCount == before);
+    std::cout << "[PASS] Status and Safe paths do not throw or allocate" << std::endl;
+}
+
+void testBatch() {
+    // Dirty feed: every 20th record has one or more parameters out of range
+    std::vector<double> vpd, pressure, wind;
+    std::vector<int> nozzle;
+    for (int i = 0; i < 4000; i++) {
+        bool dirty = i % 20 == 0;
+        vpd.push_back(dirty && i % 40 == 0 ? 1.2 : (i % 101) / 100.0);
+        nozzle.push_back(dirty && i % 60 == 0 ? 70 : 8 + (i % 57));
+        pressure.push_back(dirty ? 10.0 + (i % 3) * 40 : 20.0 + (i % 61));
+        wind.push_back((i % 151) / 10.0);
+    }
+    const size_t n = vpd.size();
+    std::vector<double> out(n);
+    std::vector<Status> status(n);
+
+    size_t before = allocationCount;
+    size_t invalid = Calculator::calculateBatch(vpd.data(), nozzle.data(), pressure.data(), wind.data(),
+                                                out.data(), status.data(), n, -1.0);
+    assert(allocationCount == before);
+
+    size_t expectedInvalid = 0;
+    for (size_t i = 0; i < n; i++) {
+        Status expected = checkInputs(vpd[i], nozzle[i], pressure[i], wind[i]);
+        assert(status[i] == expected);
+        if (expected == StatusOk) {
+            assert(bitEqual(out[i], calculateEvaporationLoss(vpd[i], nozzle[i], pressure[i], wind[i])));
+        } else {
+            assert(out[i] == -1.0);
+            assert(!thrownMessage(vpd[i], nozzle[i], pressure[i], wind[i]).empty());
+            expectedInvalid++;
+        }
+    }
+    assert(invalid == expectedInvalid);
+    assert(invalid > 0 && invalid < n);
+    std::cout << "[PASS] Batch validator: " << invalid << " of " << n << " records flagged" << std::endl;
+}
+
+int main() {
+    std::cout << "=== Validation Status Tests ===" << std::endl;
+
+    testStatusBits();
+    testMessages();
+    testNonThrowingPaths();
+    testBatch();
+
+    std::cout << "\n✅ All validation status tests passed!" << std::endl;
+    return 0;
+}